@@ -22,6 +22,7 @@ class AggressorAI : public CreatureAI
 
         void UpdateAI(const uint32);
         static int Permissible(const Creature*);
+        static bool IsIdleOutOfCombat() { return true; }
 };
 
 typedef std::vector<uint32> SpellVct;
@@ -38,6 +39,7 @@ class CombatAI : public CreatureAI
         void UpdateAI(const uint32 diff);
         void SpellInterrupted(uint32 spellId, uint32 unTimeMs);
         static int Permissible(const Creature*);
+        static bool IsIdleOutOfCombat() { return true; }
 
     protected:
         EventMap events;
@@ -64,6 +66,7 @@ struct ArcherAI : public CreatureAI
         void UpdateAI(const uint32 diff);
 
         static int Permissible(const Creature*);
+        static bool IsIdleOutOfCombat() { return true; }
     protected:
         float m_minRange;
 };
@@ -77,6 +80,7 @@ struct TurretAI : public CreatureAI
         void UpdateAI(const uint32 diff);
 
         static int Permissible(const Creature*);
+        static bool IsIdleOutOfCombat() { return true; }
     protected:
         float m_minRange;
 };
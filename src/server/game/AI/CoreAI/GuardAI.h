@@ -19,6 +19,7 @@ class GuardAI : public ScriptedAI
         explicit GuardAI(Creature* creature);
 
         static int Permissible(Creature const* creature);
+        static bool IsIdleOutOfCombat() { return true; }
         bool CanSeeAlways(WorldObject const* obj);
 
         void EnterEvadeMode();
@@ -23,6 +23,7 @@ class PassiveAI : public CreatureAI
         virtual bool IsPassived() { return true; }
 
         static int Permissible(const Creature*) { return PERMIT_BASE_IDLE;  }
+        static bool IsIdleOutOfCombat() { return true; }
 };
 
 class PossessedAI : public CreatureAI
@@ -53,6 +54,7 @@ class NullCreatureAI : public CreatureAI
         void OnCharmed(bool /*apply*/) {}
 
         static int Permissible(const Creature*) { return PERMIT_BASE_IDLE;  }
+        static bool IsIdleOutOfCombat() { return true; }
 };
 
 class CritterAI : public PassiveAI
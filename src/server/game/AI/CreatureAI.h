@@ -73,7 +73,7 @@ class CreatureAI : public UnitAI
 
     public:
         void Talk(uint8 id, uint64 WhisperGuid = 0, uint32 range = 0);
-        explicit CreatureAI(Creature* creature) : UnitAI(creature), me(creature), m_MoveInLineOfSight_locked(false), m_canSeeEvenInPassiveMode(false) {}
+        explicit CreatureAI(Creature* creature) : UnitAI(creature), me(creature), m_MoveInLineOfSight_locked(false), m_canSeeEvenInPassiveMode(false), m_Sleepable(false) {}
 
         virtual ~CreatureAI() {}
 
@@ -88,6 +88,12 @@ class CreatureAI : public UnitAI
         // Called in Creature::Update when deathstate = DEAD. Inherited classes may maniuplate the ability to respawn based on scripted events.
         virtual bool CanRespawn() { return true; }
 
+        /// True for the AI classes whose UpdateAI does nothing out of combat, an idle creature doesn't call it.
+        /// Only checked for the AIs created from the registry, scripts inheriting them may override UpdateAI.
+        static bool IsIdleOutOfCombat() { return false; }
+        bool IsSleepable() const { return m_Sleepable; }
+        void SetSleepable(bool p_Sleepable) { m_Sleepable = p_Sleepable; }
+
         // Called for reaction at stopping attack at no attackers or targets
         virtual void EnterEvadeMode();
 
@@ -370,6 +376,7 @@ class CreatureAI : public UnitAI
     private:
         bool m_MoveInLineOfSight_locked;
         bool m_canSeeEvenInPassiveMode;
+        bool m_Sleepable;
 };
 
 enum Permitions
@@ -33,7 +33,9 @@ inline CreatureAI*
 CreatureAIFactory<REAL_AI>::Create(void* data) const
 {
     Creature* creature = reinterpret_cast<Creature*>(data);
-    return (new REAL_AI(creature));
+    CreatureAI* ai = new REAL_AI(creature);
+    ai->SetSleepable(REAL_AI::IsIdleOutOfCombat());
+    return ai;
 }
 
 typedef FactoryHolder<CreatureAI> CreatureAICreator;
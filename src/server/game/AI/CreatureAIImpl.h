@@ -13,6 +13,7 @@
 #include "CreatureAI.h"
 #include "TemporarySummon.h"
 #include "SpellMgr.h"
+#include "TimerWheel.h"
 #include <functional>
 #include <type_traits>
 
@@ -23,22 +24,33 @@ static inline First const& RAND(First const& first, Second const& second, Rest c
     return pack[urand(0, sizeof...(rest) + 1)].get();
 }
 
-class EventMap : private std::map<uint32, uint32>
+// Scheduled event of an EventMap, allocated from the timer pool
+struct EventMapNode : public TimerWheelNode
+{
+    uint32 EventData;                                   // event id, group bit and phase bit
+};
+
+// Timers of a script, kept in a timing wheel: scheduling and canceling don't touch the allocator
+class EventMap
 {
     public:
-        EventMap() : _time(0), _phase(0) {}
+        EventMap() : _time(0), _phase(0), _delayed(0) {}
+        EventMap(EventMap const& right);
+        ~EventMap();
+
+        EventMap& operator=(EventMap const& right);
 
         // Returns current timer value, does not represent real dates/times
         uint32 GetTimer() const { return _time; }
 
         // Removes all events and clears phase
-        void Reset() { clear(); _time = 0; _phase = 0; }
+        void Reset();
 
         void Update(uint32 time) { _time += time; }
 
         uint32 GetPhaseMask() const { return (_phase >> 24) & 0xFF; }
 
-        bool Empty() const { return empty(); }
+        bool Empty() const { return _wheel.IsEmpty(); }
 
         // Sets event phase, must be in range 1 - 8
         void SetPhase(uint32 phase)
@@ -51,22 +63,8 @@ class EventMap : private std::map<uint32, uint32>
 
         // Creates new event entry in map with given id, time, group if given (1 - 8) and phase if given (1 - 8)
         // 0 for group/phase means it belongs to no group or runs in all phases
-        void ScheduleEvent(uint32 eventId, uint32 time, uint32 groupId = 0, uint32 phase = 0)
-        {
-            time += _time;
-            if (groupId && groupId < 9)
-                eventId |= (1 << (groupId + 16));
-            if (phase && phase < 8)
-                eventId |= (1 << (phase + 24));
-            const_iterator itr = find(time);
-            while (itr != end())
-            {
-                ++time;
-                itr = find(time);
-            }
-
-            insert(std::make_pair(time, eventId));
-        }
+        // Events scheduled for the same time are executed in scheduling order
+        void ScheduleEvent(uint32 eventId, uint32 time, uint32 groupId = 0, uint32 phase = 0);
 
         // Removes event with specified id and creates new entry for it
         void RescheduleEvent(uint32 eventId, uint32 time, uint32 groupId = 0, uint32 phase = 0)
@@ -76,174 +74,40 @@ class EventMap : private std::map<uint32, uint32>
         }
 
         // Reschedules closest event
-        void RepeatEvent(uint32 time)
-        {
-            if (empty())
-                return;
-
-            uint32 eventId = begin()->second;
-            erase(begin());
-            time += _time;
-            const_iterator itr = find(time);
-            while (itr != end())
-            {
-                ++time;
-                itr = find(time);
-            }
-
-            insert(std::make_pair(time, eventId));
-        }
+        void RepeatEvent(uint32 time);
 
         // Removes first event
-        void PopEvent()
-        {
-            erase(begin());
-        }
+        void PopEvent();
 
         // Gets next event id to execute and removes it from map
-        uint32 ExecuteEvent()
-        {
-            while (!empty())
-            {
-                if (begin()->first > _time)
-                    return 0;
-                else if (_phase && (begin()->second & 0xFF000000) && !(begin()->second & _phase))
-                    erase(begin());
-                else
-                {
-                    uint32 eventId = (begin()->second & 0x0000FFFF);
-                    erase(begin());
-                    return eventId;
-                }
-            }
-            return 0;
-        }
+        uint32 ExecuteEvent();
 
         // Gets next event id to execute
-        uint32 GetEvent()
-        {
-            while (!empty())
-            {
-                if (begin()->first > _time)
-                    return 0;
-                else if (_phase && (begin()->second & 0xFF000000) && !(begin()->second & _phase))
-                    erase(begin());
-                else
-                    return (begin()->second & 0x0000FFFF);
-            }
-
-            return 0;
-        }
+        uint32 GetEvent();
 
         // Delay all events
-        void DelayEvents(uint32 delay)
-        {
-            if (delay < _time)
-                _time -= delay;
-            else
-                _time = 0;
-        }
+        void DelayEvents(uint32 delay);
 
         // Delay all events having the specified Group
-        void DelayEvents(uint32 delay, uint32 groupId)
-        {
-            uint32 nextTime = _time + delay;
-            uint32 groupMask = (1 << (groupId + 16));
-            for (iterator itr = begin(); itr != end() && itr->first < nextTime;)
-            {
-                if (itr->second & groupMask)
-                {
-                    ScheduleEvent(itr->second, itr->first - _time + delay);
-                    erase(itr);
-                    itr = begin();
-                }
-                else
-                    ++itr;
-            }
-        }
+        void DelayEvents(uint32 delay, uint32 groupId);
 
         /// Delay specific event
-        void DelayEvent(uint32 p_EventID, uint32 p_Delay)
-        {
-            uint32 l_NextTime = _time + p_Delay;
-            for (iterator l_Iter = begin(); l_Iter != end() && l_Iter->first < l_NextTime;)
-            {
-                if ((l_Iter->second & 0x0000FFFF) == p_EventID)
-                {
-                    ScheduleEvent(p_EventID, l_Iter->first - _time + p_Delay);
-                    erase(l_Iter);
-                    l_Iter = begin();
-                }
-                else
-                    ++l_Iter;
-            }
-        }
+        void DelayEvent(uint32 p_EventID, uint32 p_Delay);
 
         /// Check if specified event is scheduled
-        bool HasEvent(uint32 p_EventID) const
-        {
-            for (const_iterator l_Iter = begin(); l_Iter != end(); ++l_Iter)
-            {
-                if ((l_Iter->second & 0x0000FFFF) == p_EventID)
-                    return true;
-            }
+        bool HasEvent(uint32 p_EventID) const;
 
-            return false;
-        }
-
-        uint32 GetEventTime(uint32 p_EventID) const
-        {
-            for (const_iterator l_Iter = begin(); l_Iter != end(); ++l_Iter)
-            {
-                if ((l_Iter->second & 0x0000FFFF) == p_EventID)
-                    return l_Iter->first;
-            }
-
-            return 0;
-        }
+        uint32 GetEventTime(uint32 p_EventID) const { return GetNextEventTime(p_EventID); }
 
         // Cancel events with specified id
-        void CancelEvent(uint32 eventId)
-        {
-            for (iterator itr = begin(); itr != end();)
-            {
-                if (eventId == (itr->second & 0x0000FFFF))
-                {
-                    erase(itr);
-                    itr = begin();
-                }
-                else
-                    ++itr;
-            }
-        }
+        void CancelEvent(uint32 eventId);
 
         // Cancel events belonging to specified group
-        void CancelEventGroup(uint32 groupId)
-        {
-            uint32 groupMask = (1 << (groupId + 16));
-
-            for (iterator itr = begin(); itr != end();)
-            {
-                if (itr->second & groupMask)
-                {
-                    erase(itr);
-                    itr = begin();
-                }
-                else
-                    ++itr;
-            }
-        }
+        void CancelEventGroup(uint32 groupId);
 
         // Returns time of next event to execute
         // To get how much time remains substract _time
-        uint32 GetNextEventTime(uint32 eventId) const
-        {
-            for (const_iterator itr = begin(); itr != end(); ++itr)
-                if (eventId == (itr->second & 0x0000FFFF))
-                    return itr->first;
-
-            return 0;
-        }
+        uint32 GetNextEventTime(uint32 eventId) const;
 
         /**
         * @name IsInPhase
@@ -260,8 +124,19 @@ class EventMap : private std::map<uint32, uint32>
         }
 
     private:
+        // Wheel time, goes on while DelayEvents rolls _time back
+        uint64 GetWheelTime() const { return uint64(_time) + _delayed; }
+
+        EventMapNode* GetEarliestEvent();
+        void DelayMatchingEvents(uint32 delay, uint32 mask, uint32 eventId);
+        void RemoveMatchingEvents(uint32 mask, uint32 eventId);
+        void CopyEvents(EventMap const& right);
+        void DeleteEvents();
+
         uint32 _time;
         uint32 _phase;
+        uint64 _delayed;                                // sum of DelayEvents, wheel time minus _time
+        TimerWheel _wheel;
 };
 
 enum AITarget
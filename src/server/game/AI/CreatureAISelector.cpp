@@ -86,7 +86,14 @@ namespace FactorySelector
         ainame = (ai_factory == NULL) ? "NullCreatureAI" : ai_factory->key();
 
         sLog->outDebug(LOG_FILTER_TSCR, "Creature %u used AI is %s.", creature->GetGUIDLow(), ainame.c_str());
-        return (ai_factory == NULL ? new NullCreatureAI(creature) : ai_factory->Create(creature));
+        if (!ai_factory)
+        {
+            CreatureAI* ai = new NullCreatureAI(creature);
+            ai->SetSleepable(NullCreatureAI::IsIdleOutOfCombat());
+            return ai;
+        }
+
+        return ai_factory->Create(creature);
     }
 
     MovementGenerator* selectMovementGenerator(Creature* creature)
@@ -0,0 +1,261 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "CreatureAIImpl.h"
+
+static EventMapNode* NewEventMapNode(uint32 eventData)
+{
+    EventMapNode* node = new (TimerWheelPool::Allocate(sizeof(EventMapNode))) EventMapNode();
+    node->EventData = eventData;
+    return node;
+}
+
+static void DeleteEventMapNode(TimerWheelNode* node)
+{
+    TimerWheelPool::Free(static_cast<EventMapNode*>(node), sizeof(EventMapNode));
+}
+
+EventMap::EventMap(EventMap const& right)
+    : _time(right._time), _phase(right._phase), _delayed(right._delayed), _wheel(right._wheel.GetTime())
+{
+    CopyEvents(right);
+}
+
+EventMap::~EventMap()
+{
+    DeleteEvents();
+}
+
+EventMap& EventMap::operator=(EventMap const& right)
+{
+    if (this == &right)
+        return *this;
+
+    DeleteEvents();
+
+    _time    = right._time;
+    _phase   = right._phase;
+    _delayed = right._delayed;
+    _wheel.Reset(right._wheel.GetTime());
+
+    CopyEvents(right);
+    return *this;
+}
+
+void EventMap::Reset()
+{
+    DeleteEvents();
+    _wheel.Reset(0);
+
+    _time    = 0;
+    _phase   = 0;
+    _delayed = 0;
+}
+
+void EventMap::ScheduleEvent(uint32 eventId, uint32 time, uint32 groupId, uint32 phase)
+{
+    if (groupId && groupId < 9)
+        eventId |= (1 << (groupId + 16));
+    if (phase && phase < 8)
+        eventId |= (1 << (phase + 24));
+
+    _wheel.Insert(NewEventMapNode(eventId), GetWheelTime() + time);
+}
+
+void EventMap::RepeatEvent(uint32 time)
+{
+    EventMapNode* node = GetEarliestEvent();
+    if (!node)
+        return;
+
+    _wheel.Remove(node);
+    _wheel.Insert(node, GetWheelTime() + time);
+}
+
+void EventMap::PopEvent()
+{
+    if (EventMapNode* node = GetEarliestEvent())
+    {
+        _wheel.Remove(node);
+        DeleteEventMapNode(node);
+    }
+}
+
+uint32 EventMap::ExecuteEvent()
+{
+    while (EventMapNode* node = static_cast<EventMapNode*>(_wheel.PopDue(GetWheelTime())))
+    {
+        uint32 eventData = node->EventData;
+        DeleteEventMapNode(node);
+
+        if (!_phase || !(eventData & 0xFF000000) || (eventData & _phase))
+            return (eventData & 0x0000FFFF);
+    }
+
+    return 0;
+}
+
+uint32 EventMap::GetEvent()
+{
+    while (EventMapNode* node = static_cast<EventMapNode*>(_wheel.PeekDue(GetWheelTime())))
+    {
+        if (!_phase || !(node->EventData & 0xFF000000) || (node->EventData & _phase))
+            return (node->EventData & 0x0000FFFF);
+
+        _wheel.Remove(node);
+        DeleteEventMapNode(node);
+    }
+
+    return 0;
+}
+
+void EventMap::DelayEvents(uint32 delay)
+{
+    // same as before, events can't be delayed further than the beginning of the timer
+    delay = std::min(delay, _time);
+    if (!delay)
+        return;
+
+    _time    -= delay;
+    _delayed += delay;
+
+    TimerWheelNode* node = _wheel.DetachAll();
+    while (node)
+    {
+        TimerWheelNode* next = node->WheelNext;
+        _wheel.Insert(node, node->WheelDue + delay);
+        node = next;
+    }
+}
+
+void EventMap::DelayEvents(uint32 delay, uint32 groupId)
+{
+    DelayMatchingEvents(delay, (1 << (groupId + 16)), 0);
+}
+
+void EventMap::DelayEvent(uint32 p_EventID, uint32 p_Delay)
+{
+    DelayMatchingEvents(p_Delay, 0, p_EventID);
+}
+
+bool EventMap::HasEvent(uint32 p_EventID) const
+{
+    return !_wheel.Visit([p_EventID](TimerWheelNode* p_Node) -> bool
+    {
+        return (static_cast<EventMapNode*>(p_Node)->EventData & 0x0000FFFF) != p_EventID;
+    });
+}
+
+void EventMap::CancelEvent(uint32 eventId)
+{
+    RemoveMatchingEvents(0, eventId);
+}
+
+void EventMap::CancelEventGroup(uint32 groupId)
+{
+    RemoveMatchingEvents((1 << (groupId + 16)), 0);
+}
+
+uint32 EventMap::GetNextEventTime(uint32 eventId) const
+{
+    TimerWheelNode const* first = nullptr;
+
+    _wheel.Visit([eventId, &first](TimerWheelNode* p_Node) -> bool
+    {
+        if ((static_cast<EventMapNode*>(p_Node)->EventData & 0x0000FFFF) == eventId && (!first || p_Node->WheelDue < first->WheelDue))
+            first = p_Node;
+        return true;
+    });
+
+    return first ? uint32(first->WheelDue - _delayed) : 0;
+}
+
+EventMapNode* EventMap::GetEarliestEvent()
+{
+    if (TimerWheelNode* due = _wheel.PeekDue(GetWheelTime()))
+        return static_cast<EventMapNode*>(due);
+
+    // nothing due yet, only a few events are waiting in the upper levels
+    TimerWheelNode* earliest = nullptr;
+    _wheel.Visit([&earliest](TimerWheelNode* p_Node) -> bool
+    {
+        if (!earliest || p_Node->WheelDue < earliest->WheelDue)
+            earliest = p_Node;
+        return true;
+    });
+
+    return static_cast<EventMapNode*>(earliest);
+}
+
+void EventMap::DelayMatchingEvents(uint32 delay, uint32 mask, uint32 eventId)
+{
+    if (!delay)
+        return;
+
+    uint64 nextTime = GetWheelTime() + delay;
+    TimerWheelNode* delayed = nullptr;
+
+    _wheel.Visit([this, mask, eventId, nextTime, &delayed](TimerWheelNode* p_Node) -> bool
+    {
+        uint32 eventData = static_cast<EventMapNode*>(p_Node)->EventData;
+        if (p_Node->WheelDue >= nextTime || (mask ? !(eventData & mask) : (eventData & 0x0000FFFF) != eventId))
+            return true;
+
+        _wheel.Remove(p_Node);
+        p_Node->WheelNext = delayed;
+        delayed = p_Node;
+        return true;
+    });
+
+    while (delayed)
+    {
+        TimerWheelNode* next = delayed->WheelNext;
+
+        // overdue events are pushed back until they land after the delay
+        uint64 due = delayed->WheelDue;
+        while (due < nextTime)
+            due += delay;
+
+        _wheel.Insert(delayed, due);
+        delayed = next;
+    }
+}
+
+void EventMap::RemoveMatchingEvents(uint32 mask, uint32 eventId)
+{
+    _wheel.Visit([this, mask, eventId](TimerWheelNode* p_Node) -> bool
+    {
+        uint32 eventData = static_cast<EventMapNode*>(p_Node)->EventData;
+        if (mask ? (eventData & mask) : (eventData & 0x0000FFFF) == eventId)
+        {
+            _wheel.Remove(p_Node);
+            DeleteEventMapNode(p_Node);
+        }
+        return true;
+    });
+}
+
+void EventMap::CopyEvents(EventMap const& right)
+{
+    right._wheel.Visit([this](TimerWheelNode* p_Node) -> bool
+    {
+        _wheel.Insert(NewEventMapNode(static_cast<EventMapNode*>(p_Node)->EventData), p_Node->WheelDue);
+        return true;
+    });
+}
+
+void EventMap::DeleteEvents()
+{
+    TimerWheelNode* node = _wheel.DetachAll();
+    while (node)
+    {
+        TimerWheelNode* next = node->WheelNext;
+        DeleteEventMapNode(node);
+        node = next;
+    }
+}
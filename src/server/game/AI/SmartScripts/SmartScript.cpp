@@ -74,6 +74,10 @@ SmartScript::SmartScript()
     goOrigGUID = 0;
     mLastInvoker = 0;
     mScriptType = SMART_SCRIPT_TYPE_CREATURE;
+    mNearbyObjectsCenter = NULL;
+    mNearbyObjectsMap = NULL;
+    mNearbyObjectsVersion = 0;
+    mNearbyObjectsDist = 0.0f;
 }
 
 SmartScript::~SmartScript()
@@ -82,6 +86,9 @@ SmartScript::~SmartScript()
         delete itr->second;
 
     delete mTargetStorage;
+
+    for (std::vector<ObjectList*>::iterator itr = mTargetListPool.begin(); itr != mTargetListPool.end(); ++itr)
+        delete *itr;
 }
 
 void SmartScript::OnReset()
@@ -102,18 +109,37 @@ void SmartScript::OnReset()
 
 void SmartScript::ProcessEventsFor(SMART_EVENT e, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
 {
-    for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
+    if (e >= SMART_EVENT_END || e == SMART_EVENT_LINK || !mEventTypes.test(e))//link: special handling
+        return;
+
+    // indexes rather than iterators, actions may install new events
+    uint32 key = uint32(e) << 16;
+    for (size_t i = std::lower_bound(mEventsByType.begin(), mEventsByType.end(), key) - mEventsByType.begin(); i < mEventsByType.size() && (mEventsByType[i] >> 16) == uint32(e); ++i)
+    {
+        SmartScriptHolder& holder = mEvents[mEventsByType[i] & 0xFFFF];
+        if (sConditionMgr->IsObjectMeetingSmartEventConditions(holder.entryOrGuid, holder.event_id, holder.source_type, unit, GetBaseObject()))
+            ProcessEvent(holder, unit, var0, var1, bvar, spell, gob);
+    }
+}
+
+void SmartScript::BuildEventBuckets()
+{
+    mEventTypes.reset();
+    mEventsByType.clear();
+    mEventsByType.reserve(mEvents.size());
+
+    for (size_t i = 0; i < mEvents.size() && i <= 0xFFFF; ++i)
     {
-        SMART_EVENT eventType = SMART_EVENT((*i).GetEventType());
-        if (eventType == SMART_EVENT_LINK)//special handling
+        uint32 eventType = mEvents[i].GetEventType();
+        if (eventType >= SMART_EVENT_END)
             continue;
 
-        if (eventType == e/* && (!(*i).event.event_phase_mask || IsInPhase((*i).event.event_phase_mask)) && !((*i).event.event_flags & SMART_EVENT_FLAG_NOT_REPEATABLE && (*i).runOnce)*/)
-        {
-            if (sConditionMgr->IsObjectMeetingSmartEventConditions(i->entryOrGuid, i->event_id, i->source_type, unit, GetBaseObject()))
-                ProcessEvent(*i, unit, var0, var1, bvar, spell, gob);
-        }
+        mEventTypes.set(eventType);
+        mEventsByType.push_back((eventType << 16) | uint32(i));
     }
+
+    // events of a same type keep their script order
+    std::sort(mEventsByType.begin(), mEventsByType.end());
 }
 
 void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
@@ -156,7 +182,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
 
             if (!talker)
@@ -196,7 +222,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         (*itr)->GetName(), (*itr)->GetGUIDLow(), uint8(e.action.talk.textGroupID));
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -215,7 +241,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -234,7 +260,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -268,7 +294,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -312,7 +338,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_FAIL_QUEST:
@@ -331,7 +357,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_ADD_QUEST:
@@ -353,7 +379,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_REACT_STATE:
@@ -392,7 +418,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 
             if (count == 0)
             {
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
 
@@ -407,7 +433,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_THREAT_ALL_PCT:
@@ -446,7 +472,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_CALL_AREAEXPLOREDOREVENTHAPPENS:
@@ -472,7 +498,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SEND_CASTCREATUREORGO:
@@ -494,7 +520,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_CAST:
@@ -522,7 +548,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_INVOKER_CAST:
@@ -556,7 +582,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_ADD_AURA:
@@ -575,7 +601,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_ACTIVATE_GOBJECT:
@@ -596,7 +622,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_RESET_GOBJECT:
@@ -615,7 +641,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_EMOTE_STATE:
@@ -634,7 +660,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_UNIT_FLAG:
@@ -653,7 +679,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVE_UNIT_FLAG:
@@ -672,7 +698,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_AUTO_ATTACK:
@@ -776,7 +802,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVEAURASFROMSPELL:
@@ -799,7 +825,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->GetGUIDLow(), e.action.removeAura.spell);
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_FOLLOW:
@@ -822,7 +848,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_RANDOM_PHASE:
@@ -899,7 +925,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         (*itr)->GetGUIDLow(), e.action.killedMonster.creature);
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             else if (trigger && IsPlayer(unit))
             {
@@ -954,7 +980,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             sLog->outDebug(LOG_FILTER_DATABASE_AI, "SmartScript::ProcessAction: SMART_ACTION_SET_INST_DATA64: Field: %u, data: " UI64FMTD,
                 e.action.setInstanceData64.field, targets->front()->GetGUID());
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_UPDATE_TEMPLATE:
@@ -1055,7 +1081,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->ToUnit()->Dismount();
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_INVINCIBILITY_HP_LEVEL:
@@ -1088,7 +1114,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->ToGameObject()->AI()->SetData(e.action.setData.field, e.action.setData.data);
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_MOVE_FORWARD:
@@ -1139,7 +1165,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SUMMON_CREATURE:
@@ -1160,7 +1186,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                             summon->AI()->AttackStart((*itr)->ToUnit());
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
 
             if (e.GetTargetType() != SMART_TARGET_POSITION)
@@ -1193,7 +1219,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     GetBaseObject()->SummonGameObject(e.action.summonGO.entry, x, y, z, o, 0, 0, 0, 0, e.action.summonGO.despawnTime);
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
 
             if (e.GetTargetType() != SMART_TARGET_POSITION)
@@ -1216,7 +1242,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 (*itr)->ToUnit()->Kill((*itr)->ToUnit());
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_INSTALL_AI_TEMPLATE:
@@ -1238,7 +1264,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 (*itr)->ToPlayer()->AddItem(e.action.item.entry, e.action.item.count);
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVE_ITEM:
@@ -1255,7 +1281,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 (*itr)->ToPlayer()->DestroyItemCount(e.action.item.entry, e.action.item.count, true);
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_STORE_VARIABLE_DECIMAL:
@@ -1285,7 +1311,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 (*itr)->ToPlayer()->TeleportTo(e.action.teleport.mapID, e.target.x, e.target.y, e.target.z, e.target.o);
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_FLY:
@@ -1373,7 +1399,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             else if (targets && !targets->empty())
                 me->SetFacingToObject(*targets->begin());
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_PLAYMOVIE:
@@ -1390,7 +1416,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 (*itr)->ToPlayer()->SendMovieStart(e.action.movie.entry);
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_MOVE_TO_POS:
@@ -1412,7 +1438,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     break;
 
                 target = targets->front();
-                delete targets;
+                ReleaseTargetList(targets);
             }
 
             if (!target)
@@ -1443,7 +1469,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->ToGameObject()->SetRespawnTime(e.action.RespawnTarget.goRespawnTime);
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_CLOSE_GOSSIP:
@@ -1456,7 +1482,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsPlayer(*itr))
                     (*itr)->ToPlayer()->PlayerTalkClass->SendCloseGossip();
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_EQUIP:
@@ -1478,7 +1504,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         if (!einfo)
                         {
                             sLog->outError(LOG_FILTER_SQL, "SmartScript: SMART_ACTION_EQUIP uses non-existent equipment info entry %u", e.action.equip.entry);
-                            delete targets;
+                            ReleaseTargetList(targets);
                             hasDelete = true;
                             break;
                         }
@@ -1505,7 +1531,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             if (hasDelete)
                 break;
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_CREATE_TIMED_EVENT:
@@ -1573,7 +1599,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_RESET_SCRIPT_BASE_OBJECT:
@@ -1599,7 +1625,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                             if (CAST_AI(SmartAI, target->AI())->CanCombatMove())
                                 target->GetMotionMaster()->MoveChase(target->getVictim(), attackDistance, attackAngle);
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -1628,7 +1654,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -1642,7 +1668,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->SetUInt32Value(UNIT_FIELD_NPC_FLAGS, e.action.unitFlag.flag);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_ADD_NPC_FLAG:
@@ -1655,7 +1681,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->SetFlag(UNIT_FIELD_NPC_FLAGS, e.action.unitFlag.flag);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVE_NPC_FLAG:
@@ -1668,7 +1694,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->RemoveFlag(UNIT_FIELD_NPC_FLAGS, e.action.unitFlag.flag);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_CROSS_CAST:
@@ -1680,7 +1706,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             ObjectList* targets = GetTargets(e, unit);
             if (!targets)
             {
-                delete casters; // casters already validated, delete now
+                ReleaseTargetList(casters); // casters already validated, delete now
                 break;
             }
 
@@ -1704,8 +1730,8 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
-            delete casters;
+            ReleaseTargetList(targets);
+            ReleaseTargetList(casters);
             break;
         }
         case SMART_ACTION_CALL_RANDOM_TIMED_ACTIONLIST:
@@ -1755,7 +1781,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -1785,7 +1811,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -1799,7 +1825,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsPlayer(*itr))
                     (*itr)->ToPlayer()->ActivateTaxiPathTo(e.action.taxi.id);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_RANDOM_MOVE:
@@ -1831,7 +1857,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     me->GetMotionMaster()->MoveIdle();
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_UNIT_FIELD_BYTES_1:
@@ -1843,7 +1869,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->SetByteFlag(UNIT_FIELD_ANIM_TIER, e.action.setunitByte.type, e.action.setunitByte.byte1);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVE_UNIT_FIELD_BYTES_1:
@@ -1856,7 +1882,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->RemoveByteFlag(UNIT_FIELD_ANIM_TIER, e.action.delunitByte.type, e.action.delunitByte.byte1);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_INTERRUPT_SPELL:
@@ -1869,7 +1895,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->InterruptNonMeleeSpells(e.action.interruptSpellCasting.withDelayed, e.action.interruptSpellCasting.spell_id, e.action.interruptSpellCasting.withInstant);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SEND_GO_CUSTOM_ANIM:
@@ -1882,7 +1908,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsGameObject(*itr))
                     (*itr)->ToGameObject()->SendCustomAnim(e.action.sendGoCustomAnim.anim);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_DYNAMIC_FLAG:
@@ -1895,7 +1921,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->SetUInt32Value(OBJECT_FIELD_DYNAMIC_FLAGS, e.action.unitFlag.flag);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_ADD_DYNAMIC_FLAG:
@@ -1908,7 +1934,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->SetFlag(OBJECT_FIELD_DYNAMIC_FLAGS, e.action.unitFlag.flag);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVE_DYNAMIC_FLAG:
@@ -1921,7 +1947,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->RemoveFlag(OBJECT_FIELD_DYNAMIC_FLAGS, e.action.unitFlag.flag);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_JUMP_TO_POS:
@@ -1945,7 +1971,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsGameObject(*itr))
                     (*itr)->ToGameObject()->SetLootState((LootState)e.action.setGoLootState.state);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SEND_TARGET_TO_TARGET:
@@ -1957,7 +1983,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             ObjectList* storedTargets = GetTargetList(e.action.sendTargetToTarget.id);
             if (!storedTargets)
             {
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
 
@@ -1979,7 +2005,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SEND_GOSSIP_MENU:
@@ -2005,7 +2031,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     player->SEND_GOSSIP_MENU(e.action.sendGossipMenu.gossipNpcTextId, GetBaseObject()->GetGUID());
                 }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
 
@@ -2039,7 +2065,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
 
             break;
         }
@@ -2069,7 +2095,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsGameObject(*itr))
                     (*itr)->ToGameObject()->SetUInt32Value(GAMEOBJECT_FIELD_FLAGS, e.action.goFlag.flag);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
 
@@ -2083,7 +2109,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsGameObject(*itr))
                     (*itr)->ToGameObject()->SetFlag(GAMEOBJECT_FIELD_FLAGS, e.action.goFlag.flag);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
 
@@ -2096,7 +2122,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
                 if (IsGameObject(*itr))
                     (*itr)->ToGameObject()->RemoveFlag(GAMEOBJECT_FIELD_FLAGS, e.action.goFlag.flag);
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
 
@@ -2119,7 +2145,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsUnit(*itr))
                         (*itr)->ToUnit()->SetPower(Powers(e.action.power.powerType), e.action.power.newPower);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_ADD_POWER:
@@ -2131,7 +2157,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsUnit(*itr))
                         (*itr)->ToUnit()->SetPower(Powers(e.action.power.powerType), (*itr)->ToUnit()->GetPower(Powers(e.action.power.powerType)) + e.action.power.newPower);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVE_POWER:
@@ -2143,7 +2169,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsUnit(*itr))
                         (*itr)->ToUnit()->SetPower(Powers(e.action.power.powerType), (*itr)->ToUnit()->GetPower(Powers(e.action.power.powerType)) - e.action.power.newPower);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
 
@@ -2224,7 +2250,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
 
             break;
@@ -2250,7 +2276,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         }
@@ -2266,7 +2292,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->ToCreature()->SetCorpseDelay(e.action.corpseDelay.timer);
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SEND_SCENARIO_PROGRESS_UPDATE:
@@ -2495,7 +2521,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
     else if (Unit* tempLastInvoker = GetLastInvoker())
         trigger = tempLastInvoker;
 
-    ObjectList* l = new ObjectList();
+    ObjectList* l = AllocateTargetList();
     switch (e.GetTargetType())
     {
         case SMART_TARGET_SELF:
@@ -2557,9 +2583,8 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
             break;
         case SMART_TARGET_CREATURE_RANGE:
         {
-            // will always return a valid pointer, even if empty list
-            ObjectList* units = GetWorldObjectsInDist((float)e.target.unitRange.maxDist);
-            for (ObjectList::const_iterator itr = units->begin(); itr != units->end(); ++itr)
+            ObjectList const& units = GetWorldObjectsInDist((float)e.target.unitRange.maxDist);
+            for (ObjectList::const_iterator itr = units.begin(); itr != units.end(); ++itr)
             {
                 if (!IsCreature(*itr))
                     continue;
@@ -2571,14 +2596,12 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                     l->push_back(*itr);
             }
 
-            delete units;
             break;
         }
         case SMART_TARGET_CREATURE_DISTANCE:
         {
-            // will always return a valid pointer, even if empty list
-            ObjectList* units = GetWorldObjectsInDist((float)e.target.unitDistance.dist);
-            for (ObjectList::const_iterator itr = units->begin(); itr != units->end(); ++itr)
+            ObjectList const& units = GetWorldObjectsInDist((float)e.target.unitDistance.dist);
+            for (ObjectList::const_iterator itr = units.begin(); itr != units.end(); ++itr)
             {
                 if (!IsCreature(*itr))
                     continue;
@@ -2590,14 +2613,12 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                     l->push_back(*itr);
             }
 
-            delete units;
             break;
         }
         case SMART_TARGET_GAMEOBJECT_DISTANCE:
         {
-            // will always return a valid pointer, even if empty list
-            ObjectList* units = GetWorldObjectsInDist((float)e.target.goDistance.dist);
-            for (ObjectList::const_iterator itr = units->begin(); itr != units->end(); ++itr)
+            ObjectList const& units = GetWorldObjectsInDist((float)e.target.goDistance.dist);
+            for (ObjectList::const_iterator itr = units.begin(); itr != units.end(); ++itr)
             {
                 if (!IsGameObject(*itr))
                     continue;
@@ -2609,14 +2630,12 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                     l->push_back(*itr);
             }
 
-            delete units;
             break;
         }
         case SMART_TARGET_GAMEOBJECT_RANGE:
         {
-            // will always return a valid pointer, even if empty list
-            ObjectList* units = GetWorldObjectsInDist((float)e.target.goRange.maxDist);
-            for (ObjectList::const_iterator itr = units->begin(); itr != units->end(); ++itr)
+            ObjectList const& units = GetWorldObjectsInDist((float)e.target.goRange.maxDist);
+            for (ObjectList::const_iterator itr = units.begin(); itr != units.end(); ++itr)
             {
                 if (!IsGameObject(*itr))
                     continue;
@@ -2628,7 +2647,6 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                     l->push_back(*itr);
             }
 
-            delete units;
             break;
         }
         case SMART_TARGET_CREATURE_GUID:
@@ -2679,25 +2697,21 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
         }
         case SMART_TARGET_PLAYER_RANGE:
         {
-            // will always return a valid pointer, even if empty list
-            ObjectList* units = GetWorldObjectsInDist((float)e.target.playerRange.maxDist);
-            if (!units->empty() && GetBaseObject())
-                for (ObjectList::const_iterator itr = units->begin(); itr != units->end(); ++itr)
+            ObjectList const& units = GetWorldObjectsInDist((float)e.target.playerRange.maxDist);
+            if (!units.empty() && GetBaseObject())
+                for (ObjectList::const_iterator itr = units.begin(); itr != units.end(); ++itr)
                     if (IsPlayer(*itr) && GetBaseObject()->IsInRange(*itr, (float)e.target.playerRange.minDist, (float)e.target.playerRange.maxDist))
                         l->push_back(*itr);
 
-            delete units;
             break;
         }
         case SMART_TARGET_PLAYER_DISTANCE:
         {
-            // will always return a valid pointer, even if empty list
-            ObjectList* units = GetWorldObjectsInDist((float)e.target.playerDistance.dist);
-            for (ObjectList::const_iterator itr = units->begin(); itr != units->end(); ++itr)
+            ObjectList const& units = GetWorldObjectsInDist((float)e.target.playerDistance.dist);
+            for (ObjectList::const_iterator itr = units.begin(); itr != units.end(); ++itr)
                 if (IsPlayer(*itr))
                     l->push_back(*itr);
 
-            delete units;
             break;
         }
         case SMART_TARGET_STORED:
@@ -2778,26 +2792,87 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
 
     if (l->empty())
     {
-        delete l;
+        ReleaseTargetList(l);
         l = NULL;
     }
 
     return l;
 }
 
-ObjectList* SmartScript::GetWorldObjectsInDist(float dist)
+struct SmartScriptNearbyObjectCollector
+{
+    SmartScriptNearbyObjectCollector(ObjectList& objects, JadeCore::AllWorldObjectsInRange& check) : _objects(objects), _check(check) { }
+
+    void operator()(WorldObject* obj) const
+    {
+        if (_check(obj))
+            _objects.push_back(obj);
+    }
+
+    ObjectList& _objects;
+    JadeCore::AllWorldObjectsInRange& _check;
+};
+
+ObjectList const& SmartScript::GetWorldObjectsInDist(float dist)
 {
-    ObjectList* targets = new ObjectList();
+    mNearbyObjectsInDist.clear();
+
     WorldObject* obj = GetBaseObject();
-    if (obj)
+    if (!obj || !obj->IsInWorld())
+        return mNearbyObjectsInDist;
+
+    JadeCore::AllWorldObjectsInRange u_check(obj, dist);
+
+    // a single grid search per update, as long as no object entered or left the map
+    Map const* map = obj->GetMap();
+    if (obj != mNearbyObjectsCenter || map != mNearbyObjectsMap || map->GetObjectsVersion() != mNearbyObjectsVersion || dist > mNearbyObjectsDist)
     {
-        JadeCore::AllWorldObjectsInRange u_check(obj, dist);
-        JadeCore::WorldObjectListSearcher<JadeCore::AllWorldObjectsInRange> searcher(obj, *targets, u_check);
-        obj->VisitNearbyObject(dist, searcher);
+        mNearbyObjects.clear();
+
+        // targets are only ever creatures, gameobjects and players
+        SmartScriptNearbyObjectCollector collector(mNearbyObjects, u_check);
+        JadeCore::WorldObjectWorker<SmartScriptNearbyObjectCollector> worker(obj, collector, GRID_MAP_TYPE_MASK_CREATURE | GRID_MAP_TYPE_MASK_GAMEOBJECT | GRID_MAP_TYPE_MASK_PLAYER);
+        obj->VisitNearbyObject(dist, worker);
+
+        mNearbyObjectsCenter  = obj;
+        mNearbyObjectsMap     = map;
+        mNearbyObjectsVersion = map->GetObjectsVersion();
+        mNearbyObjectsDist    = dist;
+        return mNearbyObjects;
     }
+
+    for (ObjectList::const_iterator itr = mNearbyObjects.begin(); itr != mNearbyObjects.end(); ++itr)
+        if (u_check(*itr))
+            mNearbyObjectsInDist.push_back(*itr);
+
+    return mNearbyObjectsInDist;
+}
+
+ObjectList* SmartScript::AllocateTargetList()
+{
+    if (mTargetListPool.empty())
+        return new ObjectList();
+
+    ObjectList* targets = mTargetListPool.back();
+    mTargetListPool.pop_back();
     return targets;
 }
 
+void SmartScript::ReleaseTargetList(ObjectList* targets)
+{
+    if (!targets)
+        return;
+
+    if (mTargetListPool.size() >= SMART_TARGET_LIST_POOL_SIZE)
+    {
+        delete targets;
+        return;
+    }
+
+    targets->clear();
+    mTargetListPool.push_back(targets);
+}
+
 void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
 {
     if (!e.active && e.GetEventType() != SMART_EVENT_LINK)
@@ -3264,7 +3339,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
                 }
             }
 
-            delete _targets;
+            ReleaseTargetList(_targets);
 
             if (!target)
                 return;
@@ -3454,6 +3529,7 @@ void SmartScript::InstallEvents()
             mEvents.push_back(*i);//must be before UpdateTimers
 
         mInstallEvents.clear();
+        BuildEventBuckets();
     }
 }
 
@@ -3540,6 +3616,7 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEn
         }
         mEvents.push_back((*i));//NOTE: 'world(0)' events still get processed in ANY instance mode
     }
+    BuildEventBuckets();
     if (mEvents.empty() && obj)
         sLog->outDebug(LOG_FILTER_SQL, "SmartScript: Entry %u has events but no events added to list because of instance flags.", obj->GetEntry());
     if (mEvents.empty() && at)
@@ -20,6 +20,10 @@
 #include "SmartScriptMgr.h"
 //#include "SmartAI.h"
 
+#include <bitset>
+
+#define SMART_TARGET_LIST_POOL_SIZE 8                   // released target lists kept by a script for its next actions
+
 class SmartScript
 {
     public:
@@ -39,7 +43,10 @@ class SmartScript
         void ProcessAction(SmartScriptHolder& e, Unit* unit = NULL, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, const SpellInfo* spell = NULL, GameObject* gob = NULL);
         void ProcessTimedAction(SmartScriptHolder& e, uint32 const& min, uint32 const& max, Unit* unit = NULL, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, const SpellInfo* spell = NULL, GameObject* gob = NULL);
         ObjectList* GetTargets(SmartScriptHolder const& e, Unit* invoker = NULL);
-        ObjectList* GetWorldObjectsInDist(float dist);
+        // gives a list returned by GetTargets back to the script
+        void ReleaseTargetList(ObjectList* targets);
+        // objects around the base object, valid until the next call
+        ObjectList const& GetWorldObjectsInDist(float dist);
         void InstallTemplate(SmartScriptHolder const& e);
         SmartScriptHolder CreateEvent(SMART_EVENT e, uint32 event_flags, uint32 event_param1, uint32 event_param2, uint32 event_param3, uint32 event_param4, SMART_ACTION action, uint32 action_param1, uint32 action_param2, uint32 action_param3, uint32 action_param4, uint32 action_param5, uint32 action_param6, SMARTAI_TARGETS t, uint32 target_param1, uint32 target_param2, uint32 target_param3, uint32 phaseMask = 0);
         void AddEvent(SMART_EVENT e, uint32 event_flags, uint32 event_param1, uint32 event_param2, uint32 event_param3, uint32 event_param4, SMART_ACTION action, uint32 action_param1, uint32 action_param2, uint32 action_param3, uint32 action_param4, uint32 action_param5, uint32 action_param6, SMARTAI_TARGETS t, uint32 target_param1, uint32 target_param2, uint32 target_param3, uint32 phaseMask = 0);
@@ -94,7 +101,7 @@ class SmartScript
                 if ((*mTargetStorage)[id] == targets)
                     return;
 
-                delete (*mTargetStorage)[id];
+                ReleaseTargetList((*mTargetStorage)[id]);
             }
 
             (*mTargetStorage)[id] = targets;
@@ -250,6 +257,8 @@ class SmartScript
         void SetPhase(uint32 p = 0) { mEventPhase = p; }
 
         SmartAIEventList mEvents;
+        std::vector<uint32> mEventsByType;              // (event type << 16) | mEvents index, sorted, rebuilt when events are added
+        std::bitset<SMART_EVENT_END> mEventTypes;       // event types having at least one event
         SmartAIEventList mInstallEvents;
         SmartAIEventList mTimedActionList;
         Creature* me;
@@ -273,6 +282,19 @@ class SmartScript
 
         SMARTAI_TEMPLATE mTemplate;
         void InstallEvents();
+        void BuildEventBuckets();
+
+        ObjectList* AllocateTargetList();
+
+        std::vector<ObjectList*> mTargetListPool;       // released target lists, their capacity is reused
+
+        // last grid search around the base object, reused while the map objects version doesn't change
+        ObjectList mNearbyObjects;
+        ObjectList mNearbyObjectsInDist;
+        WorldObject const* mNearbyObjectsCenter;
+        Map const* mNearbyObjectsMap;
+        uint32 mNearbyObjectsVersion;
+        float mNearbyObjectsDist;
 
         void RemoveStoredEvent (uint32 id)
         {
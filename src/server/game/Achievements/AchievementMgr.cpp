@@ -389,8 +389,10 @@ bool AchievementCriteriaDataSet::Meets(Player const* p_Source, Unit const* p_Tar
 }
 
 template<class T>
-AchievementMgr<T>::AchievementMgr(T* owner) : _owner(owner), _achievementPoints(0), m_NeedDBSync(false)
+AchievementMgr<T>::AchievementMgr(T* owner) : _owner(owner), _achievementPoints(0), m_NeedDBSync(false),
+    m_CompletedCriteriaBits(sCriteriaStore.GetNumRows() / 32 + 1)
 {
+    ClearCompletedCriteriaBits();
 }
 
 template<class T>
@@ -434,6 +436,7 @@ void AchievementMgr<T>::RemoveCriteriaProgress(CriteriaEntry const* p_Entry)
     SendPacket(&l_Data);
 
     l_ProgressMap->erase(l_CriteriaProgress);
+    SetCompletedCriteriaBit(p_Entry->ID, false);
 }
 
 #ifndef CROSS
@@ -451,6 +454,7 @@ void AchievementMgr<Guild>::RemoveCriteriaProgress(CriteriaEntry const* p_Entry)
 
     SendPacket(&l_Data);
     GetCriteriaProgressMap()->erase(l_CriteriaProgress);
+    SetCompletedCriteriaBit(p_Entry->ID, false);
     m_NeedDBSync = true;
 }
 #endif
@@ -1113,6 +1117,7 @@ void AchievementMgr<Player>::Reset()
 
     _achievementPoints = 0;
     criteriaProgress->clear();
+    ClearCompletedCriteriaBits();
     DeleteFromDB(GetOwner()->GetGUIDLow());
 
     // Re-fill data
@@ -1312,21 +1317,17 @@ void AchievementMgr<T>::CheckAllAchievementCriteria(Player* p_ReferencePlayer)
 
     for (uint32 l_AchievementCriteriaType = 0; l_AchievementCriteriaType < ACHIEVEMENT_CRITERIA_TYPE_TOTAL; ++l_AchievementCriteriaType)
     {
-        AchievementCriteriaUpdateTask l_Task;
-        l_Task.PlayerGUID = p_ReferencePlayer->GetGUID();
-        l_Task.UnitGUID   = 0;
-        l_Task.Task = [l_AchievementCriteriaType](uint64 const& p_PlayerGuid, uint64 const& /*p_UnitGUID*/) -> void
-        {
-            /// Task will be executed async
-            /// We need to ensure the player still exist
-            Player* l_Player = HashMapHolder<Player>::Find(p_PlayerGuid);
-            if (l_Player == nullptr)
-                return;
-
-            l_Player->GetAchievementMgr().UpdateAchievementCriteria((AchievementCriteriaTypes)l_AchievementCriteriaType, 0, 0, 0, nullptr, l_Player, true);
-        };
-
-        sAchievementMgr->AddCriteriaUpdateTask(l_Task);
+        AchievementCriteriaEvent l_Event;
+        l_Event.PlayerGUID    = p_ReferencePlayer->GetGUID();
+        l_Event.UnitGUID      = 0;
+        l_Event.MiscValues[0] = 0;
+        l_Event.MiscValues[1] = 0;
+        l_Event.MiscValues[2] = 0;
+        l_Event.Type          = l_AchievementCriteriaType;
+        l_Event.LoginCheck    = true;
+        l_Event.PlayerOnly    = true;
+
+        sAchievementMgr->AddCriteriaEvent(l_Event);
     }
 }
 
@@ -1360,7 +1361,11 @@ void AchievementMgr<T>::UpdateAchievementCriteria(AchievementCriteriaTypes p_Typ
     if (IsGuild<T>() && !sWorld->getBoolConfig(CONFIG_GUILD_LEVELING_ENABLED))
         return;
 
-    AchievementCriteriaEntryList const& l_AchievementCriteriaList = sAchievementMgr->GetAchievementCriteriaByType(p_Type);
+    // Most events (kills, loots, casts...) only concern the criteria of their creature, item or spell
+    AchievementCriteriaEntryList const& l_AchievementCriteriaList = p_MiscValue1 && AchievementGlobalMgr::IsAssetIndexedCriteriaType(p_Type)
+        ? sAchievementMgr->GetAchievementCriteriaByAsset(p_Type, p_MiscValue1)
+        : sAchievementMgr->GetAchievementCriteriaByType(p_Type);
+
     for (AchievementCriteriaEntryList::const_iterator i = l_AchievementCriteriaList.begin(); i != l_AchievementCriteriaList.end(); ++i)
     {
         CriteriaEntry const* l_AchievementCriteria = (*i);
@@ -1738,6 +1743,12 @@ bool AchievementMgr<Player>::CanCompleteCriteria(CriteriaEntry const* /*achievem
 template<class T>
 bool AchievementMgr<T>::IsCompletedCriteria(CriteriaEntry const* p_AchievementCriteria)
 {
+    if (HasCompletedCriteriaBit(p_AchievementCriteria->ID))
+        return true;
+
+    /// Realm first criteria stop being completed once someone else completes the achievement, they can't be skipped
+    bool l_CanSkip = true;
+
     AchievementCriteriaTreeList const& l_CriteriaTreeList = sAchievementMgr->GetAchievementCriteriaTreeList(p_AchievementCriteria);
     for (AchievementCriteriaTreeList::const_iterator l_Iter = l_CriteriaTreeList.begin(); l_Iter != l_CriteriaTreeList.end(); l_Iter++)
     {
@@ -1746,11 +1757,17 @@ bool AchievementMgr<T>::IsCompletedCriteria(CriteriaEntry const* p_AchievementCr
         if (!l_Achievement)
             return false;
 
+        if (l_Achievement->Flags & (ACHIEVEMENT_FLAG_REALM_FIRST_REACH | ACHIEVEMENT_FLAG_REALM_FIRST_KILL))
+            l_CanSkip = false;
+
         if (CriteriaEntry const* l_Criteria = sCriteriaStore.LookupEntry(l_CriteriaTree->CriteriaID))
             if (!IsCompletedCriteriaForAchievement(l_Criteria, l_Achievement))
                 return false;
     }
 
+    if (l_CanSkip)
+        SetCompletedCriteriaBit(p_AchievementCriteria->ID, true);
+
     return true;
 }
 
@@ -2143,6 +2160,7 @@ void AchievementMgr<T>::SetCriteriaProgress(CriteriaEntry const* p_Entry, uint64
 
     l_Progress->changed = true;
     l_Progress->date = time(NULL); // set the date to the latest update.
+    SetCompletedCriteriaBit(p_Entry->ID, false);
     uint32 l_TimeElapsed = 0; // @todo : Fix me
 
     bool l_NeedAccountUpdate = false;
@@ -3779,6 +3797,49 @@ AchievementEntry const* AchievementGlobalMgr::_GetAchievementEntryByCriteriaTree
     return NULL;
 }
 
+bool AchievementGlobalMgr::IsAssetIndexedCriteriaType(AchievementCriteriaTypes p_Type)
+{
+    /// Must stay in sync with AchievementMgr::RequirementsSatisfied, every type here compares miscValue1 to the first criteria field
+    switch (p_Type)
+    {
+        case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_KILLED_BY_CREATURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_REACH_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUESTS_IN_ZONE:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET2:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL2:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_OWN_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REPUTATION:
+        case ACHIEVEMENT_CRITERIA_TYPE_DO_EMOTE:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_GAMEOBJECT:
+        case ACHIEVEMENT_CRITERIA_TYPE_FISH_IN_GAMEOBJECT:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILLLINE_SPELLS:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LINE:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAPTURE_BATTLEPET:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEVELUP_BATTLEPET:
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_CLASS:
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_RACE:
+        case ACHIEVEMENT_CRITERIA_TYPE_BG_OBJECTIVE_CAPTURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_HONORABLE_KILL_AT_AREA:
+        case ACHIEVEMENT_CRITERIA_TYPE_CURRENCY:
+        case ACHIEVEMENT_CRITERIA_TYPE_WIN_ARENA:
+        case ACHIEVEMENT_CRITERIA_TYPE_DEFEAT_ENCOUNTER:
+            return true;
+        default:
+            break;
+    }
+
+    return false;
+}
+
 void AchievementGlobalMgr::LoadAchievementCriteriaList()
 {
     uint32 l_OldMSTime = getMSTime();
@@ -3854,6 +3915,9 @@ void AchievementGlobalMgr::LoadAchievementCriteriaList()
 
         m_AchievementCriteriasByType[l_Criteria->Type].push_back(l_Criteria);
 
+        if (IsAssetIndexedCriteriaType(AchievementCriteriaTypes(l_Criteria->Type)))
+            m_AchievementCriteriasByAsset[(uint64(l_Criteria->Type) << 32) | l_Criteria->raw.criteriaArg1].push_back(l_Criteria);
+
         if (l_Criteria->StartTimer)
             m_AchievementCriteriasByTimedType[l_Criteria->StartEvent].push_back(l_Criteria);
 
@@ -4214,31 +4278,169 @@ bool AchievementMgr<T>::RequiresScript(CriteriaEntry const* p_Criteria)
     }
 }
 
-void AchievementGlobalMgr::PrepareCriteriaUpdateTaskThread()
+bool AchievementGlobalMgr::IsIdempotentCriteriaType(AchievementCriteriaTypes p_Type)
 {
-    AchievementCriteriaUpdateTask l_Task;
-    for (auto l_Iterator = m_LockedPlayersAchievementCriteriaTask.begin(); l_Iterator != m_LockedPlayersAchievementCriteriaTask.end(); l_Iterator++)
+    switch (p_Type)
     {
-        while ((*l_Iterator).second.next(l_Task))
-            m_PlayersAchievementCriteriaTask[(*l_Iterator).first].push(l_Task);
+        case ACHIEVEMENT_CRITERIA_TYPE_REACH_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_REACH_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST_COUNT:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUESTS_IN_ZONE:
+        case ACHIEVEMENT_CRITERIA_TYPE_FALL_WITHOUT_DYING:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_EXPLORE_AREA:
+        case ACHIEVEMENT_CRITERIA_TYPE_VISIT_BARBER_SHOP:
+        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_EPIC_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_ACHIEVEMENT:
+        case ACHIEVEMENT_CRITERIA_TYPE_BUY_BANK_SLOT:
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REPUTATION:
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_EXALTED_REPUTATION:
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REVERED_REPUTATION:
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_HONORED_REPUTATION:
+        case ACHIEVEMENT_CRITERIA_TYPE_KNOWN_FACTIONS:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILLLINE_SPELLS:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LINE:
+        case ACHIEVEMENT_CRITERIA_TYPE_EARN_HONORABLE_KILL:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_GOLD_VALUE_OWNED:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_AUCTION_BID:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_AUCTION_SOLD:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_HIT_DEALT:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_HIT_RECEIVED:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_HEAL_CASTED:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_HEALING_RECEIVED:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_TEAM_RATING:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_PERSONAL_RATING:
+        case ACHIEVEMENT_CRITERIA_TYPE_COLLECT_HEIRLOOMS:
+        case ACHIEVEMENT_CRITERIA_TYPE_ACHIEVEMENTS_IN_BATTLE_PET:
+        case ACHIEVEMENT_CRITERIA_TYPE_REACH_GUILD_LEVEL:
+            return true;
+        default:
+            break;
     }
+
+    return false;
 }
 
-AchievementCriteriaUpdateRequest::AchievementCriteriaUpdateRequest(MapUpdater* p_Updater, AchievementCriteriaTaskQueue p_TaskQueue)
-: MapUpdaterTask(p_Updater), m_CriteriaUpdateTasks(p_TaskQueue)
+void AchievementGlobalMgr::PrepareCriteriaBatches()
 {
+    for (uint32 l_I = 0; l_I < ACHIEVEMENT_CRITERIA_SHARDS; ++l_I)
+    {
+        AchievementCriteriaShard& l_Shard = m_CriteriaShards[l_I];
+
+        {
+            std::lock_guard<std::mutex> l_Guard(l_Shard.Lock);
+            l_Shard.Batch.swap(l_Shard.Pending);
+        }
+
+        std::vector<AchievementCriteriaEvent>& l_Batch = l_Shard.Batch;
+        if (l_Batch.empty())
+            continue;
+
+        /// Stable, events of a player must keep their queuing order
+        std::stable_sort(l_Batch.begin(), l_Batch.end(), [](AchievementCriteriaEvent const& p_A, AchievementCriteriaEvent const& p_B) -> bool
+        {
+            return p_A.PlayerGUID < p_B.PlayerGUID;
+        });
+
+        /// Only the last of identical idempotent events of a player is kept, it sees the most recent player state
+        std::vector<AchievementCriteriaEvent const*> l_Kept;
+        for (size_t l_End = l_Batch.size(); l_End > 0;)
+        {
+            size_t l_Begin = l_End - 1;
+            while (l_Begin > 0 && l_Batch[l_Begin - 1].PlayerGUID == l_Batch[l_End - 1].PlayerGUID)
+                --l_Begin;
+
+            l_Kept.clear();
+            for (size_t l_Index = l_End; l_Index-- > l_Begin;)
+            {
+                AchievementCriteriaEvent& l_Event = l_Batch[l_Index];
+                if (!IsIdempotentCriteriaType(AchievementCriteriaTypes(l_Event.Type)))
+                    continue;
+
+                bool l_Duplicate = false;
+                for (AchievementCriteriaEvent const* l_Other : l_Kept)
+                {
+                    if (*l_Other == l_Event)
+                    {
+                        l_Duplicate = true;
+                        break;
+                    }
+                }
 
+                if (l_Duplicate)
+                    l_Event.Type = ACHIEVEMENT_CRITERIA_TYPE_TOTAL;
+                else
+                    l_Kept.push_back(&l_Event);
+            }
+
+            l_End = l_Begin;
+        }
+    }
 }
 
-void AchievementCriteriaUpdateRequest::call()
+void AchievementGlobalMgr::ProcessCriteriaBatch(uint32 p_Shard)
 {
-    AchievementCriteriaUpdateTask l_Task;
-    while (!m_CriteriaUpdateTasks.empty())
+    std::vector<AchievementCriteriaEvent>& l_Batch = m_CriteriaShards[p_Shard].Batch;
+
+    Player* l_Player     = nullptr;
+    uint64  l_PlayerGUID = 0;
+#ifndef CROSS
+    Guild*  l_Guild      = nullptr;
+#endif /* not CROSS */
+
+    for (AchievementCriteriaEvent const& l_Event : l_Batch)
     {
-        l_Task = m_CriteriaUpdateTasks.front();
-        l_Task.Task(l_Task.PlayerGUID, l_Task.UnitGUID);
-        m_CriteriaUpdateTasks.pop();
+        if (l_Event.Type >= ACHIEVEMENT_CRITERIA_TYPE_TOTAL)
+            continue;
+
+        /// Events are executed async, the player may have logged out since they were queued
+        if (l_Event.PlayerGUID != l_PlayerGUID)
+        {
+            l_PlayerGUID = l_Event.PlayerGUID;
+            l_Player     = HashMapHolder<Player>::Find(l_PlayerGUID);
+
+#ifndef CROSS
+            l_Guild = l_Player ? sGuildMgr->GetGuildById(l_Player->GetGuildId()) : nullptr;
+#endif /* not CROSS */
+        }
+
+        if (l_Player == nullptr)
+            continue;
+
+        /// Same for the unit
+        Unit* l_Unit = l_Event.UnitGUID ? Unit::GetUnit(*l_Player, l_Event.UnitGUID) : nullptr;
+
+        AchievementCriteriaTypes l_Type = AchievementCriteriaTypes(l_Event.Type);
+        l_Player->GetAchievementMgr().UpdateAchievementCriteria(l_Type, l_Event.MiscValues[0], l_Event.MiscValues[1], l_Event.MiscValues[2], l_Unit, l_Player, l_Event.LoginCheck);
+
+        // Update only individual achievement criteria here, otherwise we may get multiple updates
+        // from a single boss kill
+        if (l_Event.PlayerOnly || IsGroupCriteriaType(l_Type))
+            continue;
+
+#ifndef CROSS
+        if (l_Guild)
+            l_Guild->GetAchievementMgr().UpdateAchievementCriteria(l_Type, l_Event.MiscValues[0], l_Event.MiscValues[1], l_Event.MiscValues[2], l_Unit, l_Player, l_Event.LoginCheck);
+#else /* CROSS */
+        /// @TODO: Cross sync
+#endif /* CROSS */
     }
 
+    /// Keep the capacity, the shard will swap it with its pending events next update
+    l_Batch.clear();
+}
+
+AchievementCriteriaUpdateRequest::AchievementCriteriaUpdateRequest(MapUpdater* p_Updater, uint32 p_Shard)
+: MapUpdaterTask(p_Updater), m_Shard(p_Shard)
+{
+
+}
+
+void AchievementCriteriaUpdateRequest::call()
+{
+    sAchievementMgr->ProcessCriteriaBatch(m_Shard);
     UpdateFinished();
 }
@@ -15,6 +15,8 @@
 #include "DBCEnums.h"
 #include "DBCStores.h"
 #include "MapUpdater.h"
+#include <atomic>
+#include <mutex>
 
 typedef std::vector<CriteriaEntry const*>            AchievementCriteriaEntryList;
 typedef std::vector<AchievementEntry const*>         AchievementEntryList;
@@ -27,6 +29,7 @@ typedef std::vector<AchievementEntry const*>         AchievementEntryByCriteriaT
 typedef std::vector<ModifierTreeEntryList>           ModifierTreeEntryByTreeId;
 typedef std::vector<AchievementCriteriaTreeList>     SubCriteriaTreeListById;
 typedef std::vector<AchievementEntry const*>         AchievementEntryByCriteriaTreeId;
+typedef std::unordered_map<uint64, AchievementCriteriaEntryList> AchievementCriteriaEntryByAsset;
 
 
 struct CriteriaProgress
@@ -651,6 +654,31 @@ class AchievementMgr
         bool CanUpdateCriteria(CriteriaEntry const* criteria, AchievementEntry const* achievement, uint64 miscValue1, uint64 miscValue2, uint64 miscValue3, Unit const* unit, Player* referencePlayer);
         void SendPacket(WorldPacket* data) const;
 
+        /// Criteria completed for every achievement using them, read and written by the criteria update tasks
+        bool HasCompletedCriteriaBit(uint32 p_CriteriaID) const
+        {
+            uint32 l_Word = p_CriteriaID / 32;
+            return l_Word < m_CompletedCriteriaBits.size() && (m_CompletedCriteriaBits[l_Word].load(std::memory_order_relaxed) & (1u << (p_CriteriaID % 32)));
+        }
+
+        void SetCompletedCriteriaBit(uint32 p_CriteriaID, bool p_Completed)
+        {
+            uint32 l_Word = p_CriteriaID / 32;
+            if (l_Word >= m_CompletedCriteriaBits.size())
+                return;
+
+            if (p_Completed)
+                m_CompletedCriteriaBits[l_Word].fetch_or(1u << (p_CriteriaID % 32), std::memory_order_relaxed);
+            else
+                m_CompletedCriteriaBits[l_Word].fetch_and(~(1u << (p_CriteriaID % 32)), std::memory_order_relaxed);
+        }
+
+        void ClearCompletedCriteriaBits()
+        {
+            for (std::atomic<uint32>& l_Word : m_CompletedCriteriaBits)
+                l_Word.store(0, std::memory_order_relaxed);
+        }
+
         bool ConditionsSatisfied(CriteriaEntry const *criteria, Player* referencePlayer) const;
         bool RequirementsSatisfied(CriteriaEntry const *criteria, uint64 miscValue1, uint64 miscValue2, uint64 miscValue3, Unit const* unit, Player* referencePlayer) const;
         bool AdditionalRequirementsSatisfied(CriteriaEntry const* criteria, uint64 miscValue1, uint64 miscValue2, Unit const* unit, Player* referencePlayer) const;
@@ -664,20 +692,35 @@ class AchievementMgr
         TimedAchievementMap m_timedAchievements;      // Criteria id/time left in MS
         uint32 _achievementPoints;
         bool m_NeedDBSync;
+        std::vector<std::atomic<uint32>> m_CompletedCriteriaBits;   ///< Skip list of IsCompletedCriteria, one bit per criteria id
 };
 
-struct AchievementCriteriaUpdateTask
+/// Criteria update queued by Player::UpdateAchievementCriteria, executed by the map updater threads
+struct AchievementCriteriaEvent
 {
     uint64 PlayerGUID;
     uint64 UnitGUID;
-    std::function<void(uint64, uint64)> Task;
+    uint64 MiscValues[3];
+    uint32 Type;                ///< AchievementCriteriaTypes, ACHIEVEMENT_CRITERIA_TYPE_TOTAL once discarded
+    bool   LoginCheck;
+    bool   PlayerOnly;          ///< Not forwarded to the guild achievements
+
+    bool operator==(AchievementCriteriaEvent const& p_Other) const
+    {
+        return PlayerGUID == p_Other.PlayerGUID && UnitGUID == p_Other.UnitGUID && Type == p_Other.Type && LoginCheck == p_Other.LoginCheck && PlayerOnly == p_Other.PlayerOnly
+            && MiscValues[0] == p_Other.MiscValues[0] && MiscValues[1] == p_Other.MiscValues[1] && MiscValues[2] == p_Other.MiscValues[2];
+    }
 };
 
-using LockedAchievementCriteriaTaskQueue   = ACE_Based::LockedQueue<AchievementCriteriaUpdateTask, ACE_Thread_Mutex>;
-using LockedPlayersAchievementCriteriaTask = ACE_Based::LockedMap<uint64, LockedAchievementCriteriaTaskQueue>;
+/// Criteria events are split by player GUID, every event of a player is executed by the same task, in queuing order
+#define ACHIEVEMENT_CRITERIA_SHARDS 16
 
-using AchievementCriteriaTaskQueue   = std::queue<AchievementCriteriaUpdateTask>;
-using PlayersAchievementCriteriaTask = std::map<uint32, AchievementCriteriaTaskQueue>;
+struct AchievementCriteriaShard
+{
+    std::mutex                            Lock;
+    std::vector<AchievementCriteriaEvent> Pending;      ///< Filled by any thread, under Lock
+    std::vector<AchievementCriteriaEvent> Batch;        ///< Executed during the map update
+};
 
 class AchievementGlobalMgr
 {
@@ -693,6 +736,18 @@ class AchievementGlobalMgr
             return m_AchievementCriteriasByType[type];
         }
 
+        /// Criteria of an asset indexed type whose asset (creature entry, item id, spell id...) is p_Asset
+        AchievementCriteriaEntryList const& GetAchievementCriteriaByAsset(AchievementCriteriaTypes p_Type, uint64 p_Asset) const
+        {
+            static AchievementCriteriaEntryList const s_Empty;
+
+            AchievementCriteriaEntryByAsset::const_iterator l_Itr = m_AchievementCriteriasByAsset.find((uint64(p_Type) << 32) | uint32(p_Asset));
+            return l_Itr != m_AchievementCriteriasByAsset.end() && (p_Asset >> 32) == 0 ? l_Itr->second : s_Empty;
+        }
+
+        /// Criteria types whose requirements never match a non zero miscValue1 different from the criteria asset
+        static bool IsAssetIndexedCriteriaType(AchievementCriteriaTypes p_Type);
+
         AchievementCriteriaEntryList const& GetTimedAchievementCriteriaByType(AchievementCriteriaTimedTypes type) const
         {
             return m_AchievementCriteriasByTimedType[type];
@@ -795,22 +850,24 @@ class AchievementGlobalMgr
         AchievementEntry const* GetAchievement(uint32 achievementId) const;
         CriteriaEntry const* GetAchievementCriteria(uint32 achievementId) const;
 
-        void PrepareCriteriaUpdateTaskThread();
-
-        void AddCriteriaUpdateTask(AchievementCriteriaUpdateTask const& p_Task)
+        void AddCriteriaEvent(AchievementCriteriaEvent const& p_Event)
         {
-            m_LockedPlayersAchievementCriteriaTask[p_Task.PlayerGUID].add(p_Task);
-        }
+            AchievementCriteriaShard& l_Shard = m_CriteriaShards[p_Event.PlayerGUID % ACHIEVEMENT_CRITERIA_SHARDS];
 
-        PlayersAchievementCriteriaTask const& GetPlayersCriteriaTask() const
-        {
-            return m_PlayersAchievementCriteriaTask;
+            std::lock_guard<std::mutex> l_Guard(l_Shard.Lock);
+            l_Shard.Pending.push_back(p_Event);
         }
 
-        void ClearPlayersCriteriaTask()
-        {
-            m_PlayersAchievementCriteriaTask.clear();
-        }
+        /// Moves the pending events of every shard to its batch, grouped by player, and discards redundant ones
+        void PrepareCriteriaBatches();
+
+        bool HasCriteriaBatch(uint32 p_Shard) const { return !m_CriteriaShards[p_Shard].Batch.empty(); }
+
+        /// Executes the batch of a shard, called by one map updater thread per shard
+        void ProcessCriteriaBatch(uint32 p_Shard);
+
+        /// Events setting the progress from the player state or keeping the highest value, executing one twice changes nothing
+        static bool IsIdempotentCriteriaType(AchievementCriteriaTypes p_Type);
 
     private:
         AchievementCriteriaDataMap m_criteriaDataMap;
@@ -818,6 +875,9 @@ class AchievementGlobalMgr
         // store achievement criterias by type to speed up lookup
         AchievementCriteriaEntryList m_AchievementCriteriasByType[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
 
+        // same, split by (type << 32 | asset) for asset indexed types
+        AchievementCriteriaEntryByAsset m_AchievementCriteriasByAsset;
+
         AchievementCriteriaEntryList m_AchievementCriteriasByTimedType[ACHIEVEMENT_TIMED_TYPE_MAX];
 
         // store achievements by referenced achievement id to speed up lookup
@@ -835,8 +895,7 @@ class AchievementGlobalMgr
         AchievementRewards m_achievementRewards;
         AchievementRewardLocales m_achievementRewardLocales;
 
-        LockedPlayersAchievementCriteriaTask m_LockedPlayersAchievementCriteriaTask;  ///< All criteria update task are first storing here
-        PlayersAchievementCriteriaTask       m_PlayersAchievementCriteriaTask;        ///< Before thread process, all task stored will be move here
+        AchievementCriteriaShard m_CriteriaShards[ACHIEVEMENT_CRITERIA_SHARDS];
 };
 
 #define sAchievementMgr ACE_Singleton<AchievementGlobalMgr, ACE_Null_Mutex>::instance()
@@ -845,11 +904,11 @@ class MapUpdater;
 class AchievementCriteriaUpdateRequest : public MapUpdaterTask
 {
     public:
-        AchievementCriteriaUpdateRequest(MapUpdater* p_Updater, AchievementCriteriaTaskQueue p_TaskQueue);
+        AchievementCriteriaUpdateRequest(MapUpdater* p_Updater, uint32 p_Shard);
         virtual void call() override;
 
     private:
-        AchievementCriteriaTaskQueue m_CriteriaUpdateTasks;
+        uint32 m_Shard;
 
 };
 
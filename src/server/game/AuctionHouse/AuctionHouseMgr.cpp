@@ -408,12 +408,15 @@ void AuctionHouseObject::AddAuction(AuctionEntry* auction)
     ASSERT(auction);
 
     AuctionsMap[auction->Id] = auction;
+    SearchIndex.Add(auction, sAuctionMgr->GetAItem(auction->itemGUIDLow));
+    ExpiryQueue.push(AuctionExpiry(auction->expire_time, auction->Id));
     sScriptMgr->OnAuctionAdd(this, auction);
 }
 
 bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction, uint32 /*itemEntry*/)
 {
     bool wasInMap = AuctionsMap.erase(auction->Id) ? true : false;
+    SearchIndex.Remove(auction->Id);
 
     sScriptMgr->OnAuctionRemove(this, auction);
 
@@ -425,28 +428,24 @@ bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction, uint32 /*itemEntry
 void AuctionHouseObject::Update()
 {
     time_t curTime = sWorld->GetGameTime();
-    ///- Handle expired auctions
+    ///- Handle expired auctions, straight from memory: the queue is built by AddAuction at LoadAuctions and auction creation
 
-    // If storage is empty, no need to update. next == NULL in this case.
-    if (AuctionsMap.empty())
-        return;
-
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_AUCTION_BY_TIME);
-    stmt->setUInt32(0, (uint32)curTime+60);
-    
-    PreparedQueryResult l_Result = CharacterDatabase.Query(stmt);
-    if (!l_Result)
-        return;
+    SQLTransaction trans;
+    uint32 batched = 0;
 
-    do
+    while (!ExpiryQueue.empty() && ExpiryQueue.top().first <= curTime + AUCTION_EXPIRY_LOOKAHEAD)
     {
-        // from auctionhousehandler.cpp, creates auction pointer & player pointer
-        AuctionEntry* auction = GetAuction(l_Result->Fetch()->GetUInt32());
+        AuctionExpiry expiry = ExpiryQueue.top();
+        ExpiryQueue.pop();
 
-        if (!auction)
+        // bought out or cancelled since it was queued
+        AuctionEntry* auction = GetAuction(expiry.second);
+        if (!auction || auction->expire_time != expiry.first)
             continue;
 
-        SQLTransaction trans = CharacterDatabase.BeginTransaction();
+        // mails and deletions of a whole batch go in a single asynchronous transaction
+        if (!trans)
+            trans = CharacterDatabase.BeginTransaction();
 
         ///- Either cancel the auction if there was no bidder
         if (auction->bidder == 0)
@@ -469,12 +468,20 @@ void AuctionHouseObject::Update()
 
         ///- In any case clear the auction
         auction->DeleteFromDB(trans);
-        CharacterDatabase.CommitTransaction(trans);
 
         sAuctionMgr->RemoveAItem(auction->itemGUIDLow);
         RemoveAuction(auction, itemEntry);
+
+        if (++batched >= AUCTION_EXPIRY_BATCH_SIZE)
+        {
+            CharacterDatabase.CommitTransaction(trans);
+            trans.reset();
+            batched = 0;
+        }
     }
-    while (l_Result->NextRow());
+
+    if (trans)
+        CharacterDatabase.CommitTransaction(trans);
 }
 
 void AuctionHouseObject::BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount)
@@ -512,82 +519,30 @@ void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
     uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
     uint32& count, uint32& totalcount)
 {
-    int loc_idx = player->GetSession()->GetSessionDbLocaleIndex();
-    int locdbc_idx = player->GetSession()->GetSessionDbcLocale();
-
-    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+    AuctionSearchQuery query;
+    query.Name          = wsearchedname;
+    query.Locale        = player->GetSession()->GetSessionDbLocaleIndex();
+    query.LevelMin      = levelmin;
+    query.LevelMax      = levelmax;
+    query.InventoryType = inventoryType;
+    query.ItemClass     = itemClass;
+    query.ItemSubClass  = itemSubClass;
+    query.Quality       = quality;
+
+    // only the auctions matching every filter, in auction id order
+    std::vector<AuctionSearchIndex::IndexedAuction const*> matches;
+    SearchIndex.Search(query, matches);
+
+    for (AuctionSearchIndex::IndexedAuction const* indexed : matches)
     {
-        AuctionEntry* Aentry = itr->second;
-        Item* item = sAuctionMgr->GetAItem(Aentry->itemGUIDLow);
-        if (!item)
-            continue;
-
-        ItemTemplate const* proto = item->GetTemplate();
-
-        if (itemClass != 0xffffffff && proto->Class != itemClass)
+        if (usable != 0x00 && player->CanUseItem(indexed->AuctionItem) != EQUIP_ERR_OK)
             continue;
 
-        if (itemSubClass != 0xffffffff && proto->SubClass != itemSubClass)
-            continue;
-
-        if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
-            continue;
-
-        if (quality != 0xffffffff && proto->Quality != quality)
-            continue;
-
-        if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
-            continue;
-
-        if (usable != 0x00 && player->CanUseItem(item) != EQUIP_ERR_OK)
-            continue;
-
-        // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
-        // No need to do any of this if no search term was entered
-        if (!wsearchedname.empty())
-        {
-            std::string name = proto->Name1->Get(loc_idx);
-            if (name.empty())
-                continue;
-
-            // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
-            //  that matches the search but it may not equal item->GetItemRandomPropertyId()
-            //  used in BuildAuctionInfo() which then causes wrong items to be listed
-            int32 propRefID = item->GetItemRandomPropertyId();
-
-            if (propRefID)
-            {
-                // Append the suffix to the name (ie: of the Monkey) if one exists
-                // These are found in ItemRandomProperties.dbc, not ItemRandomSuffix.dbc
-                //  even though the DBC names seem misleading
-                const ItemRandomPropertiesEntry* itemRandProp = sItemRandomPropertiesStore.LookupEntry(propRefID);
-
-                if (itemRandProp)
-                {
-                    char* temp = itemRandProp->nameSuffix;
-                    //char* temp = itemRandProp->nameSuffix;
-
-                    // dbc local name
-                    if (temp)
-                    {
-                        // Append the suffix (ie: of the Monkey) to the name using localization
-                        // or default enUS if localization is invalid
-                        name += ' ';
-                        name += temp[locdbc_idx >= 0 ? locdbc_idx : LOCALE_enUS];
-                    }
-                }
-            }
-
-            // Perform the search (with or without suffix)
-            if (!Utf8FitTo(name, wsearchedname))
-                continue;
-        }
-
         // Add the item if no search term or if entered search term was found
         if (count < 50 && totalcount >= listfrom)
         {
             ++count;
-            Aentry->BuildAuctionInfo(data);
+            indexed->Auction->BuildAuctionInfo(data);
         }
         ++totalcount;
     }
@@ -741,6 +696,8 @@ void AuctionHouseMgr::DeleteExpiredAuctionsAtStartup()
         return;
     }
 
+    SQLTransaction trans = CharacterDatabase.BeginTransaction();
+
     do
     {
         Field* fields = expAuctions->Fetch();
@@ -756,8 +713,6 @@ void AuctionHouseMgr::DeleteExpiredAuctionsAtStartup()
             continue;
         }
 
-        SQLTransaction trans = CharacterDatabase.BeginTransaction();
-
         if (auction->bidder == 0)
         {
             // Cancel the auction, there was no bidder
@@ -776,15 +731,21 @@ void AuctionHouseMgr::DeleteExpiredAuctionsAtStartup()
 
         // Delete the auction from the DB
         auction->DeleteFromDB(trans);
-        CharacterDatabase.CommitTransaction(trans);
 
         // Release memory
         delete auction;
         ++expirecount;
 
+        if (expirecount % AUCTION_EXPIRY_BATCH_SIZE == 0)
+        {
+            CharacterDatabase.CommitTransaction(trans);
+            trans = CharacterDatabase.BeginTransaction();
+        }
     }
     while (expAuctions->NextRow());
 
+    CharacterDatabase.CommitTransaction(trans);
+
     sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Deleted %u expired auctions in %u ms", expirecount, GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -14,6 +14,7 @@
 #include "DatabaseEnv.h"
 #include "DBCStructure.h"
 #include "DB2Structure.h"
+#include "AuctionSearchIndex.h"
 
 class Item;
 class Player;
@@ -21,6 +22,8 @@ class WorldPacket;
 
 #define MIN_AUCTION_TIME (12*HOUR)
 #define MAX_AUCTION_ITEMS 160
+#define AUCTION_EXPIRY_LOOKAHEAD 60                         // auctions expiring before the next AuctionHouseMgr::Update are handled now
+#define AUCTION_EXPIRY_BATCH_SIZE 100                       // expired auctions handled in a single transaction
 
 enum AuctionError
 {
@@ -89,7 +92,7 @@ class AuctionHouseObject
 {
   public:
     // Initialize storage
-    AuctionHouseObject() { next = AuctionsMap.begin(); }
+    AuctionHouseObject() { }
     ~AuctionHouseObject()
     {
         for (AuctionEntryMap::iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
@@ -123,10 +126,17 @@ class AuctionHouseObject
         uint32& count, uint32& totalcount);
 
   private:
+    // expire time / auction id, earliest first
+    typedef std::pair<time_t, uint32> AuctionExpiry;
+    typedef std::priority_queue<AuctionExpiry, std::vector<AuctionExpiry>, std::greater<AuctionExpiry> > AuctionExpiryQueue;
+
     AuctionEntryMap AuctionsMap;
 
-    // storage for "next" auction item for next Update()
-    AuctionEntryMap::const_iterator next;
+    // secondary indexes used by BuildListAuctionItems
+    AuctionSearchIndex SearchIndex;
+
+    // every auction added, removed ones are skipped when popped
+    AuctionExpiryQueue ExpiryQueue;
 };
 
 class AuctionHouseMgr
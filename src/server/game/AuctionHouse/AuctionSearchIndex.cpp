@@ -0,0 +1,273 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CROSS
+#include "AuctionSearchIndex.h"
+#include "AuctionHouseMgr.h"
+#include "DB2Stores.h"
+#include "Item.h"
+#include "Util.h"
+
+AuctionSearchIndex::AuctionSearchIndex()
+{
+    for (uint8 l_I = 0; l_I < TOTAL_LOCALES; ++l_I)
+        m_Names[l_I].Built = false;
+}
+
+void AuctionSearchIndex::Insert(PostingList& p_List, uint32 p_AuctionId)
+{
+    /// Auction ids are generated increasingly, nearly every insert is an append
+    if (p_List.empty() || p_List.back() < p_AuctionId)
+    {
+        p_List.push_back(p_AuctionId);
+        return;
+    }
+
+    PostingList::iterator l_Itr = std::lower_bound(p_List.begin(), p_List.end(), p_AuctionId);
+    if (l_Itr == p_List.end() || *l_Itr != p_AuctionId)
+        p_List.insert(l_Itr, p_AuctionId);
+}
+
+uint64 AuctionSearchIndex::MakeTrigram(std::wstring const& p_Name, size_t p_Offset)
+{
+    return (uint64(p_Name[p_Offset] & 0x1FFFFF) << 42) | (uint64(p_Name[p_Offset + 1] & 0x1FFFFF) << 21) | uint64(p_Name[p_Offset + 2] & 0x1FFFFF);
+}
+
+void AuctionSearchIndex::Add(AuctionEntry* p_Auction, Item* p_Item)
+{
+    if (!p_Auction || !p_Item || !p_Item->GetTemplate())
+        return;
+
+    Remove(p_Auction->Id);
+
+    IndexedAuction& l_Indexed = m_Auctions[p_Auction->Id];
+    l_Indexed.Auction     = p_Auction;
+    l_Indexed.AuctionItem = p_Item;
+    l_Indexed.Template    = p_Item->GetTemplate();
+
+    ItemTemplate const* l_Template = l_Indexed.Template;
+    Insert(m_ByClass[l_Template->Class], p_Auction->Id);
+    Insert(m_BySubClass[(l_Template->Class << 16) | l_Template->SubClass], p_Auction->Id);
+    Insert(m_ByInventoryType[l_Template->InventoryType], p_Auction->Id);
+    Insert(m_ByQuality[l_Template->Quality], p_Auction->Id);
+    Insert(m_ByLevel[l_Template->RequiredLevel], p_Auction->Id);
+
+    for (uint8 l_Locale = 0; l_Locale < TOTAL_LOCALES; ++l_Locale)
+    {
+        if (m_Names[l_Locale].Built)
+            IndexName(m_Names[l_Locale], LocaleConstant(l_Locale), l_Indexed);
+    }
+}
+
+void AuctionSearchIndex::Remove(uint32 p_AuctionId)
+{
+    std::map<uint32, IndexedAuction>::iterator l_Itr = m_Auctions.find(p_AuctionId);
+    if (l_Itr == m_Auctions.end())
+        return;
+
+    /// The item may already be deleted, only the template is read
+    ItemTemplate const* l_Template = l_Itr->second.Template;
+    Erase(m_ByClass, l_Template->Class, p_AuctionId);
+    Erase(m_BySubClass, (l_Template->Class << 16) | l_Template->SubClass, p_AuctionId);
+    Erase(m_ByInventoryType, l_Template->InventoryType, p_AuctionId);
+    Erase(m_ByQuality, l_Template->Quality, p_AuctionId);
+    Erase(m_ByLevel, l_Template->RequiredLevel, p_AuctionId);
+
+    for (uint8 l_Locale = 0; l_Locale < TOTAL_LOCALES; ++l_Locale)
+    {
+        if (m_Names[l_Locale].Built)
+            UnindexName(m_Names[l_Locale], p_AuctionId);
+    }
+
+    m_Auctions.erase(l_Itr);
+}
+
+void AuctionSearchIndex::IndexName(NameIndex& p_Index, LocaleConstant p_Locale, IndexedAuction const& p_Auction)
+{
+    std::string l_Name = p_Auction.Template->Name1->Get(p_Locale);
+    if (l_Name.empty())
+        return;
+
+    /// Allow search by suffix (ie: of the Monkey), DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may
+    /// not equal item->GetItemRandomPropertyId() used in BuildAuctionInfo() which would list wrong items
+    if (int32 l_PropertyId = p_Auction.AuctionItem->GetItemRandomPropertyId())
+    {
+        ItemRandomPropertiesEntry const* l_Property = sItemRandomPropertiesStore.LookupEntry(l_PropertyId);
+        if (l_Property && l_Property->nameSuffix && *l_Property->nameSuffix)
+        {
+            l_Name += ' ';
+            l_Name += l_Property->nameSuffix;
+        }
+    }
+
+    std::wstring l_WName;
+    if (!Utf8toWStr(l_Name, l_WName))
+        return;
+
+    wstrToLower(l_WName);
+
+    uint32 l_AuctionId = p_Auction.Auction->Id;
+    for (size_t l_I = 0; l_I + 3 <= l_WName.size(); ++l_I)
+        Insert(p_Index.Trigrams[MakeTrigram(l_WName, l_I)], l_AuctionId);
+
+    p_Index.Names[l_AuctionId].swap(l_WName);
+}
+
+void AuctionSearchIndex::UnindexName(NameIndex& p_Index, uint32 p_AuctionId)
+{
+    std::unordered_map<uint32, std::wstring>::iterator l_Itr = p_Index.Names.find(p_AuctionId);
+    if (l_Itr == p_Index.Names.end())
+        return;
+
+    std::wstring const& l_Name = l_Itr->second;
+    for (size_t l_I = 0; l_I + 3 <= l_Name.size(); ++l_I)
+        Erase(p_Index.Trigrams, MakeTrigram(l_Name, l_I), p_AuctionId);
+
+    p_Index.Names.erase(l_Itr);
+}
+
+AuctionSearchIndex::NameIndex& AuctionSearchIndex::GetNameIndex(LocaleConstant p_Locale)
+{
+    if (p_Locale >= TOTAL_LOCALES)
+        p_Locale = LOCALE_enUS;
+
+    NameIndex& l_Index = m_Names[p_Locale];
+    if (!l_Index.Built)
+    {
+        for (std::map<uint32, IndexedAuction>::const_iterator l_Itr = m_Auctions.begin(); l_Itr != m_Auctions.end(); ++l_Itr)
+            IndexName(l_Index, p_Locale, l_Itr->second);
+
+        l_Index.Built = true;
+    }
+
+    return l_Index;
+}
+
+bool AuctionSearchIndex::Matches(IndexedAuction const& p_Auction, AuctionSearchQuery const& p_Query, NameIndex const* p_Names) const
+{
+    ItemTemplate const* l_Template = p_Auction.Template;
+
+    if (p_Query.ItemClass != AUCTION_SEARCH_ANY && l_Template->Class != p_Query.ItemClass)
+        return false;
+
+    if (p_Query.ItemSubClass != AUCTION_SEARCH_ANY && l_Template->SubClass != p_Query.ItemSubClass)
+        return false;
+
+    if (p_Query.InventoryType != AUCTION_SEARCH_ANY && l_Template->InventoryType != p_Query.InventoryType)
+        return false;
+
+    if (p_Query.Quality != AUCTION_SEARCH_ANY && l_Template->Quality != p_Query.Quality)
+        return false;
+
+    if (p_Query.LevelMin && (l_Template->RequiredLevel < p_Query.LevelMin || (p_Query.LevelMax && l_Template->RequiredLevel > p_Query.LevelMax)))
+        return false;
+
+    if (p_Names)
+    {
+        std::unordered_map<uint32, std::wstring>::const_iterator l_Name = p_Names->Names.find(p_Auction.Auction->Id);
+        if (l_Name == p_Names->Names.end() || l_Name->second.find(p_Query.Name) == std::wstring::npos)
+            return false;
+    }
+
+    return true;
+}
+
+void AuctionSearchIndex::Search(AuctionSearchQuery const& p_Query, std::vector<IndexedAuction const*>& p_Results)
+{
+    static PostingList const s_Empty;
+
+    p_Results.clear();
+
+    NameIndex const* l_Names = p_Query.Name.empty() ? nullptr : &GetNameIndex(p_Query.Locale);
+
+    /// Walk the most selective posting list, every other filter is checked on the template
+    PostingList const* l_Driver = nullptr;
+    auto l_Consider = [&l_Driver](PostingList const* p_List) -> void
+    {
+        if (!l_Driver || p_List->size() < l_Driver->size())
+            l_Driver = p_List;
+    };
+
+    auto l_Lookup = [](PostingMap const& p_Map, uint32 p_Key) -> PostingList const*
+    {
+        PostingMap::const_iterator l_Itr = p_Map.find(p_Key);
+        return l_Itr != p_Map.end() ? &l_Itr->second : &s_Empty;
+    };
+
+    if (p_Query.ItemClass != AUCTION_SEARCH_ANY)
+    {
+        if (p_Query.ItemSubClass != AUCTION_SEARCH_ANY)
+            l_Consider(l_Lookup(m_BySubClass, (p_Query.ItemClass << 16) | p_Query.ItemSubClass));
+        else
+            l_Consider(l_Lookup(m_ByClass, p_Query.ItemClass));
+    }
+
+    if (p_Query.InventoryType != AUCTION_SEARCH_ANY)
+        l_Consider(l_Lookup(m_ByInventoryType, p_Query.InventoryType));
+
+    if (p_Query.Quality != AUCTION_SEARCH_ANY)
+        l_Consider(l_Lookup(m_ByQuality, p_Query.Quality));
+
+    /// Shorter names can't use the trigrams, they are only checked against the cached names
+    if (l_Names)
+    {
+        for (size_t l_I = 0; l_I + 3 <= p_Query.Name.size(); ++l_I)
+        {
+            std::unordered_map<uint64, PostingList>::const_iterator l_Itr = l_Names->Trigrams.find(MakeTrigram(p_Query.Name, l_I));
+            l_Consider(l_Itr != l_Names->Trigrams.end() ? &l_Itr->second : &s_Empty);
+        }
+    }
+
+    if (l_Driver && l_Driver->empty())
+        return;
+
+    /// A level range spans several posting lists, merge them only if the result is the smallest candidate set
+    PostingList l_LevelList;
+    if (p_Query.LevelMin)
+    {
+        std::map<uint32, PostingList>::const_iterator l_Begin = m_ByLevel.lower_bound(p_Query.LevelMin);
+        std::map<uint32, PostingList>::const_iterator l_End   = p_Query.LevelMax ? m_ByLevel.upper_bound(p_Query.LevelMax) : m_ByLevel.end();
+
+        size_t l_Count = 0;
+        for (std::map<uint32, PostingList>::const_iterator l_Itr = l_Begin; l_Itr != l_End; ++l_Itr)
+            l_Count += l_Itr->second.size();
+
+        if (!l_Count)
+            return;
+
+        if (!l_Driver || l_Count < l_Driver->size())
+        {
+            l_LevelList.reserve(l_Count);
+            for (std::map<uint32, PostingList>::const_iterator l_Itr = l_Begin; l_Itr != l_End; ++l_Itr)
+                l_LevelList.insert(l_LevelList.end(), l_Itr->second.begin(), l_Itr->second.end());
+
+            std::sort(l_LevelList.begin(), l_LevelList.end());
+            l_Driver = &l_LevelList;
+        }
+    }
+
+    if (!l_Driver)
+    {
+        p_Results.reserve(m_Auctions.size());
+        for (std::map<uint32, IndexedAuction>::const_iterator l_Itr = m_Auctions.begin(); l_Itr != m_Auctions.end(); ++l_Itr)
+        {
+            if (Matches(l_Itr->second, p_Query, l_Names))
+                p_Results.push_back(&l_Itr->second);
+        }
+
+        return;
+    }
+
+    for (uint32 l_AuctionId : *l_Driver)
+    {
+        std::map<uint32, IndexedAuction>::const_iterator l_Itr = m_Auctions.find(l_AuctionId);
+        if (l_Itr != m_Auctions.end() && Matches(l_Itr->second, p_Query, l_Names))
+            p_Results.push_back(&l_Itr->second);
+    }
+}
+#endif
@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CROSS
+#ifndef _AUCTION_SEARCH_INDEX_H
+#define _AUCTION_SEARCH_INDEX_H
+
+#include "Common.h"
+
+class Item;
+struct AuctionEntry;
+struct ItemTemplate;
+
+#define AUCTION_SEARCH_ANY 0xFFFFFFFF
+
+/// Browse filters of CMSG_AUCTION_LIST_ITEMS
+struct AuctionSearchQuery
+{
+    AuctionSearchQuery()
+        : Locale(LOCALE_enUS), LevelMin(0), LevelMax(0), InventoryType(AUCTION_SEARCH_ANY),
+        ItemClass(AUCTION_SEARCH_ANY), ItemSubClass(AUCTION_SEARCH_ANY), Quality(AUCTION_SEARCH_ANY) { }
+
+    std::wstring   Name;                ///< Lower case, empty for any
+    LocaleConstant Locale;              ///< Locale of the searched name
+    uint8          LevelMin;            ///< 0 for any
+    uint8          LevelMax;            ///< 0 for no upper bound
+    uint32         InventoryType;
+    uint32         ItemClass;
+    uint32         ItemSubClass;
+    uint32         Quality;
+};
+
+/// In-memory secondary indexes over the auctions of one auction house.
+/// Every posting list is a sorted vector of auction ids, a browse request walks the smallest list
+/// matching its filters and checks the others on the cached item template, results always come in
+/// auction id order so "listfrom" pagination stays stable between two pages.
+/// Names are indexed by trigram, per locale, the first time someone searches in that locale.
+class AuctionSearchIndex
+{
+    public:
+        struct IndexedAuction
+        {
+            AuctionEntry*       Auction;
+            Item*               AuctionItem;
+            ItemTemplate const* Template;
+        };
+
+        AuctionSearchIndex();
+
+        /// @p_Auction : Auction to index
+        /// @p_Item    : Item sold, must stay valid until Remove
+        void Add(AuctionEntry* p_Auction, Item* p_Item);
+        void Remove(uint32 p_AuctionId);
+
+        /// Auctions matching every filter of the query, in auction id order
+        /// @p_Query   : Filters
+        /// @p_Results : Output
+        void Search(AuctionSearchQuery const& p_Query, std::vector<IndexedAuction const*>& p_Results);
+
+        uint32 GetSize() const { return m_Auctions.size(); }
+
+    private:
+        typedef std::vector<uint32> PostingList;
+        typedef std::unordered_map<uint32, PostingList> PostingMap;
+
+        struct NameIndex
+        {
+            bool                                    Built;
+            std::unordered_map<uint32, std::wstring> Names;        ///< Auction id -> lower case name
+            std::unordered_map<uint64, PostingList>  Trigrams;
+        };
+
+        static void Insert(PostingList& p_List, uint32 p_AuctionId);
+
+        /// Removes an auction from the posting list of p_Key, and the list itself once empty
+        template<class MapType> static void Erase(MapType& p_Map, typename MapType::key_type p_Key, uint32 p_AuctionId)
+        {
+            typename MapType::iterator l_Itr = p_Map.find(p_Key);
+            if (l_Itr == p_Map.end())
+                return;
+
+            PostingList& l_List = l_Itr->second;
+            PostingList::iterator l_Pos = std::lower_bound(l_List.begin(), l_List.end(), p_AuctionId);
+            if (l_Pos != l_List.end() && *l_Pos == p_AuctionId)
+                l_List.erase(l_Pos);
+
+            if (l_List.empty())
+                p_Map.erase(l_Itr);
+        }
+
+        static uint64 MakeTrigram(std::wstring const& p_Name, size_t p_Offset);
+
+        void IndexName(NameIndex& p_Index, LocaleConstant p_Locale, IndexedAuction const& p_Auction);
+        void UnindexName(NameIndex& p_Index, uint32 p_AuctionId);
+        NameIndex& GetNameIndex(LocaleConstant p_Locale);
+
+        bool Matches(IndexedAuction const& p_Auction, AuctionSearchQuery const& p_Query, NameIndex const* p_Names) const;
+
+        std::map<uint32, IndexedAuction> m_Auctions;                ///< Also the posting list of a query without filter
+        PostingMap                       m_ByClass;
+        PostingMap                       m_BySubClass;              ///< (Class << 16) | SubClass
+        PostingMap                       m_ByInventoryType;
+        PostingMap                       m_ByQuality;
+        std::map<uint32, PostingList>    m_ByLevel;                 ///< Required level, ordered for level ranges
+        NameIndex                        m_Names[TOTAL_LOCALES];
+};
+
+#endif
+#endif
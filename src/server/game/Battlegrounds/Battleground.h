@@ -512,6 +512,7 @@ struct GroupQueueInfo                                       // stores informatio
     uint32  m_OpponentsMatchmakerRating;                      // for rated arena matches
     Group* m_Group;
     uint64 m_WantedBGs;
+    uint64 m_EligibleBGs;                                     // wanted battlegrounds the members have the level for, set when queued
     uint32 m_BracketId;
 
     uint32 GetTeam() const
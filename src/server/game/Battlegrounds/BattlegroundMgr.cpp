@@ -209,7 +209,7 @@ namespace MS
             m_InvitationsMgr.UpdateEvents(p_Diff);
 
             /// Update Scheduler.
-            m_Scheduler.FindMatches();
+            m_Scheduler.FindMatches(p_Diff);
 #ifdef CROSS
 
             m_DumpTimer += p_Diff;
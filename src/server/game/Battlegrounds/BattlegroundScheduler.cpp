@@ -27,25 +27,13 @@ namespace MS
             /// @p_Group : The group.
             /// @p_Type : The type of the battleground.
             /// @p_BracketId : The bracket id of the battleground.
-            static bool IsEligibleForBattleground(GroupQueueInfo const* p_Group, BattlegroundType::Type p_Type, Bracket::Id p_BracketId, Battleground const* p_Template)
+            static bool IsEligibleForBattleground(GroupQueueInfo const* p_Group, BattlegroundType::Type p_Type, Bracket::Id p_BracketId)
             {
-                uint64 l_BattlegroundMask = 1LL << p_Type;
-
                 if (p_Group->m_BracketId != p_BracketId)
                     return false;
 
-                /// We check if all the players have the good level for entering the battleground.
-                for (auto l_Plrs : p_Group->m_Players)
-                {
-                    Player* l_Player = ObjectAccessor::FindPlayerInOrOutOfWorld(l_Plrs.first);
-                    if (!l_Player)
-                        continue;
-
-                    if (l_Player->getLevel() < p_Template->GetMinLevel())
-                        return false;
-                }
-
-                return (p_Group->m_WantedBGs & l_BattlegroundMask) != 0;
+                /// The levels of the players are checked when the group is queued, see ComputeEligibleBGs.
+                return (p_Group->m_EligibleBGs & (1LL << p_Type)) != 0;
             }
 
             static bool AreMatching(GroupQueueInfo const* p_A, GroupQueueInfo const* p_B)
@@ -101,7 +89,12 @@ namespace MS
 
         BattlegroundScheduler::BattlegroundScheduler()
             : m_QueuedGroups(),
-            m_BattlegroundOccurences()
+            m_BattlegroundOccurences(),
+            m_MatchTimer(0),
+            m_PlanShareCount(0),
+            m_PlanPending(0),
+            m_PlanPass(0),
+            m_PlanStop(false)
         {
             /// Initialize BattlegroundOccurences.
             for (std::size_t l_BracketId = 0; l_BracketId < Brackets::Count; l_BracketId++)
@@ -112,6 +105,51 @@ namespace MS
             }
         }
 
+        BattlegroundScheduler::~BattlegroundScheduler()
+        {
+            {
+                std::lock_guard<std::mutex> l_Guard(m_PlanLock);
+                m_PlanStop = true;
+            }
+
+            m_PlanStart.notify_all();
+            for (std::thread& l_Worker : m_PlanWorkers)
+                l_Worker.join();
+
+            for (std::size_t l_BracketId = 0; l_BracketId < Brackets::Count; l_BracketId++)
+            {
+                for (std::size_t l_Team = TEAM_ALLIANCE; l_Team <= TEAM_HORDE; l_Team++)
+                {
+                    for (GroupQueueInfo* l_Group : m_QueuedGroups[l_BracketId][l_Team])
+                        delete l_Group;
+                }
+            }
+        }
+
+        uint64 BattlegroundScheduler::ComputeEligibleBGs(GroupQueueInfo const* p_Group, uint32 p_MinLevel)
+        {
+            uint64 l_EligibleBGs = 0;
+
+            for (std::size_t i = 0; i < BattlegroundType::Max; i++)
+            {
+                if (!(p_Group->m_WantedBGs & (1LL << i)))
+                    continue;
+
+                /// We get the battleground template.
+                Battleground* l_Template = sBattlegroundMgr->GetBattlegroundTemplate(static_cast<BattlegroundType::Type>(i));
+                if (!l_Template)
+                    continue;
+
+                /// We check if all the players have the good level for entering the battleground.
+                if (p_MinLevel < l_Template->GetMinLevel())
+                    continue;
+
+                l_EligibleBGs |= 1LL << i;
+            }
+
+            return l_EligibleBGs;
+        }
+
         void BattlegroundScheduler::AddToBG(GroupQueueInfo* p_Group, Battleground* p_BG, uint32 p_Team)
         {
             /// Now that the group leave the queue, we can restrict to instanciable battlegrounds.
@@ -187,6 +225,7 @@ namespace MS
             l_GroupQueue->m_Players.clear();
 
             uint32 l_LastOnlineTime = getMSTime();
+            uint32 l_MinLevel = p_Leader->getLevel();
 
             /// Add players from group to GroupQueueInfo.
             if (p_Group)
@@ -197,6 +236,8 @@ namespace MS
                     if (!l_Member)
                         continue;
 
+                    l_MinLevel = std::min(l_MinLevel, uint32(l_Member->getLevel()));
+
                     /// Create the PlayerQueueInfo.
                     PlayerQueueInfo& l_PlayerQueue = m_QueuedPlayers[l_Member->GetGUID()];
                     l_PlayerQueue.Infos.emplace_back(PlayerQueueInfo::Pair{ l_LastOnlineTime, l_GroupQueue });
@@ -212,7 +253,9 @@ namespace MS
                 l_GroupQueue->m_Players[p_Leader->GetGUID()] = &l_PlayerQueue;
             }
 
-            /// Add the GroupQueueInfo in the groups to match.
+            l_GroupQueue->m_EligibleBGs = ComputeEligibleBGs(l_GroupQueue, l_MinLevel);
+
+            /// Add the GroupQueueInfo in the groups to match, the join time is the newest one so the queue stays ordered.
             m_QueuedGroups[l_BracketId][l_GroupQueue->GetTeam()].emplace_back(l_GroupQueue);
 
             return l_GroupQueue;
@@ -335,7 +378,8 @@ namespace MS
 
         void BattlegroundScheduler::RemoveGroupFromQueues(GroupQueueInfo* p_Group)
         {
-            m_QueuedGroups[p_Group->m_BracketId][p_Group->GetTeam()].remove(p_Group);
+            QueuedGroups& l_Queue = m_QueuedGroups[p_Group->m_BracketId][p_Group->GetTeam()];
+            l_Queue.erase(std::remove(std::begin(l_Queue), std::end(l_Queue), p_Group), std::end(l_Queue));
 
             for (auto const& l_Itr : p_Group->m_Players)
                 m_QueuedPlayers.erase(l_Itr.first);
@@ -343,7 +387,7 @@ namespace MS
 
         void BattlegroundScheduler::AllocateGroupsInExistingBattlegrounds(Bracket::Id p_BracketId, std::size_t p_Team, std::vector<std::pair<float, std::size_t>>& p_Avg)
         {
-            std::list<GroupQueueInfo*> l_ToRemove;
+            std::vector<GroupQueueInfo*> l_ToRemove;
 
             if (m_QueuedGroups[p_BracketId][p_Team].empty())
                 return;
@@ -362,21 +406,18 @@ namespace MS
                 {
                     BattlegroundType::Type l_BgType = static_cast<BattlegroundType::Type>(p_Avg[l_Fallback].second);
 
-                    /// We get the battleground template.
-                    Battleground* l_Template = sBattlegroundMgr->GetBattlegroundTemplate(l_BgType);
-                    if (!l_Template)
+                    /// We check if the group is eligible for the battleground, eligible types always have a template.
+                    if (!IsEligibleForBattleground(l_Group, l_BgType, p_BracketId))
                         continue;
 
-                    /// We check if the group is eligible for the battleground.
-                    if (!IsEligibleForBattleground(l_Group, l_BgType, p_BracketId, l_Template))
-                        continue;
+                    Battleground* l_Template = sBattlegroundMgr->GetBattlegroundTemplate(l_BgType);
 
                     auto& l_Battlegrounds = sBattlegroundMgr->GetBattlegroundList(p_BracketId, l_BgType);
                     /// We sort according to the lowest ratio of players for the specific team.
-                    l_Battlegrounds.sort([p_Team, l_BgType, l_Template](std::pair<uint32, Battleground*> const& p_A, std::pair<uint32, Battleground*> const& p_B)
+                    l_Battlegrounds.sort([p_Team](std::pair<uint32, Battleground*> const& p_A, std::pair<uint32, Battleground*> const& p_B)
                     {
-                        return p_A.second->GetPlayersCountByTeam(p_Team == TEAM_ALLIANCE ? ALLIANCE : HORDE) / l_Template->GetMaxPlayers()
-                            - p_B.second->GetPlayersCountByTeam(p_Team == TEAM_ALLIANCE ? ALLIANCE : HORDE) / l_Template->GetMaxPlayers();
+                        return p_A.second->GetPlayersCountByTeam(p_Team == TEAM_ALLIANCE ? ALLIANCE : HORDE)
+                            < p_B.second->GetPlayersCountByTeam(p_Team == TEAM_ALLIANCE ? ALLIANCE : HORDE);
                     });
 
                     for (std::pair<uint32, Battleground*> const& l_Pair : l_Battlegrounds)
@@ -405,11 +446,23 @@ namespace MS
             }
 
             // We remove from the waiting groups the groups that entered a battleground.
+            if (l_ToRemove.empty())
+                return;
+
+            QueuedGroups& l_Queue = m_QueuedGroups[p_BracketId][p_Team];
+            l_Queue.erase(std::remove_if(std::begin(l_Queue), std::end(l_Queue), [&l_ToRemove](GroupQueueInfo* p_Group) -> bool
+            {
+                return std::find(std::begin(l_ToRemove), std::end(l_ToRemove), p_Group) != std::end(l_ToRemove);
+            }), std::end(l_Queue));
+
             for (GroupQueueInfo* l_Group : l_ToRemove)
-                RemoveGroupFromQueues(l_Group);
+            {
+                for (auto const& l_Itr : l_Group->m_Players)
+                    m_QueuedPlayers.erase(l_Itr.first);
+            }
         }
 
-        void BattlegroundScheduler::FindPotentialBGs(Bracket::Id p_BracketId, std::vector<float>& p_PotientialBGs, std::vector<std::list<GroupQueueInfo*>>& p_PotentialGroups)
+        void BattlegroundScheduler::FindPotentialBGs(Bracket::Id p_BracketId, std::vector<float>& p_PotientialBGs, std::vector<std::vector<GroupQueueInfo*>>& p_PotentialGroups) const
         {
             /// We clean our variables.
             for (std::size_t i = 0; i < BattlegroundType::Max * 2; i++)
@@ -431,14 +484,11 @@ namespace MS
                     {
                         BattlegroundType::Type l_BgType = static_cast<BattlegroundType::Type>(i / 2);
 
-                        /// We get the battleground template.
-                        Battleground* l_Template = sBattlegroundMgr->GetBattlegroundTemplate(l_BgType);
-                        if (!l_Template)
+                        /// We check if the group is eligible for the arena, eligible types always have a template.
+                        if (!IsEligibleForBattleground(l_Group, l_BgType, p_BracketId))
                             continue;
 
-                        /// We check if the group is eligible for the arena.
-                        if (!IsEligibleForBattleground(l_Group, l_BgType, p_BracketId, l_Template))
-                            continue;
+                        Battleground* l_Template = sBattlegroundMgr->GetBattlegroundTemplate(l_BgType);
 
                         /// In the case of the casual battleground, we check if the group can fit in the battleground according to the max players and the group size.
                         if (BattlegroundType::IsCasualBattleground(l_BgType))
@@ -637,14 +687,23 @@ namespace MS
         }
 
 #endif /* CROSS */
-        void BattlegroundScheduler::FindMatches()
+        void BattlegroundScheduler::FindMatches(uint32 p_Diff)
         {
             //////////////////////////////////////////////////////////////////////////////////
             // Policy: trying to have a ratio of battlegrounds instances equals for each type.
             //////////////////////////////////////////////////////////////////////////////////
 
+            m_MatchTimer += p_Diff;
+            if (m_MatchTimer < sWorld->getIntConfig(CONFIG_BATTLEGROUND_SCHEDULER_INTERVAL))
+                return;
+
+            m_MatchTimer = 0;
+
             for (std::size_t l_BracketId = 0; l_BracketId < Brackets::Count; l_BracketId++)
             {
+                if (m_QueuedGroups[l_BracketId][TEAM_ALLIANCE].empty() && m_QueuedGroups[l_BracketId][TEAM_HORDE].empty())
+                    continue;
+
                 /// We first calculate the average number of players by BGType in order to fill entirely the battlegrounds.
                 std::vector<std::pair<float, std::size_t>> l_AvgHorde;
                 std::vector<std::pair<float, std::size_t>> l_AvgAlliance;
@@ -693,120 +752,228 @@ namespace MS
                     }
                 }
 
-                /// Sort averages and keep track of indexes.
-                std::sort(std::begin(l_AvgAlliance), std::end(l_AvgAlliance), [](std::pair<float, std::size_t> const& p_A, std::pair<float, std::size_t> const& p_B)
-                {
-                    return p_A.first < p_B.first;
-                });
-
-                std::sort(std::begin(l_AvgHorde), std::end(l_AvgHorde), [](std::pair<float, std::size_t> const& p_A, std::pair<float, std::size_t> const& p_B)
-                {
-                    return p_A.first < p_B.first;
-                });
-
                 /// We insert groups in existing battlegrounds.
                 AllocateGroupsInExistingBattlegrounds(static_cast<Bracket::Id>(l_BracketId), TEAM_ALLIANCE, l_AvgAlliance);
                 AllocateGroupsInExistingBattlegrounds(static_cast<Bracket::Id>(l_BracketId), TEAM_HORDE, l_AvgHorde);
+            }
 
-                /// Take a decision on what battleground can start from now.
-                std::vector<float> l_NumPlayersByBGTypes(BattlegroundType::Max * 2);
-                std::vector<std::list<GroupQueueInfo*>> l_PotentialGroups(BattlegroundType::Max * 2);
+            /// Take a decision on what battleground can start from now, the brackets don't share anything so they are planned in parallel.
+            std::vector<BracketPlan> l_Plans;
+            PlanBrackets(l_Plans, sWorld->getIntConfig(CONFIG_BATTLEGROUND_SCHEDULER_THREADS));
 
-                /// We sort according to the join time because we want older groups to join the most rapidly.
-                m_QueuedGroups[l_BracketId][TEAM_ALLIANCE].sort([](GroupQueueInfo const* p_G1, GroupQueueInfo const* p_G2)
-                {
-                    return p_G1->m_JoinTime < p_G2->m_JoinTime;
-                });
-                m_QueuedGroups[l_BracketId][TEAM_HORDE].sort([](GroupQueueInfo const* p_G1, GroupQueueInfo const* p_G2)
-                {
-                    return p_G1->m_JoinTime < p_G2->m_JoinTime;
-                });
+            /// Then everything is created and invited at once, from the world thread.
+            for (std::size_t l_BracketId = 0; l_BracketId < Brackets::Count; l_BracketId++)
+            {
+                if (l_Plans[l_BracketId].m_DecidedBg != BattlegroundType::None)
+                    ApplyPlan(l_Plans[l_BracketId], l_BracketId);
+            }
+        }
 
-                std::ostringstream l_BattlegroundDump;
+        void BattlegroundScheduler::PlanBrackets(std::vector<BracketPlan>& p_Plans, uint32 p_Threads) const
+        {
+            p_Plans.assign(Brackets::Count, BracketPlan());
 
-                /// Find the potential battlegrounds.
-                FindPotentialBGs(static_cast<Bracket::Id>(l_BracketId), l_NumPlayersByBGTypes, l_PotentialGroups);
+            std::vector<std::size_t> l_Brackets;
+            for (std::size_t l_BracketId = 0; l_BracketId < Brackets::Count; l_BracketId++)
+            {
+                if (!m_QueuedGroups[l_BracketId][TEAM_ALLIANCE].empty() || !m_QueuedGroups[l_BracketId][TEAM_HORDE].empty())
+                    l_Brackets.push_back(l_BracketId);
+            }
 
-                /// We clone our array of occurrences.
-                std::array<std::pair<float, std::size_t>, BattlegroundType::Max> l_Occurences;
-                for (std::size_t i = 0; i < BattlegroundType::Max; i++)
-                    l_Occurences[i] = m_BattlegroundOccurences[l_BracketId][i];
+            std::size_t l_TaskCount = std::min<std::size_t>(p_Threads, l_Brackets.size());
 
-                /// We sort our battleground occurrences.
-                std::sort(std::begin(l_Occurences), std::end(l_Occurences), [](std::pair<float, std::size_t> const& p_A, std::pair<float, std::size_t> const& p_B)
-                {
-                    return p_A.first < p_B.first;
-                });
+            /// Each task plans every l_TaskCount-th bracket, the calling thread takes the first share.
+            auto l_PlanShare = [this, &l_Brackets, &p_Plans](std::size_t p_First, std::size_t p_Step) -> void
+            {
+                for (std::size_t i = p_First; i < l_Brackets.size(); i += p_Step)
+                    PlanBracket(static_cast<Bracket::Id>(l_Brackets[i]), p_Plans[l_Brackets[i]]);
+            };
 
-                /// We iterate over the sorted occurrences to take a decision if possible.
-                for (std::size_t i = 0; i < BattlegroundType::Max; i++)
+            if (l_TaskCount <= 1)
+            {
+                l_PlanShare(0, 1);
+                return;
+            }
+
+            /// Workers are only started once, a pass only posts the shares and waits for them.
+            while (m_PlanWorkers.size() < l_TaskCount - 1)
+                m_PlanWorkers.emplace_back(&BattlegroundScheduler::PlanWorker, this, m_PlanWorkers.size() + 1, m_PlanPass);
+
+            {
+                std::lock_guard<std::mutex> l_Guard(m_PlanLock);
+                m_PlanShare = [&l_PlanShare, l_TaskCount](std::size_t p_Share) { l_PlanShare(p_Share, l_TaskCount); };
+                m_PlanShareCount = l_TaskCount;
+                m_PlanPending = l_TaskCount - 1;
+                ++m_PlanPass;
+            }
+
+            m_PlanStart.notify_all();
+
+            l_PlanShare(0, l_TaskCount);
+
+            std::unique_lock<std::mutex> l_Lock(m_PlanLock);
+            m_PlanDone.wait(l_Lock, [this]() { return !m_PlanPending; });
+            m_PlanShare = nullptr;
+        }
+
+        void BattlegroundScheduler::PlanWorker(std::size_t p_Share, uint32 p_LastPass) const
+        {
+            uint32 l_LastPass = p_LastPass;
+
+            std::unique_lock<std::mutex> l_Lock(m_PlanLock);
+            for (;;)
+            {
+                m_PlanStart.wait(l_Lock, [this, &l_LastPass]() { return m_PlanStop || m_PlanPass != l_LastPass; });
+                if (m_PlanStop)
+                    return;
+
+                l_LastPass = m_PlanPass;
+
+                /// Fewer brackets to plan than workers, this one sits the pass out.
+                if (p_Share >= m_PlanShareCount)
+                    continue;
+
+                std::function<void(std::size_t)> l_Share = m_PlanShare;
+
+                l_Lock.unlock();
+                l_Share(p_Share);
+                l_Lock.lock();
+
+                if (!--m_PlanPending)
+                    m_PlanDone.notify_one();
+            }
+        }
+
+        void BattlegroundScheduler::PlanBracket(Bracket::Id p_BracketId, BracketPlan& p_Plan) const
+        {
+            std::vector<float> l_NumPlayersByBGTypes(BattlegroundType::Max * 2);
+            std::vector<std::vector<GroupQueueInfo*>> l_PotentialGroups(BattlegroundType::Max * 2);
+
+            /// Find the potential battlegrounds, the queues are ordered by join time so older groups join the most rapidly.
+            FindPotentialBGs(p_BracketId, l_NumPlayersByBGTypes, l_PotentialGroups);
+
+            /// We clone our array of occurrences.
+            std::array<std::pair<float, std::size_t>, BattlegroundType::Max> l_Occurences;
+            for (std::size_t i = 0; i < BattlegroundType::Max; i++)
+                l_Occurences[i] = m_BattlegroundOccurences[p_BracketId][i];
+
+            /// We sort our battleground occurrences.
+            std::sort(std::begin(l_Occurences), std::end(l_Occurences), [](std::pair<float, std::size_t> const& p_A, std::pair<float, std::size_t> const& p_B)
+            {
+                return p_A.first < p_B.first;
+            });
+
+            /// Fills the plan if the battleground can be created with the potential groups.
+            auto l_TryPlan = [&l_PotentialGroups, &p_Plan](BattlegroundType::Type p_DecidedBg) -> bool
+            {
+                auto& l_Alliance = l_PotentialGroups[p_DecidedBg * 2 + TEAM_ALLIANCE];
+                auto& l_Horde = l_PotentialGroups[p_DecidedBg * 2 + TEAM_HORDE];
+
+                /// We check this because of the testing flag.
+                if (l_Alliance.empty() && l_Horde.empty())
+                    return false;
+
+                if (BattlegroundType::IsRated(p_DecidedBg))
                 {
-                    BattlegroundType::Type l_BGType = static_cast<BattlegroundType::Type>(l_Occurences[i].second);
+                    // We only need to check one kind of faction list because they are merged when finding the potential bgs.
+                    std::vector<GroupQueueInfo*> l_Groups = l_Alliance;
 
-                    /// If testing flag is on, we take the first one.
-                    if (sBattlegroundMgr->isTesting() && (!l_PotentialGroups[l_BGType * 2 + TEAM_ALLIANCE].empty() || !l_PotentialGroups[l_BGType * 2 + TEAM_HORDE].empty()))
+                    /// We sort them according to their MMR.
+                    std::stable_sort(std::begin(l_Groups), std::end(l_Groups), [](GroupQueueInfo const* p_A, GroupQueueInfo const* p_B)
                     {
-                        if (TryCreateBattleground(l_BGType, l_PotentialGroups, l_BracketId))
-                            break;
-                    }
+                        return p_A->m_ArenaMatchmakerRating < p_B->m_ArenaMatchmakerRating;
+                    });
 
-                    /// If we are on a casual battleground, we want to check the occurrences and ratios.
-                    if (BattlegroundType::IsCasualBattleground(l_BGType))
+                    /// We iterate over pairs of groups and check if they match according to the MatchMaking Rating.
+                    for (std::size_t i = 1; i < l_Groups.size(); i++)
                     {
-                        /// We get the battleground template.
-                        Battleground* l_Template = sBattlegroundMgr->GetBattlegroundTemplate(l_BGType);
-                        if (!l_Template)
-                            continue;
-
-                        /// We check if the battleground can start.
-                        if (l_NumPlayersByBGTypes[l_BGType * 2 + TEAM_ALLIANCE] < l_Template->GetMinPlayersPerTeam() || l_NumPlayersByBGTypes[l_BGType * 2 + TEAM_HORDE] < l_Template->GetMinPlayersPerTeam())
+                        if (!AreMatching(l_Groups[i - 1], l_Groups[i]))
                             continue;
 
-                        /// If the actual ratio in the battleground is good enough and we are not making too much instances of this battleground, we choose it.
-                        float l_Ratio = std::abs(1 - l_NumPlayersByBGTypes[l_BGType * 2 + TEAM_ALLIANCE] / l_NumPlayersByBGTypes[l_BGType * 2 + TEAM_HORDE]);
-                        if (l_Ratio < 0.15f && l_Occurences[i].first < ((1.0f / BattlegroundType::NumBattlegrounds) + 0.05f))
-                        {
-                            if (TryCreateBattleground(l_BGType, l_PotentialGroups, l_BracketId))
-                                break;
-                        }
+                        p_Plan.m_DecidedBg = p_DecidedBg;
+                        p_Plan.m_Groups[TEAM_ALLIANCE].assign(1, l_Groups[i]);
+                        p_Plan.m_Groups[TEAM_HORDE].assign(1, l_Groups[i - 1]);
+                        return true;
                     }
-                    /// If we are not caring about factions so we start.
-                    else if (BattlegroundType::IsArena(l_BGType))
-                    {
-                        /// We check if the number of players for each arena type is filled.
-                        if (l_NumPlayersByBGTypes[l_BGType * 2 + TEAM_ALLIANCE] < BattlegroundType::GetArenaType(l_BGType))
-                            continue;
 
-                        if (l_NumPlayersByBGTypes[l_BGType * 2 + TEAM_HORDE] < BattlegroundType::GetArenaType(l_BGType))
-                            continue;
+                    return false;
+                }
 
-                        if (TryCreateBattleground(l_BGType, l_PotentialGroups, l_BracketId))
-                            break;
-                    }
-                    /// From here there should only be rated battlegrounds.
-                    else if (BattlegroundType::IsRated(l_BGType))
+                if (!BattlegroundType::IsCasualBattleground(p_DecidedBg) && !BattlegroundType::IsArena(p_DecidedBg))
+                    return false;
+
+                p_Plan.m_DecidedBg = p_DecidedBg;
+                p_Plan.m_Groups[TEAM_ALLIANCE] = l_Alliance;
+                p_Plan.m_Groups[TEAM_HORDE] = l_Horde;
+                return true;
+            };
+
+            /// We iterate over the sorted occurrences to take a decision if possible.
+            for (std::size_t i = 0; i < BattlegroundType::Max; i++)
+            {
+                BattlegroundType::Type l_BGType = static_cast<BattlegroundType::Type>(l_Occurences[i].second);
+
+                /// If testing flag is on, we take the first one.
+                if (sBattlegroundMgr->isTesting() && (!l_PotentialGroups[l_BGType * 2 + TEAM_ALLIANCE].empty() || !l_PotentialGroups[l_BGType * 2 + TEAM_HORDE].empty()))
+                {
+                    if (l_TryPlan(l_BGType))
+                        return;
+                }
+
+                /// If we are on a casual battleground, we want to check the occurrences and ratios.
+                if (BattlegroundType::IsCasualBattleground(l_BGType))
+                {
+                    /// We get the battleground template.
+                    Battleground* l_Template = sBattlegroundMgr->GetBattlegroundTemplate(l_BGType);
+                    if (!l_Template)
+                        continue;
+
+                    /// We check if the battleground can start.
+                    if (l_NumPlayersByBGTypes[l_BGType * 2 + TEAM_ALLIANCE] < l_Template->GetMinPlayersPerTeam() || l_NumPlayersByBGTypes[l_BGType * 2 + TEAM_HORDE] < l_Template->GetMinPlayersPerTeam())
+                        continue;
+
+                    /// If the actual ratio in the battleground is good enough and we are not making too much instances of this battleground, we choose it.
+                    float l_Ratio = std::abs(1 - l_NumPlayersByBGTypes[l_BGType * 2 + TEAM_ALLIANCE] / l_NumPlayersByBGTypes[l_BGType * 2 + TEAM_HORDE]);
+                    if (l_Ratio < 0.15f && l_Occurences[i].first < ((1.0f / BattlegroundType::NumBattlegrounds) + 0.05f))
                     {
-                        switch (l_BGType)
-                        {
-                            case BattlegroundType::RatedBg10v10:
-                                if (l_NumPlayersByBGTypes[l_BGType * 2 + TEAM_ALLIANCE] < 10 || l_NumPlayersByBGTypes[l_BGType * 2 + TEAM_HORDE] < 10)
-                                    continue;
-                            default:
-                                break;
-                        }
+                        if (l_TryPlan(l_BGType))
+                            return;
+                    }
+                }
+                /// If we are not caring about factions so we start.
+                else if (BattlegroundType::IsArena(l_BGType))
+                {
+                    /// We check if the number of players for each arena type is filled.
+                    if (l_NumPlayersByBGTypes[l_BGType * 2 + TEAM_ALLIANCE] < BattlegroundType::GetArenaType(l_BGType))
+                        continue;
+
+                    if (l_NumPlayersByBGTypes[l_BGType * 2 + TEAM_HORDE] < BattlegroundType::GetArenaType(l_BGType))
+                        continue;
 
-                        if (TryCreateBattleground(l_BGType, l_PotentialGroups, l_BracketId))
+                    if (l_TryPlan(l_BGType))
+                        return;
+                }
+                /// From here there should only be rated battlegrounds.
+                else if (BattlegroundType::IsRated(l_BGType))
+                {
+                    switch (l_BGType)
+                    {
+                        case BattlegroundType::RatedBg10v10:
+                            if (l_NumPlayersByBGTypes[l_BGType * 2 + TEAM_ALLIANCE] < 10 || l_NumPlayersByBGTypes[l_BGType * 2 + TEAM_HORDE] < 10)
+                                continue;
+                        default:
                             break;
                     }
+
+                    if (l_TryPlan(l_BGType))
+                        return;
                 }
             }
         }
 
-        bool BattlegroundScheduler::TryCreateBattleground(BattlegroundType::Type p_DecidedBg, std::vector<std::list<GroupQueueInfo*>>& p_PotentialGroups, std::size_t p_BracketId)
+        bool BattlegroundScheduler::ApplyPlan(BracketPlan const& p_Plan, std::size_t p_BracketId)
         {
-            /// We check this because of the testing flag.
-            if (p_PotentialGroups[p_DecidedBg * 2 + TEAM_ALLIANCE].empty() && p_PotentialGroups[p_DecidedBg * 2 + TEAM_HORDE].empty())
-                return false;
+            BattlegroundType::Type p_DecidedBg = p_Plan.m_DecidedBg;
 
             if (BattlegroundType::IsCasualBattleground(p_DecidedBg))
             {
@@ -836,7 +1003,7 @@ namespace MS
                 /// Add groups to the battleground and remove them from waiting groups list.
                 for (std::size_t i = TEAM_ALLIANCE; i <= TEAM_HORDE; i++)
                 {
-                    for (GroupQueueInfo* l_Group : p_PotentialGroups[p_DecidedBg * 2 + i])
+                    for (GroupQueueInfo* l_Group : p_Plan.m_Groups[i])
                     {
                         RemoveGroupFromQueues(l_Group);
                         AddToBG(l_Group, l_Bg);
@@ -848,52 +1015,31 @@ namespace MS
             }
             else if (BattlegroundType::IsRated(p_DecidedBg))
             {
-                // We only need to check one kind of faction list because they are merged when finding the potential bgs.
-                auto& l_Groups = p_PotentialGroups[p_DecidedBg * 2];
-
-                /// We sort them according to their MMR.
-                l_Groups.sort([](GroupQueueInfo const* p_A, GroupQueueInfo const* p_B)
-                {
-                    return p_A->m_ArenaMatchmakerRating - p_B->m_ArenaMatchmakerRating;
-                });
-
-                GroupQueueInfo* l_Previous = nullptr;
-                /// We iterate over pairs of groups and check if they match according to the MatchMaking Rating.
-                for (GroupQueueInfo* l_Group : l_Groups)
-                {
-                    /// We check if their MMR are matching.
-                    if (l_Previous && AreMatching(l_Previous, l_Group))
-                    {
-                        /// Players can't decide on which kind of battleground there are playing, so it's a basic random.
-                        BattlegroundType::Type l_RatedBg = BattlegroundType::None;
-                        if (BattlegroundType::IsArena(p_DecidedBg))
-                            l_RatedBg = static_cast<BattlegroundType::Type>(urand(BattlegroundType::TigersPeaks, BattlegroundType::NagrandArena));
-                        else
-                            l_RatedBg = static_cast<BattlegroundType::Type>(urand(BattlegroundType::Warsong, BattlegroundType::BattleForGilneas));
-
-                        bool l_IsRatedBattleground = !BattlegroundType::IsArena(p_DecidedBg);   ///< We talk about rated battleground here, not rated arena!
-
-                        /// Create the new battleground.
-                        Battleground* l_Bg = sBattlegroundMgr->CreateNewBattleground(l_RatedBg, Brackets::RetreiveFromId(p_BracketId), BattlegroundType::GetArenaType(p_DecidedBg), false, false, false, l_IsRatedBattleground);
-                        if (l_Bg == nullptr)
-                            return false;
+                GroupQueueInfo* l_Group = p_Plan.m_Groups[TEAM_ALLIANCE].front();
+                GroupQueueInfo* l_Previous = p_Plan.m_Groups[TEAM_HORDE].front();
 
-                        /// Add groups to the battleground and remove them from waiting groups list.
-                        RemoveGroupFromQueues(l_Group);
-                        AddToBG(l_Group, l_Bg, ALLIANCE);
-                        RemoveGroupFromQueues(l_Previous);
-                        AddToBG(l_Previous, l_Bg, HORDE);
+                /// Players can't decide on which kind of battleground there are playing, so it's a basic random.
+                BattlegroundType::Type l_RatedBg = BattlegroundType::None;
+                if (BattlegroundType::IsArena(p_DecidedBg))
+                    l_RatedBg = static_cast<BattlegroundType::Type>(urand(BattlegroundType::TigersPeaks, BattlegroundType::NagrandArena));
+                else
+                    l_RatedBg = static_cast<BattlegroundType::Type>(urand(BattlegroundType::Warsong, BattlegroundType::BattleForGilneas));
 
-                        l_Bg->StartBattleground();
+                bool l_IsRatedBattleground = !BattlegroundType::IsArena(p_DecidedBg);   ///< We talk about rated battleground here, not rated arena!
 
-                        l_Previous = nullptr;
-                        return true;
-                    }
+                /// Create the new battleground.
+                Battleground* l_Bg = sBattlegroundMgr->CreateNewBattleground(l_RatedBg, Brackets::RetreiveFromId(p_BracketId), BattlegroundType::GetArenaType(p_DecidedBg), false, false, false, l_IsRatedBattleground);
+                if (l_Bg == nullptr)
+                    return false;
 
-                    l_Previous = l_Group;
-                }
+                /// Add groups to the battleground and remove them from waiting groups list.
+                RemoveGroupFromQueues(l_Group);
+                AddToBG(l_Group, l_Bg, ALLIANCE);
+                RemoveGroupFromQueues(l_Previous);
+                AddToBG(l_Previous, l_Bg, HORDE);
 
-                return false;
+                l_Bg->StartBattleground();
+                return true;
             }
             /// When this happened, there can't be any rated battlegrounds and it should only be skirmish arenas.
             else if (BattlegroundType::IsArena(p_DecidedBg))
@@ -911,7 +1057,7 @@ namespace MS
                 /// Add groups to the battleground and remove them from waiting groups list.
                 for (std::size_t i = TEAM_ALLIANCE; i <= TEAM_HORDE; i++)
                 {
-                    for (GroupQueueInfo* l_Group : p_PotentialGroups[p_DecidedBg * 2 + i])
+                    for (GroupQueueInfo* l_Group : p_Plan.m_Groups[i])
                     {
                         RemoveGroupFromQueues(l_Group);
                         AddToBG(l_Group, l_Bg, i == TEAM_ALLIANCE ? ALLIANCE : HORDE);
@@ -924,6 +1070,58 @@ namespace MS
 
             return false;
         }
+
+        void BattlegroundScheduler::QueueSyntheticGroups(uint32 p_Players)
+        {
+            static uint32 const k_GroupSizes[] = { 1, 1, 1, 1, 2, 3, 5 };
+            uint64 l_FakeGuid = 0;
+
+            while (p_Players)
+            {
+                GroupQueueInfo* l_Group = new GroupQueueInfo();
+                l_Group->m_Team = urand(0, 1) ? ALLIANCE : HORDE;
+                l_Group->m_BracketId = urand(0, Brackets::Count - 1);
+                l_Group->m_IsRatedBG = false;
+                l_Group->m_IsSkirmish = false;
+                l_Group->m_ArenaType = ArenaType::None;
+                l_Group->m_JoinTime = getMSTime();
+                l_Group->m_RemoveInviteTime = 0;
+                l_Group->m_IsInvitedToBGInstanceGUID = 0;
+                l_Group->m_ArenaTeamRating = 0;
+                l_Group->m_ArenaMatchmakerRating = urand(1000, 3000);
+                l_Group->m_OpponentsTeamRating = 0;
+                l_Group->m_OpponentsMatchmakerRating = 0;
+                l_Group->m_Group = nullptr;
+
+                switch (urand(0, 3))
+                {
+                    case 0:
+                        l_Group->m_BgTypeId = BattlegroundType::AllArenas;
+                        l_Group->m_WantedBGs = BattlegroundMasks::AllArenas;
+                        l_Group->m_IsRatedBG = true;
+                        break;
+                    case 1:
+                        l_Group->m_BgTypeId = static_cast<BattlegroundType::Type>(urand(BattlegroundType::Begin, BattlegroundType::NumBattlegrounds - 1));
+                        l_Group->m_WantedBGs = 1LL << l_Group->m_BgTypeId;
+                        break;
+                    default:
+                        l_Group->m_BgTypeId = BattlegroundType::RandomBattleground;
+                        l_Group->m_WantedBGs = BattlegroundMasks::AllBattlegrounds;
+                        break;
+                }
+
+                l_Group->m_IsRandom = l_Group->m_BgTypeId == BattlegroundType::RandomBattleground;
+                l_Group->m_EligibleBGs = ComputeEligibleBGs(l_Group, k_Brackets[l_Group->m_BracketId].m_MaxLevel);
+
+                /// The players are never looked up while planning, they only need to be counted.
+                uint32 l_Size = std::min(p_Players, k_GroupSizes[urand(0, sizeof(k_GroupSizes) / sizeof(k_GroupSizes[0]) - 1)]);
+                for (uint32 i = 0; i < l_Size; i++)
+                    l_Group->m_Players[++l_FakeGuid] = nullptr;
+
+                p_Players -= l_Size;
+                m_QueuedGroups[l_Group->m_BracketId][l_Group->GetTeam()].emplace_back(l_Group);
+            }
+        }
 #pragma endregion
 
     } ///< namespace Battlegrounds.
@@ -10,6 +10,10 @@
 # define BATTLEGROUND_SCHEDULER_HPP
 
 # include "Battleground.h"
+# include <thread>
+# include <mutex>
+# include <condition_variable>
+# include <functional>
 
 namespace MS
 {
@@ -45,14 +49,27 @@ namespace MS
             };
         }
 
+        /// Battleground decided for a bracket by a matchmaking pass, applied afterwards on the world thread.
+        struct BracketPlan
+        {
+            BracketPlan() : m_DecidedBg(BattlegroundType::None) {}
+
+            BattlegroundType::Type m_DecidedBg;                 ///< None if nothing can start in the bracket.
+            std::vector<GroupQueueInfo*> m_Groups[2];           ///< Groups joining, by team (rated: the two matched groups).
+        };
+
         class BattlegroundScheduler
         {
             using QueuedPlayersMap = ACE_Based::LockedMap<uint64, PlayerQueueInfo>;
+            using QueuedGroups = std::vector<GroupQueueInfo*>;
 
         public:
             /// Constructor.
             BattlegroundScheduler();
 
+            /// Destructor.
+            ~BattlegroundScheduler();
+
             /// Constructs a GroupQueueInfo and queues it in the scheduler.
             /// @p_Leader           : The player who is leading the group.
             /// @p_Group            : The group of players.
@@ -100,11 +117,20 @@ namespace MS
             /// Scheduling part.
             //////////////////////////////////////////////////////////////////////////
 
-            /// Try to make matches with the queued groups.
-            void FindMatches();
+            /// Try to make matches with the queued groups, every Battleground.Scheduler.Interval.
+            /// @p_Diff : Time elapsed since the last call.
+            void FindMatches(uint32 p_Diff);
+
+            /// Decides which battleground should start in every bracket, without modifying anything.
+            /// The brackets are independent, they are split between p_Threads tasks (0 runs them on the calling thread),
+            /// the calling thread runs the first one and workers kept by the scheduler the others.
+            /// @p_Plans    : The plans, by bracket id.
+            /// @p_Threads  : Number of tasks to use.
+            void PlanBrackets(std::vector<BracketPlan>& p_Plans, uint32 p_Threads) const;
 
-            /// Try to create a battleground
-            bool TryCreateBattleground(BattlegroundType::Type p_DecidedBg, std::vector<std::list<GroupQueueInfo*>>& p_PotentialGroups, std::size_t p_BracketId);
+            /// Fills the queues with random solo players and groups, for benchmarks only.
+            /// @p_Players : Number of players to queue, spread over the brackets.
+            void QueueSyntheticGroups(uint32 p_Players);
 
 #ifdef CROSS
             /// Dump all running battlegrounds with queue information (player in bg, invite sent ...etc) in a dump file for debugging purpose
@@ -112,6 +138,21 @@ namespace MS
 
 #endif /* CROSS */
         private:
+            /// Creates the battleground decided by a plan and invites its groups.
+            /// @p_Plan         : The plan.
+            /// @p_BracketId    : The bracket of the plan.
+            bool ApplyPlan(BracketPlan const& p_Plan, std::size_t p_BracketId);
+
+            /// Decides which battleground should start in a bracket, see PlanBrackets.
+            /// @p_BracketId    : The bracket id.
+            /// @p_Plan         : The plan to fill.
+            void PlanBracket(Bracket::Id p_BracketId, BracketPlan& p_Plan) const;
+
+            /// Bit mask of the battleground types the group can enter, checked once when queued.
+            /// @p_Group    : The group.
+            /// @p_MinLevel : The lowest level of the group members.
+            static uint64 ComputeEligibleBGs(GroupQueueInfo const* p_Group, uint32 p_MinLevel);
+
             /// Allocates the groups in the existing battlegrounds depending on different criteria and respecting eligibility.
             /// @p_BracketId    : The bracket id.
             /// @p_Team         : The team to look after.
@@ -122,13 +163,30 @@ namespace MS
             /// @p_BracketId        : The bracket id.
             /// @p_PotentialBGs     : The count of players inside the different battlegrounds.
             /// @p_PotentialGroups  : The vector of eligible groups.
-            void FindPotentialBGs(Bracket::Id p_BracketId, std::vector<float>& p_PotientialBGs, std::vector<std::list<GroupQueueInfo*>>& p_PotentialGroups);
+            void FindPotentialBGs(Bracket::Id p_BracketId, std::vector<float>& p_PotientialBGs, std::vector<std::vector<GroupQueueInfo*>>& p_PotentialGroups) const;
+
+            /// Loop of a planning worker, runs its share of every pass until the scheduler is destroyed.
+            /// @p_Share    : The share of the brackets planned by the worker, the calling thread has the share 0.
+            /// @p_LastPass : The last pass posted before the worker was started, it only runs the later ones.
+            void PlanWorker(std::size_t p_Share, uint32 p_LastPass) const;
 
         private:
-            std::list<GroupQueueInfo*> m_QueuedGroups[Brackets::Count][2];                                  ///< The queue of groups.
+            QueuedGroups m_QueuedGroups[Brackets::Count][2];                                                ///< The queue of groups, ordered by join time.
             std::pair<float, std::size_t> m_BattlegroundOccurences[Brackets::Count][BattlegroundType::Max]; ///< The occurrences of battlegrounds during runtime.
             std::size_t m_TotalOccurences[Brackets::Count];                                                 ///< The total number of occurences during runtime.
             QueuedPlayersMap m_QueuedPlayers;                                                               ///< The queue of players that are in the groups.
+            uint32 m_MatchTimer;                                                                            ///< Time since the last matchmaking pass.
+
+            /// Planning workers, started by the first pass needing them and kept until destruction.
+            mutable std::vector<std::thread> m_PlanWorkers;
+            mutable std::mutex m_PlanLock;
+            mutable std::condition_variable m_PlanStart;                                                    ///< A pass was posted, or the workers must stop.
+            mutable std::condition_variable m_PlanDone;                                                     ///< The last worker share of the pass is done.
+            mutable std::function<void(std::size_t)> m_PlanShare;                                           ///< Plans a share of the current pass.
+            mutable std::size_t m_PlanShareCount;                                                           ///< Shares of the current pass, the calling thread included.
+            mutable std::size_t m_PlanPending;                                                              ///< Worker shares not done yet.
+            mutable uint32 m_PlanPass;
+            mutable bool m_PlanStop;
         };
     } ///< namespace Battlegrounds.
 } ///< namespace MS.
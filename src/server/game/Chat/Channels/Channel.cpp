@@ -9,6 +9,7 @@
 #include <regex>
 
 #include "Channel.h"
+#include "SharedWorldPacket.h"
 #include "Chat.h"
 #include "ObjectMgr.h"
 #include "SocialMgr.h"
@@ -20,6 +21,7 @@ Channel::Channel(const std::string& name, uint32 channel_id, uint32 Team)
  : m_announce(true), _special(false), m_ownership(true), m_name(name), m_password(""), m_flags(0), m_channelId(channel_id), m_ownerGUID(0), m_Team(Team)
 {
     m_IsSaved = false;
+    m_MemberSnapshotDirty = true;
 
     if (IsWorld())
         m_announce = false;
@@ -234,6 +236,7 @@ void Channel::Join(uint64 p, const char *pass)
     m_Lock.acquire();
     m_Players[p] = pinfo;
     m_Lock.release();
+    InvalidateMemberSnapshot();
 
     MakeYouJoined(&data);
     SendToOne(&data, p);
@@ -297,6 +300,7 @@ void Channel::Leave(uint64 p, bool send)
         m_Lock.acquire();
         m_Players.erase(p);
         m_Lock.release();
+        InvalidateMemberSnapshot();
 
         if (m_announce && (!player || !AccountMgr::IsModeratorAccount(player->GetSession()->GetSecurity()) || !sWorld->getBoolConfig(CONFIG_SILENTLY_GM_JOIN_TO_CHANNEL)))
         {
@@ -379,6 +383,7 @@ void Channel::KickOrBan(uint64 good, const char *badname, bool ban)
                 SendToAll(&data);
 
             m_Players.erase(bad->GetGUID());
+            InvalidateMemberSnapshot();
             bad->LeftChannel(this);
 
             if (changeowner && m_ownership && !m_Players.empty())
@@ -854,44 +859,60 @@ void Channel::SetOwner(uint64 guid, bool exclaim)
     }
 }
 
-void Channel::SendToAll(WorldPacket* data, uint64 p, uint64 p_SenderGUID)
+Channel::MemberSnapshot Channel::GetMemberSnapshot()
 {
+    /// Members added through m_Players[] by moderation commands are caught by the size check
+    MemberSnapshot snapshot = std::atomic_load(&m_MemberSnapshot);
+    if (snapshot && !m_MemberSnapshotDirty && snapshot->size() == m_Players.size())
+        return snapshot;
+
+    std::shared_ptr<std::vector<uint64> > members = std::make_shared<std::vector<uint64> >();
+
     m_Lock.acquire();
+    m_MemberSnapshotDirty = false;
+    members->reserve(m_Players.size());
     for (PlayerList::const_iterator i = m_Players.begin(); i != m_Players.end(); ++i)
+        members->push_back(i->first);
+    m_Lock.release();
+
+    snapshot = members;
+    std::atomic_store(&m_MemberSnapshot, snapshot);
+    return snapshot;
+}
+
+void Channel::SendToAll(WorldPacket* data, uint64 p, uint64 /*p_SenderGUID*/)
+{
+    MemberSnapshot members = GetMemberSnapshot();
+    SharedWorldPacket packet(*data);
+
+    for (uint64 guid : *members)
     {
-        Player* player = ObjectAccessor::FindPlayer(i->first);
-        if (player)
-        {
+        Player* player = ObjectAccessor::FindPlayer(guid);
+        if (!player)
+            continue;
+
 #ifndef CROSS
-            if (!p || !player->GetSocial()->HasIgnore(GUID_LOPART(p)))
-            {
-                if (IsWorld() || IsConstant())
-                    player->GetSession()->SendPacket(data);
-                else if (!(IsWorld() || IsConstant()))
-                    player->GetSession()->SendPacket(data);
-            }
+        if (!p || !player->GetSocial()->HasIgnore(GUID_LOPART(p)))
 #else /* CROSS */
-            if (!p || !player->GetSocial() || !player->GetSocial()->HasIgnore(GUID_LOPART(p)))
-                player->GetSession()->SendPacket(data);
+        if (!p || !player->GetSocial() || !player->GetSocial()->HasIgnore(GUID_LOPART(p)))
 #endif /* CROSS */
-        }
+            player->GetSession()->SendPacket(packet);
     }
-    m_Lock.release();
 }
 
 void Channel::SendToAllButOne(WorldPacket* data, uint64 who)
 {
-    m_Lock.acquire();
-    for (PlayerList::const_iterator i = m_Players.begin(); i != m_Players.end(); ++i)
+    MemberSnapshot members = GetMemberSnapshot();
+    SharedWorldPacket packet(*data);
+
+    for (uint64 guid : *members)
     {
-        if (i->first != who)
-        {
-            Player* player = ObjectAccessor::FindPlayer(i->first);
-            if (player)
-                player->GetSession()->SendPacket(data);
-        }
+        if (guid == who)
+            continue;
+
+        if (Player* player = ObjectAccessor::FindPlayer(guid))
+            player->GetSession()->SendPacket(packet);
     }
-    m_Lock.release();
 }
 
 void Channel::SendToOne(WorldPacket* data, uint64 who)
@@ -147,6 +147,11 @@ class Channel
     typedef     ACE_Based::LockedMap<uint64, PlayerInfo> PlayerList;
     PlayerList  m_Players;
     mutable ACE_Thread_Mutex m_Lock;
+
+    // guids of m_Players, shared by every broadcast until the member list changes
+    typedef     std::shared_ptr<std::vector<uint64> const> MemberSnapshot;
+    MemberSnapshot    m_MemberSnapshot;
+    std::atomic<bool> m_MemberSnapshotDirty;
     typedef     std::set<uint64> BannedList;
     BannedList  banned;
     bool        m_announce;
@@ -198,6 +203,9 @@ class Channel
         void MakeVoiceOn(WorldPacket* data, uint64 guid);                       //+ 0x22
         void MakeVoiceOff(WorldPacket* data, uint64 guid);                      //+ 0x23
 
+        MemberSnapshot GetMemberSnapshot();
+        void InvalidateMemberSnapshot() { m_MemberSnapshotDirty = true; }
+
         void SendToAll(WorldPacket* data, uint64 p = 0, uint64 p_SenderGUID = 0);
         void SendToAllButOne(WorldPacket* data, uint64 who);
         void SendToOne(WorldPacket* data, uint64 who);
@@ -69,8 +69,8 @@ bool Condition::Meets(ConditionSourceInfo& sourceInfo) const
         {
             if (Player* player = object->ToPlayer())
             {
-                if (FactionEntry const* faction = sFactionStore.LookupEntry(ConditionValue1))
-                    condMeets = (ConditionValue2 & (1 << player->GetReputationMgr().GetRank(faction)));
+                if (Faction)
+                    condMeets = (ConditionValue2 & (1 << player->GetReputationMgr().GetRank(Faction)));
             }
             break;
         }
@@ -336,10 +336,118 @@ bool Condition::Meets(ConditionSourceInfo& sourceInfo) const
     if (!condMeets)
         sourceInfo.mLastFailedCondition = this;
 
+    if (!ScriptId)
+        return condMeets;
+
     bool script = sScriptMgr->OnConditionCheck(this, sourceInfo); // Returns true by default.
     return condMeets && script;
 }
 
+void Condition::Compile()
+{
+    StaticResult = CONDITION_STATIC_NONE;
+    Faction      = nullptr;
+    Reference    = nullptr;
+
+    if (ReferenceId)
+    {
+        Cost = CONDITION_COST_REFERENCE;
+        return;
+    }
+
+    bool l_Static = false;
+    bool l_StaticMeets = false;
+
+    switch (ConditionType)
+    {
+        case CONDITION_NONE:
+            l_Static = true;
+            l_StaticMeets = true;
+            break;
+        case CONDITION_REPUTATION_RANK:
+            Faction = sFactionStore.LookupEntry(ConditionValue1);
+            l_Static = !Faction;
+            Cost = CONDITION_COST_LOOKUP;
+            break;
+        case CONDITION_ZONEID:
+        case CONDITION_MAPID:
+        case CONDITION_AREAID:
+        case CONDITION_TEAM:
+        case CONDITION_CLASS:
+        case CONDITION_RACE:
+        case CONDITION_GENDER:
+        case CONDITION_LEVEL:
+        case CONDITION_DRUNKENSTATE:
+        case CONDITION_OBJECT_ENTRY:
+        case CONDITION_TYPE_MASK:
+        case CONDITION_PHASEMASK:
+        case CONDITION_SPAWNMASK:
+        case CONDITION_ALIVE:
+        case CONDITION_HP_VAL:
+        case CONDITION_HP_PCT:
+        case CONDITION_TITLE:
+            Cost = CONDITION_COST_FIELD;
+            break;
+        case CONDITION_AURA:
+        case CONDITION_SKILL:
+        case CONDITION_QUESTREWARDED:
+        case CONDITION_QUESTTAKEN:
+        case CONDITION_QUEST_COMPLETE:
+        case CONDITION_QUEST_NONE:
+        case CONDITION_ACHIEVEMENT:
+        case CONDITION_SPELL:
+        case CONDITION_ACTIVE_EVENT:
+        case CONDITION_WORLD_STATE:
+        case CONDITION_INSTANCE_DATA:
+        case CONDITION_RELATION_TO:
+        case CONDITION_REACTION_TO:
+        case CONDITION_DISTANCE_TO:
+            Cost = CONDITION_COST_LOOKUP;
+            break;
+        case CONDITION_ITEM:
+        case CONDITION_ITEM_EQUIPPED:
+            Cost = CONDITION_COST_SCAN;
+            break;
+#ifndef CROSS
+        case CONDITION_HAS_BUILDING_TYPE:
+        case CONDITION_HAS_GARRISON_LEVEL:
+            Cost = CONDITION_COST_SCAN;
+            break;
+#endif
+        case CONDITION_NEAR_CREATURE:
+        case CONDITION_NEAR_GAMEOBJECT:
+            Cost = CONDITION_COST_SEARCH;
+            break;
+        default:
+            /// Meets() has no case for it, never met
+            l_Static = true;
+            break;
+    }
+
+    /// A script can overrule any result, the check has to run
+    if (!l_Static || ScriptId)
+        return;
+
+    if (NegativeCondition)
+        l_StaticMeets = !l_StaticMeets;
+
+    StaticResult = l_StaticMeets ? CONDITION_STATIC_TRUE : CONDITION_STATIC_FALSE;
+    Cost = CONDITION_COST_STATIC;
+}
+
+void InsertCondition(ConditionContainer& p_Conditions, Condition* p_Condition)
+{
+    ConditionContainer::iterator l_Itr = std::upper_bound(p_Conditions.begin(), p_Conditions.end(), p_Condition, [](Condition const* p_Left, Condition const* p_Right) -> bool
+    {
+        if (p_Left->ElseGroup != p_Right->ElseGroup)
+            return p_Left->ElseGroup < p_Right->ElseGroup;
+
+        return p_Left->Cost < p_Right->Cost;
+    });
+
+    p_Conditions.insert(l_Itr, p_Condition);
+}
+
 uint32 Condition::GetSearcherTypeMaskForCondition() const
 {
     // build mask of types for which condition can return true
@@ -539,25 +647,30 @@ uint32 ConditionMgr::GetSearcherTypeMaskForConditionList(ConditionContainer cons
 {
     if (conditions.empty())
         return GRID_MAP_TYPE_MASK_ALL;
-    //     groupId, typeMask
-    std::map<uint32, uint32> elseGroupSearcherTypeMasks;
+
+    // object will match condition when one of the checks in ElseGroupStore is matching
+    // so, let's include all possible masks
+    uint32 mask = 0;
+    uint32 groupMask = 0;
+
     for (ConditionContainer::const_iterator i = conditions.begin(); i != conditions.end(); ++i)
     {
         // no point of having not loaded conditions in list
         ASSERT((*i)->isLoaded() && "ConditionMgr::GetSearcherTypeMaskForConditionList - not yet loaded condition found in list");
-        std::map<uint32, uint32>::const_iterator itr = elseGroupSearcherTypeMasks.find((*i)->ElseGroup);
-        // group not filled yet, fill with widest mask possible
-        if (itr == elseGroupSearcherTypeMasks.end())
-            elseGroupSearcherTypeMasks[(*i)->ElseGroup] = GRID_MAP_TYPE_MASK_ALL;
+
+        // groups are contiguous, start with widest mask possible
+        if (i == conditions.begin() || (*i)->ElseGroup != (*(i - 1))->ElseGroup)
+        {
+            mask |= groupMask;
+            groupMask = GRID_MAP_TYPE_MASK_ALL;
+        }
         // no point of checking anymore, empty mask
-        else if (!itr->second)
+        else if (!groupMask)
             continue;
 
         if ((*i)->ReferenceId) // handle reference
         {
-            ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find((*i)->ReferenceId);
-
-            if (ref == ConditionReferenceStore.end())
+            if (!(*i)->Reference)
             {
                 sLog->outAshran("ConditionMgr::GetSearcherTypeMaskForConditionList - incorrect reference [%u][%u][%u] ", (*i)->ReferenceId, (*i)->SourceEntry, (*i)->SourceGroup);
 
@@ -565,70 +678,74 @@ uint32 ConditionMgr::GetSearcherTypeMaskForConditionList(ConditionContainer cons
                 return GRID_MAP_TYPE_MASK_ALL;
             }
 
-            ASSERT(ref != ConditionReferenceStore.end() && "ConditionMgr::GetSearcherTypeMaskForConditionList - incorrect reference");
-            elseGroupSearcherTypeMasks[(*i)->ElseGroup] &= GetSearcherTypeMaskForConditionList((*ref).second);
+            groupMask &= GetSearcherTypeMaskForConditionList(*(*i)->Reference);
         }
         else // handle normal condition
         {
             // object will match conditions in one ElseGroupStore only when it matches all of them
             // so, let's find a smallest possible mask which satisfies all conditions
-            elseGroupSearcherTypeMasks[(*i)->ElseGroup] &= (*i)->GetSearcherTypeMaskForCondition();
+            groupMask &= (*i)->GetSearcherTypeMaskForCondition();
         }
     }
-    // object will match condition when one of the checks in ElseGroupStore is matching
-    // so, let's include all possible masks
-    uint32 mask = 0;
-    for (std::map<uint32, uint32>::const_iterator i = elseGroupSearcherTypeMasks.begin(); i != elseGroupSearcherTypeMasks.end(); ++i)
-        mask |= i->second;
 
-    return mask;
+    return mask | groupMask;
 }
 
 bool ConditionMgr::IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo, ConditionContainer  const& conditions) const
 {
-    //     groupId, groupCheckPassed
-    std::map<uint32, bool> elseGroupStore;
+    /// Conditions are sorted by ElseGroup then cost: a group is a run of checks stopped by the first failure,
+    /// the first group entirely met is enough
+    bool groupFound = false;
+    bool groupMet = false;
+    uint32 group = 0;
+
     for (Condition const* condition : conditions)
     {
-        sLog->outDebug(LOG_FILTER_CONDITIONSYS, "ConditionMgr::IsPlayerMeetToConditionList condType: %u val1: %u", condition->ConditionType, condition->ConditionValue1);
-        if (condition->isLoaded())
-        {
-            //! Find ElseGroup in ElseGroupStore
-            std::map<uint32, bool>::const_iterator itr = elseGroupStore.find(condition->ElseGroup);
-            //! If not found, add an entry in the store and set to true (placeholder)
-            if (itr == elseGroupStore.end())
-                elseGroupStore[condition->ElseGroup] = true;
-            else if (!(*itr).second)
-                continue;
+        if (!condition->isLoaded())
+            continue;
 
-            if (condition->ReferenceId)//handle reference
-            {
-                ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find(condition->ReferenceId);
-                if (ref != ConditionReferenceStore.end())
-                {
-                    if (!IsObjectMeetToConditionList(sourceInfo, ref->second))
-                        elseGroupStore[condition->ElseGroup] = false;
-                }
-                else
-                {
-                    sLog->outDebug(LOG_FILTER_CONDITIONSYS, "IsPlayerMeetToConditionList: Reference template -%u not found",
-                        condition->ReferenceId);//checked at loading, should never happen
-                }
+        if (!groupFound || condition->ElseGroup != group)
+        {
+            if (groupMet)
+                return true;
 
-            }
-            else //handle normal condition
+            groupFound = true;
+            groupMet = true;
+            group = condition->ElseGroup;
+        }
+        else if (!groupMet)
+            continue;
+
+        if (condition->ReferenceId) // handle reference
+        {
+            if (condition->Reference)
+                groupMet = IsObjectMeetToConditionList(sourceInfo, *condition->Reference);
+            else
             {
-                if (!condition->Meets(sourceInfo))
-                    elseGroupStore[condition->ElseGroup] = false;
+                sLog->outDebug(LOG_FILTER_CONDITIONSYS, "IsPlayerMeetToConditionList: Reference template -%u not found",
+                    condition->ReferenceId);//checked at loading, should never happen
             }
+            continue;
         }
-    }
 
-    for (std::map<uint32, bool>::const_iterator i = elseGroupStore.begin(); i != elseGroupStore.end(); ++i)
-        if (i->second)
-            return true;
+        switch (condition->StaticResult)
+        {
+            case CONDITION_STATIC_NONE:
+                groupMet = condition->Meets(sourceInfo);
+                break;
+            case CONDITION_STATIC_TRUE:
+                // same as Meets, a missing target never matches
+                groupMet = sourceInfo.mConditionTargets[condition->ConditionTarget] != nullptr;
+                break;
+            case CONDITION_STATIC_FALSE:
+                groupMet = false;
+                if (sourceInfo.mConditionTargets[condition->ConditionTarget])
+                    sourceInfo.mLastFailedCondition = condition;
+                break;
+        }
+    }
 
-    return false;
+    return groupMet;
 }
 
 bool ConditionMgr::IsObjectMeetToConditions(WorldObject* object, ConditionContainer  const& conditions) const
@@ -926,9 +1043,14 @@ void ConditionMgr::LoadConditions(bool isReload)
             continue;
         }
 
+        cond->Compile();
+
         if (iSourceTypeOrReferenceId < 0)//it is a reference template
         {
-            ConditionReferenceStore[std::abs(iSourceTypeOrReferenceId)].push_back(cond);//add to reference storage
+            if (cond->ReferenceId)
+                ReferencingConditions.push_back(cond);
+
+            InsertCondition(ConditionReferenceStore[std::abs(iSourceTypeOrReferenceId)], cond);//add to reference storage
             ++count;
             continue;
         }//end of reference templates
@@ -954,6 +1076,9 @@ void ConditionMgr::LoadConditions(bool isReload)
             continue;
         }
 
+        if (cond->ReferenceId)
+            ReferencingConditions.push_back(cond);
+
         if (cond->SourceGroup)
         {
             bool valid = false;
@@ -1004,7 +1129,7 @@ void ConditionMgr::LoadConditions(bool isReload)
                     break;
                 case CONDITION_SOURCE_TYPE_SPELL_CLICK_EVENT:
                 {
-                    SpellClickEventConditionStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                    InsertCondition(SpellClickEventConditionStore[cond->SourceGroup][cond->SourceEntry], cond);
                     valid = true;
                     ++count;
                     continue;   // do not add to m_AllocatedMemory to avoid double deleting
@@ -1014,7 +1139,7 @@ void ConditionMgr::LoadConditions(bool isReload)
                     break;
                 case CONDITION_SOURCE_TYPE_VEHICLE_SPELL:
                 {
-                    VehicleSpellConditionStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                    InsertCondition(VehicleSpellConditionStore[cond->SourceGroup][cond->SourceEntry], cond);
                     valid = true;
                     ++count;
                     continue;   // do not add to m_AllocatedMemory to avoid double deleting
@@ -1023,21 +1148,21 @@ void ConditionMgr::LoadConditions(bool isReload)
                 {
                     //! TODO: PAIR_32 ?
                     std::pair<int32, uint32> key = std::make_pair(cond->SourceEntry, cond->SourceId);
-                    SmartEventConditionStore[key][cond->SourceGroup].push_back(cond);
+                    InsertCondition(SmartEventConditionStore[key][cond->SourceGroup], cond);
                     valid = true;
                     ++count;
                     continue;
                 }
                 case CONDITION_SOURCE_TYPE_NPC_VENDOR:
                 {
-                    NpcVendorConditionContainerStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                    InsertCondition(NpcVendorConditionContainerStore[cond->SourceGroup][cond->SourceEntry], cond);
                     valid =  true;
                     ++count;
                     continue;
                 }
                 case CONDITION_SOURCE_TYPE_PHASE_DEFINITION:
                 {
-                    PhaseDefinitionsConditionStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                    InsertCondition(PhaseDefinitionsConditionStore[cond->SourceGroup][cond->SourceEntry], cond);
                     valid = true;
                     ++count;
                     continue;
@@ -1049,6 +1174,11 @@ void ConditionMgr::LoadConditions(bool isReload)
             if (!valid)
             {
                 sLog->outError(LOG_FILTER_SQL, "Not handled grouped condition, SourceGroup %u", cond->SourceGroup);
+
+                // pushed right before the switch
+                if (cond->ReferenceId)
+                    ReferencingConditions.pop_back();
+
                 delete cond;
             }
             else
@@ -1062,15 +1192,33 @@ void ConditionMgr::LoadConditions(bool isReload)
         //handle not grouped conditions
 
         //add new Condition to storage based on Type/Entry
-        ConditionStore[cond->SourceType][cond->SourceEntry].push_back(cond);
+        InsertCondition(ConditionStore[cond->SourceType][cond->SourceEntry], cond);
         ++count;
     }
     while (result->NextRow());
 
+    LinkReferences();
+
     sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Loaded %u conditions in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
 
 }
 
+void ConditionMgr::LinkReferences()
+{
+    for (Condition* l_Condition : ReferencingConditions)
+    {
+        ConditionReferenceContainer::const_iterator l_Itr = ConditionReferenceStore.find(l_Condition->ReferenceId);
+        if (l_Itr == ConditionReferenceStore.end())
+        {
+            sLog->outError(LOG_FILTER_SQL, "Condition (SourceType %u, SourceEntry %i, SourceGroup %u) uses reference template -%u which doesn't exist, ignored",
+                uint32(l_Condition->SourceType), l_Condition->SourceEntry, l_Condition->SourceGroup, l_Condition->ReferenceId);
+            continue;
+        }
+
+        l_Condition->Reference = &l_Itr->second;
+    }
+}
+
 bool ConditionMgr::addToLootTemplate(Condition* cond, LootTemplate* loot) const
 {
     if (!loot)
@@ -1096,7 +1244,7 @@ bool ConditionMgr::addToGossipMenus(Condition* cond) const
         {
             if ((*itr).second.entry == cond->SourceGroup && (*itr).second.text_id == uint32(cond->SourceEntry))
             {
-                (*itr).second.conditions.push_back(cond);
+                InsertCondition((*itr).second.conditions, cond);
                 return true;
             }
         }
@@ -1115,7 +1263,7 @@ bool ConditionMgr::addToGossipMenuItems(Condition* cond) const
         {
             if ((*itr).second.MenuId == cond->SourceGroup && (*itr).second.OptionIndex == uint32(cond->SourceEntry))
             {
-                (*itr).second.Conditions.push_back(cond);
+                InsertCondition((*itr).second.Conditions, cond);
                 return true;
             }
         }
@@ -1127,15 +1275,25 @@ bool ConditionMgr::addToGossipMenuItems(Condition* cond) const
 
 bool ConditionMgr::addToSpellImplicitTargetConditions(Condition* cond) const
 {
-    uint32 conditionEffMask = cond->SourceGroup;
+    SpellInfo* l_BaseSpellInfo = const_cast<SpellInfo*>(sSpellMgr->GetSpellInfo(cond->SourceEntry));
+    ASSERT(l_BaseSpellInfo);
 
-    for (uint32 l_Difficulty = Difficulty::DifficultyNone; l_Difficulty < Difficulty::MaxDifficulties; l_Difficulty++)
+    /// Difficulties without a variant of their own use the base spell, each SpellInfo is handled once
+    std::vector<SpellInfo*> l_SpellInfos(1, l_BaseSpellInfo);
+    if (SpellDifficultyVariants const* l_Variants = sSpellMgr->GetSpellDifficultyVariants(cond->SourceEntry))
+        l_SpellInfos.insert(l_SpellInfos.end(), l_Variants->begin(), l_Variants->end());
+
+    for (SpellInfo* spellInfo : l_SpellInfos)
     {
-        SpellInfo* spellInfo = const_cast<SpellInfo*>(sSpellMgr->GetSpellForDifficulty(cond->SourceEntry, static_cast<Difficulty>(l_Difficulty)));
-        ASSERT(spellInfo);
+        /// Only the effects the spell has are stored, a condition on the other indexes would never be checked
+        uint32 l_UsedEffectMask = spellInfo->EffectCount >= 32 ? 0xFFFFFFFF : (1 << spellInfo->EffectCount) - 1;
+        uint32 conditionEffMask = cond->SourceGroup & l_UsedEffectMask;
+        if (!conditionEffMask)
+            continue;
+
         std::list<uint32> sharedMasks;
 
-        for (uint8 i = 0; i < SpellEffIndex::MAX_EFFECTS; ++i)
+        for (uint8 i = 0; i < spellInfo->EffectCount; ++i)
         {
             // check if effect is already a part of some shared mask
             bool found = false;
@@ -1153,7 +1311,7 @@ bool ConditionMgr::addToSpellImplicitTargetConditions(Condition* cond) const
             // build new shared mask with found effect
             uint32 sharedMask = 1 << i;
             ConditionContainer* cmp = spellInfo->Effects[i].ImplicitTargetConditions;
-            for (uint8 effIndex = i + 1; effIndex < SpellEffIndex::MAX_EFFECTS; ++effIndex)
+            for (uint8 effIndex = i + 1; effIndex < spellInfo->EffectCount; ++effIndex)
             {
                 if (spellInfo->Effects[effIndex].ImplicitTargetConditions == cmp)
                     sharedMask |= 1 << effIndex;
@@ -1167,13 +1325,13 @@ bool ConditionMgr::addToSpellImplicitTargetConditions(Condition* cond) const
             if (uint32 commonMask = *itr & conditionEffMask)
             {
                 uint8 firstEffIndex = 0;
-                for (; firstEffIndex < SpellEffIndex::MAX_EFFECTS; ++firstEffIndex)
+                for (; firstEffIndex < spellInfo->EffectCount; ++firstEffIndex)
                 {
                     if ((1 << firstEffIndex) & *itr)
                         break;
                 }
 
-                if (firstEffIndex >= SpellEffIndex::MAX_EFFECTS)
+                if (firstEffIndex >= spellInfo->EffectCount)
                     return false;
 
                 // get shared data
@@ -1196,7 +1354,7 @@ bool ConditionMgr::addToSpellImplicitTargetConditions(Condition* cond) const
                     // add new list, create new shared mask
                     sharedList = new ConditionContainer();
                     bool assigned = false;
-                    for (uint8 i = firstEffIndex; i < SpellEffIndex::MAX_EFFECTS; ++i)
+                    for (uint8 i = firstEffIndex; i < spellInfo->EffectCount; ++i)
                     {
                         if ((1 << i) & commonMask)
                         {
@@ -1212,7 +1370,7 @@ bool ConditionMgr::addToSpellImplicitTargetConditions(Condition* cond) const
                     }
                 }
 
-                sharedList->push_back(cond);
+                InsertCondition(*sharedList, cond);
                 break;
             }
         }
@@ -2085,6 +2243,8 @@ bool ConditionMgr::isConditionTypeValid(Condition* cond) const
 
 void ConditionMgr::Clean()
 {
+    ReferencingConditions.clear();
+
     for (ConditionReferenceContainer::iterator itr = ConditionReferenceStore.begin(); itr != ConditionReferenceStore.end(); ++itr)
     {
         for (ConditionContainer::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
@@ -17,6 +17,7 @@ class Unit;
 class WorldObject;
 class LootTemplate;
 struct Condition;
+struct FactionEntry;
 
 enum ConditionTypes
 {                                                           // value1           value2         value3
@@ -148,6 +149,25 @@ enum
     MAX_CONDITION_TARGETS = 3
 };
 
+/// Result of a condition known once loaded, the check is skipped when it isn't CONDITION_STATIC_NONE
+enum ConditionStaticResult
+{
+    CONDITION_STATIC_NONE = 0,
+    CONDITION_STATIC_TRUE,
+    CONDITION_STATIC_FALSE
+};
+
+/// Relative price of a check, cheap ones are tried first inside their ElseGroup
+enum ConditionCost
+{
+    CONDITION_COST_STATIC = 0,                              ///< Constant folded
+    CONDITION_COST_FIELD,                                   ///< Compares a field of the object
+    CONDITION_COST_LOOKUP,                                  ///< Map / hash lookup (quests, spells, auras, reputation...)
+    CONDITION_COST_SCAN,                                    ///< Walks inventory or garrison buildings
+    CONDITION_COST_SEARCH,                                  ///< Grid search around the object
+    CONDITION_COST_REFERENCE                                ///< Whole referenced list
+};
+
 struct ConditionSourceInfo
 {
     WorldObject* mConditionTargets[MAX_CONDITION_TARGETS]; // an array of targets available for conditions
@@ -178,6 +198,12 @@ struct Condition
     uint8                   ConditionTarget;
     bool                    NegativeCondition;
 
+    /// Filled by Compile() at load, NegativeCondition is already applied to StaticResult
+    ConditionStaticResult   StaticResult;
+    ConditionCost           Cost;
+    FactionEntry const*     Faction;                        ///< CONDITION_REPUTATION_RANK
+    std::vector<Condition*> const* Reference;               ///< Resolved ReferenceId, nullptr if the template is missing
+
     Condition()
     {
         SourceType         = CONDITION_SOURCE_TYPE_NONE;
@@ -193,14 +219,21 @@ struct Condition
         ErrorTextId        = 0;
         ScriptId           = 0;
         NegativeCondition  = false;
+        StaticResult       = CONDITION_STATIC_NONE;
+        Cost               = CONDITION_COST_FIELD;
+        Faction            = nullptr;
+        Reference          = nullptr;
     }
 
+    /// Precomputes StaticResult, Cost and the DBC lookups, must be called once the fields are final
+    void Compile();
     bool Meets(ConditionSourceInfo& sourceInfo) const;
     uint32 GetSearcherTypeMaskForCondition() const;
     bool isLoaded() const { return ConditionType > CONDITION_NONE || ReferenceId; }
     uint32 GetMaxAvailableConditionTargets() const;
 };
 
+/// Kept sorted by ElseGroup then Cost, conditions must be added with InsertCondition
 typedef std::vector<Condition*> ConditionContainer;
 typedef std::unordered_map<uint32 /*SourceEntry*/, ConditionContainer> ConditionsByEntryMap;
 typedef std::array<ConditionsByEntryMap, CONDITION_SOURCE_TYPE_MAX> ConditionEntriesByTypeArray;
@@ -246,9 +279,11 @@ class ConditionMgr
         bool addToGossipMenuItems(Condition* cond) const;
         bool addToSpellImplicitTargetConditions(Condition* cond) const;
         bool IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo, ConditionContainer const& conditions) const;
+        void LinkReferences();
 
         void Clean(); // free up resources
         std::vector<Condition*> AllocatedMemoryStore; // some garbage collection :)
+        std::vector<Condition*> ReferencingConditions;  ///< Conditions with a ReferenceId, linked once every template is loaded
 
         ConditionEntriesByTypeArray         ConditionStore;
         ConditionReferenceContainer         ConditionReferenceStore;
@@ -259,6 +294,9 @@ class ConditionMgr
         PhaseDefinitionConditionContainer   PhaseDefinitionsConditionStore;
 };
 
+/// Adds a compiled condition to its ElseGroup run, after the cheaper checks
+void InsertCondition(ConditionContainer& p_Conditions, Condition* p_Condition);
+
 template <class T> bool CompareValues(ComparisionType type,  T val1, T val2)
 {
     switch (type)
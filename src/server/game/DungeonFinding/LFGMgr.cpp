@@ -293,8 +293,7 @@ void LFGMgr::Update(uint32 diff)
             firstNew.push_back(frontguid);
             newToQueue.pop_front();
             uint8 alreadyInQueue = 0;
-            LfgGuidList temporalList = currentQueue;
-            if (LfgProposal* pProposal = FindNewGroups(firstNew, temporalList, LFG_CATEGORIE_DUNGEON)) // Group found!
+            if (LfgProposal* pProposal = FindNewGroups(firstNew, currentQueue, LFG_CATEGORIE_DUNGEON)) // Group found!
             {
                 // Remove groups in the proposal from new and current queues (not from queue map)
                 for (LfgGuidList::const_iterator itQueue = pProposal->queues.begin(); itQueue != pProposal->queues.end(); ++itQueue)
@@ -331,11 +330,9 @@ void LFGMgr::Update(uint32 diff)
             {
                 if (std::find(currentQueue.begin(), currentQueue.end(), frontguid) == currentQueue.end()) //already in queue?
                     ++alreadyInQueue; //currentQueue.push_back(frontguid);         // Lfg group not found, add this group to the queue.
-                temporalList = currentQueue;
-                m_CompatibleMap.clear();
             }
 
-            if (LfgProposal* pProposal = FindNewGroups(firstNew, temporalList, LFG_CATEGORIE_RAID)) // Group found!
+            if (LfgProposal* pProposal = FindNewGroups(firstNew, currentQueue, LFG_CATEGORIE_RAID)) // Group found!
             {
                 // Remove groups in the proposal from new and current queues (not from queue map)
                 for (LfgGuidList::const_iterator itQueue = pProposal->queues.begin(); itQueue != pProposal->queues.end(); ++itQueue)
@@ -372,11 +369,9 @@ void LFGMgr::Update(uint32 diff)
             {
                 if (std::find(currentQueue.begin(), currentQueue.end(), frontguid) == currentQueue.end()) //already in queue?
                     ++alreadyInQueue; //currentQueue.push_back(frontguid);         // Lfg group not found, add this group to the queue.
-                temporalList = currentQueue;
-                m_CompatibleMap.clear();
             }
 
-            if (LfgProposal* pProposal = FindNewGroups(firstNew, temporalList, LFG_CATEGORIE_SCENARIO)) // Group found!
+            if (LfgProposal* pProposal = FindNewGroups(firstNew, currentQueue, LFG_CATEGORIE_SCENARIO)) // Group found!
             {
                 // Remove groups in the proposal from new and current queues (not from queue map)
                 for (LfgGuidList::const_iterator itQueue = pProposal->queues.begin(); itQueue != pProposal->queues.end(); ++itQueue)
@@ -413,7 +408,6 @@ void LFGMgr::Update(uint32 diff)
             {
                 if (std::find(currentQueue.begin(), currentQueue.end(), frontguid) == currentQueue.end()) //already in queue?
                     ++alreadyInQueue; //currentQueue.push_back(frontguid);         // Lfg group not found, add this group to the queue.
-                temporalList = currentQueue;
             }
 
             if (LfgProposal* pProposal = CheckForSingle(firstNew)) // Group found!
@@ -453,7 +447,6 @@ void LFGMgr::Update(uint32 diff)
             {
                 if (std::find(currentQueue.begin(), currentQueue.end(), frontguid) == currentQueue.end()) //already in queue?
                     ++alreadyInQueue; 
-                temporalList = currentQueue;
             }
 
             if (alreadyInQueue == 4 && std::find(currentQueue.begin(), currentQueue.end(), frontguid) == currentQueue.end())
@@ -471,6 +464,7 @@ void LFGMgr::Update(uint32 diff)
     {
         m_QueueTimer = 0;
         currTime = time(NULL);
+        RemoveExpiredCompatibles();
         for (LfgQueueInfoMap::const_iterator itQueue = m_QueueInfoMap.begin(); itQueue != m_QueueInfoMap.end(); ++itQueue)
         {
             LfgQueueInfo* queue = itQueue->second;
@@ -1014,6 +1008,7 @@ void LFGMgr::Join(Player* player, uint8 roles, const LfgDungeonSet& selectedDung
         else
             --pqInfo->dps;
 
+        UpdateQueueMask(pqInfo);
         m_QueueInfoMap[guid] = pqInfo;
 
         // Send update to player
@@ -1125,12 +1120,15 @@ void LFGMgr::OfferContinue(Group* grp)
 
 /**
    Checks que main queue to try to form a Lfg group. Returns first match found (if any)
+   Queued entries are added greedily, in queue order, as long as the group stays compatible.
+   Entries which can't share a dungeon or would exceed the group size or a role are skipped
+   on their queue mask, without running the whole CheckCompatibility
 
    @param[in]     check List of guids trying to match with other groups
    @param[in]     all List of all other guids in main queue to match against
    @return Pointer to proposal, if match is found
 */
-LfgProposal* LFGMgr::FindNewGroups(LfgGuidList& check, LfgGuidList& all, LfgCategory p_Category)
+LfgProposal* LFGMgr::FindNewGroups(LfgGuidList& check, LfgGuidList const& all, LfgCategory p_Category)
 {
     uint8 maxGroupSize = 5;
     if (p_Category == LFG_CATEGORIE_RAID)
@@ -1138,18 +1136,105 @@ LfgProposal* LFGMgr::FindNewGroups(LfgGuidList& check, LfgGuidList& all, LfgCate
     if (p_Category == LFG_CATEGORIE_SCENARIO)
         maxGroupSize = 3;
 
+    if (check.empty() || check.size() > maxGroupSize)
+        return NULL;
+
+    // Dungeons of another category can't be shared with anyone looking for this one
+    LfgQueueInfo const* first = GetLfgQueueInfo(check.front());
+    if (first && first->category != p_Category)
+        return NULL;
+
     LfgProposal* pProposal = NULL;
-    if (check.empty() || check.size() > maxGroupSize || !CheckCompatibility(check, pProposal, p_Category))
+    if (!CheckCompatibility(check, pProposal, p_Category))
         return NULL;
 
-    // Try to match with queued groups
-    while (!pProposal && !all.empty())
+    size_t checkSize = check.size();
+
+    uint8 tanksNeeded, healersNeeded, damageNeeded;
+    GetNeededRoles(p_Category, tanksNeeded, healersNeeded, damageNeeded);
+
+    // Summary of the entries already in the group
+    uint8 numPlayers = 0;
+    uint8 onlyTanks = 0;
+    uint8 onlyHealers = 0;
+    uint8 onlyDamage = 0;
+    LfgDungeonMask dungeonMask;
+    bool hasMask = false;
+
+    auto addToGroup = [&](LfgQueueInfo const* queue) -> void
+    {
+        numPlayers  += queue->numPlayers;
+        onlyTanks   += queue->onlyTanks;
+        onlyHealers += queue->onlyHealers;
+        onlyDamage  += queue->onlyDamage;
+
+        if (!hasMask)
+            dungeonMask = queue->dungeonMask;
+        else
+        {
+            dungeonMask.resize(std::min(dungeonMask.size(), queue->dungeonMask.size()));
+            for (size_t i = 0; i < dungeonMask.size(); ++i)
+                dungeonMask[i] &= queue->dungeonMask[i];
+        }
+        hasMask = true;
+    };
+
+    for (LfgGuidList::const_iterator it = check.begin(); it != check.end(); ++it)
+    {
+        if (LfgQueueInfo const* queue = GetLfgQueueInfo(*it))
+            addToGroup(queue);
+    }
+
+    // CheckCompatibility may remove invalid entries from the queue, don't walk it directly
+    std::vector<uint64> candidates;
+    candidates.reserve(all.size());
+    for (LfgGuidList::const_iterator it = all.begin(); it != all.end(); ++it)
+    {
+        if (std::find(check.begin(), check.end(), *it) == check.end())
+            candidates.push_back(*it);
+    }
+
+    for (std::vector<uint64>::const_iterator it = candidates.begin(); it != candidates.end() && !pProposal; ++it)
     {
-        check.push_back(all.front());
-        all.pop_front();
-        pProposal = FindNewGroups(check, all, p_Category);
-        check.pop_back();
+        // Entries without queue info are left to CheckCompatibility, which removes them from the queue
+        LfgQueueInfo const* queue = GetLfgQueueInfo(*it);
+        if (queue)
+        {
+            if (queue->category != p_Category || numPlayers + queue->numPlayers > maxGroupSize)
+                continue;
+
+            if (onlyTanks + queue->onlyTanks > tanksNeeded || onlyHealers + queue->onlyHealers > healersNeeded || onlyDamage + queue->onlyDamage > damageNeeded)
+                continue;
+
+            if (hasMask)
+            {
+                bool shareDungeon = false;
+                size_t size = std::min(dungeonMask.size(), queue->dungeonMask.size());
+                for (size_t i = 0; i < size && !shareDungeon; ++i)
+                    shareDungeon = (dungeonMask[i] & queue->dungeonMask[i]) != 0;
+
+                if (!shareDungeon)
+                    continue;
+            }
+        }
+
+        check.push_back(*it);
+        if (!CheckCompatibility(check, pProposal, p_Category))
+        {
+            check.pop_back();
+            continue;
+        }
+
+        if (pProposal)
+            break;
+
+        // Keep it, the next candidates must also fit with this one
+        if (queue)
+            addToGroup(queue);
     }
+
+    // Give the list back as we got it, the next category starts from the same entry
+    check.resize(checkSize);
     return pProposal;
 }
 
@@ -1174,16 +1259,16 @@ bool LFGMgr::CheckCompatibility(LfgGuidList p_Check, LfgProposal*& p_Proposal, L
     if (IsInDebug())
         l_MaxGroupSize = 2;
 
-    std::string strGuids = ConcatenateGuids(p_Check);
-
     if (p_Check.size() > l_MaxGroupSize || p_Check.empty())
         return false;
 
     if (p_Check.size() == 1 && IS_PLAYER_GUID(p_Check.front())) // Player joining dungeon... compatible
         return true;
 
+    uint64 compatibilityKey = MakeCompatibilityKey(p_Check, p_Categorie);
+
     // Previously cached?
-    LfgAnswer answer = GetCompatibles(strGuids);
+    LfgAnswer answer = GetCompatibles(compatibilityKey);
     if (answer != LFG_ANSWER_PENDING)
         return bool(answer);
 
@@ -1194,12 +1279,14 @@ bool LFGMgr::CheckCompatibility(LfgGuidList p_Check, LfgProposal*& p_Proposal, L
         p_Check.pop_front();
 
         // Check all-but-new compatibilities (New, A, B, C, D) --> check(A, B, C, D)
-        if (!CheckCompatibility(p_Check, p_Proposal, p_Categorie))          // Group not compatible
+        bool compatibles = CheckCompatibility(p_Check, p_Proposal, p_Categorie);
+        p_Check.push_front(frontGuid);
+
+        if (!compatibles)                                  // Group not compatible
         {
-            SetCompatibles(strGuids, false);
+            SetCompatibles(compatibilityKey, p_Check, false);
             return false;
         }
-        p_Check.push_front(frontGuid);
         // all-but-new compatibles, now check with new
     }
 
@@ -1243,7 +1330,7 @@ bool LFGMgr::CheckCompatibility(LfgGuidList p_Check, LfgProposal*& p_Proposal, L
     // Do not match - groups already in a lfgDungeon or too much players
     if (numLfgGroups > 1 || numPlayers > l_MaxGroupSize)
     {
-        SetCompatibles(strGuids, false);
+        SetCompatibles(compatibilityKey, p_Check, false);
         return false;
     }
 
@@ -1270,7 +1357,7 @@ bool LFGMgr::CheckCompatibility(LfgGuidList p_Check, LfgProposal*& p_Proposal, L
     {
         Player* player = ObjectAccessor::FindPlayer(it->first);
         if (!player)
-            sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::CheckCompatibility: (%s) Warning! [" UI64FMTD "] offline! Marking as not compatibles!", strGuids.c_str(), it->first);
+            sLog->outDebug(LOG_FILTER_LFG, "LFGMgr::CheckCompatibility: (%s) Warning! [" UI64FMTD "] offline! Marking as not compatibles!", ConcatenateGuids(p_Check).c_str(), it->first);
         else
         {
             for (PlayerSet::const_iterator itPlayer = players.begin(); itPlayer != players.end() && player; ++itPlayer)
@@ -1294,7 +1381,7 @@ bool LFGMgr::CheckCompatibility(LfgGuidList p_Check, LfgProposal*& p_Proposal, L
     // otherwise check if roles are compatible
     if (players.size() != numPlayers || !CheckGroupRoles(rolesMap, p_Categorie))
     {
-        SetCompatibles(strGuids, false);
+        SetCompatibles(compatibilityKey, p_Check, false);
         return false;
     }
 
@@ -1321,48 +1408,16 @@ bool LFGMgr::CheckCompatibility(LfgGuidList p_Check, LfgProposal*& p_Proposal, L
 
     if (compatibleDungeons.empty())
     {
-        SetCompatibles(strGuids, false);
+        SetCompatibles(compatibilityKey, p_Check, false);
         return false;
     }
-    SetCompatibles(strGuids, true);
+    SetCompatibles(compatibilityKey, p_Check, true);
 
     // ----- Group is compatible, if we have MAXGROUPSIZE members then match is found
     if (numPlayers != l_MaxGroupSize)
     {
-        uint8 Tanks_Needed = LFG_TANKS_NEEDED;
-        uint8 Healers_Needed = LFG_HEALERS_NEEDED;
-        uint8 Dps_Needed = LFG_DPS_NEEDED;
-
-        switch (p_Categorie)
-        {
-            case LFG_CATEGORIE_DUNGEON:
-                Dps_Needed = 3;
-                Healers_Needed = 1;
-                Tanks_Needed = 1;
-                break;
-            case LFG_CATEGORIE_RAID:
-                Dps_Needed = 17;
-                Healers_Needed = 6;
-                Tanks_Needed = 2;
-                break;
-            case LFG_CATEGORIE_SCENARIO:
-                Dps_Needed = 1;
-                Healers_Needed = 1;
-                Tanks_Needed = 1;
-                break;
-            default:
-                Dps_Needed = 3;
-                Healers_Needed = 1;
-                Tanks_Needed = 1;
-                break;
-        }
-
-        if (IsInDebug())
-        {
-            Dps_Needed     = 1;
-            Healers_Needed = 1;
-            Tanks_Needed   = 1;
-        }
+        uint8 Tanks_Needed, Healers_Needed, Dps_Needed;
+        GetNeededRoles(p_Categorie, Tanks_Needed, Healers_Needed, Dps_Needed);
 
         for (LfgQueueInfoMap::const_iterator itQueue = pqInfoMap.begin(); itQueue != pqInfoMap.end(); ++itQueue)
         {
@@ -1568,6 +1623,7 @@ void LFGMgr::UpdateRoleCheck(uint64 gguid, uint64 guid /* = 0 */, uint8 roles /*
                 --pqInfo->dps;
         }
 
+        UpdateQueueMask(pqInfo);
         m_QueueInfoMap[gguid] = pqInfo;
         if (GetState(gguid) != LFG_STATE_NONE)
         {
@@ -1602,43 +1658,207 @@ void LFGMgr::UpdateRoleCheck(uint64 gguid, uint64 guid /* = 0 */, uint8 roles /*
 */
 void LFGMgr::RemoveFromCompatibles(uint64 guid)
 {
-    std::stringstream out;
-    out << guid;
-    std::string strGuid = out.str();
+    LfgCompatibleKeysMap::iterator itKeys = m_CompatibleKeys.find(guid);
+    if (itKeys == m_CompatibleKeys.end())
+        return;
+
+    // Keys of the other members may now point to nothing, they go away with their own guid
+    for (std::vector<uint64>::const_iterator it = itKeys->second.begin(); it != itKeys->second.end(); ++it)
+        m_CompatibleMap.erase(*it);
+
+    m_CompatibleKeys.erase(itKeys);
+}
+
+/**
+   Remove the compatibilities cached for too long, the players may have changed meanwhile
+*/
+void LFGMgr::RemoveExpiredCompatibles()
+{
+    time_t now = time(NULL);
+    for (LfgCompatibleMap::iterator it = m_CompatibleMap.begin(); it != m_CompatibleMap.end();)
+    {
+        if (it->second.expireTime <= now)
+            it = m_CompatibleMap.erase(it);
+        else
+            ++it;
+    }
 
-    for (LfgCompatibleMap::iterator itNext = m_CompatibleMap.begin(); itNext != m_CompatibleMap.end();)
+    for (LfgCompatibleKeysMap::iterator it = m_CompatibleKeys.begin(); it != m_CompatibleKeys.end();)
     {
-        LfgCompatibleMap::iterator it = itNext++;
-        if (it->first.find(strGuid) != std::string::npos)  // Found, remove it
-            m_CompatibleMap.erase(it);
+        std::vector<uint64>& keys = it->second;
+        keys.erase(std::remove_if(keys.begin(), keys.end(), [this](uint64 key) -> bool
+        {
+            return m_CompatibleMap.find(key) == m_CompatibleMap.end();
+        }), keys.end());
+
+        if (keys.empty())
+            it = m_CompatibleKeys.erase(it);
+        else
+            ++it;
     }
 }
 
 /**
    Stores the compatibility of a list of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Key of the guids, see MakeCompatibilityKey
+   @param[in]     check Guids of the key
    @param[in]     compatibles Compatibles or not
 */
-void LFGMgr::SetCompatibles(std::string const& key, bool compatibles)
+void LFGMgr::SetCompatibles(uint64 key, LfgGuidList const& check, bool compatibles)
 {
-    m_CompatibleMap[key] = LfgAnswer(compatibles);
+    std::pair<LfgCompatibleMap::iterator, bool> result = m_CompatibleMap.insert(std::make_pair(key, LfgCompatibility()));
+    result.first->second.answer = LfgAnswer(compatibles);
+    result.first->second.expireTime = time(NULL) + LFG_COMPATIBILITY_CACHE_TIME;
+
+    if (!result.second)
+        return;
+
+    for (LfgGuidList::const_iterator it = check.begin(); it != check.end(); ++it)
+        m_CompatibleKeys[*it].push_back(key);
 }
 
 /**
    Get the compatibility of a group of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Key of the guids, see MakeCompatibilityKey
    @return 1 (Compatibles), 0 (Not compatibles), -1 (Not set)
 */
-LfgAnswer LFGMgr::GetCompatibles(std::string const& key)
+LfgAnswer LFGMgr::GetCompatibles(uint64 key)
+{
+    LfgCompatibleMap::const_iterator it = m_CompatibleMap.find(key);
+    if (it == m_CompatibleMap.end() || it->second.expireTime <= time(NULL))
+        return LFG_ANSWER_PENDING;
+
+    return it->second.answer;
+}
+
+/**
+   Key of a combination of queued guids, independent of their order
+
+   @param[in]     p_Check Guids to combine
+   @param[in]     p_Category Category the guids are checked for
+   @return 64 bits hash of the category and the sorted guids
+*/
+uint64 LFGMgr::MakeCompatibilityKey(LfgGuidList const& p_Check, LfgCategory p_Category) const
+{
+    std::vector<uint64> l_Guids(p_Check.begin(), p_Check.end());
+    std::sort(l_Guids.begin(), l_Guids.end());
+
+    /// MurmurHash3 finalizer, chained over the guids
+    auto l_Mix = [](uint64 p_Value) -> uint64
+    {
+        p_Value ^= p_Value >> 33;
+        p_Value *= UI64LIT(0xFF51AFD7ED558CCD);
+        p_Value ^= p_Value >> 33;
+        p_Value *= UI64LIT(0xC4CEB9FE1A85EC53);
+        p_Value ^= p_Value >> 33;
+        return p_Value;
+    };
+
+    uint64 l_Key = l_Mix(uint64(p_Category) + 1);
+    for (uint64 l_Guid : l_Guids)
+        l_Key = l_Mix(l_Key ^ l_Mix(l_Guid));
+
+    return l_Key;
+}
+
+/**
+   Builds the matchmaking summary of a queued player or group: players able to fill a
+   single role and one bit per selected dungeon, two entries without any common bit can never
+   be grouped together
+
+   @param[in, out] p_Info Queue info to update
+*/
+void LFGMgr::UpdateQueueMask(LfgQueueInfo* p_Info)
+{
+    p_Info->numPlayers  = uint8(p_Info->roles.size());
+    p_Info->onlyTanks   = 0;
+    p_Info->onlyHealers = 0;
+    p_Info->onlyDamage  = 0;
+
+    for (LfgRolesMap::const_iterator it = p_Info->roles.begin(); it != p_Info->roles.end(); ++it)
+    {
+        switch (it->second & ~LFG_ROLEMASK_LEADER)
+        {
+            case LFG_ROLEMASK_TANK:
+                ++p_Info->onlyTanks;
+                break;
+            case LFG_ROLEMASK_HEALER:
+                ++p_Info->onlyHealers;
+                break;
+            case LFG_ROLEMASK_DAMAGE:
+                ++p_Info->onlyDamage;
+                break;
+            default:
+                break;
+        }
+    }
+
+    p_Info->dungeonMask.clear();
+    for (LfgDungeonSet::const_iterator it = p_Info->dungeons.begin(); it != p_Info->dungeons.end(); ++it)
+    {
+        uint32 bit = GetDungeonBit(*it);
+        if (p_Info->dungeonMask.size() <= bit / 64)
+            p_Info->dungeonMask.resize(bit / 64 + 1, 0);
+
+        p_Info->dungeonMask[bit / 64] |= UI64LIT(1) << (bit % 64);
+    }
+}
+
+/**
+   Dense index of a queued dungeon id, assigned the first time the dungeon is queued for
+
+   @param[in]     p_DungeonId Dungeon id, as stored in LfgQueueInfo::dungeons
+   @return Bit of the dungeon in LfgQueueInfo::dungeonMask
+*/
+uint32 LFGMgr::GetDungeonBit(uint32 p_DungeonId)
 {
-    LfgAnswer answer = LFG_ANSWER_PENDING;
-    LfgCompatibleMap::iterator it = m_CompatibleMap.find(key);
-    if (it != m_CompatibleMap.end())
-        answer = it->second;
+    std::unordered_map<uint32, uint32>::const_iterator it = m_DungeonBits.find(p_DungeonId);
+    if (it != m_DungeonBits.end())
+        return it->second;
 
-    return answer;
+    uint32 bit = uint32(m_DungeonBits.size());
+    m_DungeonBits[p_DungeonId] = bit;
+    return bit;
+}
+
+/**
+   Roles needed to complete a group of the given category
+
+   @param[in]     p_Category Category of the group
+   @param[out]    p_Tanks Tanks needed
+   @param[out]    p_Healers Healers needed
+   @param[out]    p_Damage Damage dealers needed
+*/
+void LFGMgr::GetNeededRoles(LfgCategory p_Category, uint8& p_Tanks, uint8& p_Healers, uint8& p_Damage) const
+{
+    switch (p_Category)
+    {
+        case LFG_CATEGORIE_RAID:
+            p_Damage  = 17;
+            p_Healers = 6;
+            p_Tanks   = 2;
+            break;
+        case LFG_CATEGORIE_SCENARIO:
+            p_Damage  = 1;
+            p_Healers = 1;
+            p_Tanks   = 1;
+            break;
+        case LFG_CATEGORIE_DUNGEON:
+        default:
+            p_Damage  = 3;
+            p_Healers = 1;
+            p_Tanks   = 1;
+            break;
+    }
+
+    if (IsInDebug())
+    {
+        p_Damage  = 1;
+        p_Healers = 1;
+        p_Tanks   = 1;
+    }
 }
 
 /**
@@ -1686,40 +1906,8 @@ bool LFGMgr::CheckGroupRoles(LfgRolesMap& groles, LfgCategory p_Category, bool r
     uint8 tank = 0;
     uint8 healer = 0;
 
-    uint8 dpsNeeded = 0;
-    uint8 healerNeeded = 0;
-    uint8 tankNeeded = 0;
-
-    switch (p_Category)
-    {
-        case LFG_CATEGORIE_DUNGEON:
-            dpsNeeded = 3;
-            healerNeeded = 1;
-            tankNeeded = 1;
-            break;
-        case LFG_CATEGORIE_RAID:
-            dpsNeeded = 17;
-            healerNeeded = 6;
-            tankNeeded = 2;
-            break;
-        case LFG_CATEGORIE_SCENARIO:
-            dpsNeeded = 1;
-            healerNeeded = 1;
-            tankNeeded = 1;
-            break;
-        default:
-            dpsNeeded = 3;
-            healerNeeded = 1;
-            tankNeeded = 1;
-            break;
-    }
-
-    if (IsInDebug())
-    {
-        dpsNeeded    = 1;
-        healerNeeded = 1;
-        tankNeeded   = 1;
-    }
+    uint8 dpsNeeded, healerNeeded, tankNeeded;
+    GetNeededRoles(p_Category, tankNeeded, healerNeeded, dpsNeeded);
 
     if (removeLeaderFlag)
         for (LfgRolesMap::iterator it = groles.begin(); it != groles.end(); ++it)
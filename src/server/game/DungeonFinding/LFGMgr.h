@@ -28,6 +28,7 @@ enum LFGenum
     LFG_HEALERS_NEEDED                           = 1,
     LFG_DPS_NEEDED                               = 3,
     LFG_QUEUEUPDATE_INTERVAL                     = 15*IN_MILLISECONDS,
+    LFG_COMPATIBILITY_CACHE_TIME                 = 30,     // Seconds a compatibility answer is trusted, players may log out or lose their locks meanwhile
     LFG_SPELL_DUNGEON_COOLDOWN                   = 71328,
     LFG_SPELL_DUNGEON_DESERTER                   = 71041,
     LFG_SPELL_LUCK_OF_THE_DRAW                   = 72221
@@ -178,6 +179,7 @@ struct LfgRoleCheck;
 struct LfgProposal;
 struct LfgProposalPlayer;
 struct LfgPlayerBoot;
+struct LfgCompatibility;
 class LfgPlayerData;
 
 typedef std::set<uint64> LfgGuidSet;
@@ -186,7 +188,9 @@ typedef std::map<uint8, LfgGuidList> LfgGuidListMap;
 typedef std::set<Player*> PlayerSet;
 typedef std::list<Player*> LfgPlayerList;
 typedef std::map<uint32, LfgReward const*> LfgRewardMap;
-typedef std::map<std::string, LfgAnswer> LfgCompatibleMap;
+typedef std::unordered_map<uint64, LfgCompatibility> LfgCompatibleMap;
+typedef std::unordered_map<uint64, std::vector<uint64>> LfgCompatibleKeysMap;
+typedef std::vector<uint64> LfgDungeonMask;
 typedef std::map<uint64, LfgDungeonSet> LfgDungeonMap;
 typedef std::map<uint64, uint8> LfgRolesMap;
 typedef std::map<uint64, LfgAnswer> LfgAnswerMap;
@@ -247,7 +251,8 @@ struct LfgReward
 /// Stores player or group queue info
 struct LfgQueueInfo
 {
-    LfgQueueInfo(): joinTime(0), tanks(LFG_TANKS_NEEDED), healers(LFG_HEALERS_NEEDED), dps(LFG_DPS_NEEDED), category(0) {};
+    LfgQueueInfo(): joinTime(0), tanks(LFG_TANKS_NEEDED), healers(LFG_HEALERS_NEEDED), dps(LFG_DPS_NEEDED), category(0),
+        numPlayers(0), onlyTanks(0), onlyHealers(0), onlyDamage(0) {};
     time_t joinTime;                                       ///< Player queue join time (to calculate wait times)
     uint8 tanks;                                           ///< Tanks needed
     uint8 healers;                                         ///< Healers needed
@@ -256,6 +261,20 @@ struct LfgQueueInfo
     LfgRolesMap roles;                                     ///< Selected Player Role/s
     uint8 type;
     uint8 category;
+
+    /// Matchmaking summary, built once when queued (see LFGMgr::UpdateQueueMask)
+    uint8 numPlayers;                                      ///< Players of the queued entry
+    uint8 onlyTanks;                                       ///< Players who can only tank
+    uint8 onlyHealers;                                     ///< Players who can only heal
+    uint8 onlyDamage;                                      ///< Players who can only deal damage
+    LfgDungeonMask dungeonMask;                            ///< Bit per selected dungeon, see LFGMgr::GetDungeonBit
+};
+
+/// Cached answer of CheckCompatibility
+struct LfgCompatibility
+{
+    LfgAnswer answer;
+    time_t expireTime;
 };
 
 /// Stores player data related to proposal to join
@@ -410,13 +429,18 @@ class LFGMgr
         void RemoveProposal(LfgProposalMap::iterator itProposal, LfgUpdateType type);
 
         // Group Matching
-        LfgProposal* FindNewGroups(LfgGuidList& check, LfgGuidList& all, LfgCategory type);
+        LfgProposal* FindNewGroups(LfgGuidList& check, LfgGuidList const& all, LfgCategory type);
         bool CheckGroupRoles(LfgRolesMap &groles, LfgCategory type, bool removeLeaderFlag = true);
         bool CheckCompatibility(LfgGuidList check, LfgProposal*& pProposal, LfgCategory type);
         void GetCompatibleDungeons(LfgDungeonSet& dungeons, const PlayerSet& players, LfgLockPartyMap& lockMap);
-        void SetCompatibles(std::string const& concatenatedGuids, bool compatibles);
-        LfgAnswer GetCompatibles(std::string const& concatenatedGuids);
+        void GetNeededRoles(LfgCategory p_Category, uint8& p_Tanks, uint8& p_Healers, uint8& p_Damage) const;
+        uint64 MakeCompatibilityKey(LfgGuidList const& p_Check, LfgCategory p_Category) const;
+        void SetCompatibles(uint64 key, LfgGuidList const& check, bool compatibles);
+        LfgAnswer GetCompatibles(uint64 key);
         void RemoveFromCompatibles(uint64 guid);
+        void RemoveExpiredCompatibles();
+        void UpdateQueueMask(LfgQueueInfo* p_Info);
+        uint32 GetDungeonBit(uint32 p_DungeonId);
         LfgProposal* CheckForSingle(LfgGuidList& check);
 
         // Generic
@@ -447,7 +471,9 @@ class LFGMgr
         LfgQueueInfoMap m_QueueInfoMap;                    ///< Queued groups
         LfgGuidListMap m_currentQueue;                     ///< Ordered list. Used to find groups
         LfgGuidListMap m_newToQueue;                       ///< New groups to add to queue
-        LfgCompatibleMap m_CompatibleMap;                  ///< Compatible dungeons
+        LfgCompatibleMap m_CompatibleMap;                  ///< Compatibility of checked combinations, by MakeCompatibilityKey
+        LfgCompatibleKeysMap m_CompatibleKeys;             ///< Compatibility keys involving each queued guid
+        std::unordered_map<uint32, uint32> m_DungeonBits;  ///< Dungeon id -> bit in LfgQueueInfo::dungeonMask
         LfgGuidList m_teleport;                            ///< Players being teleported
         // Rolecheck - Proposal - Vote Kicks
         LfgRoleCheckMap m_RoleChecks;                      ///< Current Role checks
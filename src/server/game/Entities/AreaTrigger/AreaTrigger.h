@@ -11,6 +11,7 @@
 
 # include "Object.h"
 # include "Timer.h"
+# include "AreaTargetTracker.h"
 
 class Unit;
 class SpellInfo;
@@ -310,6 +311,9 @@ class AreaTrigger : public WorldObject, public GridObject<AreaTrigger>
 
         void SendAreaTriggerRePath(uint32 p_TimeToTarget, uint32 p_OldTime);
 
+        /// Units inside the AreaTrigger, for scripts applying an effect on enter and removing it on leave
+        AreaTargetTracker& GetTargetTracker() { return m_TargetTracker; }
+
     protected:
         int32 m_Duration;
         Unit* m_Caster;
@@ -326,5 +330,7 @@ class AreaTrigger : public WorldObject, public GridObject<AreaTrigger>
 
         uint64 m_CreatureVisualGUID;
         std::list<Position> m_PathToLinearDestination;
+
+        AreaTargetTracker m_TargetTracker;
 };
 #endif
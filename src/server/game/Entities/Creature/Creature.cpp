@@ -42,6 +42,7 @@
 #include "MoveSpline.h"
 #include "WildBattlePet.h"
 #include "Transport.h"
+#include "TickProfiler.h"
 
 #ifndef CROSS
 # include "GarrisonNPCAI.hpp"
@@ -174,6 +175,12 @@ m_creatureInfo(NULL), m_NativeCreatureInfo(nullptr), m_creatureData(NULL), m_Cre
 
     m_MovingUpdateTimer = 0;
     m_NotMovingUpdateTimer = 0;
+
+    m_UpdateLOD           = CREATURE_UPDATE_LOD_FULL;
+    m_LODDiff             = 0;
+    m_LODPlayerCheckTimer = 0;
+    m_LODPlayerNearby     = false;
+    m_AISleeping          = false;
 }
 
 Creature::~Creature()
@@ -539,6 +546,9 @@ void Creature::Update(uint32 diff)
         _skipDiff = 0;
     }
 
+    if (!UpdateLOD(diff))
+        return;
+
     if (IsAIEnabled && TriggerJustRespawned)
     {
         TriggerJustRespawned = false;
@@ -639,13 +649,16 @@ void Creature::Update(uint32 diff)
                 IsAIEnabled = true;
             }
 
-            if (!IsInEvadeMode() && IsAIEnabled)
+            if (!IsInEvadeMode() && IsAIEnabled && !m_AISleeping)
             {
                 // do not allow the AI to be changed during update
                 m_AI_locked = true;
                 uint32 diffAI = getMSTime();
 
-                i_AI->UpdateAI(diff);
+                {
+                    TICK_PROFILE_ZONE_ARG("CreatureAI::UpdateAI", "entry", GetEntry());
+                    i_AI->UpdateAI(diff);
+                }
 
                 if ((getMSTime() - diffAI) > 10)
                     sLog->outAshran("CreatureScript [%u] take more than 10 ms to execute (%u ms)", GetEntry(), (getMSTime() - diffAI));
@@ -721,6 +734,78 @@ void Creature::Update(uint32 diff)
     sScriptMgr->OnCreatureUpdate(this, diff);
 }
 
+bool Creature::IsIdleForUpdateLOD() const
+{
+    if (m_deathState != ALIVE || isInCombat() || getVictim() || IsInEvadeMode())
+        return false;
+
+    /// Pets, summons and vehicles follow their owner or a script, bosses and dungeons are scripted around
+    if (GetCharmerOrOwnerGUID() || isSummon() || IsVehicle() || isWorldBoss() || IsDungeonBoss() || isActiveObject() || GetMap()->Instanceable())
+        return false;
+
+    if (NeedChangeAI || TriggerJustRespawned || m_NeedRespawn || !m_MovementInform.empty())
+        return false;
+
+    if (IsMoving() || IsSplineEnabled() || IsFalling() || HasUnitState(UNIT_STATE_CASTING))
+        return false;
+
+    /// Waypoints, random movement, follow... keep their timers precise
+    if (GetMotionMaster()->GetCurrentMovementGeneratorType() != IDLE_MOTION_TYPE)
+        return false;
+
+    /// Periodic triggers are mostly visuals, one tick is done per update
+    if (HasAuraType(SPELL_AURA_PERIODIC_TRIGGER_SPELL) || HasAuraType(SPELL_AURA_PERIODIC_DUMMY))
+        return false;
+
+    return true;
+}
+
+bool Creature::UpdateLOD(uint32& p_Diff)
+{
+    uint32 l_Interval = sWorld->getIntConfig(CONFIG_CREATURE_LOD_INTERVAL);
+
+    if (!l_Interval || !IsIdleForUpdateLOD())
+    {
+        /// Woken up (aggro, movement, script...), the skipped time is given back at once
+        m_UpdateLOD           = CREATURE_UPDATE_LOD_FULL;
+        m_AISleeping          = false;
+        m_LODPlayerCheckTimer = 0;
+        p_Diff               += m_LODDiff;
+        m_LODDiff             = 0;
+        return true;
+    }
+
+    /// Nothing but the AI can leave the idle state from there, an AI that does nothing out of combat is put to sleep
+    m_AISleeping = IsAIEnabled && AI() && AI()->IsSleepable();
+
+    /// Players around are only looked for at the reduced rate, aggro doesn't depend on it (MoveInLineOfSight)
+    if (m_LODPlayerCheckTimer <= p_Diff)
+    {
+        m_LODPlayerCheckTimer = l_Interval;
+        m_LODPlayerNearby     = FindNearestPlayer(sWorld->getFloatConfig(CONFIG_CREATURE_LOD_PLAYER_DISTANCE), false) != nullptr;
+    }
+    else
+        m_LODPlayerCheckTimer -= p_Diff;
+
+    if (m_LODPlayerNearby)
+    {
+        m_UpdateLOD = CREATURE_UPDATE_LOD_FULL;
+        p_Diff     += m_LODDiff;
+        m_LODDiff   = 0;
+        return true;
+    }
+
+    m_UpdateLOD  = CREATURE_UPDATE_LOD_REDUCED;
+    m_LODDiff   += p_Diff;
+
+    if (m_LODDiff < l_Interval)
+        return false;
+
+    p_Diff    = m_LODDiff;
+    m_LODDiff = 0;
+    return true;
+}
+
 void Creature::RegenerateMana()
 {
     uint32 l_CurValue = GetPower(POWER_MANA);
@@ -511,6 +511,13 @@ typedef std::map<uint32, time_t> CreatureSpellCooldowns;
 // max different by z coordinate for creature aggro reaction
 #define CREATURE_Z_ATTACK_RANGE 3
 
+/// Update level of detail, see CreatureLOD.* in worldserver.conf
+enum CreatureUpdateLOD
+{
+    CREATURE_UPDATE_LOD_FULL    = 0,                        ///< Updated on every map tick
+    CREATURE_UPDATE_LOD_REDUCED = 1                         ///< Idle without player around, updated every CreatureLOD.Interval with the accumulated diff
+};
+
 class Creature : public Unit, public GridObject<Creature>, public MapObject
 {
     public:
@@ -867,9 +874,24 @@ class Creature : public Unit, public GridObject<Creature>, public MapObject
             m_MovementInform.push_back(std::make_pair(p_Type, p_ID));
         }
 
+        CreatureUpdateLOD GetUpdateLOD() const { return m_UpdateLOD; }
+        bool IsAISleeping() const { return m_AISleeping; }
+
     private:
         void DoRespawn();
 
+        /// Nothing needs a full rate update: out of combat, not moving, not owned, not scripted around
+        bool IsIdleForUpdateLOD() const;
+        /// @p_Diff : Tick diff, replaced by the accumulated one when a reduced update happens
+        /// @return False if the creature skips this tick
+        bool UpdateLOD(uint32& p_Diff);
+
+        CreatureUpdateLOD m_UpdateLOD;
+        uint32 m_LODDiff;                                   ///< Accumulated while skipping ticks
+        uint32 m_LODPlayerCheckTimer;
+        bool m_LODPlayerNearby;
+        bool m_AISleeping;                                  ///< Idle AI doing nothing out of combat, UpdateAI isn't called
+
         bool m_NeedRespawn;
         int m_RespawnFrameDelay;
 
@@ -1754,6 +1754,31 @@ m_phaseMask(PHASEMASK_NORMAL), m_AIAnimKitId(0), m_MovementAnimKitId(0), m_Melee
     m_summonCounter = 0;
 }
 
+void WorldObject::AddToWorld()
+{
+    if (IsInWorld())
+        return;
+
+    Object::AddToWorld();
+
+    /// Map-local guid lookups, see ObjectAccessor::GetObjectInMap
+    if (Map* l_Map = FindMap())
+        l_Map->GetObjectStore().Insert(GetGUID(), this);
+}
+
+void WorldObject::RemoveFromWorld()
+{
+    if (!IsInWorld())
+        return;
+
+    DestroyForNearbyPlayers();
+
+    if (Map* l_Map = FindMap())
+        l_Map->GetObjectStore().Remove(GetGUID(), this);
+
+    Object::RemoveFromWorld();
+}
+
 void WorldObject::SetWorldObject(bool on)
 {
     if (!IsInWorld())
@@ -3146,9 +3171,7 @@ void Player::SummonPet(uint32 entry, float x, float y, float z, float ang, PetTy
             PetQueryHolder* l_PetHolder = new PetQueryHolder(p_Result->Fetch()[0].GetUInt32(), l_RealmID, p_Result);
             l_PetHolder->Initialize();
 
-            auto l_QueryHolderResultFuture = l_Database->DelayQueryHolder(l_PetHolder);
-
-            sWorld->AddQueryHolderCallback(QueryHolderCallback(l_QueryHolderResultFuture, [entry, x, y, z, ang, petType, duration, l_LoadPetSlotID, slotID, stampeded, p_Callback, l_Pet, currentPet, l_PlayerGUID](SQLQueryHolder* p_QueryHolder) -> void
+            DelayQueryHolder(*l_Database, l_PetHolder, [entry, x, y, z, ang, petType, duration, l_LoadPetSlotID, slotID, stampeded, p_Callback, l_Pet, currentPet, l_PlayerGUID](SQLQueryHolder* p_QueryHolder) -> void
             {
                 Player* l_Player = sObjectAccessor->FindPlayer(l_PlayerGUID);
                 if (!l_Player || !p_QueryHolder)
@@ -3188,7 +3211,7 @@ void Player::SummonPet(uint32 entry, float x, float y, float z, float ang, PetTy
 
                     p_Callback(p_Pet, true);
                 });
-            }));
+            });
         });
 
         return;
@@ -854,15 +854,8 @@ class WorldObject : public Object, public WorldLocation
 
         void _Create(uint32 guidlow, HighGuid guidhigh, uint32 phaseMask);
 
-        virtual void RemoveFromWorld()
-        {
-            if (!IsInWorld())
-                return;
-
-            DestroyForNearbyPlayers();
-
-            Object::RemoveFromWorld();
-        }
+        virtual void AddToWorld();
+        virtual void RemoveFromWorld();
 
         void GetNearPoint2D(float &x, float &y, float distance, float absAngle) const;
         void GetNearPoint(WorldObject const* p_Searcher, float &p_InOutX, float &p_InOutY, float &p_InOutZ, float p_SearcherSize, float p_Distance2D, float p_AbsAngle) const;
@@ -31047,39 +31047,18 @@ void Player::UpdateAchievementCriteria(AchievementCriteriaTypes p_Type, uint64 p
     if (sWorld->getBoolConfig(CONFIG_ACHIEVEMENT_DISABLE))
         return;
 
-    AchievementCriteriaUpdateTask l_Task;
-    l_Task.PlayerGUID = GetGUID();
-    l_Task.UnitGUID   = p_Unit ? p_Unit->GetGUID() : 0;
-    l_Task.Task = [p_Type, p_MiscValue1, p_MiscValue2, p_MiscValue3, p_LoginCheck](uint64 const& p_PlayerGuid, uint64 const& p_UnitGUID) -> void
-    {
-        /// Task will be executed async
-        /// We need to ensure the player still exist
-        Player* l_Player = HashMapHolder<Player>::Find(p_PlayerGuid);
-        if (l_Player == nullptr)
-            return;
-
-        /// Same for the unit
-        Unit* l_Unit = p_UnitGUID ? Unit::GetUnit(*l_Player, p_UnitGUID) : nullptr;
-
-        l_Player->GetAchievementMgr().UpdateAchievementCriteria(p_Type, p_MiscValue1, p_MiscValue2, p_MiscValue3, l_Unit, l_Player, p_LoginCheck);
-
-        // Update only individual achievement criteria here, otherwise we may get multiple updates
-        // from a single boss kill
-        if (sAchievementMgr->IsGroupCriteriaType(p_Type))
-            return;
-
-#ifndef CROSS
-        if (Guild* l_Guild = sGuildMgr->GetGuildById(l_Player->GetGuildId()))
-            l_Guild->GetAchievementMgr().UpdateAchievementCriteria(p_Type, p_MiscValue1, p_MiscValue2, p_MiscValue3, l_Unit, l_Player, p_LoginCheck);
-#else /* CROSS */
-        /// @TODO: Cross sync
-        //if (Guild* l_Guild = sGuildMgr->GetGuildById(l_Player->GetGuildId()))
-        //    l_Guild->GetAchievementMgr().UpdateAchievementCriteria(p_Type, p_MiscValue1, p_MiscValue2, p_MiscValue3, l_Unit, l_Player, p_LoginCheck);
-#endif /* CROSS */
-        
-    };
+    /// Executed async by the map updater threads, see AchievementGlobalMgr::ProcessCriteriaBatch
+    AchievementCriteriaEvent l_Event;
+    l_Event.PlayerGUID    = GetGUID();
+    l_Event.UnitGUID      = p_Unit ? p_Unit->GetGUID() : 0;
+    l_Event.MiscValues[0] = p_MiscValue1;
+    l_Event.MiscValues[1] = p_MiscValue2;
+    l_Event.MiscValues[2] = p_MiscValue3;
+    l_Event.Type          = p_Type;
+    l_Event.LoginCheck    = p_LoginCheck;
+    l_Event.PlayerOnly    = false;
 
-    sAchievementMgr->AddCriteriaUpdateTask(l_Task);
+    sAchievementMgr->AddCriteriaEvent(l_Event);
 }
 
 void Player::CompletedAchievement(AchievementEntry const* entry)
@@ -31222,9 +31201,7 @@ void Player::ResummonPetTemporaryUnSummonedIfAny()
         PetQueryHolder* l_PetHolder = new PetQueryHolder(p_Result->Fetch()[0].GetUInt32(), l_RealmID, p_Result);
         l_PetHolder->Initialize();
 
-        auto l_QueryHolderResultFuture = l_Database->DelayQueryHolder(l_PetHolder);
-
-        sWorld->AddQueryHolderCallback(QueryHolderCallback(l_QueryHolderResultFuture, [l_NewPet, l_PlayerGUID, l_PetNumber](SQLQueryHolder* p_QueryHolder) -> void
+        DelayQueryHolder(*l_Database, l_PetHolder, [l_NewPet, l_PlayerGUID, l_PetNumber](SQLQueryHolder* p_QueryHolder) -> void
         {
             Player* l_Player = sObjectAccessor->FindPlayer(l_PlayerGUID);
             if (!l_Player || !p_QueryHolder || l_Player != l_NewPet->GetOwner())
@@ -31248,7 +31225,7 @@ void Player::ResummonPetTemporaryUnSummonedIfAny()
                 if (l_Player->HasSpell(109212) && !l_Player->HasAura(118694))
                     l_Player->CastSpell(l_Player, 118694, true);
             });
-        }));
+        });
     });
 
     m_temporaryUnsummonedPetNumber = 0;
@@ -59,6 +59,7 @@
 #include "Guild.h"
 #endif /* not CROSS */
 #include "DB2Stores.h"
+#include "TickProfiler.h"
 #ifndef CROSS
 #include "../../Garrison/GarrisonMgr.hpp"
 #include "../../../scripts/Draenor/Garrison/GarrisonScriptData.hpp"
@@ -376,6 +377,8 @@ Unit::~Unit()
 
 void Unit::Update(uint32 p_time)
 {
+    TICK_PROFILE_ZONE_ARG("Unit::Update", "entry", GetEntry());
+
     // WARNING! Order of execution here is important, do not change.
     // Spells must be processed with event system BEFORE they go to _UpdateSpells.
     // Or else we may have some SPELL_STATE_FINISHED spells stalled in pointers, that is bad.
@@ -3429,6 +3432,8 @@ void Unit::_DeleteRemovedAuras()
 
 void Unit::_UpdateSpells(uint32 time)
 {
+    TICK_PROFILE_ZONE_ARG("Unit::UpdateSpells", "entry", GetEntry());
+
     if (m_currentSpells[CURRENT_AUTOREPEAT_SPELL])
         _UpdateAutoRepeatSpell();
 
@@ -115,6 +115,14 @@ Object* ObjectAccessor::GetObjectByTypeMask(WorldObject const& p, uint64 guid, u
     return NULL;
 }
 
+WorldObject* ObjectAccessor::FindInMapStore(uint64 guid, Map* map)
+{
+    if (!map)
+        return NULL;
+
+    return map->GetObjectStore().Find(guid);
+}
+
 Corpse* ObjectAccessor::GetCorpse(WorldObject const& u, uint64 guid)
 {
     return GetObjectInMap(guid, u.GetMap(), (Corpse*)NULL);
@@ -488,6 +496,7 @@ void ObjectAccessor::UnloadAll()
 
 template <class T> std::unordered_map< uint64, T* > HashMapHolder<T>::m_objectMap;
 template <class T> typename HashMapHolder<T>::LockType HashMapHolder<T>::i_lock;
+template <class T> MS::Utilities::ConcurrentGuidMap<T> HashMapHolder<T>::m_index(1024);
 
 /// Global definitions for the hashmap storage
 
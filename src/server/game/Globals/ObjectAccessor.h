@@ -16,6 +16,7 @@
 #include "Object.h"
 #include "Player.h"
 #include "Transport.h"
+#include "ConcurrentGuidMap.hpp"
 
 class Creature;
 class Corpse;
@@ -28,6 +29,9 @@ class Map;
 class WorldRunnable;
 class Transport;
 
+/// Global registry of one object type.
+/// Lookups go through a lock-free index and never block, the map and its lock are only kept
+/// for the callers iterating over every object of the type.
 template <class T>
 class HashMapHolder
 {
@@ -40,19 +44,19 @@ class HashMapHolder
         {
             TRINITY_WRITE_GUARD(LockType, i_lock);
             m_objectMap[o->GetGUID()] = o;
+            m_index.Insert(o->GetGUID(), o);
         }
 
         static void Remove(T* o)
         {
             TRINITY_WRITE_GUARD(LockType, i_lock);
             m_objectMap.erase(o->GetGUID());
+            m_index.Remove(o->GetGUID());
         }
 
         static T* Find(uint64 guid)
         {
-            TRINITY_READ_GUARD(LockType, i_lock);
-            typename MapType::iterator itr = m_objectMap.find(guid);
-            return (itr != m_objectMap.end()) ? itr->second : NULL;
+            return m_index.Find(guid);
         }
 
         static MapType& GetContainer() { return m_objectMap; }
@@ -66,6 +70,7 @@ class HashMapHolder
 
         static LockType i_lock;
         static MapType  m_objectMap;
+        static MS::Utilities::ConcurrentGuidMap<T> m_index;
 };
 
 class ObjectAccessor
@@ -143,12 +148,29 @@ class ObjectAccessor
         // returns object if is in map
         template<class T> static T* GetObjectInMap(uint64 guid, Map* map, T* /*typeSpecifier*/)
         {
+            /// Objects added to the world are indexed by their map, no need to go through the global registry
+            if (IsStoredInMap(guid, (T*)NULL))
+                return static_cast<T*>(FindInMapStore(guid, map));
+
             if (T * obj = GetObjectInWorld(guid, (T*)NULL))
                 if (obj->GetMap() == map)
                     return obj;
             return NULL;
         }
 
+        // whether GetObjectInMap can resolve the guid with the map store, it only holds objects of the right type for these guids
+        template<class T> static bool IsStoredInMap(uint64 /*guid*/, T* /*typeSpecifier*/) { return false; }
+        static bool IsStoredInMap(uint64 guid, Player* /*typeSpecifier*/)        { return IS_PLAYER_GUID(guid); }
+        static bool IsStoredInMap(uint64 guid, Pet* /*typeSpecifier*/)           { return IS_PET_GUID(guid); }
+        static bool IsStoredInMap(uint64 guid, Creature* /*typeSpecifier*/)      { return IS_CRE_OR_VEH_GUID(guid); }
+        static bool IsStoredInMap(uint64 guid, Unit* /*typeSpecifier*/)          { return IS_UNIT_GUID(guid); }
+        static bool IsStoredInMap(uint64 guid, GameObject* /*typeSpecifier*/)    { return IS_GAMEOBJECT_GUID(guid) || IS_TRANSPORT(guid) || IS_MO_TRANSPORT(guid); }
+        static bool IsStoredInMap(uint64 guid, DynamicObject* /*typeSpecifier*/) { return IS_DYNAMICOBJECT_GUID(guid); }
+        static bool IsStoredInMap(uint64 guid, AreaTrigger* /*typeSpecifier*/)   { return IS_AREATRIGGER(guid); }
+        static bool IsStoredInMap(uint64 guid, Conversation* /*typeSpecifier*/)  { return GUID_HIPART(guid) == HIGHGUID_CONVERSATION; }
+
+        static WorldObject* FindInMapStore(uint64 guid, Map* map);
+
         template<class T> static T* GetObjectInWorld(uint32 mapid, float x, float y, uint64 guid, T* /*fake*/)
         {
             T* obj = HashMapHolder<T>::Find(guid);
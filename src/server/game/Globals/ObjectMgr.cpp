@@ -1618,7 +1618,8 @@ void ObjectMgr::LoadCreatures()
         l_Query += l_TempQueryEnding;
     }
 
-    QueryResult result = WorldDatabase.Query(l_Query.c_str());
+    /// Biggest table loaded at startup, streamed instead of buffered
+    QueryResult result = WorldDatabase.StreamQuery(l_Query.c_str());
 
     if (!result)
     {
@@ -1765,6 +1766,13 @@ void ObjectMgr::LoadCreatures()
     }
     while (result->NextRow());
 
+    if (result->IsIncomplete())
+    {
+        sLog->outError(LOG_FILTER_SERVER_LOADING, ">> Table `creature` could not be read entirely, shutting down server.");
+        World::StopNow(ERROR_EXIT_CODE);
+        return;
+    }
+
     sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Loaded %u creatures in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -1975,7 +1983,7 @@ void ObjectMgr::LoadGameobjects()
         l_Query += l_TempQueryEnding;
     }
 
-    QueryResult result = WorldDatabase.Query(l_Query.c_str());
+    QueryResult result = WorldDatabase.StreamQuery(l_Query.c_str());
 
     if (!result)
     {
@@ -2115,6 +2123,13 @@ void ObjectMgr::LoadGameobjects()
     }
     while (result->NextRow());
 
+    if (result->IsIncomplete())
+    {
+        sLog->outError(LOG_FILTER_SERVER_LOADING, ">> Table `gameobject` could not be read entirely, shutting down server.");
+        World::StopNow(ERROR_EXIT_CODE);
+        return;
+    }
+
     sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Loaded %lu gameobjects in %u ms", (unsigned long)_gameObjectDataStore.size(), GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -4107,7 +4122,7 @@ void ObjectMgr::LoadQuests()
 
     mExclusiveQuestGroups.clear();
 
-    QueryResult result = WorldDatabase.Query("SELECT "
+    QueryResult result = WorldDatabase.StreamQuery("SELECT "
         "Id, Method, Level, MinLevel, MaxLevel, PackageID, ZoneOrSort, Type, SuggestedPlayers, LimitTime, RequiredTeam, RequiredClasses, RequiredRaces, RequiredSkillId, RequiredSkillPoints, "
         "RequiredMinRepFaction, RequiredMaxRepFaction, RequiredMinRepValue, RequiredMaxRepValue, "
         "PrevQuestId, NextQuestId, ExclusiveGroup, NextQuestIdChain, RewardXPId, RewardMoney, RewardMoneyMaxLevel, RewardSpell, RewardSpellCast, RewardHonor, RewardHonorMultiplier, "
@@ -4143,6 +4158,13 @@ void ObjectMgr::LoadQuests()
     }
     while (result->NextRow());
 
+    if (result->IsIncomplete())
+    {
+        sLog->outError(LOG_FILTER_SERVER_LOADING, ">> Table `quest_template` could not be read entirely, shutting down server.");
+        World::StopNow(ERROR_EXIT_CODE);
+        return;
+    }
+
     std::map<uint32, uint32> usedMailTemplates;
 
     std::list<uint32> l_QuestToRemove;
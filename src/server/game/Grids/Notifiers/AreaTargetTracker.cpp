@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AreaTargetTracker.h"
+#include "CellImpl.h"
+#include "GridNotifiers.h"
+#include "Unit.h"
+
+namespace
+{
+    /// Hands every unit of the visited cells in the phase of the area to the tracker
+    struct AreaTargetVisitor
+    {
+        AreaTargetTracker& i_tracker;
+        uint32 i_phaseMask;
+
+        AreaTargetVisitor(AreaTargetTracker& tracker, WorldObject const* center)
+            : i_tracker(tracker), i_phaseMask(center->GetPhaseMask()) {}
+
+        void Visit(PlayerMapType& m)
+        {
+            for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+                if (itr->getSource()->InSamePhase(i_phaseMask))
+                    i_tracker.VisitUnit(itr->getSource());
+        }
+
+        void Visit(CreatureMapType& m)
+        {
+            for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+                if (itr->getSource()->InSamePhase(i_phaseMask))
+                    i_tracker.VisitUnit(itr->getSource());
+        }
+
+        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+    };
+}
+
+AreaTargetTracker::AreaTargetTracker()
+    : m_Pass(0), m_Center(nullptr), m_Radius(0.0f), m_Check(nullptr)
+{
+}
+
+void AreaTargetTracker::Clear()
+{
+    m_Entered.clear();
+    m_Left.clear();
+
+    for (TrackedUnitMap::const_iterator l_Itr = m_Units.begin(); l_Itr != m_Units.end(); ++l_Itr)
+    {
+        if (l_Itr->second.Inside)
+            m_Left.push_back(l_Itr->first);
+    }
+
+    m_Units.clear();
+}
+
+void AreaTargetTracker::UpdateTargets(WorldObject const* p_Center, float p_Radius, Check const& p_Check)
+{
+    m_Entered.clear();
+    m_Left.clear();
+
+    /// 0 is the pass of the units never tested
+    if (!++m_Pass)
+        m_Pass = 1;
+
+    m_Center = p_Center;
+    m_Radius = p_Radius;
+    m_Check  = &p_Check;
+
+    AreaTargetVisitor l_Visitor(*this, p_Center);
+    p_Center->VisitNearbyObject(p_Radius, l_Visitor);
+
+    m_Center = nullptr;
+    m_Check  = nullptr;
+
+    /// Units not found in range anymore left the area, the phase or the map
+    for (TrackedUnitMap::iterator l_Itr = m_Units.begin(); l_Itr != m_Units.end();)
+    {
+        if (l_Itr->second.Pass == m_Pass)
+        {
+            ++l_Itr;
+            continue;
+        }
+
+        if (l_Itr->second.Inside)
+            m_Left.push_back(l_Itr->first);
+
+        l_Itr = m_Units.erase(l_Itr);
+    }
+}
+
+void AreaTargetTracker::VisitUnit(Unit* p_Unit)
+{
+    /// Out of range units are never stored, the ones inside are reported as left by UpdateTargets()
+    if (!m_Center->IsWithinDist(p_Unit, m_Radius))
+        return;
+
+    TrackedUnit& l_Tracked = m_Units[p_Unit->GetGUID()];
+    l_Tracked.Target = p_Unit;
+    l_Tracked.Pass   = m_Pass;
+
+    /// Checked on every pass, the state (alive, hostile, immune...) may change without moving
+    bool l_Inside = (*m_Check)(p_Unit);
+    if (l_Inside == l_Tracked.Inside)
+        return;
+
+    l_Tracked.Inside = l_Inside;
+
+    if (l_Inside)
+        m_Entered.push_back(p_Unit);
+    else
+        m_Left.push_back(p_Unit->GetGUID());
+}
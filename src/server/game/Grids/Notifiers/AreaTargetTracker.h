@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TRINITY_AREATARGETTRACKER_H
+#define TRINITY_AREATARGETTRACKER_H
+
+#include "Common.h"
+
+class Unit;
+class WorldObject;
+
+/// Units inside an area effect (AreaTrigger...), kept from one pass to the next
+/// - The units are found with a single visit of the cells covered by the area
+/// - Only the units in range are stored, the others cost one distance test as with a searcher
+/// - Entering and leaving units are reported against the previous pass, no target list is rebuilt
+class AreaTargetTracker
+{
+    public:
+        typedef std::function<bool(Unit*)> Check;
+
+        AreaTargetTracker();
+
+        /// Tests the units around p_Center, p_Check is only called for the ones within p_Radius
+        template<class CHECK> void Update(WorldObject const* p_Center, float p_Radius, CHECK& p_Check)
+        {
+            UpdateTargets(p_Center, p_Radius, [&p_Check](Unit* p_Unit) -> bool { return p_Check(p_Unit); });
+        }
+
+        /// Forgets every unit, the ones inside are reported in GetLeft()
+        void Clear();
+
+        /// Result of the last Update() or Clear()
+        std::vector<Unit*> const& GetEntered() const { return m_Entered; }
+        std::vector<uint64> const& GetLeft() const { return m_Left; }
+
+        /// Units inside after the last Update(), the pointers can't be kept after it
+        template<class WORKER> void ForEachInside(WORKER p_Worker) const
+        {
+            for (TrackedUnitMap::const_iterator l_Itr = m_Units.begin(); l_Itr != m_Units.end(); ++l_Itr)
+            {
+                if (l_Itr->second.Inside)
+                    p_Worker(l_Itr->second.Target);
+            }
+        }
+
+        /// Called by the cell visit of Update() for every unit in the phase of the area
+        void VisitUnit(Unit* p_Unit);
+
+    private:
+        struct TrackedUnit
+        {
+            TrackedUnit() : Target(nullptr), Pass(0), Inside(false) { }
+
+            Unit*   Target;
+            uint32  Pass;                                   ///< Last pass the unit was found in range
+            bool    Inside;                                 ///< In range and passed the check
+        };
+
+        typedef std::unordered_map<uint64, TrackedUnit> TrackedUnitMap;
+
+        void UpdateTargets(WorldObject const* p_Center, float p_Radius, Check const& p_Check);
+
+        TrackedUnitMap      m_Units;
+        std::vector<Unit*>  m_Entered;
+        std::vector<uint64> m_Left;
+        uint32              m_Pass;
+
+        /// Only set during UpdateTargets()
+        WorldObject const*  m_Center;
+        float               m_Radius;
+        Check const*        m_Check;
+};
+
+#endif
@@ -12,6 +12,7 @@
 #include "GuildMgr.h"
 #include "GuildFinderMgr.h"
 #include "ScriptMgr.h"
+#include "SharedWorldPacket.h"
 #include "Chat.h"
 #include "Config.h"
 #include "SocialMgr.h"
@@ -2636,13 +2637,14 @@ void Guild::BroadcastToGuild(WorldSession* session, bool officerOnly, const std:
     {
         WorldPacket data;
         ChatHandler::FillMessageData(&data, session, officerOnly ? CHAT_MSG_OFFICER : CHAT_MSG_GUILD, language, NULL, 0, msg.c_str(), NULL);
+        SharedWorldPacket packet(data);
         for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
         {
             if (Player* player = itr->second->FindPlayer())
             {
                 if (player->GetSession() && _HasRankRight(player, officerOnly ? GR_RIGHT_OFFCHATLISTEN : GR_RIGHT_GCHATLISTEN) &&
                     !player->GetSocial()->HasIgnore(session->GetPlayer()->GetGUIDLow()))
-                    player->GetSession()->SendPacket(&data);
+                    player->GetSession()->SendPacket(packet);
             }
            else if (Player* player = ObjectAccessor::FindPlayerInOrOutOfWorld(itr->second->GetGUID()))
            {
@@ -2663,28 +2665,31 @@ void Guild::BroadcastAddonToGuild(WorldSession* session, bool officerOnly, const
     {
         WorldPacket data;
         ChatHandler::FillMessageData(&data, session, officerOnly ? CHAT_MSG_OFFICER : CHAT_MSG_GUILD, CHAT_MSG_ADDON, NULL, 0, msg.c_str(), NULL, prefix.c_str());
+        SharedWorldPacket packet(data);
         for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
             if (Player* player = itr->second->FindPlayer())
                 if (player->GetSession() && _HasRankRight(player, officerOnly ? GR_RIGHT_OFFCHATLISTEN : GR_RIGHT_GCHATLISTEN) &&
                     !player->GetSocial()->HasIgnore(session->GetPlayer()->GetGUIDLow()) &&
                     player->GetSession()->IsAddonRegistered(prefix))
-                        player->GetSession()->SendPacket(&data);
+                        player->GetSession()->SendPacket(packet);
     }
 }
 
 void Guild::BroadcastPacketToRank(WorldPacket* packet, uint8 rankId) const
 {
+    SharedWorldPacket shared(*packet);
     for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
         if (itr->second->IsRank(rankId))
             if (Player* player = itr->second->FindPlayer())
-                player->GetSession()->SendPacket(packet);
+                player->GetSession()->SendPacket(shared);
 }
 
 void Guild::BroadcastPacket(WorldPacket* packet) const
 {
+    SharedWorldPacket shared(*packet);
     for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
         if (Player* player = itr->second->FindPlayer())
-            player->GetSession()->SendPacket(packet);
+            player->GetSession()->SendPacket(shared);
 }
 
 void Guild::MassInviteToEvent(WorldSession* /*p_Session*/, uint32 /*p_MinLevel*/, uint32 /*p_MaxLevel*/, uint32 /*p_MinRank*/)
@@ -415,7 +415,7 @@ void WorldSession::HandleCharEnumOpcode(WorldPacket& /*recvData*/)
     stmt->setUInt8(0, PetSlot::PET_SLOT_ACTUAL_PET_SLOT);
     stmt->setUInt32(1, GetAccountId());
 
-    m_CharEnumCallback = CharacterDatabase.AsyncQuery(stmt);
+    CharacterDatabase.AsyncQuery(stmt, std::bind(&WorldSession::HandleCharEnum, this, std::placeholders::_1), m_QueryCallbackQueue);
 }
 
 void WorldSession::HandleCharCreateOpcode(WorldPacket& p_RecvData)
@@ -1583,7 +1583,7 @@ void WorldSession::HandleChangePlayerNameOpcodeCallBack(PreparedQueryResult resu
     stmt->setString(1, oldName);
     stmt->setString(2, newName);
 
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.Execute(stmt, SQL_PRIORITY_LOW);
 
     sLog->outInfo(LOG_FILTER_CHARACTER, "Account: %d (IP: %s) Character:[%s] (guid:%u) Changed name to: %s", GetAccountId(), GetRemoteAddress().c_str(), oldName.c_str(), guidLow, newName.c_str());
 
@@ -676,7 +676,7 @@ void WorldSession::HandleAddFriendOpcode(WorldPacket& p_RecvData)
     l_Stmt->setString(0, l_FriendName);
 
     _addFriendCallback.SetParam(l_FriendNote);
-    _addFriendCallback.SetFutureResult(SessionRealmDatabase.AsyncQuery(l_Stmt));
+    _addFriendCallback.SetFutureResult(SessionRealmDatabase.AsyncQuery(l_Stmt, SQL_PRIORITY_HIGH));
 }
 
 void WorldSession::HandleAddFriendOpcodeCallBack(PreparedQueryResult result, std::string friendNote)
@@ -778,7 +778,7 @@ void WorldSession::HandleAddIgnoreOpcode(WorldPacket& p_RecvData)
 
     l_Stmt->setString(0, l_IgnoreName);
 
-    m_AddIgnoreCallback = SessionRealmDatabase.AsyncQuery(l_Stmt);
+    SessionRealmDatabase.AsyncQuery(l_Stmt, std::bind(&WorldSession::HandleAddIgnoreOpcodeCallBack, this, std::placeholders::_1), m_QueryCallbackQueue, SQL_PRIORITY_HIGH);
 }
 
 void WorldSession::HandleAddIgnoreOpcodeCallBack(PreparedQueryResult result)
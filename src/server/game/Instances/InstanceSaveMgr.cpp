@@ -119,6 +119,7 @@ InstanceSave* InstanceSaveManager::AddInstanceSave(uint32 mapId, uint32 instance
         save->SaveToDB();
 
     m_instanceSaveById[instanceId] = save;
+    m_instanceIdsByMapDifficulty[MAKE_PAIR32(mapId, difficulty)].insert(instanceId);
     return save;
 }
 
@@ -131,7 +132,12 @@ InstanceSave* InstanceSaveManager::GetInstanceSave(uint32 InstanceId)
 void InstanceSaveManager::DeleteInstanceFromDB(uint32 instanceid)
 {
     SQLTransaction l_Transaction = CharacterDatabase.BeginTransaction();
+    DeleteInstanceFromDB(instanceid, l_Transaction);
+    CharacterDatabase.CommitTransaction(l_Transaction);
+}
 
+void InstanceSaveManager::DeleteInstanceFromDB(uint32 instanceid, SQLTransaction& l_Transaction)
+{
     std::ostringstream l_Query;
     std::string l_StringQuery;
 
@@ -148,8 +154,6 @@ void InstanceSaveManager::DeleteInstanceFromDB(uint32 instanceid)
     l_Query << "DELETE FROM group_instance WHERE instance = " << instanceid;
     l_StringQuery = l_Query.str();
     l_Transaction->Append(l_StringQuery.c_str());
-
-    CharacterDatabase.CommitTransaction(l_Transaction);
 }
 
 void InstanceSaveManager::RemoveInstanceSave(uint32 InstanceId)
@@ -162,6 +166,7 @@ void InstanceSaveManager::RemoveInstanceSave(uint32 InstanceId)
             CharacterDatabase.PExecute("UPDATE instance SET resettime = '%u' WHERE id = '%u'", uint32(resettime), InstanceId);
 
         itr->second->SetToDelete(true);
+        m_instanceIdsByMapDifficulty[MAKE_PAIR32(itr->second->GetMapId(), itr->second->GetDifficultyID())].erase(InstanceId);
         m_instanceSaveById.erase(itr);
     }
 }
@@ -303,10 +308,6 @@ void InstanceSaveManager::LoadResetTimes()
     typedef std::map<uint32, ResetTimeMapDiffType> InstResetTimeMapDiffType;
     InstResetTimeMapDiffType instResetTime;
 
-    // index instance ids by map/difficulty pairs for fast reset warning send
-    typedef std::multimap<uint32 /*PAIR32(map, difficulty)*/, uint32 /*instanceid*/ > ResetTimeMapDiffInstances;
-    ResetTimeMapDiffInstances mapDiffResetInstances;
-
     QueryResult result = CharacterDatabase.Query("SELECT id, map, difficulty, resettime FROM instance ORDER BY id ASC");
     if (result)
     {
@@ -347,7 +348,6 @@ void InstanceSaveManager::LoadResetTimes()
                 }
 
                 instResetTime[instanceId] = ResetTimeMapDiffType(MAKE_PAIR32(mapid, difficulty), resettime);
-                mapDiffResetInstances.insert(ResetTimeMapDiffInstances::value_type(MAKE_PAIR32(mapid, difficulty), instanceId));
             }
         }
         while (result->NextRow());
@@ -407,8 +407,6 @@ void InstanceSaveManager::LoadResetTimes()
         while (result->NextRow());
     }
 
-    ResetTimeMapDiffInstances::const_iterator in_itr;
-
     // calculate new global reset times for expired instances and those that have never been reset yet
     // add the global reset times to the priority queue
     for (auto& mapDifficultyPair : sMapDifficultyMap)
@@ -452,10 +450,8 @@ void InstanceSaveManager::LoadResetTimes()
             if (t - ResetTimeDelay[type - 1] > now)
                 break;
 
+            // a single event per map/difficulty, the global reset goes through all its instances anyway
             ScheduleReset(true, t - ResetTimeDelay[type - 1], InstResetEvent(type, mapid, difficulty, 0));
-
-            for (in_itr = mapDiffResetInstances.lower_bound(mapDifficultyPair.first); in_itr != mapDiffResetInstances.upper_bound(mapDifficultyPair.first); ++in_itr)
-                ScheduleReset(true, t - ResetTimeDelay[type - 1], InstResetEvent(type, mapid, difficulty, in_itr->second));
         }
     }
 }
@@ -502,24 +498,30 @@ void InstanceSaveManager::Update()
     time_t now = time(NULL);
     time_t t;
 
+    // all the DB cleanup of the due resets goes in a single async transaction
+    SQLTransaction trans;
+
     while (!m_resetTimeQueue.empty())
     {
         t = m_resetTimeQueue.begin()->first;
         if (t >= now)
             break;
 
+        if (!trans)
+            trans = CharacterDatabase.BeginTransaction();
+
         InstResetEvent &event = m_resetTimeQueue.begin()->second;
         if (event.type == 0)
         {
             // for individual normal instances, max creature respawn + X hours
-            _ResetInstance(event.mapid, event.instanceId);
+            _ResetInstance(event.mapid, event.instanceId, trans);
             m_resetTimeQueue.erase(m_resetTimeQueue.begin());
         }
         else
         {
             // global reset/warning for a certain map
             time_t resetTime = GetResetTimeFor(event.mapid, event.difficulty);
-            _ResetOrWarnAll(event.mapid, event.difficulty, event.type != 4, resetTime);
+            _ResetOrWarnAll(event.mapid, event.difficulty, event.type != 4, resetTime, trans);
             if (event.type != 4)
             {
                 // schedule the next warning/reset
@@ -529,6 +531,26 @@ void InstanceSaveManager::Update()
             m_resetTimeQueue.erase(m_resetTimeQueue.begin());
         }
     }
+
+    if (trans && trans->GetSize())
+        CharacterDatabase.CommitTransaction(trans);
+
+    _SendResetWarnings();
+}
+
+void InstanceSaveManager::_SendResetWarnings()
+{
+    for (uint32 i = 0; i < INSTANCE_RESET_WARNINGS_PER_UPDATE && !m_resetWarnings.empty(); ++i)
+    {
+        ResetWarning const& warning = m_resetWarnings.front();
+
+        // the map may have been unloaded since the warning was queued
+        Map* map = sMapMgr->FindMap(warning.mapid, warning.instanceId);
+        if (map && map->IsDungeon())
+            ((InstanceMap*)map)->SendResetWarnings(warning.timeLeft);
+
+        m_resetWarnings.pop_front();
+    }
 }
 
 void InstanceSaveManager::_ResetSave(InstanceSaveHashMap::iterator &itr)
@@ -563,13 +585,15 @@ void InstanceSaveManager::_ResetSave(InstanceSaveHashMap::iterator &itr)
         ++l_Counter;
     }
 
+    m_instanceIdsByMapDifficulty[MAKE_PAIR32(itr->second->GetMapId(), itr->second->GetDifficultyID())].erase(itr->first);
+
     delete itr->second;
     m_instanceSaveById.erase(itr++);
 
     lock_instLists = false;
 }
 
-void InstanceSaveManager::_ResetInstance(uint32 mapid, uint32 instanceId)
+void InstanceSaveManager::_ResetInstance(uint32 mapid, uint32 instanceId, SQLTransaction& trans)
 {
     sLog->outDebug(LOG_FILTER_MAPS, "InstanceSaveMgr::_ResetInstance %u, %u", mapid, instanceId);
     Map const* map = sMapMgr->CreateBaseMap(mapid);
@@ -580,7 +604,7 @@ void InstanceSaveManager::_ResetInstance(uint32 mapid, uint32 instanceId)
     if (itr != m_instanceSaveById.end())
         _ResetSave(itr);
 
-    DeleteInstanceFromDB(instanceId);                       // even if save not loaded
+    DeleteInstanceFromDB(instanceId, trans);                // even if save not loaded
 
     Map* iMap = ((MapInstanced*)map)->FindInstanceMap(instanceId);
 
@@ -590,13 +614,13 @@ void InstanceSaveManager::_ResetInstance(uint32 mapid, uint32 instanceId)
     if (iMap)
         iMap->DeleteRespawnTimes();
     else
-        Map::DeleteRespawnTimesInDB(mapid, instanceId);
+        Map::DeleteRespawnTimesInDB(mapid, instanceId, trans);
 
     // Free up the instance id and allow it to be reused
     sMapMgr->FreeInstanceId(instanceId);
 }
 
-void InstanceSaveManager::_ResetOrWarnAll(uint32 mapid, Difficulty difficulty, bool warn, time_t resetTime)
+void InstanceSaveManager::_ResetOrWarnAll(uint32 mapid, Difficulty difficulty, bool warn, time_t resetTime, SQLTransaction& trans)
 {
     // global reset for all instances of the given map
     MapEntry const* mapEntry = sMapStore.LookupEntry(mapid);
@@ -614,19 +638,26 @@ void InstanceSaveManager::_ResetOrWarnAll(uint32 mapid, Difficulty difficulty, b
             return;
         }
 
-        // remove all binds to instances of the given map
-        for (InstanceSaveHashMap::iterator itr = m_instanceSaveById.begin(); itr != m_instanceSaveById.end();)
+        // remove all binds to instances of the given map, only its own saves are looked at
+        InstanceIdsByMapDifficultyMap::iterator ids = m_instanceIdsByMapDifficulty.find(MAKE_PAIR32(mapid, difficulty));
+        if (ids != m_instanceIdsByMapDifficulty.end())
         {
-            if (itr->second->GetMapId() == mapid && itr->second->GetDifficultyID() == difficulty)
-                _ResetSave(itr);
-            else
-                ++itr;
+            std::unordered_set<uint32> instanceIds;
+            instanceIds.swap(ids->second);
+            m_instanceIdsByMapDifficulty.erase(ids);
+
+            for (std::unordered_set<uint32>::const_iterator id = instanceIds.begin(); id != instanceIds.end(); ++id)
+            {
+                InstanceSaveHashMap::iterator itr = m_instanceSaveById.find(*id);
+                if (itr != m_instanceSaveById.end())
+                    _ResetSave(itr);
+            }
         }
 
         // delete them from the DB, even if not loaded
-        CharacterDatabase.PExecute("DELETE FROM character_instance USING character_instance LEFT JOIN instance ON character_instance.instance = id WHERE map = '%u' AND difficulty = '%u'", uint16(mapid), uint8(difficulty));
-        CharacterDatabase.PExecute("DELETE FROM group_instance USING group_instance LEFT JOIN instance on group_instance.instance = id WHERE map = '%u' AND difficulty = '%u'", uint16(mapid), uint8(difficulty));
-        CharacterDatabase.PExecute("DELETE FROM instance WHERE map = '%u' AND difficulty = '%u'", uint16(mapid), uint8(difficulty));
+        trans->PAppend("DELETE FROM character_instance USING character_instance LEFT JOIN instance ON character_instance.instance = id WHERE map = '%u' AND difficulty = '%u'", uint16(mapid), uint8(difficulty));
+        trans->PAppend("DELETE FROM group_instance USING group_instance LEFT JOIN instance on group_instance.instance = id WHERE map = '%u' AND difficulty = '%u'", uint16(mapid), uint8(difficulty));
+        trans->PAppend("DELETE FROM instance WHERE map = '%u' AND difficulty = '%u'", uint16(mapid), uint8(difficulty));
 
         // calculate the next reset time
         uint32 diff = sWorld->getIntConfig(CONFIG_INSTANCE_RESET_TIME_HOUR) * HOUR;
@@ -641,7 +672,7 @@ void InstanceSaveManager::_ResetOrWarnAll(uint32 mapid, Difficulty difficulty, b
         ScheduleReset(true, time_t(next_reset-3600), InstResetEvent(1, mapid, difficulty, 0));
 
         // Update it in the DB
-        CharacterDatabase.PExecute("UPDATE instance_reset SET resettime = '%u' WHERE mapid = '%u' AND difficulty = '%u'", uint32(next_reset), uint16(mapid), uint8(difficulty));
+        trans->PAppend("UPDATE instance_reset SET resettime = '%u' WHERE mapid = '%u' AND difficulty = '%u'", uint32(next_reset), uint16(mapid), uint8(difficulty));
     }
 
     // note: this isn't fast but it's meant to be executed very rarely
@@ -663,7 +694,12 @@ void InstanceSaveManager::_ResetOrWarnAll(uint32 mapid, Difficulty difficulty, b
             else
                 timeLeft = uint32(now - resetTime);
 
-            ((InstanceMap*)map2)->SendResetWarnings(timeLeft);
+            // sent over the next updates, a global warning reaches every instance of the map at once
+            ResetWarning warning;
+            warning.mapid      = mapid;
+            warning.instanceId = map2->GetInstanceId();
+            warning.timeLeft   = timeLeft;
+            m_resetWarnings.push_back(warning);
         }
         else
             ((InstanceMap*)map2)->Reset(INSTANCE_RESET_GLOBAL);
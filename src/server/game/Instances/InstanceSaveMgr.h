@@ -106,6 +106,10 @@ class InstanceSave
 };
 
 typedef std::unordered_map<uint32 /*PAIR32(map, difficulty)*/, time_t /*resetTime*/> ResetTimeByMapDifficultyMap;
+typedef std::unordered_map<uint32 /*PAIR32(map, difficulty)*/, std::unordered_set<uint32 /*InstanceId*/> > InstanceIdsByMapDifficultyMap;
+
+// instance maps warned per update after a global reset warning, the rest waits for the next ones
+#define INSTANCE_RESET_WARNINGS_PER_UPDATE 50
 
 class InstanceSaveManager
 {
@@ -161,6 +165,7 @@ class InstanceSaveManager
             bool canReset, bool load = false);
         void RemoveInstanceSave(uint32 InstanceId);
         static void DeleteInstanceFromDB(uint32 instanceid);
+        static void DeleteInstanceFromDB(uint32 instanceid, SQLTransaction& trans);
 
         InstanceSave* GetInstanceSave(uint32 InstanceId);
 
@@ -173,13 +178,26 @@ class InstanceSaveManager
         static uint16 ResetTimeDelay[];
 
     private:
-        void _ResetOrWarnAll(uint32 mapid, Difficulty difficulty, bool warn, time_t resetTime);
-        void _ResetInstance(uint32 mapid, uint32 instanceId);
+        struct ResetWarning
+        {
+            uint32 mapid;
+            uint32 instanceId;
+            uint32 timeLeft;
+        };
+        typedef std::deque<ResetWarning> ResetWarningQueue;
+
+        void _ResetOrWarnAll(uint32 mapid, Difficulty difficulty, bool warn, time_t resetTime, SQLTransaction& trans);
+        void _ResetInstance(uint32 mapid, uint32 instanceId, SQLTransaction& trans);
         void _ResetSave(InstanceSaveHashMap::iterator &itr);
+        void _SendResetWarnings();
         // used during global instance resets
         bool lock_instLists;
         // fast lookup by instance id
         InstanceSaveHashMap m_instanceSaveById;
+        // loaded saves of each map/difficulty, a global reset only goes through its own
+        InstanceIdsByMapDifficultyMap m_instanceIdsByMapDifficulty;
+        // instance maps still to warn about a global reset
+        ResetWarningQueue m_resetWarnings;
         // fast lookup for reset times (always use existed functions for access/set)
         ResetTimeByMapDifficultyMap m_resetTimeByMapDifficulty;
         ResetTimeQueue m_resetTimeQueue;
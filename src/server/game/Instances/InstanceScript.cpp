@@ -1462,7 +1462,7 @@ void InstanceScript::RewardNewRealmRecord(RealmCompletedChallenge* p_OldChalleng
                 PreparedStatement* l_Statement = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHAR_TITLES);
                 l_Statement->setUInt32(0, l_LowGuid);
 
-                PreparedQueryResult l_Result = AsyncQuery(CharacterDatabase, l_Statement, [l_Index, l_Flag, l_LowGuid](PreparedQueryResult const& p_Result) -> void
+                AsyncQuery(CharacterDatabase, l_Statement, [l_Index, l_Flag, l_LowGuid](PreparedQueryResult const& p_Result) -> void
                 {
                     if (!p_Result)
                         return;
@@ -1795,7 +1795,7 @@ void InstanceScript::SaveEncounterLogs(Creature* p_Creature, uint32 p_EncounterI
         l_Transaction->Append(l_Statement);
     }
 
-    CharacterDatabase.CommitTransaction(l_Transaction);
+    CharacterDatabase.CommitTransaction(l_Transaction, SQL_PRIORITY_LOW);
 
     p_Creature->ClearDamageLog();
     p_Creature->ClearGroupDumps();
@@ -58,11 +58,17 @@ class LootTemplate::LootGroup                               // A set of loot def
         LootStoreItemList* GetExplicitlyChancedItemList() { return &ExplicitlyChanced; }
         LootStoreItemList* GetEqualChancedItemList() { return &EqualChanced; }
         void CopyConditions(ConditionContainer conditions);
+        void Compile();                                     // Builds the roll table (at loading stage)
     private:
         LootStoreItemList ExplicitlyChanced;                // Entries with chances defined in DB
         LootStoreItemList EqualChanced;                     // Zero chances - every entry takes the same chance
 
-        LootStoreItem const* Roll() const;                 // Rolls an item from the group, returns NULL if all miss their chances
+        // Alias table of the first roll: one slot per explicitly chanced entry, the last one for the equal chanced part
+        std::vector<float>  RollChances;
+        std::vector<uint32> RollAliases;
+
+        LootStoreItem const* Roll(uint32& index) const;     // Rolls an item from the group, returns NULL if all miss their chances
+                                                            // index is its place in ExplicitlyChanced, or after it in EqualChanced
 };
 
 //Remove all data and free all memory
@@ -164,6 +170,9 @@ uint32 LootStore::LoadLootTable()
 
     Verify();                                           // Checks validity of the loot store
 
+    for (LootTemplateMap::const_iterator i = m_LootTemplates.begin(); i != m_LootTemplates.end(); ++i)
+        i->second->Compile();                           // Nothing left to look up at loot generation
+
     return count;
 }
 
@@ -260,13 +269,12 @@ bool LootStoreItem::Roll(bool rate, Player const* p_Player) const
 
     if (type == LOOT_ITEM_TYPE_ITEM)
     {
-        ItemTemplate const* pProto = sObjectMgr->GetItemTemplate(itemid);
-        float qualityModifier = pProto && rate ? sWorld->getRate(qualityToRate[pProto->Quality]) : 1.0f;
+        float qualityModifier = proto && rate ? sWorld->getRate(qualityToRate[proto->Quality]) : 1.0f;
         return roll_chance_f(chance*qualityModifier);
     }
     else if (type == LOOT_ITEM_TYPE_CURRENCY)
     {
-        if ((sCurrencyTypesStore.LookupEntry(itemid)->Category == CURRENCY_TYPE_APEXIS_CRYSTAL) && p_Player->HasAura(186400))
+        if ((sCurrencyTypesStore.LookupEntry(itemid)->Category == CURRENCY_TYPE_APEXIS_CRYSTAL) && p_Player && p_Player->HasAura(186400))
             return roll_chance_f(chance * 2);
         return roll_chance_f(chance);
     }
@@ -274,6 +282,12 @@ bool LootStoreItem::Roll(bool rate, Player const* p_Player) const
     return false;
 }
 
+// Item templates are never reloaded, the pointer stays valid as long as the entry
+void LootStoreItem::Compile()
+{
+    proto = (type == LOOT_ITEM_TYPE_ITEM && mincountOrRef >= 0) ? sObjectMgr->GetItemTemplate(itemid) : NULL;
+}
+
 // Checks correctness of values
 bool LootStoreItem::IsValid(LootStore const& store, uint32 entry) const
 {
@@ -383,7 +397,7 @@ LootItem::LootItem(LootStoreItem const& p_LootItem, ItemContext p_Context, Loot*
     }
     else
     {
-        auto l_ItemTemplate = sObjectMgr->GetItemTemplate(itemid);
+        auto l_ItemTemplate = p_LootItem.proto ? p_LootItem.proto : sObjectMgr->GetItemTemplate(itemid);
         freeforall          = l_ItemTemplate && (l_ItemTemplate->Flags & ITEM_FLAG_PARTY_LOOT);
         follow_loot_rules   = l_ItemTemplate && (l_ItemTemplate->FlagsCu & ITEM_FLAGS_CU_FOLLOW_LOOT_RULES);
         needs_quest         = p_LootItem.needs_quest;
@@ -525,7 +539,7 @@ void Loot::AddItem(LootStoreItem const & item)
         // non-ffa conditionals are counted in FillNonQuestNonFFAConditionalLoot()
         if (item.conditions.empty() && item.type == LOOT_ITEM_TYPE_ITEM)
         {
-            ItemTemplate const* proto = sObjectMgr->GetItemTemplate(item.itemid);
+            ItemTemplate const* proto = item.proto ? item.proto : sObjectMgr->GetItemTemplate(item.itemid);
             if (!proto || (proto->Flags & ITEM_FLAG_PARTY_LOOT) == 0)
                 ++UnlootedCount;
         }
@@ -1568,29 +1582,97 @@ void LootTemplate::LootGroup::AddEntry(LootStoreItem& item)
         EqualChanced.push_back(item);
 }
 
-// Rolls an item from the group, returns NULL if all miss their chances
-LootStoreItem const* LootTemplate::LootGroup::Roll() const
+// Builds the alias table (Vose) of the first roll at loading, one draw whatever the size of the group
+void LootTemplate::LootGroup::Compile()
 {
-    if (!ExplicitlyChanced.empty())                             // First explicitly chanced entries are checked
+    for (LootStoreItemList::iterator i = ExplicitlyChanced.begin(); i != ExplicitlyChanced.end(); ++i)
+        i->Compile();
+    for (LootStoreItemList::iterator i = EqualChanced.begin(); i != EqualChanced.end(); ++i)
+        i->Compile();
+
+    RollChances.clear();
+    RollAliases.clear();
+
+    if (ExplicitlyChanced.empty())
+        return;
+
+    // Odds of each entry in the walk of the [0, 100) roll: the first entry at 100% takes all what is left,
+    // the ones after it never drop, the remaining odds go to the equal chanced part
+    uint32 slots = ExplicitlyChanced.size() + 1;
+    std::vector<double> weights(slots);
+    double left = 100.0;
+
+    for (uint32 i = 0; i < slots - 1; ++i)
     {
-        float Roll = (float)rand_chance();
+        double weight = ExplicitlyChanced[i].chance >= 100.0f ? left : std::min<double>(ExplicitlyChanced[i].chance, left);
+        weights[i] = weight * slots / 100.0;
+        left -= weight;
+    }
+    weights[slots - 1] = left * slots / 100.0;
 
-        for (uint32 i = 0; i < ExplicitlyChanced.size(); ++i)   // check each explicitly chanced entry in the template and modify its chance based on quality.
-        {
-            if (ExplicitlyChanced[i].chance >= 100.0f)
-                return &ExplicitlyChanced[i];
+    RollChances.assign(slots, 1.0f);
+    RollAliases.resize(slots);
 
-            Roll -= ExplicitlyChanced[i].chance;
-            if (Roll < 0)
-                return &ExplicitlyChanced[i];
-        }
+    std::vector<uint32> small, large;
+    for (uint32 i = 0; i < slots; ++i)
+    {
+        RollAliases[i] = i;
+        (weights[i] < 1.0 ? small : large).push_back(i);
+    }
+
+    while (!small.empty() && !large.empty())
+    {
+        uint32 less = small.back();
+        uint32 more = large.back();
+        small.pop_back();
+        large.pop_back();
+
+        RollChances[less] = float(weights[less]);
+        RollAliases[less] = more;
+
+        weights[more] = (weights[more] + weights[less]) - 1.0;
+        (weights[more] < 1.0 ? small : large).push_back(more);
+    }
+    // Slots left in a list are only off by rounding errors, they keep their whole chance
+}
+
+// Rolls an item from the group, returns NULL if all miss their chances
+LootStoreItem const* LootTemplate::LootGroup::Roll(uint32& index) const
+{
+    if (!RollChances.empty())                               // First explicitly chanced entries are checked
+    {
+        double roll = rand_norm() * RollChances.size();
+        uint32 slot = std::min<uint32>(uint32(roll), RollChances.size() - 1);
+
+        index = (roll - slot) < RollChances[slot] ? slot : RollAliases[slot];
+        if (index < ExplicitlyChanced.size())
+            return &ExplicitlyChanced[index];
     }
     if (!EqualChanced.empty())                              // If nothing selected yet - an item is taken from equal-chanced part
-        return &EqualChanced[irand(0, EqualChanced.size()-1)];
+    {
+        uint32 equalIndex = irand(0, EqualChanced.size()-1);
+        index = ExplicitlyChanced.size() + equalIndex;
+        return &EqualChanced[equalIndex];
+    }
 
     return NULL;                                            // Empty drop from the group
 }
 
+// Same item already dropped: non-equippable items are limited to 3 drops, equippable items to 1
+static bool IsDuplicateDrop(Loot const& loot, LootStoreItem const& item)
+{
+    if (!item.proto)
+        return false;
+
+    uint8 limit = item.proto->InventoryType == 0 ? 3 : 1;
+    uint8 counter = 0;
+    for (LootItemList::const_iterator i = loot.Items.begin(); i != loot.Items.end(); ++i)
+        if (i->itemid == item.itemid && ++counter == limit)
+            return true;
+
+    return false;
+}
+
 // True if group includes at least 1 quest drop entry
 bool LootTemplate::LootGroup::HasQuestDrop() const
 {
@@ -1630,86 +1712,90 @@ void LootTemplate::LootGroup::CopyConditions(ConditionContainer /*conditions*/)
 // Rolls an item from the group (if any takes its chance) and adds the item to the loot
 void LootTemplate::LootGroup::Process(Loot& loot, uint16 lootMode) const
 {
-    // build up list of possible drops
-    LootStoreItemList EqualPossibleDrops = EqualChanced;
-    LootStoreItemList ExplicitPossibleDrops = ExplicitlyChanced;
+    // The first roll is done on the compiled table, it is enough unless the item is a duplicate or has the wrong mode
+    uint32 index = 0;
+    LootStoreItem const* item = Roll(index);
+    if (item == NULL)
+        return;
+
+    bool duplicate = false;
+    if (item->lootmode & lootMode)
+    {
+        if (!IsDuplicateDrop(loot, *item))
+        {
+            loot.AddItem(*item);
+            return;
+        }
+        duplicate = true;
+    }
+
+    // Rolls again like the walk through the lists would have: the explicitly chanced entries before the
+    // selected one already missed their chance, a duplicate is removed from the possible drops
+    std::vector<LootStoreItem const*> ExplicitPossibleDrops;
+    std::vector<LootStoreItem const*> EqualPossibleDrops;
+
+    if (index < ExplicitlyChanced.size())
+    {
+        for (uint32 i = index + (duplicate ? 1 : 0); i < ExplicitlyChanced.size(); ++i)
+            ExplicitPossibleDrops.push_back(&ExplicitlyChanced[i]);
+    }
+
+    for (uint32 i = 0; i < EqualChanced.size(); ++i)
+        if (!duplicate || ExplicitlyChanced.size() + i != index)
+            EqualPossibleDrops.push_back(&EqualChanced[i]);
 
-    uint8 uiAttemptCount = 0;
-    const uint8 uiMaxAttempts = ExplicitlyChanced.size() + EqualChanced.size();
+    uint32 uiAttemptCount = 1;
+    const uint32 uiMaxAttempts = ExplicitlyChanced.size() + EqualChanced.size();
 
     while (!ExplicitPossibleDrops.empty() || !EqualPossibleDrops.empty())
     {
         if (uiAttemptCount == uiMaxAttempts)             // already tried rolling too many times, just abort
             return;
 
-        LootStoreItem* item = NULL;
+        item = NULL;
 
-        // begin rolling (normally called via Roll())
-        LootStoreItemList::iterator itr;
-        uint8 itemSource = 0;
+        std::vector<LootStoreItem const*>::iterator itr;
+        bool fromEqual = false;
         if (!ExplicitPossibleDrops.empty())              // First explicitly chanced entries are checked
         {
-            itemSource = 1;
             float Roll = (float)rand_chance();
-            // check each explicitly chanced entry in the template and modify its chance based on quality
             for (itr = ExplicitPossibleDrops.begin(); itr != ExplicitPossibleDrops.end(); itr = ExplicitPossibleDrops.erase(itr))
             {
-                if (itr->chance >= 100.0f)
+                if ((*itr)->chance >= 100.0f)
                 {
-                    item = &*itr;
+                    item = *itr;
                     break;
                 }
 
-                Roll -= itr->chance;
+                Roll -= (*itr)->chance;
                 if (Roll < 0)
                 {
-                    item = &*itr;
+                    item = *itr;
                     break;
                 }
             }
         }
         if (item == NULL && !EqualPossibleDrops.empty()) // If nothing selected yet - an item is taken from equal-chanced part
         {
-            itemSource = 2;
-            itr = EqualPossibleDrops.begin();
-            std::advance(itr, irand(0, EqualPossibleDrops.size()-1));
-            item = &*itr;
+            fromEqual = true;
+            itr = EqualPossibleDrops.begin() + irand(0, EqualPossibleDrops.size()-1);
+            item = *itr;
         }
-        // finish rolling
 
         ++uiAttemptCount;
 
         if (item != NULL && item->lootmode & lootMode)   // only add this item if roll succeeds and the mode matches
         {
-            bool duplicate = false;
-            if (ItemTemplate const* _proto = sObjectMgr->GetItemTemplate(item->itemid))
-            {
-                uint8 _item_counter = 0;
-                for (LootItemList::const_iterator _item = loot.Items.begin(); _item != loot.Items.end(); ++_item)
-                    if (_item->itemid == item->itemid)                             // search through the items that have already dropped
-                    {
-                        ++_item_counter;
-                        if (_proto->InventoryType == 0 && _item_counter == 3)      // Non-equippable items are limited to 3 drops
-                            duplicate = true;
-                        else if (_proto->InventoryType != 0 && _item_counter == 1) // Equippable item are limited to 1 drop
-                            duplicate = true;
-                    }
-            }
-            if (duplicate) // if item->itemid is a duplicate, remove it
-                switch (itemSource)
-                {
-                    case 1: // item came from ExplicitPossibleDrops
-                        ExplicitPossibleDrops.erase(itr);
-                        break;
-                    case 2: // item came from EqualPossibleDrops
-                        EqualPossibleDrops.erase(itr);
-                        break;
-                }
-            else           // otherwise, add the item and exit the function
+            if (!IsDuplicateDrop(loot, *item))
             {
                 loot.AddItem(*item);
                 return;
             }
+
+            if (fromEqual)                               // if item->itemid is a duplicate, remove it
+                EqualPossibleDrops.erase(itr);
+            else
+                ExplicitPossibleDrops.erase(itr);
         }
     }
 }
@@ -1862,6 +1948,15 @@ void LootTemplate::AddEntry(LootStoreItem& item)
         Entries.push_back(item);
 }
 
+void LootTemplate::Compile()
+{
+    for (LootStoreItemList::iterator i = Entries.begin(); i != Entries.end(); ++i)
+        i->Compile();
+
+    for (LootGroups::iterator i = Groups.begin(); i != Groups.end(); ++i)
+        i->Compile();
+}
+
 void LootTemplate::CopyConditions(ConditionContainer conditions)
 {
     for (LootStoreItemList::iterator i = Entries.begin(); i != Entries.end(); ++i)
@@ -1892,26 +1987,6 @@ void LootTemplate::Process(Loot& loot, bool rate, uint16 lootMode, Player const*
         if (!i->Roll(rate, lootOwner))
             continue;                                         // Bad luck for the entry
 
-        if (i->type == LOOT_ITEM_TYPE_ITEM)
-        {
-            if (ItemTemplate const* _proto = sObjectMgr->GetItemTemplate(i->itemid))
-            {
-                uint8 _item_counter = 0;
-                LootItemList::const_iterator _item = loot.Items.begin();
-                for (; _item != loot.Items.end(); ++_item)
-                    if (_item->itemid == i->itemid)                               // search through the items that have already dropped
-                    {
-                        ++_item_counter;
-                        if (_proto->InventoryType == 0 && _item_counter == 3)     // Non-equippable items are limited to 3 drops
-                            continue;
-                        else if (_proto->InventoryType != 0 && _item_counter == 1) // Equippable item are limited to 1 drop
-                            continue;
-                    }
-                if (_item != loot.Items.end())
-                    continue;
-            }
-        }
-
         if (i->mincountOrRef < 0 && i->type == LOOT_ITEM_TYPE_ITEM)                             // References processing
         {
             LootTemplate const* Referenced = LootTemplates_Reference.GetLootFor(-i->mincountOrRef);
@@ -2030,7 +2105,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
         {
             if (i->itemid == uint32(cond->SourceEntry))
             {
-                i->conditions.push_back(cond);
+                InsertCondition(i->conditions, cond);
                 return true;
             }
         }
@@ -2046,7 +2121,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
                 {
                     if ((*i).itemid == uint32(cond->SourceEntry))
                     {
-                        (*i).conditions.push_back(cond);
+                        InsertCondition((*i).conditions, cond);
                         return true;
                     }
                 }
@@ -2058,7 +2133,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
                 {
                     if ((*i).itemid == uint32(cond->SourceEntry))
                     {
-                        (*i).conditions.push_back(cond);
+                        InsertCondition((*i).conditions, cond);
                         return true;
                     }
                 }
@@ -116,17 +116,19 @@ struct LootStoreItem
     uint32   maxcount;                                      // max drop count for the item (mincountOrRef positive) or Ref multiplicator (mincountOrRef negative)
     std::vector<uint32> itemBonuses;                        // item bonuses >= WoD
     ConditionContainer conditions;                               // additional loot condition
+    ItemTemplate const* proto;                              // item entries only, resolved by Compile() at loading
 
     // Constructor, converting ChanceOrQuestChance -> (chance, needs_quest)
     // displayid is filled in IsValid() which must be called after
     LootStoreItem(uint32 _itemid, uint8 _type, float _chanceOrQuestChance, uint16 _lootmode, uint8 _group, int32 _mincountOrRef, uint32 _maxcount, std::vector<uint32> _itemBonuses)
         : itemid(_itemid), type(_type), chance(fabs(_chanceOrQuestChance)), mincountOrRef(_mincountOrRef), lootmode(_lootmode),
-        group(_group), needs_quest(_chanceOrQuestChance < 0), maxcount(_maxcount), itemBonuses(_itemBonuses)
+        group(_group), needs_quest(_chanceOrQuestChance < 0), maxcount(_maxcount), itemBonuses(_itemBonuses), proto(NULL)
          {}
 
     bool Roll(bool rate, Player const* Player) const;                             // Checks if the entry takes it's chance (at loot generation)
     bool IsValid(LootStore const& store, uint32 entry) const;
                                                             // Checks correctness of values
+    void Compile();                                         // Resolves the item template once for all the rolls
 };
 
 typedef std::set<uint32> AllowedLooterSet;
@@ -238,6 +240,8 @@ class LootTemplate
         // Rolls for every item in the template and adds the rolled items the the loot
         void Process(Loot& loot, bool rate, uint16 lootMode, Player const* p_Player, uint8 groupId = 0) const;
         void CopyConditions(ConditionContainer conditions);
+        // Prepares the entries and the group roll tables for loot generation, once the template is loaded
+        void Compile();
         void FillAutoAssignationLoot(std::list<const ItemTemplate*>& p_ItemList, Player* p_Player = nullptr, bool p_IsBGReward = false) const;
 
         // True if template includes at least 1 quest drop entry
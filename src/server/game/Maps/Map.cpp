@@ -28,6 +28,7 @@
 #include "OutdoorPvPMgr.h"
 #include "DisableMgr.h"
 #include "Logger.h"
+#include "TickProfiler.h"
 
 u_map_magic MapMagic        = { {'M','A','P','S'} };
 u_map_magic MapVersionMagic = { {'v','1','.','8'} };
@@ -231,7 +232,7 @@ void Map::DeleteStateMachine()
 
 Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode, Map* _parent):
 _creatureToMoveLock(false), _gameObjectsToMoveLock(false), i_mapEntry(sMapStore.LookupEntry(id)),
-i_spawnMode(SpawnMode), i_InstanceId(InstanceId), m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
+i_spawnMode(SpawnMode), i_InstanceId(InstanceId), m_unloadTimer(0), m_ObjectsVersion(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
 m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
 m_activeNonPlayersIter(m_activeNonPlayers.end()), _transportsGameObjectUpdateIter(_transportsGameObject.end()), _transportsUpdateIter(_transports.end()),
 i_gridExpiry(expiry), i_scriptLock(false)
@@ -466,6 +467,8 @@ void Map::LoadGrid(float x, float y)
 
 bool Map::AddPlayerToMap(Player* player, bool p_Switched /*= false*/)
 {
+    ++m_ObjectsVersion;
+
     CellCoord cellCoord = JadeCore::ComputeCellCoord(player->GetPositionX(), player->GetPositionY());
     if (!cellCoord.IsCoordValid())
     {
@@ -513,6 +516,8 @@ void Map::InitializeObject(GameObject* obj)
 template<class T>
 bool Map::AddToMap(T* obj)
 {
+    ++m_ObjectsVersion;
+
     //TODO: Needs clean up. An object should not be added to map twice.
     if (obj->IsInWorld())
     {
@@ -562,6 +567,8 @@ bool Map::AddToMap(T* obj)
 template<>
 bool Map::AddToMap(Transport* obj)
 {
+    ++m_ObjectsVersion;
+
     //TODO: Needs clean up. An object should not be added to map twice.
     if (obj->IsInWorld())
         return true;
@@ -615,12 +622,18 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<JadeCore::Ob
 
 void Map::Update(const uint32 t_diff)
 {
+    TICK_PROFILE_ZONE_ARG("Map::Update", "map", GetId());
+
+    ++m_ObjectsVersion;
+
 #ifdef CROSS
     SetUpdating(true);
 #endif
 
     uint32 l_Time = getMSTime();
 
+    m_SplineBroadcast.Begin();
+
     _dynamicTree.update(t_diff);
     /// update worldsessions for existing players
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
@@ -729,6 +742,11 @@ void Map::Update(const uint32 t_diff)
 
     sScriptMgr->OnMapUpdate(this, t_diff);
 
+    {
+        TICK_PROFILE_ZONE("Map::SplineBroadcast");
+        m_SplineBroadcast.Flush(this);
+    }
+
 #ifdef CROSS
     SetUpdating(false);
 #endif
@@ -736,6 +754,8 @@ void Map::Update(const uint32 t_diff)
 
 void Map::RemovePlayerFromMap(Player* player, bool remove)
 {
+    ++m_ObjectsVersion;
+
     player->RemoveFromWorld();
     SendRemoveTransports(player);
     sOutdoorPvPMgr->HandlePlayerLeaveMap(player, GetId());
@@ -756,6 +776,8 @@ void Map::RemovePlayerFromMap(Player* player, bool remove)
 template<class T>
 void Map::RemoveFromMap(T *obj, bool remove)
 {
+    ++m_ObjectsVersion;
+
     if (Creature* creature = obj->ToCreature())
         sWildBattlePetMgr->OnRemoveToMap(creature);
 
@@ -809,6 +831,8 @@ void Map::RemoveFromMap(T *obj, bool remove)
 template<>
 void Map::RemoveFromMap(Transport* obj, bool remove)
 {
+    ++m_ObjectsVersion;
+
     obj->RemoveFromWorld();
 
     if (_transportsUpdateIter != _transports.end())
@@ -1266,6 +1290,8 @@ bool Map::GameObjectRespawnRelocation(GameObject* go, bool diffGridOnly)
 
 bool Map::UnloadGrid(NGridType& ngrid, bool unloadAll)
 {
+    ++m_ObjectsVersion;
+
     const uint32 x = ngrid.getX();
     const uint32 y = ngrid.getY();
 
@@ -3505,6 +3531,19 @@ void Map::DeleteRespawnTimesInDB(uint16 mapId, uint32 instanceId)
     CharacterDatabase.Execute(stmt);
 }
 
+void Map::DeleteRespawnTimesInDB(uint16 mapId, uint32 instanceId, SQLTransaction& trans)
+{
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CREATURE_RESPAWN_BY_INSTANCE);
+    stmt->setUInt16(0, mapId);
+    stmt->setUInt32(1, instanceId);
+    trans->Append(stmt);
+
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GO_RESPAWN_BY_INSTANCE);
+    stmt->setUInt16(0, mapId);
+    stmt->setUInt32(1, instanceId);
+    trans->Append(stmt);
+}
+
 time_t Map::GetLinkedRespawnTime(uint64 guid) const
 {
     uint64 linkedGuid = sObjectMgr->GetLinkedRespawnGuid(guid);
@@ -21,6 +21,9 @@
 #include "DynamicTree.h"
 #include "GameObjectModel.h"
 #include "Common.h"
+#include "ConcurrentGuidMap.hpp"
+#include "Transaction.h"
+#include "MoveSplineBroadcast.h"
 
 #include <bitset>
 
@@ -255,6 +258,10 @@ class Map : public GridRefManager<NGridType>
         template<class T> bool AddToMap(T *);
         template<class T> void RemoveFromMap(T *, bool);
 
+        /// Changes on every update and whenever an object enters or leaves the map,
+        /// object pointers found by a grid search stay valid while it doesn't
+        uint32 GetObjectsVersion() const { return m_ObjectsVersion; }
+
 #ifdef CROSS
         void SetUpdating(bool value) { m_IsUpdating = value; }
         bool IsUpdating() const { return m_IsUpdating; }
@@ -469,6 +476,12 @@ class Map : public GridRefManager<NGridType>
         AreaTrigger* GetAreaTrigger(uint64 p_Guid);
         Conversation* GetConversation(uint64 p_Guid);
 
+        /// Objects currently in world on this map, by guid (filled by WorldObject::AddToWorld / RemoveFromWorld)
+        MS::Utilities::ConcurrentGuidMap<WorldObject>& GetObjectStore() { return m_ObjectStore; }
+
+        /// SMSG_MONSTER_MOVE sent at the end of the update (see MoveSplineInit::Launch)
+        Movement::MoveSplineBroadcast& GetSplineBroadcast() { return m_SplineBroadcast; }
+
         MapInstanced* ToMapInstanced(){ if (Instanceable())  return reinterpret_cast<MapInstanced*>(this); else return NULL;  }
         const MapInstanced* ToMapInstanced() const { if (Instanceable())  return (const MapInstanced*)((MapInstanced*)this); else return NULL;  }
 
@@ -514,6 +527,7 @@ class Map : public GridRefManager<NGridType>
         void DeleteRespawnTimes();
 
         static void DeleteRespawnTimesInDB(uint16 mapId, uint32 instanceId);
+        static void DeleteRespawnTimesInDB(uint16 mapId, uint32 instanceId, SQLTransaction& trans);
 
         void AddGameObjectTransport(GameObject* p_Transport) { _transportsGameObject.insert(p_Transport); }
         void DeleteGameObjectTransport(GameObject* p_Transport) { _transportsGameObject.erase(p_Transport); }
@@ -583,6 +597,7 @@ class Map : public GridRefManager<NGridType>
         uint8 i_spawnMode;
         uint32 i_InstanceId;
         uint32 m_unloadTimer;
+        uint32 m_ObjectsVersion;
         float m_VisibleDistance;
         DynamicMapTree _dynamicTree;
 
@@ -636,6 +651,10 @@ class Map : public GridRefManager<NGridType>
         std::map<WorldObject*, bool> i_objectsToSwitch;
         std::set<WorldObject*> i_worldObjects;
 
+        MS::Utilities::ConcurrentGuidMap<WorldObject> m_ObjectStore;
+
+        Movement::MoveSplineBroadcast m_SplineBroadcast;
+
         typedef std::multimap<time_t, ScriptAction> ScriptScheduleMap;
         ScriptScheduleMap m_scriptSchedule;
 
@@ -24,6 +24,7 @@
 #include "WorldPacket.h"
 #include "Group.h"
 #include "Common.h"
+#include "TickProfiler.h"
 
 extern GridState* si_GridStates[];                          // debugging code, should be deleted some day
 
@@ -265,19 +266,24 @@ void MapManager::Update(uint32 diff)
     if (!i_timer.Passed())
         return;
 
+    TICK_PROFILE_ZONE("MapManager::Update");
+
     m_MapsDelay.clear();
 
     /// - Start Achievement criteria update processing thread
-    sAchievementMgr->PrepareCriteriaUpdateTaskThread();
+    sAchievementMgr->PrepareCriteriaBatches();
 
-    for (auto l_PlayerTask : sAchievementMgr->GetPlayersCriteriaTask())
+    for (uint32 l_Shard = 0; l_Shard < ACHIEVEMENT_CRITERIA_SHARDS; ++l_Shard)
     {
+        if (!sAchievementMgr->HasCriteriaBatch(l_Shard))
+            continue;
+
         if (m_updater.activated())
-            m_updater.schedule_specific(new AchievementCriteriaUpdateRequest(&m_updater, l_PlayerTask.second));
+            m_updater.schedule_specific(new AchievementCriteriaUpdateRequest(&m_updater, l_Shard));
         else
         {
             /// Process all task in synchrone way
-            auto l_Task = new AchievementCriteriaUpdateRequest(nullptr, l_PlayerTask.second);
+            auto l_Task = new AchievementCriteriaUpdateRequest(nullptr, l_Shard);
             l_Task->call();
             delete l_Task;
         }
@@ -296,8 +302,6 @@ void MapManager::Update(uint32 diff)
     if (m_updater.activated())
         m_updater.wait();
 
-    sAchievementMgr->ClearPlayersCriteriaTask();
-
     for (iter = i_maps.begin(); iter != i_maps.end(); ++iter)
         iter->second->DelayedUpdate(uint32(i_timer.GetCurrent()));
 
@@ -0,0 +1,256 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MoveSplineBroadcast.h"
+#include "MoveSpline.h"
+#include "Map.h"
+#include "Player.h"
+#include "DynamicObject.h"
+#include "World.h"
+#include "WorldSession.h"
+#include "SharedWorldPacket.h"
+#include "GridNotifiers.h"
+
+namespace Movement
+{
+    /// Same receivers as MessageDistDeliverer, phase and distance are checked for each mover afterwards
+    struct MoveSplineViewerCollector
+    {
+        std::vector<std::pair<WorldObject*, Player*>>& m_Viewers;
+
+        explicit MoveSplineViewerCollector(std::vector<std::pair<WorldObject*, Player*>>& p_Viewers) : m_Viewers(p_Viewers) { }
+
+        void AddSharedVision(Unit* p_Eye)
+        {
+            for (Player* l_Player : p_Eye->GetSharedVisionList())
+            {
+                if (l_Player->m_seer == p_Eye)
+                    m_Viewers.push_back(std::make_pair(p_Eye, l_Player));
+            }
+        }
+
+        void Visit(PlayerMapType& p_Players)
+        {
+            for (PlayerMapType::iterator l_Itr = p_Players.begin(); l_Itr != p_Players.end(); ++l_Itr)
+            {
+                Player* l_Player = l_Itr->getSource();
+
+                if (!l_Player->GetSharedVisionList().empty())
+                    AddSharedVision(l_Player);
+
+                if (l_Player->m_seer == l_Player || l_Player->GetVehicle())
+                    m_Viewers.push_back(std::make_pair(l_Player, l_Player));
+            }
+        }
+
+        void Visit(CreatureMapType& p_Creatures)
+        {
+            for (CreatureMapType::iterator l_Itr = p_Creatures.begin(); l_Itr != p_Creatures.end(); ++l_Itr)
+            {
+                Creature* l_Creature = l_Itr->getSource();
+                if (!l_Creature->GetSharedVisionList().empty())
+                    AddSharedVision(l_Creature);
+            }
+        }
+
+        void Visit(DynamicObjectMapType& p_DynamicObjects)
+        {
+            for (DynamicObjectMapType::iterator l_Itr = p_DynamicObjects.begin(); l_Itr != p_DynamicObjects.end(); ++l_Itr)
+            {
+                DynamicObject* l_DynamicObject = l_Itr->getSource();
+                if (!IS_PLAYER_GUID(l_DynamicObject->GetCasterGUID()))
+                    continue;
+
+                Player* l_Caster = (Player*)l_DynamicObject->GetCaster();
+                if (l_Caster && l_Caster->m_seer == l_DynamicObject)
+                    m_Viewers.push_back(std::make_pair(l_DynamicObject, l_Caster));
+            }
+        }
+
+        template<class SKIP> void Visit(GridRefManager<SKIP>&) { }
+    };
+
+    MoveSplineBroadcast::MoveSplineBroadcast()
+        : m_Collecting(false)
+    {
+    }
+
+    MoveSplineBroadcast::~MoveSplineBroadcast()
+    {
+        for (Move& l_Move : m_Moves)
+            delete l_Move.Packet;
+
+        for (WorldPacket* l_Packet : m_FreePackets)
+            delete l_Packet;
+    }
+
+    void MoveSplineBroadcast::Begin()
+    {
+        m_Collecting = sWorld->getBoolConfig(CONFIG_MOVEMENT_SPLINE_BATCHING);
+    }
+
+    WorldPacket* MoveSplineBroadcast::Prepare(Unit* p_Unit, uint32 p_SplineId)
+    {
+        /// Players see their own splines right away, they are the ones moving
+        if (!m_Collecting || p_Unit->GetTypeId() == TYPEID_PLAYER)
+            return nullptr;
+
+        std::pair<std::unordered_map<uint64, uint32>::iterator, bool> l_Result = m_MoveIndexes.insert(std::make_pair(p_Unit->GetGUID(), uint32(m_Moves.size())));
+        if (!l_Result.second)
+        {
+            /// Viewers never saw the previous one, the new spline starts from the current position anyway
+            Move& l_Move = m_Moves[l_Result.first->second];
+            l_Move.SplineId = p_SplineId;
+            l_Move.Packet->Initialize(SMSG_MONSTER_MOVE, 64);
+            return l_Move.Packet;
+        }
+
+        WorldPacket* l_Packet;
+        if (!m_FreePackets.empty())
+        {
+            l_Packet = m_FreePackets.back();
+            m_FreePackets.pop_back();
+        }
+        else
+            l_Packet = new WorldPacket();
+
+        l_Packet->Initialize(SMSG_MONSTER_MOVE, 64);
+
+        Move l_Move;
+        l_Move.MoverGUID = p_Unit->GetGUID();
+        l_Move.SplineId  = p_SplineId;
+        l_Move.Packet    = l_Packet;
+        m_Moves.push_back(l_Move);
+
+        return l_Packet;
+    }
+
+    void MoveSplineBroadcast::CollectViewers(Map* p_Map, Unit* p_Center, float p_Radius)
+    {
+        m_Viewers.clear();
+
+        MoveSplineViewerCollector l_Collector(m_Viewers);
+        p_Map->VisitWorld(p_Center->GetPositionX(), p_Center->GetPositionY(), p_Radius, l_Collector);
+    }
+
+    void MoveSplineBroadcast::Flush(Map* p_Map)
+    {
+        m_Collecting = false;
+
+        if (m_Moves.empty())
+            return;
+
+        /// Movers still on the map, with the spline they had when queued, grouped by cell
+        m_Movers.assign(m_Moves.size(), nullptr);
+        m_Order.clear();
+
+        for (uint32 l_I = 0; l_I < m_Moves.size(); ++l_I)
+        {
+            Move const& l_Move = m_Moves[l_I];
+
+            WorldObject* l_Object = p_Map->GetObjectStore().Find(l_Move.MoverGUID);
+            Unit* l_Unit = l_Object ? l_Object->ToUnit() : nullptr;
+            if (!l_Unit || !l_Unit->IsInWorld() || l_Unit->movespline->GetId() != l_Move.SplineId)
+                continue;
+
+            m_Movers[l_I] = l_Unit;
+            m_Order.push_back(std::make_pair(JadeCore::ComputeCellCoord(l_Unit->GetPositionX(), l_Unit->GetPositionY()).GetId(), l_I));
+        }
+
+        std::sort(m_Order.begin(), m_Order.end());
+
+        /// One grid visit per cell, wide enough for the viewers of every mover in it
+        m_Deliveries.clear();
+
+        for (size_t l_Begin = 0; l_Begin < m_Order.size();)
+        {
+            size_t l_End = l_Begin + 1;
+            while (l_End < m_Order.size() && m_Order[l_End].first == m_Order[l_Begin].first)
+                ++l_End;
+
+            Unit* l_Center  = m_Movers[m_Order[l_Begin].second];
+            float l_Radius  = 0.0f;
+
+            for (size_t l_I = l_Begin; l_I < l_End; ++l_I)
+            {
+                Unit* l_Unit = m_Movers[m_Order[l_I].second];
+                l_Radius = std::max(l_Radius, l_Unit->GetVisibilityRange() + l_Center->GetExactDist2d(l_Unit));
+            }
+
+            CollectViewers(p_Map, l_Center, l_Radius);
+
+            for (size_t l_I = l_Begin; l_I < l_End; ++l_I)
+            {
+                uint32 l_MoveIndex  = m_Order[l_I].second;
+                Unit* l_Unit        = m_Movers[l_MoveIndex];
+                float l_RangeSq     = l_Unit->GetVisibilityRange() * l_Unit->GetVisibilityRange();
+                uint32 l_PhaseMask  = l_Unit->GetPhaseMask();
+
+                for (Viewer const& l_Viewer : m_Viewers)
+                {
+                    if (!l_Viewer.first->InSamePhase(l_PhaseMask) || l_Viewer.first->GetExactDist2dSq(l_Unit) > l_RangeSq)
+                        continue;
+
+                    Player* l_Receiver = l_Viewer.second;
+                    if (l_Receiver == l_Unit || !l_Receiver->HaveAtClient(l_Unit))
+                        continue;
+
+                    Delivery l_Delivery;
+                    l_Delivery.Receiver  = l_Receiver;
+                    l_Delivery.MoveIndex = l_MoveIndex;
+                    m_Deliveries.push_back(l_Delivery);
+                }
+            }
+
+            l_Begin = l_End;
+        }
+
+        /// Per receiver bundles, packets built once for all of them
+        std::stable_sort(m_Deliveries.begin(), m_Deliveries.end());
+        m_Shared.assign(m_Moves.size(), nullptr);
+
+        for (size_t l_Begin = 0; l_Begin < m_Deliveries.size();)
+        {
+            Player* l_Receiver = m_Deliveries[l_Begin].Receiver;
+            m_Bundle.clear();
+
+            size_t l_End = l_Begin;
+            for (; l_End < m_Deliveries.size() && m_Deliveries[l_End].Receiver == l_Receiver; ++l_End)
+            {
+                uint32 l_MoveIndex = m_Deliveries[l_End].MoveIndex;
+
+                /// Seen through several eyes, they are next to each other
+                if (l_End != l_Begin && m_Deliveries[l_End - 1].MoveIndex == l_MoveIndex)
+                    continue;
+
+                SharedWorldPacket*& l_Shared = m_Shared[l_MoveIndex];
+                if (!l_Shared)
+                    l_Shared = new SharedWorldPacket(*m_Moves[l_MoveIndex].Packet);
+
+                if (l_Shared->IsSendable())
+                    m_Bundle.push_back(l_Shared);
+            }
+
+            if (WorldSession* l_Session = l_Receiver->GetSession())
+                l_Session->SendPackets(m_Bundle);
+
+            l_Begin = l_End;
+        }
+
+        for (uint32 l_I = 0; l_I < m_Moves.size(); ++l_I)
+        {
+            delete m_Shared[l_I];
+
+            m_Moves[l_I].Packet->clear();
+            m_FreePackets.push_back(m_Moves[l_I].Packet);
+        }
+
+        m_Moves.clear();
+        m_MoveIndexes.clear();
+    }
+}
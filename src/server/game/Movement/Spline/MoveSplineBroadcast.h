@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TRINITYSERVER_MOVESPLINEBROADCAST_H
+#define TRINITYSERVER_MOVESPLINEBROADCAST_H
+
+#include "Common.h"
+#include "WorldPacket.h"
+
+class Map;
+class Player;
+class Unit;
+class WorldObject;
+class SharedWorldPacket;
+
+namespace Movement
+{
+    /// SMSG_MONSTER_MOVE of the creatures of a map, collected during its update and sent at the end of it.
+    /// - A unit launching several splines in the same tick only sends the last one
+    /// - Units of the same cell look for their viewers with a single grid visit
+    /// - Each packet is validated once and its payload shared by every viewer
+    /// - Each viewer gets all its packets of the tick with a single socket lock
+    class MoveSplineBroadcast
+    {
+        public:
+            MoveSplineBroadcast();
+            ~MoveSplineBroadcast();
+
+            /// Called by the map around its update, packets are only collected in between
+            void Begin();
+            void Flush(Map* p_Map);
+
+            /// Replaces the move queued for p_Unit in this tick, if any
+            /// @return Packet to write the SMSG_MONSTER_MOVE in, NULL if it must be sent right away
+            WorldPacket* Prepare(Unit* p_Unit, uint32 p_SplineId);
+
+        private:
+            struct Move
+            {
+                uint64          MoverGUID;
+                uint32          SplineId;
+                WorldPacket*    Packet;
+            };
+
+            /// Eye, receiver seeing through it (itself, shared vision...), see MessageDistDeliverer
+            typedef std::pair<WorldObject*, Player*> Viewer;
+
+            struct Delivery
+            {
+                Player*     Receiver;
+                uint32      MoveIndex;
+
+                bool operator<(Delivery const& p_Other) const { return Receiver < p_Other.Receiver; }
+            };
+
+            void CollectViewers(Map* p_Map, Unit* p_Center, float p_Radius);
+
+            bool                                m_Collecting;
+            std::vector<Move>                   m_Moves;
+            std::unordered_map<uint64, uint32>  m_MoveIndexes;          ///< Mover GUID -> m_Moves index
+            std::vector<WorldPacket*>           m_FreePackets;
+
+            /// Flush buffers, kept between ticks
+            std::vector<Unit*>                  m_Movers;               ///< Same index as m_Moves, NULL if gone
+            std::vector<std::pair<uint32, uint32>> m_Order;             ///< Cell id, m_Moves index
+            std::vector<Viewer>                 m_Viewers;
+            std::vector<Delivery>               m_Deliveries;
+            std::vector<SharedWorldPacket*>     m_Shared;
+            std::vector<SharedWorldPacket const*> m_Bundle;
+
+            MoveSplineBroadcast(MoveSplineBroadcast const&);
+            MoveSplineBroadcast& operator=(MoveSplineBroadcast const&);
+    };
+}
+
+#endif
@@ -10,6 +10,7 @@
 #include "MoveSpline.h"
 #include "Unit.h"
 #include "Transport.h"
+#include "Map.h"
 
 enum MonsterMoveType
 {
@@ -374,10 +375,7 @@ namespace Movement
             packet.SplineData.Move.VehicleSeat = unit->GetTransSeat();
         }
 
-        WorldPacket l_Data(SMSG_MONSTER_MOVE);
-        packet.Write(&l_Data);
-
-        unit->SendMessageToSet(&l_Data, true);
+        SendMonsterMove(packet, l_MoveSpline.GetId());
 
         return l_MoveSpline.Duration();
     }
@@ -424,10 +422,25 @@ namespace Movement
             packet.SplineData.Move.VehicleSeat = unit->GetTransSeat();
         }
 
-        WorldPacket l_Data(SMSG_MONSTER_MOVE);
-        packet.Write(&l_Data);
+        SendMonsterMove(packet, move_spline.GetId());
+    }
+
+    void MoveSplineInit::SendMonsterMove(MonsterMove& packet, uint32 splineId)
+    {
+        // grouped with the other moves of the map update when possible
+        if (unit->IsInWorld())
+        {
+            if (WorldPacket* data = unit->GetMap()->GetSplineBroadcast().Prepare(unit, splineId))
+            {
+                packet.Write(data);
+                return;
+            }
+        }
+
+        WorldPacket data(SMSG_MONSTER_MOVE);
+        packet.Write(&data);
 
-        unit->SendMessageToSet(&l_Data, true);
+        unit->SendMessageToSet(&data, true);
     }
 
     MoveSplineInit::MoveSplineInit(Unit* m) : unit(m)
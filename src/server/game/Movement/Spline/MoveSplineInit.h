@@ -13,6 +13,7 @@
 #include "PathGenerator.h"
 
 class Unit;
+class MonsterMove;
 
 namespace Movement
 {
@@ -143,6 +144,9 @@ namespace Movement
         void DisableTransportPathTransformations();
     protected:
 
+        // Sends the packet to the viewers of the unit, or queues it on its map until the end of the update
+        void SendMonsterMove(MonsterMove& packet, uint32 splineId);
+
         MoveSplineInitArgs args;
         Unit*  unit;
     };
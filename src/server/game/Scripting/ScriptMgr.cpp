@@ -1414,14 +1414,19 @@ void ScriptMgr::OnPacketReceive(WorldSocket* p_Socket, WorldPacket p_Packet, Wor
     FOREACH_SCRIPT(ServerScript)->OnPacketReceive(p_Socket, p_Packet, p_Session);
 }
 
-/// Called when a (valid) packet is received by a client. The packet object is a copy of the original packet, so reading and modifying it is safe.
+/// Called when a (valid) packet is received by a client. Each script gets a copy of the original packet, so reading and modifying it is safe.
 /// @p_Socket : Socket who received the packet
 /// @p_Packet : Received packet
-void ScriptMgr::OnPacketSend(WorldSocket* p_Socket, WorldPacket p_Packet)
+void ScriptMgr::OnPacketSend(WorldSocket* p_Socket, WorldPacket const& p_Packet)
 {
     ASSERT(p_Socket);
 
-    FOREACH_SCRIPT(ServerScript)->OnPacketSend(p_Socket, p_Packet);
+    /// Only copied when a script listens, every sent packet goes through here
+    FOR_SCRIPTS(ServerScript, itr, end)
+    {
+        WorldPacket l_Packet(p_Packet);
+        itr->second->OnPacketSend(p_Socket, l_Packet);
+    }
 }
 
 /// Called when an invalid (unknown opcode) packet is received by a client. The packet is a reference to the original packet; not a copy.
@@ -444,10 +444,10 @@ class ScriptMgr
         /// @p_Session : Session who receive the packet /!\ CAN BE NULLPTR
         void OnPacketReceive(WorldSocket* p_Socket, WorldPacket p_Packet, WorldSession* p_Session = nullptr);
 
-        /// Called when a (valid) packet is received by a client. The packet object is a copy of the original packet, so reading and modifying it is safe.
+        /// Called when a (valid) packet is received by a client. Each script gets a copy of the original packet, so reading and modifying it is safe.
         /// @p_Socket : Socket who received the packet
         /// @p_Packet : Received packet
-        void OnPacketSend(WorldSocket* p_Socket, WorldPacket p_Packet);
+        void OnPacketSend(WorldSocket* p_Socket, WorldPacket const& p_Packet);
         /// Called when an invalid (unknown opcode) packet is received by a client. The packet is a reference to the original packet; not a copy.
         /// This allows you to actually handle unknown packets (for whatever purpose).
         /// @p_Socket : Socket who received the packet
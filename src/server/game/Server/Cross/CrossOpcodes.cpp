@@ -131,6 +131,10 @@ void IROpcodeTable::Initialize()
     DEFINE_IR_OPCODE_HANDLER(IR_SMSG_PLAYER_RECONNECT_RESULT,   &InterRealmClient::Handle_ServerSide);
     DEFINE_IR_OPCODE_HANDLER(IR_CMSG_PLAYER_RECONNECT_READY_TO_LOAD, &InterRealmClient::Handle_PlayerReconnectReadyToLoad);
 
+    // Split by IRSocket
+    DEFINE_IR_OPCODE_HANDLER(IR_CMSG_TUNNEL_BATCH,              &InterRealmClient::Handle_Null                  );
+    DEFINE_IR_OPCODE_HANDLER(IR_SMSG_TUNNEL_BATCH,              &InterRealmClient::Handle_ServerSide            );
+
 #undef DEFINE_IR_OPCODE_HANDLER
 };
 #endif
\ No newline at end of file
@@ -85,14 +85,15 @@ void InterRealmClient::SendTunneledPacket(uint64 playerGuid, WorldPacket const*
 
     const_cast<WorldPacket*>(packet)->FlushBits();
 
-    WorldPacket tmpPacket(IR_SMSG_TUNNEL_PACKET, 8 + 2 + packet->size());
-    tmpPacket << playerGuid;
-    tmpPacket << packet->GetOpcode();
-
-    if (packet->size() > 0)
-        tmpPacket.append(packet->contents(), packet->size());
+    if (!m_IRSocket || m_IRSocket->IsClosed())
+        return;
 
-    SendPacket(&tmpPacket);
+    // Coalesced with the other players packets by the socket
+    if (m_IRSocket->SendTunneledPacket(playerGuid, packet) == -1)
+    {
+        sLog->outError(LOG_FILTER_INTERREALM, "Cannot send tunneled packet %u", packet->GetOpcode());
+        m_IRSocket->CloseSocket();
+    }
 }
 
 void InterRealmClient::SendPacket(WorldPacket const* packet)
@@ -199,6 +200,11 @@ void InterRealmClient::Handle_WhoAmI(WorldPacket& packet)
         m_rate_reputation_premium = sWorld->getRate(RATE_REPUTATION_GAIN_PREMIUM);
     }
 
+    // Older realms don't send their capabilities, they keep the single packet tunnel
+    uint8 l_Capabilities = 0;
+    if (packet.rpos() < packet.size())
+        packet >> l_Capabilities;
+
     sLog->outDebug(LOG_FILTER_INTERREALM, "Received packet CMSG_WHO_AM_I.", m_realmId);
 
     WorldPacket pckt(IR_SMSG_WHO_AM_I, 1);
@@ -223,7 +229,13 @@ void InterRealmClient::Handle_WhoAmI(WorldPacket& packet)
     }
 
     pckt << uint8(0);
+    pckt << uint8(IR_TUNNEL_CAPABILITY_BATCH);
     SendPacket(&pckt);
+
+    // After the reply, it must reach the realm before any batch
+    if (m_IRSocket)
+        m_IRSocket->SetTunnelPeerCapabilities(l_Capabilities);
+
     _isDatabaseOpened = true;
     sLog->outInfo(LOG_FILTER_INTERREALM, "Database connection was successful. %lu", time(nullptr));
 
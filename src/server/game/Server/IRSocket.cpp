@@ -24,6 +24,7 @@
 #include "ScriptMgr.h"
 #include "AccountMgr.h"
 #include "ObjectMgr.h"
+#include "Config.h"
 
 #ifdef CROSS
 # include "IRSocket.h"
@@ -61,6 +62,8 @@ m_Seed(static_cast<uint32> (rand32()))
 
     msg_queue()->high_water_mark(8 * 1024 * 1024);
     msg_queue()->low_water_mark(8 * 1024 * 1024);
+
+    InitializeTunnel();
 }
 
 IRSocket::~IRSocket (void)
@@ -110,42 +113,11 @@ int IRSocket::SendPacket(WorldPacket const* pct)
 {
     ACE_GUARD_RETURN (LockType, Guard, m_OutBufferLock, -1);
 
-    if (closing_)
+    // tunneled packets sent before must reach the cross first
+    if (!m_TunnelWriter.IsEmpty() && FlushTunnelBatch() == -1)
         return -1;
 
-    IROutPktHeader header(pct->size() + 4, pct->GetOpcode());
-
-    if (m_OutBuffer->space() >= pct->size() + header.getHeaderLength() && msg_queue()->is_empty())
-    {
-        // Put the packet on the buffer.
-        if (m_OutBuffer->copy((char*) header.header, header.getHeaderLength()) == -1)
-            ACE_ASSERT (false);
-
-        if (!pct->empty())
-            if (m_OutBuffer->copy((char*) pct->contents(), pct->size()) == -1)
-                ACE_ASSERT (false);
-    }
-    else
-    {
-        // Enqueue the packet.
-        ACE_Message_Block* mb;
-
-        ACE_NEW_RETURN(mb, ACE_Message_Block(pct->size() + header.getHeaderLength()), -1);
-
-        mb->copy((char*) header.header, header.getHeaderLength());
-
-        if (!pct->empty())
-            mb->copy((const char*)pct->contents(), pct->size());
-
-        if (msg_queue()->enqueue_tail(mb, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
-        {
-            sLog->outError(LOG_FILTER_INTERREALM, "IRSocket::SendPacket enqueue_tail failed");
-            mb->release();
-            return -1;
-        }
-    }
-
-    return 0;
+    return SendPacketLocked(pct);
 }
 
 long IRSocket::AddReference (void)
@@ -396,6 +368,17 @@ int IRSocket::Update (void)
     if (closing_)
         return -1;
 
+    // Critical section
+    {
+        ACE_GUARD_RETURN (LockType, Guard, m_OutBufferLock, -1);
+
+        if (!m_TunnelWriter.IsEmpty() && getMSTimeDiff(m_TunnelWriter.GetPendingSince(), getMSTime()) >= m_TunnelFlushWindow)
+        {
+            if (FlushTunnelBatch() == -1)
+                return -1;
+        }
+    }
+
     if (m_OutActive || (m_OutBuffer->length() == 0 && msg_queue()->is_empty()))
         return 0;
 
@@ -617,6 +600,8 @@ int IRSocket::ProcessIncoming(WorldPacket* new_pct)
             case IR_SMSG_TUNNEL_PACKET:
                 return Handle_TunneledPacket(new_pct);
                 break;
+            case IR_SMSG_TUNNEL_BATCH:
+                return Handle_TunnelBatch(new_pct);
             default:
             {
                 ACE_GUARD_RETURN(LockType, Guard, m_SessionLock, -1);
@@ -675,6 +660,8 @@ m_OutBuffer(0), m_OutBufferSize(65536), m_OutActive(false)
     msg_queue()->low_water_mark(8 * 1024 * 1024);
 
     m_InterRealmClient = NULL;
+
+    InitializeTunnel();
 }
 
 IRSocket::~IRSocket (void)
@@ -718,42 +705,11 @@ int IRSocket::SendPacket(WorldPacket const* pct)
 
     ACE_GUARD_RETURN (LockType, Guard, m_OutBufferLock, -1);
 
-    if (closing_)
+    // tunneled packets sent before must reach the realm first
+    if (!m_TunnelWriter.IsEmpty() && FlushTunnelBatch() == -1)
         return -1;
 
-    IROutPktHeader header(pct->size() + 4, pct->GetOpcode());
-
-    if (m_OutBuffer->space() >= pct->size() + header.getHeaderLength() && msg_queue()->is_empty())
-    {
-        // Put the packet on the buffer.
-        if (m_OutBuffer->copy((char*) header.header, header.getHeaderLength()) == -1)
-            ACE_ASSERT (false);
-
-        if (!pct->empty())
-            if (m_OutBuffer->copy((char*) pct->contents(), pct->size()) == -1)
-                ACE_ASSERT (false);
-    }
-    else
-    {
-        // Enqueue the packet.
-        ACE_Message_Block* mb;
-
-        ACE_NEW_RETURN(mb, ACE_Message_Block(pct->size() + header.getHeaderLength()), -1);
-
-        mb->copy((char*) header.header, header.getHeaderLength());
-
-        if (!pct->empty())
-            mb->copy((const char*)pct->contents(), pct->size());
-
-        if (msg_queue()->enqueue_tail(mb, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
-        {
-            sLog->outError(LOG_FILTER_INTERREALM, "IRSocket::SendPacket enqueue_tail failed");
-            mb->release();
-            return -1;
-        }
-    }
-
-    return 0;
+    return SendPacketLocked(pct);
 }
 
 long IRSocket::AddReference (void)
@@ -996,6 +952,17 @@ int IRSocket::Update (void)
     if (closing_)
         return -1;
 
+    // Critical section
+    {
+        ACE_GUARD_RETURN (LockType, Guard, m_OutBufferLock, -1);
+
+        if (!m_TunnelWriter.IsEmpty() && getMSTimeDiff(m_TunnelWriter.GetPendingSince(), getMSTime()) >= m_TunnelFlushWindow)
+        {
+            if (FlushTunnelBatch() == -1)
+                return -1;
+        }
+    }
+
     if (m_OutActive || (m_OutBuffer->length() == 0 && msg_queue()->is_empty()))
         return 0;
 
@@ -1217,6 +1184,8 @@ int IRSocket::ProcessIncoming(WorldPacket* new_pct)
                 //ACE_GUARD_RETURN(LockType, Guard, m_SessionLock, -1);
                 m_InterRealmClient->Handle_TunneledPacket(new_pct);
                 break;
+            case IR_CMSG_TUNNEL_BATCH:
+                return Handle_TunnelBatch(new_pct);
             default:
                 //aptr.release();
                 m_InterRealmClient->AddPacket(new_pct);
@@ -1276,3 +1245,162 @@ int IRSocket::Handle_Ping(WorldPacket* packet)
 }
 # endif
 
+# ifndef CROSS
+#  define IR_TUNNEL_OUT_PACKET  IR_CMSG_TUNNEL_PACKET
+#  define IR_TUNNEL_OUT_BATCH   IR_CMSG_TUNNEL_BATCH
+#  define IR_TUNNEL_IN_PACKET   IR_SMSG_TUNNEL_PACKET
+# else
+#  define IR_TUNNEL_OUT_PACKET  IR_SMSG_TUNNEL_PACKET
+#  define IR_TUNNEL_OUT_BATCH   IR_SMSG_TUNNEL_BATCH
+#  define IR_TUNNEL_IN_PACKET   IR_CMSG_TUNNEL_PACKET
+# endif
+
+void IRSocket::InitializeTunnel()
+{
+    m_TunnelBatchingEnabled = ConfigMgr::GetBoolDefault("InterRealm.Tunnel.Batching", true);
+    m_TunnelBatching        = false;
+    m_TunnelFlushWindow     = ConfigMgr::GetIntDefault("InterRealm.Tunnel.FlushWindow", 0);
+    m_TunnelMaxBatchSize    = std::max(ConfigMgr::GetIntDefault("InterRealm.Tunnel.MaxBatchSize", 32 * 1024), 1024);
+
+    m_TunnelWriter.SetCompression(ConfigMgr::GetIntDefault("InterRealm.Tunnel.CompressionLevel", 1),
+        ConfigMgr::GetIntDefault("InterRealm.Tunnel.CompressionThreshold", 256));
+}
+
+void IRSocket::SetTunnelPeerCapabilities(uint8 p_Capabilities)
+{
+    ACE_GUARD (LockType, Guard, m_OutBufferLock);
+
+    m_TunnelBatching = m_TunnelBatchingEnabled && (p_Capabilities & IR_TUNNEL_CAPABILITY_BATCH);
+
+    sLog->outInfo(LOG_FILTER_INTERREALM, "Tunnel batching %s.", m_TunnelBatching ? "enabled" : "disabled");
+}
+
+IRTunnelStats IRSocket::GetTunnelStats()
+{
+    ACE_GUARD_RETURN (LockType, Guard, m_OutBufferLock, IRTunnelStats());
+
+    IRTunnelStats l_Stats   = m_TunnelWriter.GetStats();
+    l_Stats.ReceivedPackets = m_TunnelStats.ReceivedPackets;
+    l_Stats.ReceivedBatches = m_TunnelStats.ReceivedBatches;
+    l_Stats.SequenceGaps    = m_TunnelStats.SequenceGaps;
+    return l_Stats;
+}
+
+int IRSocket::SendTunneledPacket(uint64 p_PlayerGuid, WorldPacket const* p_Packet)
+{
+    ACE_GUARD_RETURN (LockType, Guard, m_OutBufferLock, -1);
+
+    if (closing_)
+        return -1;
+
+    if (!m_TunnelBatching)
+    {
+        WorldPacket l_Packet(IR_TUNNEL_OUT_PACKET, 8 + 2 + p_Packet->size());
+        l_Packet << uint64(p_PlayerGuid);
+        l_Packet << uint16(p_Packet->GetOpcode());
+
+        if (p_Packet->size() > 0)
+            l_Packet.append(p_Packet->contents(), p_Packet->size());
+
+        return SendPacketLocked(&l_Packet);
+    }
+
+    m_TunnelWriter.Append(p_PlayerGuid, p_Packet->GetOpcode(), p_Packet->size() > 0 ? p_Packet->contents() : nullptr, p_Packet->size());
+
+    if (m_TunnelWriter.IsFull(m_TunnelMaxBatchSize))
+        return FlushTunnelBatch();
+
+    return 0;
+}
+
+int IRSocket::FlushTunnelBatch()
+{
+    WorldPacket l_Batch(IR_TUNNEL_OUT_BATCH);
+    m_TunnelWriter.Build(l_Batch);
+
+    int l_Result = SendPacketLocked(&l_Batch);
+
+    // what the peer didn't read yet, grows when it can't keep up
+    IRTunnelStats& l_Stats = m_TunnelWriter.GetStats();
+    l_Stats.QueuedBytes    = m_OutBuffer->length() + msg_queue()->message_bytes();
+    l_Stats.MaxQueuedBytes = std::max(l_Stats.MaxQueuedBytes, l_Stats.QueuedBytes);
+
+    return l_Result;
+}
+
+int IRSocket::SendPacketLocked(WorldPacket const* pct)
+{
+    if (closing_)
+        return -1;
+
+    IROutPktHeader header(pct->size() + 4, pct->GetOpcode());
+
+    if (m_OutBuffer->space() >= pct->size() + header.getHeaderLength() && msg_queue()->is_empty())
+    {
+        // Put the packet on the buffer.
+        if (m_OutBuffer->copy((char*) header.header, header.getHeaderLength()) == -1)
+            ACE_ASSERT (false);
+
+        if (!pct->empty())
+            if (m_OutBuffer->copy((char*) pct->contents(), pct->size()) == -1)
+                ACE_ASSERT (false);
+    }
+    else
+    {
+        // Enqueue the packet.
+        ACE_Message_Block* mb;
+
+        ACE_NEW_RETURN(mb, ACE_Message_Block(pct->size() + header.getHeaderLength()), -1);
+
+        mb->copy((char*) header.header, header.getHeaderLength());
+
+        if (!pct->empty())
+            mb->copy((const char*)pct->contents(), pct->size());
+
+        if (msg_queue()->enqueue_tail(mb, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
+        {
+            sLog->outError(LOG_FILTER_INTERREALM, "IRSocket::SendPacket enqueue_tail failed");
+            mb->release();
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int IRSocket::Handle_TunnelBatch(WorldPacket* new_pct)
+{
+    IRTunnelStats l_Received;
+
+# ifndef CROSS
+    bool l_Valid = m_TunnelReader.Read(*new_pct, IR_TUNNEL_IN_PACKET, l_Received, [this](WorldPacket* p_Packet)
+    {
+        Handle_TunneledPacket(p_Packet);
+    });
+# else
+    InterRealmClient* l_Client = m_InterRealmClient;
+    bool l_Valid = m_TunnelReader.Read(*new_pct, IR_TUNNEL_IN_PACKET, l_Received, [l_Client](WorldPacket* p_Packet)
+    {
+        l_Client->Handle_TunneledPacket(p_Packet);
+    });
+# endif
+
+    delete new_pct;
+
+    // Critical section
+    {
+        ACE_GUARD_RETURN (LockType, Guard, m_OutBufferLock, -1);
+
+        m_TunnelStats.ReceivedPackets += l_Received.ReceivedPackets;
+        m_TunnelStats.ReceivedBatches += l_Received.ReceivedBatches;
+        m_TunnelStats.SequenceGaps    += l_Received.SequenceGaps;
+    }
+
+    if (!l_Valid)
+    {
+        sLog->outError(LOG_FILTER_INTERREALM, "IRSocket::Handle_TunnelBatch: corrupted batch from %s, closing connection.", GetRemoteAddress().c_str());
+        return -1;
+    }
+
+    return 0;
+}
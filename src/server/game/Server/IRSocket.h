@@ -23,6 +23,7 @@
 #endif /* ACE_LACKS_PRAGMA_ONCE */
 
 #include "Common.h"
+#include "IRTunnelBatch.h"
 
 #ifdef CROSS
 #include "AuthCrypt.h"
@@ -68,6 +69,16 @@ class IRSocket : public IRHandler
         /// @return -1 of failure
         int SendPacket(const WorldPacket* pct);
 
+        /// Send a packet of a player through the tunnel, coalesced with the other players packets
+        /// until the next Update if the peer reads batches
+        /// @return -1 of failure
+        int SendTunneledPacket(uint64 p_PlayerGuid, WorldPacket const* p_Packet);
+
+        /// Set from the WHO_AM_I exchange, see IRTunnelCapabilities
+        void SetTunnelPeerCapabilities(uint8 p_Capabilities);
+
+        IRTunnelStats GetTunnelStats();
+
         /// Add reference to this object.
         long AddReference (void);
 
@@ -112,6 +123,18 @@ class IRSocket : public IRHandler
         /// Drain the queue if its not empty.
         int handle_output_queue (GuardType& g);
 
+        /// SendPacket body, m_OutBufferLock must be held.
+        int SendPacketLocked(WorldPacket const* pct);
+
+        /// Send the pending tunneled packets as one batch, m_OutBufferLock must be held.
+        int FlushTunnelBatch();
+
+        /// Read the tunnel settings from the config.
+        void InitializeTunnel();
+
+        /// Split a batch in tunneled packets, deletes it.
+        int Handle_TunnelBatch(WorldPacket* new_pct);
+
         /// process one incoming packet.
         /// @param new_pct received packet, note that you need to delete it.
         int ProcessIncoming (WorldPacket* new_pct);
@@ -149,6 +172,25 @@ class IRSocket : public IRHandler
         /// True if the socket is registered with the reactor for output
         bool m_OutActive;
 
+        /// Tunneled packets waiting for the next flush, protected by m_OutBufferLock.
+        IRTunnelBatchWriter m_TunnelWriter;
+
+        /// Only used by the network thread.
+        IRTunnelBatchReader m_TunnelReader;
+
+        /// Receive side counters, the send side ones are in m_TunnelWriter.
+        IRTunnelStats m_TunnelStats;
+
+        /// Batching allowed by the config, and supported by the peer.
+        bool m_TunnelBatchingEnabled;
+        bool m_TunnelBatching;
+
+        /// Max age (ms) of a batch before Update sends it, 0 for every Update.
+        uint32 m_TunnelFlushWindow;
+
+        /// Batches are sent as soon as their entries reach that size.
+        uint32 m_TunnelMaxBatchSize;
+
 #ifdef CROSS
         /// === Cross specific === //
         InterRealmClient* m_InterRealmClient;
@@ -0,0 +1,210 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "IRTunnelBatch.h"
+#include "Log.h"
+#include "Timer.h"
+
+#include <zlib.h>
+
+IRTunnelBatchWriter::IRTunnelBatchWriter()
+    : m_Pending(4096), m_Count(0), m_PendingSince(0), m_Stream(nullptr), m_CompressionThreshold(0)
+{
+}
+
+IRTunnelBatchWriter::~IRTunnelBatchWriter()
+{
+    SetCompression(0, 0);
+}
+
+void IRTunnelBatchWriter::SetCompression(uint32 p_Level, uint32 p_Threshold)
+{
+    if (m_Stream)
+    {
+        deflateEnd(m_Stream);
+        delete m_Stream;
+        m_Stream = nullptr;
+    }
+
+    m_CompressionThreshold = p_Threshold;
+    if (!p_Level)
+        return;
+
+    m_Stream = new z_stream();
+    m_Stream->zalloc = (alloc_func)NULL;
+    m_Stream->zfree  = (free_func)NULL;
+    m_Stream->opaque = (voidpf)NULL;
+
+    int32 l_Result = deflateInit(m_Stream, std::min<uint32>(p_Level, Z_BEST_COMPRESSION));
+    if (l_Result != Z_OK)
+    {
+        sLog->outError(LOG_FILTER_INTERREALM, "Can't initialize tunnel compression (zlib: deflateInit) Error code: %i (%s)", l_Result, zError(l_Result));
+        delete m_Stream;
+        m_Stream = nullptr;
+    }
+}
+
+void IRTunnelBatchWriter::Append(uint64 p_PlayerGuid, uint16 p_Opcode, uint8 const* p_Data, size_t p_Size)
+{
+    if (!m_Count)
+        m_PendingSince = getMSTime();
+
+    m_Pending << uint64(p_PlayerGuid);
+    m_Pending << uint16(m_Sequences[p_PlayerGuid]++);
+    m_Pending << uint16(p_Opcode);
+    m_Pending << uint32(p_Size);
+
+    if (p_Size)
+        m_Pending.append(p_Data, p_Size);
+
+    ++m_Count;
+    m_Stats.MaxPendingBytes = std::max<uint32>(m_Stats.MaxPendingBytes, m_Pending.size());
+}
+
+void IRTunnelBatchWriter::Build(WorldPacket& p_Batch)
+{
+    uint32 l_RawSize = m_Pending.size();
+
+    p_Batch.reserve(IR_TUNNEL_BATCH_HEADER_SIZE + l_RawSize);
+    p_Batch << uint8(0);
+    p_Batch << uint16(m_Count);
+    p_Batch << uint32(l_RawSize);
+
+    if (!m_Stream || l_RawSize < m_CompressionThreshold || !Deflate(p_Batch))
+        p_Batch.append(m_Pending.contents(), l_RawSize);
+    else
+    {
+        p_Batch.put<uint8>(0, IR_TUNNEL_BATCH_COMPRESSED);
+        ++m_Stats.SentCompressedBatches;
+    }
+
+    ++m_Stats.SentBatches;
+    m_Stats.SentPackets   += m_Count;
+    m_Stats.SentRawBytes  += l_RawSize;
+    m_Stats.SentWireBytes += p_Batch.size();
+    m_Stats.LargestBatch   = std::max(m_Stats.LargestBatch, m_Count);
+    m_Stats.MaxFlushDelay  = std::max(m_Stats.MaxFlushDelay, getMSTimeDiff(m_PendingSince, getMSTime()));
+
+    m_Pending.clear();
+    m_Count = 0;
+}
+
+bool IRTunnelBatchWriter::Deflate(WorldPacket& p_Batch)
+{
+    size_t l_Offset = p_Batch.size();
+    uint32 l_Bound  = compressBound(m_Pending.size()) + 16;     ///< Room for the sync flush marker
+
+    p_Batch.resize(l_Offset + l_Bound);
+
+    m_Stream->next_in   = (Bytef*)m_Pending.contents();
+    m_Stream->avail_in  = (uInt)m_Pending.size();
+    m_Stream->next_out  = (Bytef*)p_Batch.contents() + l_Offset;
+    m_Stream->avail_out = (uInt)l_Bound;
+
+    /// Sync flush only: the window is kept between batches, the peer inflates them in order with a single stream
+    int32 l_Result = deflate(m_Stream, Z_SYNC_FLUSH);
+    if (l_Result != Z_OK || m_Stream->avail_in || !m_Stream->avail_out)
+    {
+        /// The stream already swallowed the data, the peer would be out of sync with any later compressed batch
+        sLog->outError(LOG_FILTER_INTERREALM, "Can't compress tunnel batch (zlib: deflate) Error code: %i (%s), compression disabled", l_Result, zError(l_Result));
+        SetCompression(0, m_CompressionThreshold);
+        p_Batch.resize(l_Offset);
+        return false;
+    }
+
+    p_Batch.resize(l_Offset + l_Bound - m_Stream->avail_out);
+    return true;
+}
+
+IRTunnelBatchReader::IRTunnelBatchReader()
+    : m_Stream(nullptr)
+{
+}
+
+IRTunnelBatchReader::~IRTunnelBatchReader()
+{
+    if (m_Stream)
+    {
+        inflateEnd(m_Stream);
+        delete m_Stream;
+    }
+}
+
+bool IRTunnelBatchReader::Unpack(WorldPacket& p_Batch, uint8 const*& p_Entries, uint32& p_Size, uint16& p_Count)
+{
+    uint8 l_Flags;
+    p_Batch >> l_Flags;
+    p_Batch >> p_Count;
+    p_Batch >> p_Size;
+
+    uint32 l_PayloadSize = p_Batch.size() - p_Batch.rpos();
+    uint8 const* l_Payload = p_Batch.contents() + p_Batch.rpos();
+    p_Batch.rfinish();
+
+    if (p_Size > IR_TUNNEL_BATCH_MAX_RAW_SIZE)
+        return false;
+
+    if (!(l_Flags & IR_TUNNEL_BATCH_COMPRESSED))
+    {
+        p_Entries = l_Payload;
+        return l_PayloadSize == p_Size;
+    }
+
+    if (!m_Stream)
+    {
+        m_Stream = new z_stream();
+        m_Stream->zalloc   = (alloc_func)NULL;
+        m_Stream->zfree    = (free_func)NULL;
+        m_Stream->opaque   = (voidpf)NULL;
+        m_Stream->avail_in = 0;
+        m_Stream->next_in  = NULL;
+
+        int32 l_Result = inflateInit(m_Stream);
+        if (l_Result != Z_OK)
+        {
+            sLog->outError(LOG_FILTER_INTERREALM, "Can't initialize tunnel decompression (zlib: inflateInit) Error code: %i (%s)", l_Result, zError(l_Result));
+            delete m_Stream;
+            m_Stream = nullptr;
+            return false;
+        }
+    }
+
+    /// One spare byte, a batch inflating to more than its announced size is caught
+    if (m_Inflated.size() < p_Size + 1)
+        m_Inflated.resize(p_Size + 1);
+
+    m_Stream->next_in   = (Bytef*)l_Payload;
+    m_Stream->avail_in  = (uInt)l_PayloadSize;
+    m_Stream->next_out  = (Bytef*)m_Inflated.data();
+    m_Stream->avail_out = (uInt)(p_Size + 1);
+
+    int32 l_Result = inflate(m_Stream, Z_SYNC_FLUSH);
+    if ((l_Result != Z_OK && l_Result != Z_BUF_ERROR) || m_Stream->avail_in || m_Stream->avail_out != 1)
+    {
+        sLog->outError(LOG_FILTER_INTERREALM, "Can't decompress tunnel batch (zlib: inflate) Error code: %i (%s)", l_Result, zError(l_Result));
+        return false;
+    }
+
+    p_Entries = m_Inflated.data();
+    return true;
+}
+
+void IRTunnelBatchReader::CheckSequence(uint64 p_PlayerGuid, uint16 p_Sequence, IRTunnelStats& p_Stats)
+{
+    uint16& l_Expected = m_Sequences[p_PlayerGuid];
+
+    /// 0 is the first packet of the player on this connection
+    if (p_Sequence != l_Expected && p_Sequence)
+    {
+        ++p_Stats.SequenceGaps;
+        sLog->outDebug(LOG_FILTER_INTERREALM, "Tunnel packet %u of player " UI64FMTD " out of sequence, expected %u",
+            uint32(p_Sequence), p_PlayerGuid, uint32(l_Expected));
+    }
+
+    l_Expected = p_Sequence + 1;
+}
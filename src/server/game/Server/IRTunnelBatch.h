@@ -0,0 +1,166 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRTUNNELBATCH_H
+#define IRTUNNELBATCH_H
+
+#include "Common.h"
+#include "WorldPacket.h"
+
+struct z_stream_s;
+
+/// Sent at the end of IR_CMSG_WHO_AM_I / IR_SMSG_WHO_AM_I, older peers don't send anything
+enum IRTunnelCapabilities
+{
+    IR_TUNNEL_CAPABILITY_BATCH      = 0x01              ///< Reads IR_*_TUNNEL_BATCH, compressed or not
+};
+
+enum IRTunnelBatchFlags
+{
+    IR_TUNNEL_BATCH_COMPRESSED      = 0x01              ///< Entries went through the zlib stream of the connection
+};
+
+/// Header of an IR_*_TUNNEL_BATCH payload, followed by the entries (deflated if flagged):
+///     uint64 player guid, uint16 sequence, uint16 opcode, uint32 size, packet data
+#define IR_TUNNEL_BATCH_HEADER_SIZE     (1 + 2 + 4)     ///< uint8 flags, uint16 count, uint32 entries size
+#define IR_TUNNEL_BATCH_ENTRY_SIZE      (8 + 2 + 2 + 4)
+#define IR_TUNNEL_BATCH_MAX_ENTRIES     0xFFFF
+#define IR_TUNNEL_BATCH_MAX_RAW_SIZE    (16 * 1024 * 1024)
+
+/// Flow control counters of one connection, both directions
+struct IRTunnelStats
+{
+    IRTunnelStats() { memset(this, 0, sizeof(IRTunnelStats)); }
+
+    uint64 SentPackets;                                 ///< Player packets sent in batches
+    uint64 SentBatches;
+    uint64 SentCompressedBatches;
+    uint64 SentRawBytes;                                ///< Batch entries before compression
+    uint64 SentWireBytes;                               ///< Batch payloads written on the socket
+    uint64 ReceivedPackets;
+    uint64 ReceivedBatches;
+    uint64 SequenceGaps;                                ///< Player packets received out of their sequence
+    uint32 LargestBatch;                                ///< Packets
+    uint32 MaxPendingBytes;                             ///< Largest batch waiting for a flush
+    uint32 MaxFlushDelay;                               ///< ms between the first packet of a batch and its flush
+    uint32 QueuedBytes;                                 ///< Output the peer didn't read yet, at the last flush
+    uint32 MaxQueuedBytes;
+};
+
+/// Coalesces the tunneled packets of a connection, not thread safe (the socket output lock covers it)
+class IRTunnelBatchWriter
+{
+    public:
+        IRTunnelBatchWriter();
+        ~IRTunnelBatchWriter();
+
+        /// @p_Level     : zlib level, 0 disables compression
+        /// @p_Threshold : Batches smaller than that are sent as they are
+        void SetCompression(uint32 p_Level, uint32 p_Threshold);
+
+        void Append(uint64 p_PlayerGuid, uint16 p_Opcode, uint8 const* p_Data, size_t p_Size);
+
+        /// Writes the pending entries as a batch payload in p_Batch and starts a new batch
+        void Build(WorldPacket& p_Batch);
+
+        bool IsEmpty() const { return !m_Count; }
+        bool IsFull(uint32 p_MaxSize) const { return m_Pending.size() >= p_MaxSize || m_Count >= IR_TUNNEL_BATCH_MAX_ENTRIES; }
+        size_t GetPendingSize() const { return m_Pending.size(); }
+        uint32 GetPendingSince() const { return m_PendingSince; }
+
+        IRTunnelStats& GetStats() { return m_Stats; }
+
+    private:
+        bool Deflate(WorldPacket& p_Batch);
+
+        ByteBuffer                          m_Pending;
+        uint32                              m_Count;
+        uint32                              m_PendingSince;
+        std::unordered_map<uint64, uint16>  m_Sequences;    ///< Next sequence of each player, lives as long as the connection
+        z_stream_s*                         m_Stream;
+        uint32                              m_CompressionThreshold;
+        IRTunnelStats                       m_Stats;
+
+        IRTunnelBatchWriter(IRTunnelBatchWriter const&);
+        IRTunnelBatchWriter& operator=(IRTunnelBatchWriter const&);
+};
+
+/// Splits the batches of a connection, used by its network thread only
+class IRTunnelBatchReader
+{
+    public:
+        IRTunnelBatchReader();
+        ~IRTunnelBatchReader();
+
+        /// Calls p_Handler(WorldPacket*) for every entry with a p_TunnelOpcode packet (player guid, opcode, data)
+        /// laid out as a single tunneled packet, the handler owns it
+        /// @return false if the batch is corrupted, the connection can't be trusted anymore
+        template<class Handler> bool Read(WorldPacket& p_Batch, uint16 p_TunnelOpcode, IRTunnelStats& p_Stats, Handler p_Handler)
+        {
+            uint8 const* l_Entries = nullptr;
+            uint32 l_Size  = 0;
+            uint16 l_Count = 0;
+
+            if (!Unpack(p_Batch, l_Entries, l_Size, l_Count))
+                return false;
+
+            uint8 const* l_End = l_Entries + l_Size;
+            for (uint16 l_I = 0; l_I < l_Count; ++l_I)
+            {
+                if (l_End - l_Entries < IR_TUNNEL_BATCH_ENTRY_SIZE)
+                    return false;
+
+                uint64 l_PlayerGuid = ReadLE<uint64>(l_Entries);
+                uint16 l_Sequence   = ReadLE<uint16>(l_Entries + 8);
+                uint16 l_Opcode     = ReadLE<uint16>(l_Entries + 10);
+                uint32 l_DataSize   = ReadLE<uint32>(l_Entries + 12);
+                l_Entries += IR_TUNNEL_BATCH_ENTRY_SIZE;
+
+                if (uint32(l_End - l_Entries) < l_DataSize)
+                    return false;
+
+                CheckSequence(l_PlayerGuid, l_Sequence, p_Stats);
+
+                WorldPacket* l_Packet = new WorldPacket(p_TunnelOpcode, 8 + 2 + l_DataSize);
+                *l_Packet << uint64(l_PlayerGuid);
+                *l_Packet << uint16(l_Opcode);
+
+                if (l_DataSize)
+                    l_Packet->append(l_Entries, l_DataSize);
+
+                l_Entries += l_DataSize;
+                p_Handler(l_Packet);
+            }
+
+            ++p_Stats.ReceivedBatches;
+            p_Stats.ReceivedPackets += l_Count;
+            return l_Entries == l_End;
+        }
+
+    private:
+        template<class T> static T ReadLE(uint8 const* p_Data)
+        {
+            T l_Value;
+            memcpy(&l_Value, p_Data, sizeof(T));
+            EndianConvert(l_Value);
+            return l_Value;
+        }
+
+        /// Points p_Entries to the entries of the batch, inflated in m_Inflated when compressed
+        bool Unpack(WorldPacket& p_Batch, uint8 const*& p_Entries, uint32& p_Size, uint16& p_Count);
+        void CheckSequence(uint64 p_PlayerGuid, uint16 p_Sequence, IRTunnelStats& p_Stats);
+
+        std::unordered_map<uint64, uint16>  m_Sequences;    ///< Next expected sequence of each player
+        std::vector<uint8>                  m_Inflated;
+        z_stream_s*                         m_Stream;       ///< Created with the first compressed batch
+
+        IRTunnelBatchReader(IRTunnelBatchReader const&);
+        IRTunnelBatchReader& operator=(IRTunnelBatchReader const&);
+};
+
+#endif
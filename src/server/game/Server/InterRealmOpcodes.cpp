@@ -143,6 +143,10 @@ void IROpcodeTable::Initialize()
     DEFINE_IR_OPCODE_HANDLER(IR_SMSG_PLAYER_RECONNECT_RESULT, &InterRealmSession::Handle_PlayerReconnectResult);
     DEFINE_IR_OPCODE_HANDLER(IR_CMSG_PLAYER_RECONNECT_READY_TO_LOAD, &InterRealmSession::Handle_ClientSide);
 
+    // Split by IRSocket
+    DEFINE_IR_OPCODE_HANDLER(IR_CMSG_TUNNEL_BATCH, &InterRealmSession::Handle_ClientSide);
+    DEFINE_IR_OPCODE_HANDLER(IR_SMSG_TUNNEL_BATCH, &InterRealmSession::Handle_Null);
+
 
 #undef DEFINE_IR_OPCODE_HANDLER
 };
@@ -329,22 +329,22 @@ void InterRealmSession::SendTunneledPacket(uint64 playerGuid, WorldPacket const*
         return;
     }
 
-    if (!m_tunnel_open)
+    if (!m_tunnel_open || !IsConnected() || !m_IRSocket || m_IRSocket->IsClosed())
     {
         delete packet;
         return;
     }
-    
-    WorldPacket tmpPacket(IR_CMSG_TUNNEL_PACKET, 8 + 2 + packet->size());
-    tmpPacket << (uint64)playerGuid;
-    tmpPacket << (uint16)packet->GetOpcode();
 
-    if (packet->size() > 0)
-        tmpPacket.append(packet->contents(), packet->size());
+    // Coalesced with the other players packets by the socket
+    m_IRSocket->SendTunneledPacket(playerGuid, packet);
 
     delete packet;
-    
-    SendPacket(&tmpPacket);
+}
+
+IRTunnelStats InterRealmSession::GetTunnelStats()
+{
+    IRSocket* socket = m_IRSocket;
+    return socket ? socket->GetTunnelStats() : IRTunnelStats();
 }
 
 void InterRealmSession::SendTunneledPacketToClient(uint64 guid, WorldPacket const *packet)
@@ -469,6 +469,7 @@ void InterRealmSession::Handle_Hello(WorldPacket& packet)
         //packet << uint32(sWorld->getIntConfig(CONFIG_MAX_ARENA_POINTS));
         packet << float(sWorld->getRate(RATE_REPUTATION_GAIN));
         packet << float(sWorld->getRate(RATE_REPUTATION_GAIN_PREMIUM));
+        packet << uint8(IR_TUNNEL_CAPABILITY_BATCH);
         SendPacket(&packet);
     }
 }
@@ -499,6 +500,14 @@ void InterRealmSession::Handle_WhoAmI(WorldPacket& packet)
 
     if (_valid == 0)
     {
+        // Older cross servers don't send their capabilities
+        uint8 capabilities = 0;
+        if (packet.rpos() < packet.size())
+            packet >> capabilities;
+
+        if (m_IRSocket)
+            m_IRSocket->SetTunnelPeerCapabilities(capabilities);
+
         m_tunnel_open = true;
 
         SetConnected(true);
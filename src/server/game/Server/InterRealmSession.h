@@ -113,6 +113,7 @@ class InterRealmSession: public ACE_Based::Runnable
 
         void SendTunneledPacket(uint64 guid, WorldPacket const* packet);
         void SendTunneledPacketToClient(uint64 guid, WorldPacket const *packet);
+        IRTunnelStats GetTunnelStats();
         void SendPacket(WorldPacket const* packet);
         void SendPSysMessage(Player *player, char const *format, ...);
         void SendServerAnnounce(uint64 guid, std::string const &text);
@@ -0,0 +1,209 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "OpcodeStats.h"
+#include "Log.h"
+#include <atomic>
+
+#define OPCODE_UNTRACKED 0xFFFF
+
+/// Written by a single thread, read by anyone summing the statistics
+struct OpcodeCounter
+{
+    std::atomic<uint64> Count;
+    std::atomic<uint64> TotalTime;
+    std::atomic<uint64> MaxTime;
+    std::atomic<uint32> Buckets[OPCODE_LATENCY_BUCKETS];
+};
+
+static thread_local OpcodeCounter* t_OpcodeCounters = nullptr;
+
+/// Handlers walking big containers or building big packets, throttled by OpcodeBudget.Expensive.PerSecond
+static uint16 const s_ExpensiveOpcodes[] =
+{
+    CMSG_AUCTION_LIST_ITEMS,
+    CMSG_AUCTION_LIST_BIDDER_ITEMS,
+    CMSG_AUCTION_LIST_OWNER_ITEMS,
+    CMSG_AUCTION_LIST_PENDING_SALES,
+    CMSG_BLACK_MARKET_OPEN,
+    CMSG_WHO,
+    CMSG_GUILD_GET_ROSTER,
+    CMSG_GUILD_BANK_QUERY_TAB,
+    CMSG_LF_GUILD_BROWSE,
+    CMSG_LFG_LIST_SEARCH,
+    CMSG_LFG_LIST_UPDATE_REQUEST
+};
+
+uint64 OpcodeStatsEntry::GetPercentile(uint32 p_Percentile) const
+{
+    if (!Count)
+        return 0;
+
+    uint64 l_Threshold = (Count * p_Percentile + 99) / 100;
+    uint64 l_Seen      = 0;
+
+    for (uint32 l_I = 0; l_I < OPCODE_LATENCY_BUCKETS - 1; ++l_I)
+    {
+        l_Seen += Buckets[l_I];
+        if (l_Seen >= l_Threshold)
+            return uint64(16) << l_I;
+    }
+
+    return MaxTime;
+}
+
+OpcodeStats::~OpcodeStats()
+{
+    for (OpcodeCounter* l_Counters : m_Threads)
+        delete[] l_Counters;
+}
+
+void OpcodeStats::Initialize()
+{
+    m_DenseIndex.assign(NUM_OPCODE_HANDLERS, OPCODE_UNTRACKED);
+    m_CostClasses.assign(NUM_OPCODE_HANDLERS, OPCODE_COST_NORMAL);
+    m_Opcodes.clear();
+
+    for (uint32 l_Opcode = 0; l_Opcode < NUM_OPCODE_HANDLERS; ++l_Opcode)
+    {
+        OpcodeHandler const* l_Handler = g_OpcodeTable[WOW_CLIENT_TO_SERVER][l_Opcode];
+        if (!l_Handler || l_Handler->status == STATUS_NEVER || l_Handler->status == STATUS_UNHANDLED)
+            continue;
+
+        m_DenseIndex[l_Opcode] = m_Opcodes.size();
+        m_Opcodes.push_back(l_Opcode);
+    }
+
+    for (uint16 l_Opcode : s_ExpensiveOpcodes)
+        m_CostClasses[l_Opcode] = OPCODE_COST_EXPENSIVE;
+
+    sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Tracking handler latency of %u client opcodes", uint32(m_Opcodes.size()));
+}
+
+OpcodeCounter* OpcodeStats::GetThreadCounters()
+{
+    if (!t_OpcodeCounters)
+    {
+        OpcodeCounter* l_Counters = new OpcodeCounter[m_Opcodes.size()];
+        for (size_t l_I = 0; l_I < m_Opcodes.size(); ++l_I)
+        {
+            l_Counters[l_I].Count.store(0, std::memory_order_relaxed);
+            l_Counters[l_I].TotalTime.store(0, std::memory_order_relaxed);
+            l_Counters[l_I].MaxTime.store(0, std::memory_order_relaxed);
+
+            for (uint32 l_Bucket = 0; l_Bucket < OPCODE_LATENCY_BUCKETS; ++l_Bucket)
+                l_Counters[l_I].Buckets[l_Bucket].store(0, std::memory_order_relaxed);
+        }
+
+        std::lock_guard<std::mutex> l_Guard(m_ThreadsLock);
+        m_Threads.push_back(l_Counters);
+        t_OpcodeCounters = l_Counters;
+    }
+
+    return t_OpcodeCounters;
+}
+
+void OpcodeStats::Record(uint16 p_Opcode, uint64 p_Microseconds)
+{
+    if (p_Opcode >= m_DenseIndex.size() || m_DenseIndex[p_Opcode] == OPCODE_UNTRACKED)
+        return;
+
+    OpcodeCounter& l_Counter = GetThreadCounters()[m_DenseIndex[p_Opcode]];
+
+    uint32 l_Bucket = 0;
+    for (uint64 l_Value = p_Microseconds >> 4; l_Value && l_Bucket < OPCODE_LATENCY_BUCKETS - 1; l_Value >>= 1)
+        ++l_Bucket;
+
+    /// Only this thread writes these counters (apart from Reset), no need for a lock or a CAS loop
+    l_Counter.Count.fetch_add(1, std::memory_order_relaxed);
+    l_Counter.TotalTime.fetch_add(p_Microseconds, std::memory_order_relaxed);
+    l_Counter.Buckets[l_Bucket].fetch_add(1, std::memory_order_relaxed);
+
+    if (p_Microseconds > l_Counter.MaxTime.load(std::memory_order_relaxed))
+        l_Counter.MaxTime.store(p_Microseconds, std::memory_order_relaxed);
+}
+
+void OpcodeStats::GetTop(uint32 p_Count, std::vector<OpcodeStatsEntry>& p_Entries) const
+{
+    p_Entries.clear();
+    p_Entries.resize(m_Opcodes.size());
+
+    for (size_t l_I = 0; l_I < m_Opcodes.size(); ++l_I)
+    {
+        memset(&p_Entries[l_I], 0, sizeof(OpcodeStatsEntry));
+        p_Entries[l_I].Opcode = m_Opcodes[l_I];
+    }
+
+    {
+        std::lock_guard<std::mutex> l_Guard(m_ThreadsLock);
+        for (OpcodeCounter const* l_Counters : m_Threads)
+        {
+            for (size_t l_I = 0; l_I < m_Opcodes.size(); ++l_I)
+            {
+                OpcodeCounter const& l_Counter = l_Counters[l_I];
+                OpcodeStatsEntry& l_Entry      = p_Entries[l_I];
+
+                l_Entry.Count     += l_Counter.Count.load(std::memory_order_relaxed);
+                l_Entry.TotalTime += l_Counter.TotalTime.load(std::memory_order_relaxed);
+                l_Entry.MaxTime    = std::max(l_Entry.MaxTime, l_Counter.MaxTime.load(std::memory_order_relaxed));
+
+                for (uint32 l_Bucket = 0; l_Bucket < OPCODE_LATENCY_BUCKETS; ++l_Bucket)
+                    l_Entry.Buckets[l_Bucket] += l_Counter.Buckets[l_Bucket].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    p_Entries.erase(std::remove_if(p_Entries.begin(), p_Entries.end(), [](OpcodeStatsEntry const& p_Entry) -> bool
+    {
+        return !p_Entry.Count;
+    }), p_Entries.end());
+
+    std::sort(p_Entries.begin(), p_Entries.end(), [](OpcodeStatsEntry const& p_A, OpcodeStatsEntry const& p_B) -> bool
+    {
+        return p_A.TotalTime > p_B.TotalTime;
+    });
+
+    if (p_Entries.size() > p_Count)
+        p_Entries.resize(p_Count);
+}
+
+void OpcodeStats::Reset()
+{
+    /// Samples recorded while resetting may be lost, statistics only
+    std::lock_guard<std::mutex> l_Guard(m_ThreadsLock);
+    for (OpcodeCounter* l_Counters : m_Threads)
+    {
+        for (size_t l_I = 0; l_I < m_Opcodes.size(); ++l_I)
+        {
+            l_Counters[l_I].Count.store(0, std::memory_order_relaxed);
+            l_Counters[l_I].TotalTime.store(0, std::memory_order_relaxed);
+            l_Counters[l_I].MaxTime.store(0, std::memory_order_relaxed);
+
+            for (uint32 l_Bucket = 0; l_Bucket < OPCODE_LATENCY_BUCKETS; ++l_Bucket)
+                l_Counters[l_I].Buckets[l_Bucket].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void OpcodeStats::LogTop(uint32 p_Count) const
+{
+    std::vector<OpcodeStatsEntry> l_Entries;
+    GetTop(p_Count, l_Entries);
+
+    if (l_Entries.empty())
+        return;
+
+    sLog->outInfo(LOG_FILTER_OPCODES, "Most expensive client opcodes:");
+    for (OpcodeStatsEntry const& l_Entry : l_Entries)
+    {
+        sLog->outInfo(LOG_FILTER_OPCODES, "%s: %llu packets, total %llu ms, avg %llu us, p99 %llu us, max %llu us",
+            GetOpcodeNameForLogging(l_Entry.Opcode, WOW_CLIENT_TO_SERVER).c_str(), (unsigned long long)l_Entry.Count,
+            (unsigned long long)(l_Entry.TotalTime / 1000), (unsigned long long)l_Entry.GetAverage(),
+            (unsigned long long)l_Entry.GetPercentile(99), (unsigned long long)l_Entry.MaxTime);
+    }
+}
@@ -0,0 +1,89 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef OPCODESTATS_H
+# define OPCODESTATS_H
+
+#include "Common.h"
+#include "Opcodes.h"
+#include <mutex>
+
+#define OPCODE_LATENCY_BUCKETS 12   ///< Bucket 0 is < 16 us, bucket N is [2^(N+3), 2^(N+4)) us
+
+/// Rate budget classes of client opcodes, see WorldSession::ConsumeOpcodeBudget
+enum OpcodeCostClass : uint8
+{
+    OPCODE_COST_NORMAL,
+    OPCODE_COST_EXPENSIVE,      ///< Searches and listings walking big containers (auction house, LFG list, guild roster...)
+    MAX_OPCODE_COST_CLASS
+};
+
+struct OpcodeStatsEntry
+{
+    uint16 Opcode;
+    uint64 Count;
+    uint64 TotalTime;           ///< Microseconds
+    uint64 MaxTime;
+    uint64 Buckets[OPCODE_LATENCY_BUCKETS];
+
+    uint64 GetAverage() const { return Count ? TotalTime / Count : 0; }
+
+    /// Upper bound (in us) of the bucket holding the given percentile (0-100)
+    uint64 GetPercentile(uint32 p_Percentile) const;
+};
+
+struct OpcodeCounter;
+
+/// Handler count and latency of every client opcode.
+/// Each thread dispatching packets (world and map threads) records in its own counters,
+/// they are only summed when someone asks for the statistics.
+class OpcodeStats
+{
+    friend class ACE_Singleton<OpcodeStats, ACE_Null_Mutex>;
+
+    public:
+        /// Builds the opcode index from g_OpcodeTable, must be called after InitOpcodes
+        void Initialize();
+
+        /// Called after each handler
+        /// @p_Opcode       : Client opcode
+        /// @p_Microseconds : Time spent in the handler
+        void Record(uint16 p_Opcode, uint64 p_Microseconds);
+
+        /// Opcodes sorted by total time spent in their handler since the last reset
+        /// @p_Count   : Max entries returned
+        /// @p_Entries : Output
+        void GetTop(uint32 p_Count, std::vector<OpcodeStatsEntry>& p_Entries) const;
+
+        void Reset();
+
+        /// Writes the top opcodes in the opcode log
+        void LogTop(uint32 p_Count) const;
+
+        OpcodeCostClass GetCostClass(uint16 p_Opcode) const
+        {
+            return p_Opcode < m_CostClasses.size() ? OpcodeCostClass(m_CostClasses[p_Opcode]) : OPCODE_COST_NORMAL;
+        }
+
+    private:
+        OpcodeStats() { }
+        ~OpcodeStats();
+
+        OpcodeCounter* GetThreadCounters();
+
+        std::vector<uint16>             m_DenseIndex;   ///< Opcode -> counter index, 0xFFFF if the opcode has no handler
+        std::vector<uint16>             m_Opcodes;      ///< Counter index -> opcode
+        std::vector<uint8>              m_CostClasses;  ///< Opcode -> OpcodeCostClass
+
+        mutable std::mutex              m_ThreadsLock;
+        std::vector<OpcodeCounter*>     m_Threads;      ///< Counters of each thread that ever dispatched a packet
+};
+
+#define sOpcodeStats ACE_Singleton<OpcodeStats, ACE_Null_Mutex>::instance()
+
+#endif // OPCODESTATS_H
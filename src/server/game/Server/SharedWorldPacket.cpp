@@ -0,0 +1,57 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "SharedWorldPacket.h"
+#include "Log.h"
+#include <ace/Message_Block.h>
+#include <ace/Lock_Adapter_T.h>
+
+/// Payload references are released by the network threads while the broadcasting thread
+/// still duplicates them, the reference count must be locked
+static ACE_Lock_Adapter<ACE_Thread_Mutex> s_PayloadReferenceLock;
+
+SharedWorldPacket::SharedWorldPacket(WorldPacket const& p_Packet)
+    : m_Packet(p_Packet), m_Sendable(true), m_Payload(nullptr)
+{
+    WorldPacket& l_Packet = const_cast<WorldPacket&>(p_Packet);
+    l_Packet.FlushBits();
+    l_Packet.OnSend();
+
+    if (p_Packet.GetOpcode() == NULL_OPCODE || p_Packet.GetOpcode() == UNKNOWN_OPCODE)
+    {
+        sLog->outError(LOG_FILTER_OPCODES, "Prevented broadcast of %s", GetOpcodeNameForLogging(p_Packet.GetOpcode(), WOW_SERVER_TO_CLIENT).c_str());
+        m_Sendable = false;
+        return;
+    }
+
+    OpcodeHandler* l_Handler = g_OpcodeTable[WOW_SERVER_TO_CLIENT][p_Packet.GetOpcode()];
+    if (!l_Handler || l_Handler->status == STATUS_UNHANDLED)
+    {
+        sLog->outError(LOG_FILTER_OPCODES, "Prevented broadcast of disabled opcode %s", GetOpcodeNameForLogging(p_Packet.GetOpcode(), WOW_SERVER_TO_CLIENT).c_str());
+        m_Sendable = false;
+    }
+}
+
+SharedWorldPacket::~SharedWorldPacket()
+{
+    if (m_Payload)
+        m_Payload->release();
+}
+
+ACE_Message_Block* SharedWorldPacket::DuplicatePayload() const
+{
+    if (!m_Payload)
+    {
+        m_Payload = new ACE_Message_Block(m_Packet.size(), ACE_Message_Block::MB_DATA, nullptr, nullptr, nullptr, &s_PayloadReferenceLock);
+
+        if (!m_Packet.empty())
+            m_Payload->copy((char const*)m_Packet.contents(), m_Packet.size());
+    }
+
+    return m_Payload->duplicate();
+}
@@ -0,0 +1,46 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SHAREDWORLDPACKET_H
+#define SHAREDWORLDPACKET_H
+
+#include "WorldPacket.h"
+
+class ACE_Message_Block;
+
+/// A packet sent as is to many sessions (channel, guild, group...).
+/// Validation, bit flushing and profiling are done once, each socket only builds and encrypts its own header.
+/// Sockets that can't write the payload in their output buffer right away queue a reference to a single
+/// reference counted copy of it instead of a copy of their own.
+/// Must only be used for the duration of the broadcast call, the source packet is not copied.
+class SharedWorldPacket
+{
+    public:
+        /// @p_Packet : Packet to broadcast, must outlive this object
+        explicit SharedWorldPacket(WorldPacket const& p_Packet);
+        ~SharedWorldPacket();
+
+        WorldPacket const& GetPacket() const { return m_Packet; }
+        uint16 GetOpcode() const { return m_Packet.GetOpcode(); }
+
+        /// False if the opcode can't be sent to clients (NULL, unknown or disabled)
+        bool IsSendable() const { return m_Sendable; }
+
+        /// New reference to the payload, released by the socket once sent
+        ACE_Message_Block* DuplicatePayload() const;
+
+    private:
+        WorldPacket const&          m_Packet;
+        bool                        m_Sendable;
+        mutable ACE_Message_Block*  m_Payload;      ///< Created by the first socket needing it
+
+        SharedWorldPacket(SharedWorldPacket const&);
+        SharedWorldPacket& operator=(SharedWorldPacket const&);
+};
+
+#endif
@@ -20,6 +20,7 @@
 #endif
 
 #include <zlib.h>
+#include <chrono>
 #include "Common.h"
 #include "DatabaseEnv.h"
 #include "Log.h"
@@ -45,6 +46,9 @@
 #include "AccountMgr.h"
 #include "PetBattle.h"
 #include "Chat.h"
+#include "OpcodeStats.h"
+#include "SharedWorldPacket.h"
+#include "TickProfiler.h"
 
 bool MapSessionFilter::Process(WorldPacket* packet)
 {
@@ -217,9 +221,13 @@ WorldSession::WorldSession(uint32 id, InterRealmClient* irc, AccountTypes sec, b
 
     InitializeQueryCallbackParameters();
 
-    m_TransactionCallbacks             = std::unique_ptr<TransactionCallbacks>(new TransactionCallbacks());
-    m_PreparedStatementCallbacks       = std::unique_ptr<PreparedStatementCallbacks>(new PreparedStatementCallbacks());
-    m_PreparedStatementCallbacksBuffer = std::unique_ptr<PreparedStatementCallbacks>(new PreparedStatementCallbacks());
+    m_QueryCallbackQueue               = std::make_shared<SQLCallbackQueue>();
+
+    for (uint8 l_I = 0; l_I < MAX_OPCODE_COST_CLASS; ++l_I)
+    {
+        m_OpcodeBudgets[l_I].Tokens     = std::numeric_limits<uint32>::max();   ///< Clamped to a full bucket on first use
+        m_OpcodeBudgets[l_I].LastRefill = getMSTime();
+    }
 
     _compressionStream = new z_stream();
     _compressionStream->zalloc = (alloc_func)NULL;
@@ -361,6 +369,50 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
 #endif
 }
 
+void WorldSession::SendPacket(SharedWorldPacket const& p_Packet)
+{
+    if (!p_Packet.IsSendable())
+        return;
+
+#ifndef CROSS
+    if (!m_Socket)
+        return;
+
+    if (GetInterRealmBG() && !CanBeSentDuringInterRealm(p_Packet.GetOpcode()))
+        return;
+
+    if (m_Socket->SendPacket(p_Packet) == -1)
+        m_Socket->CloseSocket();
+#else
+    SendPacket(&p_Packet.GetPacket(), true);
+#endif
+}
+
+void WorldSession::SendPackets(std::vector<SharedWorldPacket const*> const& p_Packets)
+{
+    if (p_Packets.empty())
+        return;
+
+#ifndef CROSS
+    if (!m_Socket)
+        return;
+
+    if (GetInterRealmBG())
+    {
+        for (SharedWorldPacket const* l_Packet : p_Packets)
+            SendPacket(*l_Packet);
+
+        return;
+    }
+
+    if (m_Socket->SendPackets(p_Packets.data(), p_Packets.size()) == -1)
+        m_Socket->CloseSocket();
+#else
+    for (SharedWorldPacket const* l_Packet : p_Packets)
+        SendPacket(&l_Packet->GetPacket(), true);
+#endif
+}
+
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket* new_packet)
 {
@@ -393,6 +445,8 @@ struct OpcodeInfo
 /// Update the WorldSession (triggered by World update)
 bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 {
+    TICK_PROFILE_ZONE_ARG("WorldSession::Update", "account", GetAccountId());
+
     if (IsIRClosing())
         return false;
 
@@ -456,6 +510,8 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 /// Update the WorldSession (triggered by World update)
 bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 {
+    TICK_PROFILE_ZONE_ARG("WorldSession::Update", "account", GetAccountId());
+
     uint32 sessionDiff = getMSTime();
     uint32 nbPacket = 0;
     std::map<uint32, OpcodeInfo> pktHandle; // opcodeId / OpcodeInfo
@@ -532,13 +588,17 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
     //! loop caused by re-enqueueing the same packets over and over again, we stop updating this session
     //! and continue updating others. The re-enqueued packets will be handled in the next Update call for this session.
     uint32 processedPackets = 0;
+    //! A packet over its rate budget isn't dequeued, the session waits for its next update to go on
+    BudgetedPacketFilter budgetedUpdater(updater, this);
     while (m_Socket && !m_Socket->IsClosed() &&
             !_recvQueue.empty() && _recvQueue.peek(true) != firstDelayedPacket &&
-            _recvQueue.next(packet, updater))
+            _recvQueue.next(packet, budgetedUpdater))
     {
         const OpcodeHandler* opHandle = g_OpcodeTable[WOW_CLIENT_TO_SERVER][packet->GetOpcode()];
         uint32 pktTime = getMSTime();
 
+        std::chrono::steady_clock::time_point l_HandlerStart = std::chrono::steady_clock::now();
+
         try
         {
             switch (opHandle->status)
@@ -705,6 +765,12 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 
         if (deletePacket)
         {
+            if (sWorld->getBoolConfig(CONFIG_OPCODE_STATS_ENABLE))
+            {
+                uint64 l_HandlerTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - l_HandlerStart).count();
+                sOpcodeStats->Record(packet->GetOpcode(), l_HandlerTime);
+            }
+
             std::map<uint32, OpcodeInfo>::iterator itr = pktHandle.find(packet->GetOpcode());
             if (itr == pktHandle.end())
                 pktHandle.insert(std::make_pair(packet->GetOpcode(), OpcodeInfo(1, getMSTime() - pktTime)));
@@ -778,6 +844,31 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 }
 #endif
 
+bool WorldSession::ConsumeOpcodeBudget(uint16 p_Opcode)
+{
+    if (!sWorld->getBoolConfig(CONFIG_OPCODE_BUDGET_ENABLE))
+        return true;
+
+    OpcodeCostClass l_CostClass = sOpcodeStats->GetCostClass(p_Opcode);
+    uint32 l_PerSecond = sWorld->getIntConfig(l_CostClass == OPCODE_COST_EXPENSIVE ? CONFIG_OPCODE_BUDGET_EXPENSIVE : CONFIG_OPCODE_BUDGET_NORMAL);
+    if (!l_PerSecond)
+        return true;
+
+    /// Token bucket refilled at l_PerSecond, holding at most one second of budget (tokens are stored in thousandths)
+    OpcodeBudget& l_Budget = m_OpcodeBudgets[l_CostClass];
+    uint32 l_Now   = getMSTime();
+    uint64 l_Refill = uint64(getMSTimeDiff(l_Budget.LastRefill, l_Now)) * l_PerSecond;
+
+    l_Budget.LastRefill = l_Now;
+    l_Budget.Tokens     = uint32(std::min<uint64>(uint64(l_Budget.Tokens) + l_Refill, uint64(l_PerSecond) * IN_MILLISECONDS));
+
+    if (l_Budget.Tokens < IN_MILLISECONDS)
+        return false;
+
+    l_Budget.Tokens -= IN_MILLISECONDS;
+    return true;
+}
+
 /// %Log the player out
 void WorldSession::LogoutPlayer(bool p_Save, bool p_AfterInterRealm)
 {
@@ -1640,13 +1731,8 @@ void WorldSession::ProcessQueryCallbacks()
 
     l_Times.push_back(getMSTime() - l_StartTime);
 
-    //! HandleCharEnumOpcode
-    if (m_CharEnumCallback.ready())
-    {
-        m_CharEnumCallback.get(result);
-        HandleCharEnum(result);
-        m_CharEnumCallback.cancel();
-    }
+    //! HandleCharEnumOpcode, HandleAddIgnoreOpcode
+    m_QueryCallbackQueue->Process();
 
     l_Times.push_back(getMSTime() - l_StartTime);
 
@@ -1681,15 +1767,6 @@ void WorldSession::ProcessQueryCallbacks()
 
     l_Times.push_back(getMSTime() - l_StartTime);
 
-    //- HandleCharAddIgnoreOpcode
-    if (m_AddIgnoreCallback.ready())
-    {
-        m_AddIgnoreCallback.get(result);
-        HandleAddIgnoreOpcodeCallBack(result);
-        m_AddIgnoreCallback.cancel();
-    }
-
-    l_Times.push_back(getMSTime() - l_StartTime);
 #endif
 
     //! HandlePlayerLoginOpcode
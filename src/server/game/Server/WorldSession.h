@@ -17,6 +17,7 @@
 #include "WorldPacket.h"
 #include "Cryptography/BigNumber.h"
 #include "Opcodes.h"
+#include "OpcodeStats.h"
 #include "LFGListMgr.h"
 #include "MSCallback.hpp"
 #ifdef CROSS
@@ -30,6 +31,7 @@ class Item;
 class Object;
 class Player;
 class Quest;
+class SharedWorldPacket;
 class SpellCastTargets;
 class Unit;
 class Warden;
@@ -386,6 +388,8 @@ class CharacterCreateInfo
 #define SessionRealmDatabase CharacterDatabase
 #endif
 /// Player session in the World
+class SharedWorldPacket;
+
 class WorldSession
 {
     public:
@@ -443,6 +447,13 @@ class WorldSession
         static void WriteMovementInfo(WorldPacket& data, MovementInfo* mi);
 
         void SendPacket(WorldPacket const* packet, bool forced = false, bool ir_packet = false);
+
+        /// Send a packet built once for many sessions (channels, guilds, groups...)
+        /// @p_Packet : Shared packet, already validated
+        void SendPacket(SharedWorldPacket const& p_Packet);
+        /// Send several shared packets at once (grouped movement broadcast)
+        /// @p_Packets : Shared packets, already validated
+        void SendPackets(std::vector<SharedWorldPacket const*> const& p_Packets);
         void SendNotification(const char *format, ...) ATTR_PRINTF(2, 3);
         void SendNotification(uint32 string_id, ...);
         void SendPetNameInvalid(uint32 error, const std::string& name, DeclinedName *declinedName);
@@ -1491,8 +1502,6 @@ class WorldSession
 
         QueryCallback<QueryResult, bool, true> m_VoteTimeCallback;
 
-        PreparedQueryResultFuture m_CharEnumCallback;
-        PreparedQueryResultFuture m_AddIgnoreCallback;
 
 #ifdef CROSS
         struct BattlegroundLeaveData
@@ -1519,22 +1528,42 @@ class WorldSession
         QueryResultHolderFuture m_CharacterLoginDBCallback;
 
         //////////////////////////////////////////////////////////////////////////
-        /// New transaction query callback system
+        /// New query callback system, completions posted by the database workers
+        /// and run from ProcessQueryCallbacks on the thread updating the session
         //////////////////////////////////////////////////////////////////////////
-        using TransactionCallbacks = std::forward_list < std::shared_ptr<MS::Utilities::Callback> > ;
-        std::unique_ptr<TransactionCallbacks> m_TransactionCallbacks;
-        std::mutex m_TransactionCallbackLock;
-
-        //////////////////////////////////////////////////////////////////////////
-        /// New prepare statement query callback system
-        //////////////////////////////////////////////////////////////////////////
-        using PrepareStatementCallback = std::pair < std::function<void(PreparedQueryResult)>, PreparedQueryResultFuture > ;
-        using PreparedStatementCallbacks = std::forward_list < PrepareStatementCallback > ;
-        std::unique_ptr<PreparedStatementCallbacks> m_PreparedStatementCallbacks;
-        std::unique_ptr<PreparedStatementCallbacks> m_PreparedStatementCallbacksBuffer;
-        std::mutex m_PreparedStatementCallbackLock;
+        SQLCallbackQueuePtr m_QueryCallbackQueue;
 
     private:
+        /// Takes one token from the rate budget of the opcode cost class, see OpcodeBudget.* config
+        /// @p_Opcode : Client opcode about to be handled
+        /// Return false if the packet must wait for the next update
+        bool ConsumeOpcodeBudget(uint16 p_Opcode);
+
+        /// Lets a packet out of the receive queue only if the filter accepts it and its opcode is within budget,
+        /// a packet over budget stays at the head of the queue so the packets of the session keep their order
+        class BudgetedPacketFilter
+        {
+            public:
+                BudgetedPacketFilter(PacketFilter& p_Filter, WorldSession* p_Session) : m_Filter(p_Filter), m_Session(p_Session) { }
+
+                bool Process(WorldPacket* p_Packet)
+                {
+                    return m_Filter.Process(p_Packet) && m_Session->ConsumeOpcodeBudget(p_Packet->GetOpcode());
+                }
+
+            private:
+                PacketFilter& m_Filter;
+                WorldSession* m_Session;
+        };
+
+        struct OpcodeBudget
+        {
+            uint32 Tokens;                                  ///< Thousandths of packet
+            uint32 LastRefill;
+        };
+
+        OpcodeBudget m_OpcodeBudgets[MAX_OPCODE_COST_CLASS];
+
         // private trade methods
         void moveItems(Item* myItems[], Item* hisItems[]);
 
@@ -19,6 +19,7 @@
 #include <ace/Auto_Ptr.h>
 
 #include "WorldSocket.h"
+#include "SharedWorldPacket.h"
 #include "Common.h"
 
 #include "Util.h"
@@ -148,9 +149,37 @@ const std::string& WorldSocket::GetRemoteAddress (void) const
 }
 
 int WorldSocket::SendPacket(WorldPacket const& pct)
+{
+    return SendPacket(pct, nullptr);
+}
+
+int WorldSocket::SendPacket(SharedWorldPacket const& p_Packet)
+{
+    return SendPacket(p_Packet.GetPacket(), &p_Packet);
+}
+
+int WorldSocket::SendPackets(SharedWorldPacket const* const* p_Packets, size_t p_Count)
+{
+    ACE_GUARD_RETURN (LockType, Guard, m_OutBufferLock, -1);
+
+    for (size_t l_I = 0; l_I < p_Count; ++l_I)
+    {
+        if (SendPacketLocked(p_Packets[l_I]->GetPacket(), p_Packets[l_I]) == -1)
+            return -1;
+    }
+
+    return 0;
+}
+
+int WorldSocket::SendPacket(WorldPacket const& pct, SharedWorldPacket const* p_Shared)
 {
     ACE_GUARD_RETURN (LockType, Guard, m_OutBufferLock, -1);
 
+    return SendPacketLocked(pct, p_Shared);
+}
+
+int WorldSocket::SendPacketLocked(WorldPacket const& pct, SharedWorldPacket const* p_Shared)
+{
     if (closing_)
         return -1;
 
@@ -162,7 +191,10 @@ int WorldSocket::SendPacket(WorldPacket const& pct)
         return 0;
 
     WorldPacket const* pkt = &pct;
-    const_cast<WorldPacket*>(pkt)->FlushBits();
+
+    // already done once for every recipient of a shared packet
+    if (!p_Shared)
+        const_cast<WorldPacket*>(pkt)->FlushBits();
 
     gSentBytes += pkt->size() + 3;
 
@@ -197,6 +229,20 @@ int WorldSocket::SendPacket(WorldPacket const& pct)
         if (m_OutBuffer->copy((char*)pkt->contents(), pkt->size()) == -1)
             ACE_ASSERT(false);
     }
+    else if (p_Shared)
+    {
+        // Enqueue our own header followed by a reference to the payload shared by every recipient
+        ACE_Message_Block* mb;
+
+        ACE_NEW_RETURN(mb, ACE_Message_Block(header.getHeaderLength()), -1);
+        mb->copy((char*)header.header, header.getHeaderLength());
+
+        if (EnqueueMessageBlock(mb) == -1)
+            return -1;
+
+        if (!pkt->empty() && EnqueueMessageBlock(p_Shared->DuplicatePayload()) == -1)
+            return -1;
+    }
     else
     {
         // Enqueue the packet.
@@ -209,12 +255,20 @@ int WorldSocket::SendPacket(WorldPacket const& pct)
         if (!pkt->empty())
             mb->copy((const char*)pkt->contents(), pkt->size());
 
-        if (msg_queue()->enqueue_tail(mb, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
-        {
-            sLog->outError(LOG_FILTER_NETWORKIO, "WorldSocket::SendPacket enqueue_tail failed");
-            mb->release();
+        if (EnqueueMessageBlock(mb) == -1)
             return -1;
-        }
+    }
+
+    return 0;
+}
+
+int WorldSocket::EnqueueMessageBlock(ACE_Message_Block* p_Block)
+{
+    if (msg_queue()->enqueue_tail(p_Block, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
+    {
+        sLog->outError(LOG_FILTER_NETWORKIO, "WorldSocket::SendPacket enqueue_tail failed");
+        p_Block->release();
+        return -1;
     }
 
     return 0;
@@ -35,6 +35,7 @@
 
 class ACE_Message_Block;
 class WorldPacket;
+class SharedWorldPacket;
 class WorldSession;
 
 /// Handler that can communicate over stream sockets.
@@ -102,6 +103,17 @@ class WorldSocket : public WorldHandler
         /// @return -1 of failure
         int SendPacket(const WorldPacket& pct);
 
+        /// Send a packet shared by many sockets, see SharedWorldPacket
+        /// @p_Packet : Packet to send
+        /// @return -1 of failure
+        int SendPacket(SharedWorldPacket const& p_Packet);
+
+        /// Send several shared packets in a row, the output lock is only taken once
+        /// @p_Packets : Packets to send
+        /// @p_Count   : Number of packets
+        /// @return -1 of failure
+        int SendPackets(SharedWorldPacket const* const* p_Packets, size_t p_Count);
+
         /// Add reference to this object.
         long AddReference (void);
 
@@ -143,6 +155,16 @@ class WorldSocket : public WorldHandler
         /// Drain the queue if its not empty.
         int handle_output_queue (GuardType& g);
 
+        /// Common part of both SendPacket, p_Shared is NULL for a packet sent to this socket only
+        int SendPacket(WorldPacket const& pct, SharedWorldPacket const* p_Shared);
+
+        /// SendPacket body, m_OutBufferLock must be held
+        int SendPacketLocked(WorldPacket const& pct, SharedWorldPacket const* p_Shared);
+
+        /// Queue a block to be sent once the output buffer is flushed, m_OutBufferLock must be held
+        /// @return -1 of failure, the block is released
+        int EnqueueMessageBlock(ACE_Message_Block* p_Block);
+
         /// process one incoming packet.
         /// @param new_pct received packet, note that you need to delete it.
         int ProcessIncoming (WorldPacket* new_pct);
@@ -3435,6 +3435,12 @@ void DynObjAura::FillTargetMap(std::map<Unit*, uint32> & targets, Unit* /*caster
     Unit* dynObjOwnerCaster = GetDynobjOwner()->GetCaster();
     float radius = GetDynobjOwner()->GetRadius();
 
+    // one search per kind of target, shared by the effects
+    UnitList allyTargets;
+    UnitList aoeTargets;
+    bool allySearched = false;
+    bool aoeSearched = false;
+
     for (uint8 effIndex = 0; effIndex < m_EffectCount; ++effIndex)
     {
         if (!HasEffect(effIndex))
@@ -3445,22 +3451,35 @@ void DynObjAura::FillTargetMap(std::map<Unit*, uint32> & targets, Unit* /*caster
             if (effIndex != 0)
                 continue;
 
-        UnitList targetList;
+        UnitList* targetList = NULL;
         if (GetSpellInfo()->Effects[effIndex].TargetB.GetTarget() == TARGET_DEST_DYNOBJ_ALLY
             || GetSpellInfo()->Effects[effIndex].TargetB.GetTarget() == TARGET_UNIT_DEST_AREA_ALLY)
         {
-            JadeCore::AnyFriendlyUnitInObjectRangeCheck u_check(GetDynobjOwner(), dynObjOwnerCaster, radius);
-            JadeCore::UnitListSearcher<JadeCore::AnyFriendlyUnitInObjectRangeCheck> searcher(GetDynobjOwner(), targetList, u_check);
-            GetDynobjOwner()->VisitNearbyObject(radius, searcher);
+            targetList = &allyTargets;
+            if (!allySearched)
+            {
+                JadeCore::AnyFriendlyUnitInObjectRangeCheck u_check(GetDynobjOwner(), dynObjOwnerCaster, radius);
+                JadeCore::UnitListSearcher<JadeCore::AnyFriendlyUnitInObjectRangeCheck> searcher(GetDynobjOwner(), allyTargets, u_check);
+                GetDynobjOwner()->VisitNearbyObject(radius, searcher);
+                allySearched = true;
+            }
         }
         else if (GetSpellInfo()->Effects[effIndex].Effect != SPELL_EFFECT_CREATE_AREATRIGGER)
         {
-            JadeCore::AnyAoETargetUnitInObjectRangeCheck u_check(GetDynobjOwner(), dynObjOwnerCaster, radius);
-            JadeCore::UnitListSearcher<JadeCore::AnyAoETargetUnitInObjectRangeCheck> searcher(GetDynobjOwner(), targetList, u_check);
-            GetDynobjOwner()->VisitNearbyObject(radius, searcher);
+            targetList = &aoeTargets;
+            if (!aoeSearched)
+            {
+                JadeCore::AnyAoETargetUnitInObjectRangeCheck u_check(GetDynobjOwner(), dynObjOwnerCaster, radius);
+                JadeCore::UnitListSearcher<JadeCore::AnyAoETargetUnitInObjectRangeCheck> searcher(GetDynobjOwner(), aoeTargets, u_check);
+                GetDynobjOwner()->VisitNearbyObject(radius, searcher);
+                aoeSearched = true;
+            }
         }
 
-        for (UnitList::iterator itr = targetList.begin(); itr!= targetList.end();++itr)
+        if (!targetList)
+            continue;
+
+        for (UnitList::iterator itr = targetList->begin(); itr!= targetList->end();++itr)
         {
             if (dynObjOwnerCaster->MagicSpellHitResult((*itr), m_spellInfo))
                 continue;
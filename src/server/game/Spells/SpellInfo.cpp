@@ -403,6 +403,38 @@ SpellEffectInfo::SpellEffectInfo(SpellEntry const* spellEntry, SpellInfo const*
     GroupSizeCoefficient = l_GroupSize ? l_GroupSize->Coefficient : 0.0f;
 }
 
+SpellEffectInfo::SpellEffectInfo(SpellInfo const* spellInfo, uint8 effIndex)
+{
+    _spellInfo = spellInfo;
+    _effIndex = effIndex;
+    Effect = 0;
+    ApplyAuraName = 0;
+    Amplitude = 0;
+    DieSides = 0;
+    RealPointsPerLevel = 0.0f;
+    BasePoints = 0;
+    PointsPerComboPoint = 0.0f;
+    ValueMultiplier = 0.0f;
+    DamageMultiplier = 0.0f;
+    BonusMultiplier = 0.0f;
+    MiscValue = 0;
+    MiscValueB = 0;
+    Mechanic = MECHANIC_NONE;
+    TargetA = SpellImplicitTargetInfo(0);
+    TargetB = SpellImplicitTargetInfo(0);
+    RadiusEntry = NULL;
+    ChainTarget = 0;
+    ItemType = 0;
+    TriggerSpell = 0;
+    SpellClassMask = flag128(0);
+    ImplicitTargetConditions = NULL;
+    ScalingMultiplier = 0.0f;
+    DeltaScalingMultiplier = 0.0f;
+    ComboScalingMultiplier = 0.0f;
+    AttackPowerMultiplier = 0.0f;
+    GroupSizeCoefficient = 0.0f;
+}
+
 bool SpellEffectInfo::IsEffect() const
 {
     return Effect != 0;
@@ -470,6 +502,10 @@ int32 SpellEffectInfo::CalcValue(Unit const* p_Caster, int32 const* p_Bp, Unit c
     int32 l_BasePoints = p_Bp ? *p_Bp : BasePoints;
     float l_ComboDamage = PointsPerComboPoint;
 
+    /// Shared empty effect, the spell doesn't have this index
+    if (!_spellInfo)
+        return l_BasePoints;
+
     // base amount modification based on spell lvl vs caster lvl
     if (ScalingMultiplier != 0.0f)
     {
@@ -668,6 +704,9 @@ int32 SpellEffectInfo::CalcBaseValue(int32 value) const
 float SpellEffectInfo::CalcValueMultiplier(Unit* caster, Spell* spell) const
 {
     float multiplier = ValueMultiplier;
+    if (!_spellInfo)
+        return multiplier;
+
     if (Player* modOwner = (caster ? caster->GetSpellModOwner() : NULL))
         modOwner->ApplySpellMod(_spellInfo->Id, SPELLMOD_VALUE_MULTIPLIER, multiplier, spell);
     return multiplier;
@@ -676,6 +715,8 @@ float SpellEffectInfo::CalcValueMultiplier(Unit* caster, Spell* spell) const
 float SpellEffectInfo::CalcDamageMultiplier(Unit* p_Caster, Spell* p_Spell) const
 {
     float l_Multiplier = DamageMultiplier * 100.0f;
+    if (!_spellInfo)
+        return DamageMultiplier;
 
     if (Player* l_ModOwner = (p_Caster ? p_Caster->GetSpellModOwner() : nullptr))
         l_ModOwner->ApplySpellMod(_spellInfo->Id, SPELLMOD_DAMAGE_MULTIPLIER, l_Multiplier, p_Spell);
@@ -700,6 +741,37 @@ float SpellEffectInfo::CalcRadius(Unit* caster, Spell* spell) const
     return radius;
 }
 
+/// Shared by all the spells for the indexes they don't use
+static struct SpellEffectInfoEmptyEffects
+{
+    SpellEffectInfoEmptyEffects()
+    {
+        for (uint8 l_I = 0; l_I < SpellEffIndex::MAX_EFFECTS; ++l_I)
+            Effects[l_I] = SpellEffectInfo(nullptr, l_I);
+    }
+
+    SpellEffectInfo Effects[SpellEffIndex::MAX_EFFECTS];
+} s_EmptySpellEffects;
+
+SpellEffectInfo const& SpellEffectInfoArray::GetEmptyEffect(uint32 p_Index)
+{
+    return s_EmptySpellEffects.Effects[p_Index];
+}
+
+void SpellEffectInfoArray::Resize(uint8 p_Count)
+{
+    if (p_Count == m_Count)
+        return;
+
+    SpellEffectInfo* l_Effects = p_Count ? new SpellEffectInfo[p_Count] : nullptr;
+    for (uint8 l_I = 0; l_I < p_Count; ++l_I)
+        l_Effects[l_I] = l_I < m_Count ? m_Effects[l_I] : SpellEffectInfo(m_Owner, l_I);
+
+    delete[] m_Effects;
+    m_Effects = l_Effects;
+    m_Count   = p_Count;
+}
+
 uint32 SpellEffectInfo::GetProvidedTargetMask() const
 {
     return GetTargetFlagMask(TargetA.GetObjectType()) | GetTargetFlagMask(TargetB.GetObjectType());
@@ -1001,6 +1073,7 @@ SpellEffectInfo::StaticData  SpellEffectInfo::_data[TOTAL_SPELL_EFFECTS] =
 };
 
 SpellInfo::SpellInfo(SpellEntry const* p_SpellEntry, uint32 p_Difficulty, SpellVisualMap&& p_Visuals)
+    : Effects(this)
 {
     Id = p_SpellEntry->Id;
     DifficultyID = p_Difficulty;
@@ -1028,7 +1101,8 @@ SpellInfo::SpellInfo(SpellEntry const* p_SpellEntry, uint32 p_Difficulty, SpellV
     SpellTotemsId = p_SpellEntry->SpellTotemsId;
     SpellMiscId = p_SpellEntry->SpellMiscId;
 
-    // SpellDifficultyEntry
+    // SpellDifficultyEntry, all the indexes are kept until the corrections are applied, see CompactEffects
+    Effects.Resize(SpellEffIndex::MAX_EFFECTS);
     for (uint8 i = 0; i < SpellEffIndex::MAX_EFFECTS; ++i)
         Effects[i] = SpellEffectInfo(p_SpellEntry, this, i, p_Difficulty);
 
@@ -3765,13 +3839,13 @@ void SpellInfo::SetCastTimeIndex(uint32 index)
 void SpellInfo::_UnloadImplicitTargetConditionLists()
 {
     // find the same instances of ConditionContainer and delete them.
-    for (uint8 i = 0; i < EffectCount; ++i)
+    for (uint8 i = 0; i < Effects.GetStoredCount(); ++i)
     {
         ConditionContainer* cur = Effects[i].ImplicitTargetConditions;
         if (!cur)
             continue;
 
-        for (uint8 j = i; j < EffectCount; ++j)
+        for (uint8 j = i; j < Effects.GetStoredCount(); ++j)
         {
             if (Effects[j].ImplicitTargetConditions == cur)
                 Effects[j].ImplicitTargetConditions = NULL;
@@ -4837,13 +4911,19 @@ std::string SpellInfo::GetNameForLogging() const
 void SpellInfo::UpdateSpellEffectCount()
 {
     EffectCount = 0;
-    for (uint8 l_I = 0; l_I < SpellEffIndex::MAX_EFFECTS; ++l_I)
+    for (uint8 l_I = 0; l_I < Effects.GetStoredCount(); ++l_I)
     {
         if (Effects[l_I].IsEffect())
             EffectCount = l_I + 1;
     }
 }
 
+void SpellInfo::CompactEffects()
+{
+    UpdateSpellEffectCount();
+    Effects.Resize(EffectCount);
+}
+
 bool SpellInfo::IsAffectedByWodAuraSystem() const
 {
     switch (Id)
@@ -280,6 +280,7 @@ public:
     float     GroupSizeCoefficient;
 
     SpellEffectInfo() {}
+    SpellEffectInfo(SpellInfo const* spellInfo, uint8 effIndex);
     SpellEffectInfo(SpellEntry const* spellEntry, SpellInfo const* spellInfo, uint8 effIndex, uint32 difficulty);
 
     bool IsEffect() const;
@@ -321,6 +322,46 @@ private:
     static StaticData _data[TOTAL_SPELL_EFFECTS];
 };
 
+/// Effects of a spell, only the used ones are stored once the spell store is loaded.
+/// Reading an unused index gives a shared empty effect, writing one (load time corrections) allocates it.
+class SpellEffectInfoArray
+{
+    public:
+        explicit SpellEffectInfoArray(SpellInfo const* p_Owner) : m_Owner(p_Owner), m_Effects(nullptr), m_Count(0) { }
+        ~SpellEffectInfoArray() { delete[] m_Effects; }
+
+        SpellEffectInfo const& operator[](uint32 p_Index) const
+        {
+            if (p_Index < m_Count)
+                return m_Effects[p_Index];
+
+            return GetEmptyEffect(p_Index);
+        }
+
+        SpellEffectInfo& operator[](uint32 p_Index)
+        {
+            if (p_Index >= m_Count)
+                Resize(p_Index + 1);
+
+            return m_Effects[p_Index];
+        }
+
+        uint8 GetStoredCount() const { return m_Count; }
+
+        /// Effects past p_Count are dropped, missing ones are added empty
+        void Resize(uint8 p_Count);
+
+        static SpellEffectInfo const& GetEmptyEffect(uint32 p_Index);
+
+    private:
+        SpellInfo const* m_Owner;
+        SpellEffectInfo* m_Effects;
+        uint8            m_Count;
+
+        SpellEffectInfoArray(SpellEffectInfoArray const&);
+        SpellEffectInfoArray& operator=(SpellEffectInfoArray const&);
+};
+
 typedef std::vector<SpellXSpellVisualEntry const*> SpellVisualVector;
 typedef std::unordered_map<uint32, SpellVisualVector> SpellVisualMap;
 
@@ -432,7 +473,7 @@ public:
     int32  ScalingClass;
     float  NerfFactor;
     int32  NerfMaxLevel;
-    SpellEffectInfo Effects[SpellEffIndex::MAX_EFFECTS];
+    SpellEffectInfoArray Effects;
     uint32 ExplicitTargetMask;
     SpellChainNode const* ChainEntry;
     std::list<SpellPowerEntry const*> SpellPowers;
@@ -664,6 +705,8 @@ public:
 
     /// Cache the maximum number of effects
     void UpdateSpellEffectCount();
+    /// Release the unused effects, done once the corrections are applied
+    void CompactEffects();
 
     /// Handler for new Wod aura system
     bool IsAffectedByWodAuraSystem() const;
@@ -1416,13 +1416,7 @@ void SpellMgr::LoadSpellRanks()
 
     // cleanup core data before reload - remove reference to ChainNode from SpellInfo
     for (SpellChainMap::iterator itr = mSpellChains.begin(); itr != mSpellChains.end(); ++itr)
-    {
-        for (int difficulty = 0; difficulty < Difficulty::MaxDifficulties; difficulty++)
-        {
-            if (mSpellInfoMap[difficulty][itr->first])
-                mSpellInfoMap[difficulty][itr->first]->ChainEntry = NULL;
-        }
-    }
+        _ForEachSpellDifficulty(itr->first, [](SpellInfo* p_SpellInfo) { p_SpellInfo->ChainEntry = NULL; });
     mSpellChains.clear();
     //                                                     0             1      2
     QueryResult result = WorldDatabase.Query("SELECT first_spell_id, spell_id, rank from spell_ranks ORDER BY first_spell_id, rank");
@@ -1511,9 +1505,8 @@ void SpellMgr::LoadSpellRanks()
             mSpellChains[addedSpell].last = GetSpellInfo(rankChain.back().first);
             mSpellChains[addedSpell].rank = itr->second;
             mSpellChains[addedSpell].prev = GetSpellInfo(prevRank);
-            for (int difficulty = 0; difficulty < Difficulty::MaxDifficulties; difficulty++)
-                if (mSpellInfoMap[difficulty][addedSpell])
-                    mSpellInfoMap[difficulty][addedSpell]->ChainEntry = &mSpellChains[addedSpell];
+            SpellChainNode const* chainNode = &mSpellChains[addedSpell];
+            _ForEachSpellDifficulty(addedSpell, [chainNode](SpellInfo* p_SpellInfo) { p_SpellInfo->ChainEntry = chainNode; });
             prevRank = addedSpell;
             ++itr;
             if (itr == rankChain.end())
@@ -3122,8 +3115,19 @@ void SpellMgr::LoadSpellInfoStore()
     uint32 oldMSTime = getMSTime();
 
     UnloadSpellInfoStore();
-    for (int difficulty = 0; difficulty < Difficulty::MaxDifficulties; difficulty++)
-        mSpellInfoMap[difficulty].resize(sSpellStore.GetNumRows(), nullptr);
+    mSpellInfoMap.resize(sSpellStore.GetNumRows(), nullptr);
+
+    /// Only the difficulties having their own rows get a SpellInfo, the other ones fall back on the base spell.
+    /// Slots are created here, the loading threads below only fill them.
+    for (AvaiableDifficultySpell::const_iterator l_Itr = mAvaiableDifficultyBySpell.begin(); l_Itr != mAvaiableDifficultyBySpell.end(); ++l_Itr)
+    {
+        if (!sSpellStore.LookupEntry(l_Itr->first))
+            continue;
+
+        uint32 l_VariantCount = l_Itr->second.size() - l_Itr->second.count(DifficultyNone);
+        if (l_VariantCount)
+            mSpellDifficultyVariants[l_Itr->first].resize(l_VariantCount, nullptr);
+    }
 
     for (uint32 l_ID = 0; l_ID < sSpellXSpellVisualStore.GetNumRows(); ++l_ID)
     {
@@ -3142,10 +3146,22 @@ void SpellMgr::LoadSpellInfoStore()
             SpellVisualMap emptyMap;
             SpellVisualMap& visualMap = (l_Itr == VisualsBySpellMap.end()) ? emptyMap : l_Itr->second;
 
-            std::set<uint32> difficultyInfo = mAvaiableDifficultyBySpell[l_I];
+            AvaiableDifficultySpell::const_iterator l_Difficulties = mAvaiableDifficultyBySpell.find(l_I);
+            if (l_Difficulties == mAvaiableDifficultyBySpell.end())
+                return;
+
+            SpellDifficultyVariantsMap::iterator l_Variants = mSpellDifficultyVariants.find(l_I);
+            uint32 l_VariantIndex = 0;
+
+            for (uint32 l_Difficulty : l_Difficulties->second)
+            {
+                SpellInfo* l_SpellInfo = new SpellInfo(spellEntry, l_Difficulty, std::move(visualMap));
 
-            for (std::set<uint32>::iterator itr = difficultyInfo.begin(); itr != difficultyInfo.end(); itr++)
-                mSpellInfoMap[(*itr)][l_I] = new SpellInfo(spellEntry, (*itr), std::move(visualMap));
+                if (l_Difficulty == DifficultyNone)
+                    mSpellInfoMap[l_I] = l_SpellInfo;
+                else
+                    l_Variants->second[l_VariantIndex++] = l_SpellInfo;
+            }
         }
     });
 
@@ -3155,14 +3171,7 @@ void SpellMgr::LoadSpellInfoStore()
         if (!spellPower)
             continue;
 
-        for (int difficulty = 0; difficulty < Difficulty::MaxDifficulties; difficulty++)
-        {
-            SpellInfo* spell = mSpellInfoMap[difficulty][spellPower->SpellId];
-            if (!spell)
-                continue;
-
-            spell->SpellPowers.push_back(spellPower);
-        }
+        _ForEachSpellDifficulty(spellPower->SpellId, [spellPower](SpellInfo* p_SpellInfo) { p_SpellInfo->SpellPowers.push_back(spellPower); });
     }
 
     for (uint32 l_I = 0; l_I < sTalentStore.GetNumRows(); l_I++)
@@ -3171,7 +3180,7 @@ void SpellMgr::LoadSpellInfoStore()
         if (!l_TalentEntry)
             continue;
 
-        SpellInfo* l_SpellInfo = mSpellInfoMap[DifficultyNone][l_TalentEntry->SpellID];
+        SpellInfo* l_SpellInfo = _GetSpellInfo(l_TalentEntry->SpellID, DifficultyNone);
         if (l_SpellInfo)
             l_SpellInfo->m_TalentIDs.push_back(l_TalentEntry->Id);
 
@@ -3189,27 +3198,84 @@ void SpellMgr::LoadSpellInfoStore()
 
 void SpellMgr::UnloadSpellInfoStore()
 {
-    for (int difficulty = 0; difficulty < Difficulty::MaxDifficulties; difficulty++)
+    for (uint32 i = 0; i < mSpellInfoMap.size(); ++i)
+    {
+        if (mSpellInfoMap[i])
+            delete mSpellInfoMap[i];
+    }
+    mSpellInfoMap.clear();
+
+    for (SpellDifficultyVariantsMap::iterator itr = mSpellDifficultyVariants.begin(); itr != mSpellDifficultyVariants.end(); ++itr)
+    {
+        for (SpellInfo* spellInfo : itr->second)
+            delete spellInfo;
+    }
+    mSpellDifficultyVariants.clear();
+}
+
+void SpellMgr::UnloadSpellInfoImplicitTargetConditionLists()
+{
+    for (uint32 i = 0; i < mSpellInfoMap.size(); ++i)
+    {
+        if (mSpellInfoMap[i])
+            mSpellInfoMap[i]->_UnloadImplicitTargetConditionLists();
+    }
+
+    for (SpellDifficultyVariantsMap::iterator itr = mSpellDifficultyVariants.begin(); itr != mSpellDifficultyVariants.end(); ++itr)
+    {
+        for (SpellInfo* spellInfo : itr->second)
+            spellInfo->_UnloadImplicitTargetConditionLists();
+    }
+}
+
+SpellInfo* SpellMgr::_GetSpellInfo(uint32 p_SpellID, uint32 p_Difficulty) const
+{
+    if (p_Difficulty == DifficultyNone)
+        return p_SpellID < mSpellInfoMap.size() ? mSpellInfoMap[p_SpellID] : nullptr;
+
+    if (SpellDifficultyVariants const* l_Variants = GetSpellDifficultyVariants(p_SpellID))
     {
-        for (uint32 i = 0; i < mSpellInfoMap[difficulty].size(); ++i)
+        for (SpellInfo* l_SpellInfo : *l_Variants)
         {
-            if (mSpellInfoMap[difficulty][i])
-                delete mSpellInfoMap[difficulty][i];
+            if (l_SpellInfo->DifficultyID == p_Difficulty)
+                return l_SpellInfo;
         }
-        mSpellInfoMap[difficulty].clear();
     }
+
+    return nullptr;
 }
 
-void SpellMgr::UnloadSpellInfoImplicitTargetConditionLists()
+void SpellMgr::_SetSpellInfo(uint32 p_SpellID, uint32 p_Difficulty, SpellInfo* p_SpellInfo)
 {
-    for (int difficulty = 0; difficulty < Difficulty::MaxDifficulties; difficulty++)
+    if (p_Difficulty == DifficultyNone)
+    {
+        if (p_SpellID >= mSpellInfoMap.size())
+            mSpellInfoMap.resize(p_SpellID + 1, nullptr);
+
+        mSpellInfoMap[p_SpellID] = p_SpellInfo;
+        return;
+    }
+
+    SpellDifficultyVariants& l_Variants = mSpellDifficultyVariants[p_SpellID];
+    for (SpellInfo*& l_SpellInfo : l_Variants)
     {
-        for (uint32 i = 0; i < mSpellInfoMap[difficulty].size(); ++i)
+        if (l_SpellInfo->DifficultyID == p_Difficulty)
         {
-            if (mSpellInfoMap[difficulty][i])
-                mSpellInfoMap[difficulty][i]->_UnloadImplicitTargetConditionLists();
+            l_SpellInfo = p_SpellInfo;
+            return;
         }
     }
+
+    l_Variants.push_back(p_SpellInfo);
+}
+
+SpellDifficultyVariants const* SpellMgr::GetSpellDifficultyVariants(uint32 p_SpellID) const
+{
+    SpellDifficultyVariantsMap::const_iterator l_Itr = mSpellDifficultyVariants.find(p_SpellID);
+    if (l_Itr == mSpellDifficultyVariants.end())
+        return nullptr;
+
+    return &l_Itr->second;
 }
 
 void SpellMgr::LoadSpellCustomAttr()
@@ -3217,13 +3283,15 @@ void SpellMgr::LoadSpellCustomAttr()
     uint32 oldMSTime = getMSTime();
 
     SpellInfo* spellInfo = NULL;
+    std::vector<SpellInfo*> spellInfos;
     for (uint32 i = 0; i < GetSpellInfoStoreSize(); ++i)
     {
-        for (int difficulty = 0; difficulty < Difficulty::MaxDifficulties; difficulty++)
+        spellInfos.clear();
+        _ForEachSpellDifficulty(i, [&spellInfos](SpellInfo* p_SpellInfo) { spellInfos.push_back(p_SpellInfo); });
+
+        for (SpellInfo* difficultySpellInfo : spellInfos)
         {
-            spellInfo = mSpellInfoMap[difficulty][i];
-            if (!spellInfo)
-                continue;
+            spellInfo = difficultySpellInfo;
 
             for (uint8 j = 0; j < spellInfo->EffectCount; ++j)
             {
@@ -6884,9 +6952,9 @@ void SpellMgr::LoadSpellCustomAttr()
             case 110412: ///< Zen Master Fishing
             {
                 std::unordered_map<uint32, SpellVisualMap> l_VisualsBySpell;
-                SpellInfo* fishingDummy = new SpellInfo(sSpellStore.LookupEntry(131474), difficulty, std::move(l_VisualsBySpell[spellInfo->Effects[0].TriggerSpell]));
+                SpellInfo* fishingDummy = new SpellInfo(sSpellStore.LookupEntry(131474), spellInfo->DifficultyID, std::move(l_VisualsBySpell[spellInfo->Effects[0].TriggerSpell]));
                 fishingDummy->Id = spellInfo->Effects[0].TriggerSpell;
-                mSpellInfoMap[difficulty][spellInfo->Effects[0].TriggerSpell] = fishingDummy;
+                _SetSpellInfo(spellInfo->Effects[0].TriggerSpell, spellInfo->DifficultyID, fishingDummy);
                 break;
             }
             /// Mogu'shan Vault
@@ -7833,6 +7901,10 @@ void SpellMgr::LoadSpellCustomAttr()
         }
     }
 
+    /// Corrections are done, only the effects the spells use are kept
+    for (uint32 i = 0; i < GetSpellInfoStoreSize(); ++i)
+        _ForEachSpellDifficulty(i, [](SpellInfo* p_SpellInfo) { p_SpellInfo->CompactEffects(); });
+
     CreatureAI::FillAISpellInfo();
 
     sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Loaded spell custom attributes in %u ms", GetMSTimeDiffToNow(oldMSTime));
@@ -7854,21 +7926,27 @@ const SpellInfo* SpellMgr::GetSpellInfo(uint32 p_SpellID, Difficulty p_Difficult
 {
     if (p_SpellID < GetSpellInfoStoreSize())
     {
+        /// Most spells don't have any variant, the fallback chain is only walked for the others
         if (p_Difficulty != DifficultyNone)
         {
-            /// If spell isn't available in difficulty we want, check fallback difficulty ...
-            DifficultyEntry const* l_Difficulty = sDifficultyStore.LookupEntry(p_Difficulty);
-            while (l_Difficulty != nullptr)
+            if (SpellDifficultyVariants const* l_Variants = GetSpellDifficultyVariants(p_SpellID))
             {
-                SpellInfo const* l_SpellInfo = mSpellInfoMap[l_Difficulty->ID][p_SpellID];
-                if (l_SpellInfo != nullptr)
-                    return l_SpellInfo;
+                /// If spell isn't available in difficulty we want, check fallback difficulty ...
+                DifficultyEntry const* l_Difficulty = sDifficultyStore.LookupEntry(p_Difficulty);
+                while (l_Difficulty != nullptr && l_Difficulty->ID != DifficultyNone)
+                {
+                    for (SpellInfo const* l_SpellInfo : *l_Variants)
+                    {
+                        if (l_SpellInfo->DifficultyID == l_Difficulty->ID)
+                            return l_SpellInfo;
+                    }
 
-                l_Difficulty = sDifficultyStore.LookupEntry(l_Difficulty->FallbackDifficultyID);
+                    l_Difficulty = sDifficultyStore.LookupEntry(l_Difficulty->FallbackDifficultyID);
+                }
             }
         }
 
-        return mSpellInfoMap[DifficultyNone][p_SpellID];
+        return mSpellInfoMap[p_SpellID];
     }
 
     return nullptr;
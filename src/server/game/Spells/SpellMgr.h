@@ -567,6 +567,9 @@ typedef std::vector<uint32> SpellCustomAttribute;
 typedef std::vector<bool> EnchantCustomAttribute;
 
 typedef std::vector<SpellInfo*> SpellInfoMap;
+/// Spells having their own DB2 rows for some difficulties, the DifficultyNone version isn't included
+typedef std::vector<SpellInfo*> SpellDifficultyVariants;
+typedef std::unordered_map<uint32, SpellDifficultyVariants> SpellDifficultyVariantsMap;
 
 typedef std::map<int32, std::vector<int32> > SpellLinkedMap;
 
@@ -708,7 +711,9 @@ class SpellMgr
         // SpellInfo object management
         SpellInfo const* GetSpellInfo(uint32 spellId, Difficulty difficulty = DifficultyNone) const;
         int64 GetSpellVisualOverride(uint32 p_SpellID) const;
-        uint32 GetSpellInfoStoreSize() const { return mSpellInfoMap[DifficultyNone].size(); }
+        uint32 GetSpellInfoStoreSize() const { return mSpellInfoMap.size(); }
+        /// nullptr if the spell only exists for DifficultyNone
+        SpellDifficultyVariants const* GetSpellDifficultyVariants(uint32 p_SpellID) const;
         std::set<uint32> GetSpellClassList(uint8 ClassID) const { return mSpellClassInfo[ClassID]; }
         std::list<uint32> GetSpellPowerList(uint32 spellId) const { return mSpellPowerInfo[spellId]; }
         TalentsPlaceHoldersSpell GetTalentPlaceHoldersSpell() const { return mPlaceHolderSpells; }
@@ -824,6 +829,21 @@ class SpellMgr
         std::vector<uint32>        mSpellCreateItemList;
 
     private:
+        /// Exact difficulty, no fallback, used while loading the store
+        SpellInfo* _GetSpellInfo(uint32 p_SpellID, uint32 p_Difficulty) const;
+        void _SetSpellInfo(uint32 p_SpellID, uint32 p_Difficulty, SpellInfo* p_SpellInfo);
+
+        /// Calls p_Worker(SpellInfo*) on the DifficultyNone version then on the variants of the spell
+        template<class Worker> void _ForEachSpellDifficulty(uint32 p_SpellID, Worker p_Worker) const
+        {
+            if (p_SpellID < mSpellInfoMap.size() && mSpellInfoMap[p_SpellID])
+                p_Worker(mSpellInfoMap[p_SpellID]);
+
+            if (SpellDifficultyVariants const* l_Variants = GetSpellDifficultyVariants(p_SpellID))
+                for (SpellInfo* l_SpellInfo : *l_Variants)
+                    p_Worker(l_SpellInfo);
+        }
+
         SpellDifficultySearcherMap mSpellDifficultySearcherMap;
         SpellChainMap              mSpellChains;
         SpellsRequiringSpellMap    mSpellsReqSpell;
@@ -851,7 +871,8 @@ class SpellMgr
         SkillLineAbilityMap        mSkillLineAbilityMap;
         PetLevelupSpellMap         mPetLevelupSpellMap;
         PetDefaultSpellsMap        mPetDefaultSpellsMap;           // only spells not listed in related mPetLevelupSpellMap entry
-        SpellInfoMap               mSpellInfoMap[Difficulty::MaxDifficulties];
+        SpellInfoMap               mSpellInfoMap;                  // DifficultyNone
+        SpellDifficultyVariantsMap mSpellDifficultyVariants;
         SpellClassList             mSpellClassInfo;
         SpecializatioPerkMap       mSpecializationPerks;
         TalentSpellSet             mTalentSpellInfo;
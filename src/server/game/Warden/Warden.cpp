@@ -159,7 +159,11 @@ std::string Warden::Penalty(WardenCheck* check /*= NULL*/)
     WardenActions action;
 
     if (check)
+    {
+        // Overrides can be reloaded while sessions are updated
+        ACE_READ_GUARD_RETURN(ACE_RW_Mutex, g, sWardenCheckMgr->_checkStoreLock, "Undefined");
         action = check->Action;
+    }
     else
         action = WardenActions(sWorld->getIntConfig(CONFIG_WARDEN_CLIENT_FAIL_ACTION));
 
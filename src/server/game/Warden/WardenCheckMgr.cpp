@@ -131,6 +131,8 @@ void WardenCheckMgr::LoadWardenChecks()
         else
             wardenCheck->Comment = comment;
 
+        CompileCheck(wardenCheck, GetWardenResultById(id));
+
         ++count;
     }
     while (result->NextRow());
@@ -188,6 +190,72 @@ void WardenCheckMgr::LoadWardenOverrides()
 
 }
 
+void WardenCheckMgr::CompileCheck(WardenCheck* check, WardenCheckResult const* result)
+{
+    ByteBuffer request;
+
+    switch (check->Type)
+    {
+        case MEM_CHECK:
+            request << uint8(0x00);
+            request << uint32(check->Address);
+            request << uint8(check->Length);
+            break;
+        case PAGE_CHECK_A:
+        case PAGE_CHECK_B:
+            request.append(check->Data.AsByteArray(0, false), check->Data.GetNumBytes());
+            request << uint32(check->Address);
+            request << uint8(check->Length);
+            break;
+        case DRIVER_CHECK:
+            request.append(check->Data.AsByteArray(0, false), check->Data.GetNumBytes());
+            break;
+        default:
+            break;
+    }
+
+    if (request.size())
+        check->Request.assign(request.contents(), request.contents() + request.size());
+
+    if (!result)
+        return;
+
+    // Padded to the length compared with the client answer, a result shorter than that used to be compared with garbage
+    BigNumber expected = result->Result;
+    uint8 const* bytes = expected.AsByteArray(0, false);
+    check->Expected.assign(bytes, bytes + expected.GetNumBytes());
+    check->Expected.resize(check->Type == MEM_CHECK ? check->Length : 20, 0);
+}
+
+void WardenCheckMgr::DrawChecks(WardenCheckCycle& cycle, uint32 memChecks, uint32 otherChecks, std::vector<uint16>& checks) const
+{
+    checks.clear();
+
+    // If all checks were done, fill the todo list again
+    if (cycle.MemChecksTodo.empty())
+        cycle.MemChecksTodo = MemChecksIdPool;
+
+    if (cycle.OtherChecksTodo.empty())
+        cycle.OtherChecksTodo = OtherChecksIdPool;
+
+    std::vector<uint16>* pools[2] = { &cycle.MemChecksTodo, &cycle.OtherChecksTodo };
+    uint32 counts[2] = { memChecks, otherChecks };
+
+    for (uint8 i = 0; i < 2; ++i)
+    {
+        std::vector<uint16>& todo = *pools[i];
+
+        // Random pick swapped with the last id, a client can't predict the next checks from the order of the table
+        for (uint32 j = 0; j < counts[i] && !todo.empty(); ++j)
+        {
+            uint32 index = urand(0, todo.size() - 1);
+            checks.push_back(todo[index]);
+            todo[index] = todo.back();
+            todo.pop_back();
+        }
+    }
+}
+
 WardenCheck* WardenCheckMgr::GetWardenDataById(uint16 Id)
 {
     if (Id < CheckStore.size())
@@ -28,7 +28,11 @@ struct WardenCheck
     std::string Str;                                        // LUA, MPQ, DRIVER
     std::string Comment;
     uint16 CheckId;
-    enum WardenActions Action;
+    enum WardenActions Action;                              // Can be reloaded, read it under _checkStoreLock
+
+    // Built at load, everything above but Action is never changed afterwards
+    std::vector<uint8> Request;                             // Request bytes following the check type, but the string index and MODULE_CHECK seed
+    std::vector<uint8> Expected;                            // MEM_CHECK, MPQ_CHECK result bytes
 };
 
 struct WardenCheckResult
@@ -36,6 +40,13 @@ struct WardenCheckResult
     BigNumber Result;                                       // MEM_CHECK
 };
 
+// Checks of a client not sent yet, the pools are drawn in a random order and refilled once exhausted
+struct WardenCheckCycle
+{
+    std::vector<uint16> MemChecksTodo;
+    std::vector<uint16> OtherChecksTodo;
+};
+
 class WardenCheckMgr
 {
     friend class ACE_Singleton<WardenCheckMgr, ACE_Null_Mutex>;
@@ -56,9 +67,14 @@ class WardenCheckMgr
         void LoadWardenChecks();
         void LoadWardenOverrides();
 
+        // Fills checks with the ids of the next request, memory checks first
+        void DrawChecks(WardenCheckCycle& cycle, uint32 memChecks, uint32 otherChecks, std::vector<uint16>& checks) const;
+
         ACE_RW_Mutex _checkStoreLock;
 
     private:
+        static void CompileCheck(WardenCheck* check, WardenCheckResult const* result);
+
         CheckContainer CheckStore;
         CheckResultContainer CheckResultStore;
 };
@@ -168,54 +168,37 @@ void WardenWin::RequestData()
 {
     sLog->outDebug(LOG_FILTER_WARDEN, "Request data");
 
-    // If all checks were done, fill the todo list again
-    if (_memChecksTodo.empty())
-        _memChecksTodo.assign(sWardenCheckMgr->MemChecksIdPool.begin(), sWardenCheckMgr->MemChecksIdPool.end());
+    _serverTicks = getMSTime();
 
-    if (_otherChecksTodo.empty())
-        _otherChecksTodo.assign(sWardenCheckMgr->OtherChecksIdPool.begin(), sWardenCheckMgr->OtherChecksIdPool.end());
+    sWardenCheckMgr->DrawChecks(_checkCycle, sWorld->getIntConfig(CONFIG_WARDEN_NUM_MEM_CHECKS), sWorld->getIntConfig(CONFIG_WARDEN_NUM_OTHER_CHECKS), _currentChecks);
 
-    _serverTicks = getMSTime();
+    WorldPacket pkt(SMSG_WARDEN_DATA, 64);
+    BuildCheckRequest(pkt, _currentChecks, _inputKey[0]);
 
-    uint16 id;
-    uint8 type;
-    WardenCheck* wd;
-    _currentChecks.clear();
+    // Encrypt with warden RC4 key
+    EncryptData(const_cast<uint8*>(pkt.contents()), pkt.size());
+    _session->SendPacket(&pkt);
 
-    // Build check request
-    for (uint32 i = 0; i < sWorld->getIntConfig(CONFIG_WARDEN_NUM_MEM_CHECKS); ++i)
-    {
-        // If todo list is done break loop (will be filled on next Update() run)
-        if (_memChecksTodo.empty())
-            break;
+    _dataSent = true;
 
-        // Get check id from the end and remove it from todo
-        id = _memChecksTodo.back();
-        _memChecksTodo.pop_back();
+    if (sLog->ShouldLog(LOG_FILTER_WARDEN, LOG_LEVEL_DEBUG))
+    {
+        std::stringstream stream;
+        stream << "Sent check id's: ";
+        for (uint16 id : _currentChecks)
+            stream << id << " ";
 
-        // Add the id to the list sent in this cycle
-        _currentChecks.push_back(id);
+        sLog->outDebug(LOG_FILTER_WARDEN, "%s", stream.str().c_str());
     }
+}
 
-    ByteBuffer buff;
+void WardenWin::BuildCheckRequest(ByteBuffer& buff, std::vector<uint16> const& checks, uint8 xorByte)
+{
     buff << uint8(WARDEN_SMSG_CHEAT_CHECKS_REQUEST);
 
-    ACE_READ_GUARD(ACE_RW_Mutex, g, sWardenCheckMgr->_checkStoreLock);
-
-    for (uint32 i = 0; i < sWorld->getIntConfig(CONFIG_WARDEN_NUM_OTHER_CHECKS); ++i)
+    for (uint16 id : checks)
     {
-        // If todo list is done break loop (will be filled on next Update() run)
-        if (_otherChecksTodo.empty())
-            break;
-
-        // Get check id from the end and remove it from todo
-        id = _otherChecksTodo.back();
-        _otherChecksTodo.pop_back();
-
-        // Add the id to the list sent in this cycle
-        _currentChecks.push_back(id);
-
-        wd = sWardenCheckMgr->GetWardenDataById(id);
+        WardenCheck const* wd = sWardenCheckMgr->GetWardenDataById(id);
 
         switch (wd->Type)
         {
@@ -230,49 +213,28 @@ void WardenWin::RequestData()
         }
     }
 
-    uint8 xorByte = _inputKey[0];
-
     // Add TIMING_CHECK
     buff << uint8(0x00);
     buff << uint8(TIMING_CHECK ^ xorByte);
 
     uint8 index = 1;
 
-    for (std::list<uint16>::iterator itr = _currentChecks.begin(); itr != _currentChecks.end(); ++itr)
+    for (uint16 id : checks)
     {
-        wd = sWardenCheckMgr->GetWardenDataById(*itr);
+        WardenCheck const* wd = sWardenCheckMgr->GetWardenDataById(id);
 
-        type = wd->Type;
-        buff << uint8(type ^ xorByte);
-        switch (type)
+        buff << uint8(wd->Type ^ xorByte);
+
+        if (!wd->Request.empty())
+            buff.append(wd->Request.data(), wd->Request.size());
+
+        switch (wd->Type)
         {
-            case MEM_CHECK:
-            {
-                buff << uint8(0x00);
-                buff << uint32(wd->Address);
-                buff << uint8(wd->Length);
-                break;
-            }
-            case PAGE_CHECK_A:
-            case PAGE_CHECK_B:
-            {
-                buff.append(wd->Data.AsByteArray(0, false), wd->Data.GetNumBytes());
-                buff << uint32(wd->Address);
-                buff << uint8(wd->Length);
-                break;
-            }
             case MPQ_CHECK:
             case LUA_STR_CHECK:
-            {
-                buff << uint8(index++);
-                break;
-            }
             case DRIVER_CHECK:
-            {
-                buff.append(wd->Data.AsByteArray(0, false), wd->Data.GetNumBytes());
                 buff << uint8(index++);
                 break;
-            }
             case MODULE_CHECK:
             {
                 uint32 seed = static_cast<uint32>(rand32());
@@ -293,27 +255,12 @@ void WardenWin::RequestData()
                 break;
             }*/
             default:
-                break;                                      // Should never happen
+                break;
         }
     }
+
     buff << uint8(xorByte);
     buff.hexlike();
-
-    // Encrypt with warden RC4 key
-    EncryptData(const_cast<uint8*>(buff.contents()), buff.size());
-
-    WorldPacket pkt(SMSG_WARDEN_DATA, buff.size());
-    pkt.append(buff);
-    _session->SendPacket(&pkt);
-
-    _dataSent = true;
-
-    std::stringstream stream;
-    stream << "Sent check id's: ";
-    for (std::list<uint16>::iterator itr = _currentChecks.begin(); itr != _currentChecks.end(); ++itr)
-        stream << *itr << " ";
-
-    sLog->outDebug(LOG_FILTER_WARDEN, "%s", stream.str().c_str());
 }
 
 void WardenWin::HandleData(ByteBuffer &buff)
@@ -328,7 +275,7 @@ void WardenWin::HandleData(ByteBuffer &buff)
     uint32 Checksum;
     buff >> Checksum;
 
-    if (!IsValidCheckSum(Checksum, buff.contents() + buff.rpos(), Length))
+    if (Length > buff.size() - buff.rpos() || !IsValidCheckSum(Checksum, buff.contents() + buff.rpos(), Length))
     {
         buff.rpos(buff.wpos());
         sLog->outWarn(LOG_FILTER_WARDEN, "%s failed checksum. Action: %s", _session->GetPlayerName(false).c_str(), Penalty().c_str());
@@ -358,43 +305,85 @@ void WardenWin::HandleData(ByteBuffer &buff)
         sLog->outDebug(LOG_FILTER_WARDEN, "Ticks diff %u", ourTicks - newClientTicks);
     }
 
-    WardenCheckResult *rs;
-    WardenCheck *rd;
-    uint8 type;
     uint16 checkFailed = 0;
 
-    ACE_READ_GUARD(ACE_RW_Mutex, g, sWardenCheckMgr->_checkStoreLock);
+    if (!ValidateCheckResults(buff, _currentChecks, _session->GetAccountId(), checkFailed))
+    {
+        buff.rpos(buff.wpos());
+        sLog->outWarn(LOG_FILTER_WARDEN, "%s sent truncated check results. Action: %s", _session->GetPlayerName(false).c_str(), Penalty().c_str());
+        return;
+    }
 
-    for (std::list<uint16>::iterator itr = _currentChecks.begin(); itr != _currentChecks.end(); ++itr)
+    if (checkFailed > 0)
     {
-        rd = sWardenCheckMgr->GetWardenDataById(*itr);
-        rs = sWardenCheckMgr->GetWardenResultById(*itr);
+        WardenCheck* check = sWardenCheckMgr->GetWardenDataById(checkFailed);
+        sLog->outWarn(LOG_FILTER_WARDEN, "%s failed Warden check %u. Action: %s", _session->GetPlayerName(false).c_str(), checkFailed, Penalty(check).c_str());
+    }
+
+    // Set hold off timer, minimum timer should at least be 1 second
+    uint32 holdOff = sWorld->getIntConfig(CONFIG_WARDEN_CLIENT_CHECK_HOLDOFF);
+    _checkTimer = (holdOff < 1 ? 1 : holdOff) * IN_MILLISECONDS;
+}
+
+bool WardenWin::ValidateCheckResults(ByteBuffer& buff, std::vector<uint16> const& checks, uint32 accountId, uint16& failedCheck)
+{
+    bool debug = sLog->ShouldLog(LOG_FILTER_WARDEN, LOG_LEVEL_DEBUG);
+    failedCheck = 0;
+
+    for (uint16 id : checks)
+    {
+        WardenCheck const* rd = sWardenCheckMgr->GetWardenDataById(id);
+        uint8 type = rd->Type;
 
-        type = rd->Type;
+        // Result byte and what follows it for this check type, the client can't make us read past the packet
+        size_t left = buff.size() - buff.rpos();
+        size_t needed = 1;
         switch (type)
         {
             case MEM_CHECK:
+            case MPQ_CHECK:
+                needed += rd->Expected.size();
+                break;
+            case LUA_STR_CHECK:
+                needed += 1;
+                break;
+            default:
+                break;
+        }
+
+        uint8 result = left ? buff.contents()[buff.rpos()] : 0;
+        bool failedResult = result != 0 && (type == MEM_CHECK || type == MPQ_CHECK || type == LUA_STR_CHECK);
+        if (left < (failedResult ? 1 : needed))
+            return false;
+
+        switch (type)
+        {
+            case MEM_CHECK:
+            case MPQ_CHECK:
             {
-                uint8 Mem_Result;
-                buff >> Mem_Result;
+                buff.rpos(buff.rpos() + 1);
 
-                if (Mem_Result != 0)
+                if (result != 0)
                 {
-                    sLog->outDebug(LOG_FILTER_WARDEN, "RESULT MEM_CHECK not 0x00, CheckId %u account Id %u", *itr, _session->GetAccountId());
-                    checkFailed = *itr;
+                    if (debug)
+                        sLog->outDebug(LOG_FILTER_WARDEN, "RESULT %s not 0x00, CheckId %u account Id %u", type == MEM_CHECK ? "MEM_CHECK" : "MPQ_CHECK", id, accountId);
+                    failedCheck = id;
                     continue;
                 }
 
-                if (memcmp(buff.contents() + buff.rpos(), rs->Result.AsByteArray(0, false), rd->Length) != 0)
+                bool passed = memcmp(buff.contents() + buff.rpos(), rd->Expected.data(), rd->Expected.size()) == 0;
+                buff.rpos(buff.rpos() + rd->Expected.size());
+
+                if (!passed)
                 {
-                    sLog->outDebug(LOG_FILTER_WARDEN, "RESULT MEM_CHECK fail CheckId %u account Id %u", *itr, _session->GetAccountId());
-                    checkFailed = *itr;
-                    buff.rpos(buff.rpos() + rd->Length);
+                    if (debug)
+                        sLog->outDebug(LOG_FILTER_WARDEN, "RESULT %s fail CheckId %u account Id %u", type == MEM_CHECK ? "MEM_CHECK" : "MPQ_CHECK", id, accountId);
+                    failedCheck = id;
                     continue;
                 }
 
-                buff.rpos(buff.rpos() + rd->Length);
-                sLog->outDebug(LOG_FILTER_WARDEN, "RESULT MEM_CHECK passed CheckId %u account Id %u", *itr, _session->GetAccountId());
+                if (debug)
+                    sLog->outDebug(LOG_FILTER_WARDEN, "RESULT %s passed CheckId %u account Id %u", type == MEM_CHECK ? "MEM_CHECK" : "MPQ_CHECK", id, accountId);
                 break;
             }
             case PAGE_CHECK_A:
@@ -402,78 +391,45 @@ void WardenWin::HandleData(ByteBuffer &buff)
             case DRIVER_CHECK:
             case MODULE_CHECK:
             {
-                const uint8 byte = 0xE9;
-                if (memcmp(buff.contents() + buff.rpos(), &byte, sizeof(uint8)) != 0)
+                char const* name = type == DRIVER_CHECK ? "DRIVER_CHECK" : (type == MODULE_CHECK ? "MODULE_CHECK" : "PAGE_CHECK");
+                buff.rpos(buff.rpos() + 1);
+
+                if (result != 0xE9)
                 {
-                    if (type == PAGE_CHECK_A || type == PAGE_CHECK_B)
-                        sLog->outDebug(LOG_FILTER_WARDEN, "RESULT PAGE_CHECK fail, CheckId %u account Id %u", *itr, _session->GetAccountId());
-                    if (type == MODULE_CHECK)
-                        sLog->outDebug(LOG_FILTER_WARDEN, "RESULT MODULE_CHECK fail, CheckId %u account Id %u", *itr, _session->GetAccountId());
-                    if (type == DRIVER_CHECK)
-                        sLog->outDebug(LOG_FILTER_WARDEN, "RESULT DRIVER_CHECK fail, CheckId %u account Id %u", *itr, _session->GetAccountId());
-                    checkFailed = *itr;
-                    buff.rpos(buff.rpos() + 1);
+                    if (debug)
+                        sLog->outDebug(LOG_FILTER_WARDEN, "RESULT %s fail, CheckId %u account Id %u", name, id, accountId);
+                    failedCheck = id;
                     continue;
                 }
 
-                buff.rpos(buff.rpos() + 1);
-                if (type == PAGE_CHECK_A || type == PAGE_CHECK_B)
-                    sLog->outDebug(LOG_FILTER_WARDEN, "RESULT PAGE_CHECK passed CheckId %u account Id %u", *itr, _session->GetAccountId());
-                else if (type == MODULE_CHECK)
-                    sLog->outDebug(LOG_FILTER_WARDEN, "RESULT MODULE_CHECK passed CheckId %u account Id %u", *itr, _session->GetAccountId());
-                else if (type == DRIVER_CHECK)
-                    sLog->outDebug(LOG_FILTER_WARDEN, "RESULT DRIVER_CHECK passed CheckId %u account Id %u", *itr, _session->GetAccountId());
+                if (debug)
+                    sLog->outDebug(LOG_FILTER_WARDEN, "RESULT %s passed CheckId %u account Id %u", name, id, accountId);
                 break;
             }
             case LUA_STR_CHECK:
             {
-                uint8 Lua_Result;
-                buff >> Lua_Result;
+                buff.rpos(buff.rpos() + 1);
 
-                if (Lua_Result != 0)
+                if (result != 0)
                 {
-                    sLog->outDebug(LOG_FILTER_WARDEN, "RESULT LUA_STR_CHECK fail, CheckId %u account Id %u", *itr, _session->GetAccountId());
-                    checkFailed = *itr;
+                    if (debug)
+                        sLog->outDebug(LOG_FILTER_WARDEN, "RESULT LUA_STR_CHECK fail, CheckId %u account Id %u", id, accountId);
+                    failedCheck = id;
                     continue;
                 }
 
                 uint8 luaStrLen;
                 buff >> luaStrLen;
 
-                if (luaStrLen != 0)
-                {
-                    char *str = new char[luaStrLen + 1];
-                    memset(str, 0, luaStrLen + 1);
-                    memcpy(str, buff.contents() + buff.rpos(), luaStrLen);
-                    sLog->outDebug(LOG_FILTER_WARDEN, "Lua string: %s", str);
-                    delete[] str;
-                }
-                buff.rpos(buff.rpos() + luaStrLen);         // Skip string
-                sLog->outDebug(LOG_FILTER_WARDEN, "RESULT LUA_STR_CHECK passed, CheckId %u account Id %u", *itr, _session->GetAccountId());
-                break;
-            }
-            case MPQ_CHECK:
-            {
-                uint8 Mpq_Result;
-                buff >> Mpq_Result;
-
-                if (Mpq_Result != 0)
-                {
-                    sLog->outDebug(LOG_FILTER_WARDEN, "RESULT MPQ_CHECK not 0x00 account id %u", _session->GetAccountId());
-                    checkFailed = *itr;
-                    continue;
-                }
+                if (luaStrLen > buff.size() - buff.rpos())
+                    return false;
 
-                if (memcmp(buff.contents() + buff.rpos(), rs->Result.AsByteArray(0, false), 20) != 0) // SHA1
-                {
-                    sLog->outDebug(LOG_FILTER_WARDEN, "RESULT MPQ_CHECK fail, CheckId %u account Id %u", *itr, _session->GetAccountId());
-                    checkFailed = *itr;
-                    buff.rpos(buff.rpos() + 20);            // 20 bytes SHA1
-                    continue;
-                }
+                if (luaStrLen != 0 && debug)
+                    sLog->outDebug(LOG_FILTER_WARDEN, "Lua string: %s", std::string((char const*)buff.contents() + buff.rpos(), luaStrLen).c_str());
 
-                buff.rpos(buff.rpos() + 20);                // 20 bytes SHA1
-                sLog->outDebug(LOG_FILTER_WARDEN, "RESULT MPQ_CHECK passed, CheckId %u account Id %u", *itr, _session->GetAccountId());
+                buff.rpos(buff.rpos() + luaStrLen);         // Skip string
+                if (debug)
+                    sLog->outDebug(LOG_FILTER_WARDEN, "RESULT LUA_STR_CHECK passed, CheckId %u account Id %u", id, accountId);
                 break;
             }
             default:                                        // Should never happen
@@ -481,13 +437,5 @@ void WardenWin::HandleData(ByteBuffer &buff)
         }
     }
 
-    if (checkFailed > 0)
-    {
-        WardenCheck* check = sWardenCheckMgr->GetWardenDataById(checkFailed);
-        sLog->outWarn(LOG_FILTER_WARDEN, "%s failed Warden check %u. Action: %s", _session->GetPlayerName(false).c_str(), checkFailed, Penalty(check).c_str());
-    }
-
-    // Set hold off timer, minimum timer should at least be 1 second
-    uint32 holdOff = sWorld->getIntConfig(CONFIG_WARDEN_CLIENT_CHECK_HOLDOFF);
-    _checkTimer = (holdOff < 1 ? 1 : holdOff) * IN_MILLISECONDS;
+    return true;
 }
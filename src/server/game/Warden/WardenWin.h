@@ -74,11 +74,15 @@ class WardenWin : public Warden
         void RequestData();
         void HandleData(ByteBuffer &buff);
 
+        // Only read the checks built at load, they don't need the session nor the check store lock
+        static void BuildCheckRequest(ByteBuffer& buff, std::vector<uint16> const& checks, uint8 xorByte);
+        // Returns false if the answer is truncated, failedCheck is the last failed check id or 0
+        static bool ValidateCheckResults(ByteBuffer& buff, std::vector<uint16> const& checks, uint32 accountId, uint16& failedCheck);
+
     private:
         uint32 _serverTicks;
-        std::list<uint16> _otherChecksTodo;
-        std::list<uint16> _memChecksTodo;
-        std::list<uint16> _currentChecks;
+        WardenCheckCycle _checkCycle;
+        std::vector<uint16> _currentChecks;
 };
 
 #endif
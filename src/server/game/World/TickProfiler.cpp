@@ -0,0 +1,212 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "TickProfiler.h"
+#include "Config.h"
+#include "Log.h"
+#include <chrono>
+
+/// Single producer (the owning thread) / single consumer (the world thread at the end of a tick)
+struct TickProfilerThread
+{
+    TickProfilerThread(uint32 p_Id) : Id(p_Id), Head(0), Tail(0), Dropped(0) { }
+
+    uint32              Id;
+    std::atomic<uint64> Head;
+    std::atomic<uint64> Tail;
+    std::atomic<uint32> Dropped;
+    TickProfilerEvent   Events[TICK_PROFILER_EVENTS_PER_THREAD];
+};
+
+static thread_local TickProfilerThread* t_TickProfilerThread = nullptr;
+
+std::atomic<bool> TickProfiler::s_Recording(false);
+
+TickProfiler::TickProfiler()
+    : m_Armed(false), m_ThresholdMs(0), m_RemainingDumps(0), m_SlowestTick(0), m_TickStart(0)
+{
+}
+
+TickProfiler::~TickProfiler()
+{
+    for (TickProfilerThread* l_Thread : m_Threads)
+        delete l_Thread;
+}
+
+uint64 TickProfiler::Now()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+TickProfilerThread* TickProfiler::GetThreadBuffer()
+{
+    if (!t_TickProfilerThread)
+    {
+        std::lock_guard<std::mutex> l_Guard(m_ThreadsLock);
+
+        t_TickProfilerThread = new TickProfilerThread(m_Threads.size() + 1);
+        m_Threads.push_back(t_TickProfilerThread);
+    }
+
+    return t_TickProfilerThread;
+}
+
+void TickProfiler::Record(char const* p_Name, char const* p_ArgName, uint32 p_Arg, uint64 p_Start, uint64 p_End)
+{
+    TickProfilerThread* l_Thread = GetThreadBuffer();
+
+    uint64 l_Head = l_Thread->Head.load(std::memory_order_relaxed);
+    if (l_Head - l_Thread->Tail.load(std::memory_order_acquire) >= TICK_PROFILER_EVENTS_PER_THREAD)
+    {
+        l_Thread->Dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    TickProfilerEvent& l_Event = l_Thread->Events[l_Head & (TICK_PROFILER_EVENTS_PER_THREAD - 1)];
+    l_Event.Name     = p_Name;
+    l_Event.ArgName  = p_ArgName;
+    l_Event.Arg      = p_Arg;
+    l_Event.Start    = p_Start;
+    l_Event.Duration = uint32(std::min<uint64>(p_End - p_Start, 0xFFFFFFFF));
+
+    l_Thread->Head.store(l_Head + 1, std::memory_order_release);
+}
+
+void TickProfiler::Arm(uint32 p_ThresholdMs, uint32 p_Dumps)
+{
+    m_ThresholdMs.store(p_ThresholdMs, std::memory_order_relaxed);
+    m_RemainingDumps.store(std::max(p_Dumps, 1u), std::memory_order_relaxed);
+    m_SlowestTick.store(0, std::memory_order_relaxed);
+    m_Armed.store(true, std::memory_order_relaxed);
+}
+
+void TickProfiler::Disarm()
+{
+    m_Armed.store(false, std::memory_order_relaxed);
+}
+
+std::string TickProfiler::GetLastDump() const
+{
+    std::lock_guard<std::mutex> l_Guard(m_ThreadsLock);
+    return m_LastDump;
+}
+
+void TickProfiler::BeginTick()
+{
+    /// Zones only start recording on a tick boundary, a dumped tick is always complete
+    s_Recording.store(m_Armed.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    m_TickStart = Now();
+}
+
+void TickProfiler::EndTick(uint32 p_Diff)
+{
+    if (!s_Recording.load(std::memory_order_relaxed))
+        return;
+
+    uint64 l_TickEnd = Now();
+    Record("World::Update", "diff", p_Diff, m_TickStart, l_TickEnd);
+
+    std::vector<TickProfilerThread*> l_Threads;
+    {
+        std::lock_guard<std::mutex> l_Guard(m_ThreadsLock);
+        l_Threads = m_Threads;
+    }
+
+    /// Map threads are done with this tick, anything older belongs to a previous arming
+    m_TickEvents.clear();
+    for (TickProfilerThread* l_Thread : l_Threads)
+    {
+        uint64 l_Tail = l_Thread->Tail.load(std::memory_order_relaxed);
+        uint64 l_Head = l_Thread->Head.load(std::memory_order_acquire);
+
+        for (; l_Tail < l_Head; ++l_Tail)
+        {
+            TickProfilerEvent const& l_Event = l_Thread->Events[l_Tail & (TICK_PROFILER_EVENTS_PER_THREAD - 1)];
+            if (l_Event.Start >= m_TickStart)
+                m_TickEvents.push_back(std::make_pair(l_Thread->Id, l_Event));
+        }
+
+        l_Thread->Tail.store(l_Tail, std::memory_order_release);
+    }
+
+    uint32 l_TickTime = uint32((l_TickEnd - m_TickStart) / IN_MILLISECONDS);
+    if (l_TickTime > m_SlowestTick.load(std::memory_order_relaxed))
+        m_SlowestTick.store(l_TickTime, std::memory_order_relaxed);
+
+    if (l_TickTime < m_ThresholdMs.load(std::memory_order_relaxed))
+        return;
+
+    Dump(m_TickStart, l_TickEnd, p_Diff);
+
+    if (m_RemainingDumps.fetch_sub(1, std::memory_order_relaxed) <= 1)
+        Disarm();
+}
+
+void TickProfiler::Dump(uint64 p_TickStart, uint64 p_TickEnd, uint32 p_Diff)
+{
+    std::string l_Path = ConfigMgr::GetStringDefault("LogsDir", "");
+    if (!l_Path.empty() && l_Path[l_Path.size() - 1] != '/' && l_Path[l_Path.size() - 1] != '\\')
+        l_Path.push_back('/');
+
+    char l_FileName[128];
+    snprintf(l_FileName, sizeof(l_FileName), "tick_%s_%ums.json", Log::GetTimestampStr().c_str(), uint32((p_TickEnd - p_TickStart) / IN_MILLISECONDS));
+    l_Path.append(l_FileName);
+
+    FILE* l_File = fopen(l_Path.c_str(), "w");
+    if (!l_File)
+    {
+        sLog->outError(LOG_FILTER_PROFILING, "TickProfiler: can't write %s", l_Path.c_str());
+        return;
+    }
+
+    uint32 l_WorldThread = t_TickProfilerThread ? t_TickProfilerThread->Id : 0;
+    uint32 l_Dropped = 0;
+    uint32 l_ThreadCount = 0;
+    char const* l_Separator = "";
+
+    fprintf(l_File, "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"diff\":%u},\"traceEvents\":[\n", p_Diff);
+
+    {
+        std::lock_guard<std::mutex> l_Guard(m_ThreadsLock);
+        for (TickProfilerThread* l_Thread : m_Threads)
+        {
+            fprintf(l_File, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s %u\"}}",
+                l_Separator, l_Thread->Id, l_Thread->Id == l_WorldThread ? "World" : "Thread", l_Thread->Id);
+            l_Separator = ",\n";
+
+            l_Dropped += l_Thread->Dropped.exchange(0, std::memory_order_relaxed);
+        }
+
+        l_ThreadCount = m_Threads.size();
+    }
+
+    /// Complete events, timestamps relative to the beginning of the tick
+    for (std::pair<uint32, TickProfilerEvent> const& l_Pair : m_TickEvents)
+    {
+        TickProfilerEvent const& l_Event = l_Pair.second;
+        fprintf(l_File, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":" UI64FMTD ",\"dur\":%u",
+            l_Separator, l_Event.Name, l_Pair.first, l_Event.Start - p_TickStart, l_Event.Duration);
+
+        if (l_Event.ArgName)
+            fprintf(l_File, ",\"args\":{\"%s\":%u}", l_Event.ArgName, l_Event.Arg);
+
+        fprintf(l_File, "}");
+        l_Separator = ",\n";
+    }
+
+    fprintf(l_File, "\n]}\n");
+    fclose(l_File);
+
+    {
+        std::lock_guard<std::mutex> l_Guard(m_ThreadsLock);
+        m_LastDump = l_Path;
+    }
+
+    sLog->outInfo(LOG_FILTER_PROFILING, "TickProfiler: tick of %u ms dumped in %s (%u events, %u threads, %u dropped)",
+        uint32((p_TickEnd - p_TickStart) / IN_MILLISECONDS), l_Path.c_str(), uint32(m_TickEvents.size()), l_ThreadCount, l_Dropped);
+}
@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TICKPROFILER_H
+# define TICKPROFILER_H
+
+#include "Common.h"
+#include <ace/Null_Mutex.h>
+#include <atomic>
+#include <mutex>
+
+#define TICK_PROFILER_EVENTS_PER_THREAD 65536   ///< Must be a power of two
+
+/// A finished zone, recorded by the thread that ran it
+struct TickProfilerEvent
+{
+    char const* Name;           ///< String literal
+    char const* ArgName;        ///< String literal, nullptr if the zone has no argument
+    uint64      Start;          ///< Microseconds, see TickProfiler::Now
+    uint32      Duration;       ///< Microseconds
+    uint32      Arg;
+};
+
+struct TickProfilerThread;
+
+/// Hierarchical timeline of the world updates.
+/// Once armed, every zone (see TICK_PROFILE_ZONE) is recorded in a lock-free buffer of the thread running it,
+/// the world thread collects them at the end of each tick and dumps ticks slower than the threshold
+/// in a Chrome trace / Perfetto JSON file of the logs directory. Zones cost a single load while disarmed.
+class TickProfiler
+{
+    friend class ACE_Singleton<TickProfiler, ACE_Null_Mutex>;
+
+    public:
+        static bool IsRecording() { return s_Recording.load(std::memory_order_relaxed); }
+
+        /// Microseconds on a monotonic clock
+        static uint64 Now();
+
+        /// Called by TickProfilerZone, on any thread
+        void Record(char const* p_Name, char const* p_ArgName, uint32 p_Arg, uint64 p_Start, uint64 p_End);
+
+        /// Starts recording
+        /// @p_ThresholdMs : Ticks lasting at least this long are dumped
+        /// @p_Dumps       : Disarmed after this many dumps
+        void Arm(uint32 p_ThresholdMs, uint32 p_Dumps);
+        void Disarm();
+
+        /// World thread, around World::Update
+        void BeginTick();
+        void EndTick(uint32 p_Diff);
+
+        /// Status, readable from any thread
+        bool IsArmed() const { return m_Armed.load(std::memory_order_relaxed); }
+        uint32 GetThreshold() const { return m_ThresholdMs.load(std::memory_order_relaxed); }
+        uint32 GetRemainingDumps() const { return m_RemainingDumps.load(std::memory_order_relaxed); }
+        uint32 GetSlowestTick() const { return m_SlowestTick.load(std::memory_order_relaxed); }
+        std::string GetLastDump() const;
+
+    private:
+        TickProfiler();
+        ~TickProfiler();
+
+        TickProfilerThread* GetThreadBuffer();
+        void Dump(uint64 p_TickStart, uint64 p_TickEnd, uint32 p_Diff);
+
+        static std::atomic<bool>            s_Recording;
+
+        /// Armed by GM commands, possibly from a map thread
+        std::atomic<bool>                   m_Armed;
+        std::atomic<uint32>                 m_ThresholdMs;
+        std::atomic<uint32>                 m_RemainingDumps;
+        std::atomic<uint32>                 m_SlowestTick;      ///< Milliseconds, since armed
+        uint64                              m_TickStart;
+
+        mutable std::mutex                  m_ThreadsLock;      ///< Protects m_Threads and m_LastDump
+        std::string                         m_LastDump;
+        std::vector<TickProfilerThread*>    m_Threads;          ///< Buffers of each thread that ever recorded a zone
+
+        /// Events of the current tick, filled by EndTick: thread id, event
+        std::vector<std::pair<uint32, TickProfilerEvent>> m_TickEvents;
+};
+
+#define sTickProfiler ACE_Singleton<TickProfiler, ACE_Null_Mutex>::instance()
+
+/// Records the time spent in the enclosing scope when the profiler is armed
+class TickProfilerZone
+{
+    public:
+        explicit TickProfilerZone(char const* p_Name, char const* p_ArgName = nullptr, uint32 p_Arg = 0)
+            : m_Name(TickProfiler::IsRecording() ? p_Name : nullptr), m_ArgName(p_ArgName), m_Arg(p_Arg), m_Start(0)
+        {
+            if (m_Name)
+                m_Start = TickProfiler::Now();
+        }
+
+        ~TickProfilerZone()
+        {
+            if (m_Name)
+                sTickProfiler->Record(m_Name, m_ArgName, m_Arg, m_Start, TickProfiler::Now());
+        }
+
+    private:
+        char const* m_Name;
+        char const* m_ArgName;
+        uint32      m_Arg;
+        uint64      m_Start;
+
+        TickProfilerZone(TickProfilerZone const&);
+        TickProfilerZone& operator=(TickProfilerZone const&);
+};
+
+#define TICK_PROFILE_ZONE(p_Name) TickProfilerZone l_TickProfilerZone(p_Name)
+#define TICK_PROFILE_ZONE_ARG(p_Name, p_ArgName, p_Arg) TickProfilerZone l_TickProfilerZone(p_Name, p_ArgName, p_Arg)
+
+#endif // TICKPROFILER_H
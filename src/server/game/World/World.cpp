@@ -94,6 +94,8 @@
 #include "MMapFactory.h"
 #include "TaxiPathGraph.h"
 #include "ChatLexicsCutter.h"
+#include "OpcodeStats.h"
+#include "TickProfiler.h"
 #include <ctime>
 
 uint32 gOnlineGameMaster = 0;
@@ -167,12 +169,7 @@ World::World()
 
     m_LastAccountLogId = 0;
 
-    m_QueryHolderCallbacks             = std::unique_ptr<QueryHolderCallbacks>(new QueryHolderCallbacks());
-    m_QueryHolderCallbacksBuffer       = std::unique_ptr<QueryHolderCallbacks>(new QueryHolderCallbacks());
-    m_TransactionCallbacks             = std::unique_ptr<TransactionCallbacks>(new TransactionCallbacks());
-    m_TransactionCallbacksBuffer       = std::unique_ptr<TransactionCallbacks>(new TransactionCallbacks());
-    m_PreparedStatementCallbacks       = std::unique_ptr<PreparedStatementCallbacks>(new PreparedStatementCallbacks());
-    m_PreparedStatementCallbacksBuffer = std::unique_ptr<PreparedStatementCallbacks>(new PreparedStatementCallbacks());
+    m_QueryCallbackQueue               = std::make_shared<SQLCallbackQueue>();
 }
 
 /// World destructor
@@ -1134,6 +1131,8 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_BATTLEGROUND_INVITATION_TYPE]               = ConfigMgr::GetIntDefault ("Battleground.InvitationType", 0);
     m_int_configs[CONFIG_BATTLEGROUND_PREMATURE_FINISH_TIMER]        = ConfigMgr::GetIntDefault ("Battleground.PrematureFinishTimer", 5 * MINUTE * IN_MILLISECONDS);
     m_int_configs[CONFIG_BATTLEGROUND_PREMADE_GROUP_WAIT_FOR_MATCH]  = ConfigMgr::GetIntDefault ("Battleground.PremadeGroupWaitForMatch", 5 * MINUTE * IN_MILLISECONDS);
+    m_int_configs[CONFIG_BATTLEGROUND_SCHEDULER_INTERVAL]            = ConfigMgr::GetIntDefault ("Battleground.Scheduler.Interval", IN_MILLISECONDS);
+    m_int_configs[CONFIG_BATTLEGROUND_SCHEDULER_THREADS]             = ConfigMgr::GetIntDefault ("Battleground.Scheduler.Threads", 2);
     m_bool_configs[CONFIG_BG_XP_FOR_KILL]                            = ConfigMgr::GetBoolDefault("Battleground.GiveXPForKills", false);
     m_int_configs[CONFIG_ARENA_MAX_RATING_DIFFERENCE]                = ConfigMgr::GetIntDefault ("Arena.MaxRatingDifference", 150);
     m_int_configs[CONFIG_ARENA_RATING_DISCARD_TIMER]                 = ConfigMgr::GetIntDefault ("Arena.RatingDiscardTimer", 10 * MINUTE * IN_MILLISECONDS);
@@ -1365,6 +1364,26 @@ void World::LoadConfigSettings(bool reload)
     // MySQL ping time interval
     m_int_configs[CONFIG_DB_PING_INTERVAL] = ConfigMgr::GetIntDefault("MaxPingTime", 30);
 
+    // Opcode handler statistics and per session rate budgets
+    m_bool_configs[CONFIG_OPCODE_STATS_ENABLE]       = ConfigMgr::GetBoolDefault("OpcodeStats.Enable", true);
+    m_bool_configs[CONFIG_MOVEMENT_SPLINE_BATCHING]  = ConfigMgr::GetBoolDefault("Movement.SplineBatching", true);
+    m_int_configs[CONFIG_OPCODE_STATS_LOG_INTERVAL]  = ConfigMgr::GetIntDefault("OpcodeStats.LogInterval", 0);
+    m_int_configs[CONFIG_OPCODE_STATS_LOG_COUNT]     = ConfigMgr::GetIntDefault("OpcodeStats.LogTopCount", 10);
+    m_bool_configs[CONFIG_OPCODE_BUDGET_ENABLE]      = ConfigMgr::GetBoolDefault("OpcodeBudget.Enable", false);
+    m_int_configs[CONFIG_OPCODE_BUDGET_NORMAL]       = ConfigMgr::GetIntDefault("OpcodeBudget.Normal.PerSecond", 0);
+    m_int_configs[CONFIG_OPCODE_BUDGET_EXPENSIVE]    = ConfigMgr::GetIntDefault("OpcodeBudget.Expensive.PerSecond", 5);
+    m_int_configs[CONFIG_TICK_PROFILER_THRESHOLD]    = ConfigMgr::GetIntDefault("TickProfiler.SlowTickThreshold", 150);
+
+    // Idle creatures update rate
+    m_int_configs[CONFIG_CREATURE_LOD_INTERVAL]           = ConfigMgr::GetIntDefault("CreatureLOD.Interval", 1000);
+    m_float_configs[CONFIG_CREATURE_LOD_PLAYER_DISTANCE]  = ConfigMgr::GetFloatDefault("CreatureLOD.PlayerDistance", 60.0f);
+
+    if (reload)
+    {
+        m_timers[WUPDATE_OPCODE_STATS].SetInterval(std::max<uint32>(m_int_configs[CONFIG_OPCODE_STATS_LOG_INTERVAL], 1) * IN_MILLISECONDS);
+        m_timers[WUPDATE_OPCODE_STATS].Reset();
+    }
+
     //Reset Duel Cooldown
     m_bool_configs[CONFIG_DUEL_RESET_COOLDOWN_ON_START] = ConfigMgr::GetBoolDefault("DuelReset.Cooldown.OnStart", false);
     m_bool_configs[CONFIG_DUEL_RESET_COOLDOWN_ON_FINISH] = ConfigMgr::GetBoolDefault("DuelReset.Cooldown.OnFinish", false);
@@ -2153,6 +2172,7 @@ void World::SetInitialWorldSettings()
     m_timers[WUPDATE_GUILDSAVE].SetInterval(getIntConfig(CONFIG_GUILD_SAVE_INTERVAL) * MINUTE * IN_MILLISECONDS);
 
     m_timers[WUPDATE_REALM_STATS].SetInterval(MINUTE * IN_MILLISECONDS);
+    m_timers[WUPDATE_OPCODE_STATS].SetInterval(std::max<uint32>(getIntConfig(CONFIG_OPCODE_STATS_LOG_INTERVAL), 1) * IN_MILLISECONDS);
 
 #ifndef CROSS
     m_timers[WUPDATE_BLACKMARKET].SetInterval(MINUTE * IN_MILLISECONDS);
@@ -2250,6 +2270,7 @@ void World::SetInitialWorldSettings()
 
     sLog->outInfo(LOG_FILTER_GENERAL, "Initializing Opcodes...");
     InitOpcodes();
+    sOpcodeStats->Initialize();
 
 #ifdef CROSS
     sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading InterRealm config...");
@@ -2415,6 +2436,8 @@ void World::LoadAutobroadcasts()
 /// Update the World !
 void World::Update(uint32 diff)
 {
+    sTickProfiler->BeginTick();
+
     m_updateTime = diff;
 
 #ifdef CROSS
@@ -2546,7 +2569,10 @@ void World::Update(uint32 diff)
 
     /// <li> Handle session updates when the timer has passed
     RecordTimeDiff(NULL);
-    UpdateSessions(diff);
+    {
+        TICK_PROFILE_ZONE("World::UpdateSessions");
+        UpdateSessions(diff);
+    }
 
     SetRecordDiff(RECORD_DIFF_SESSION, getMSTime() - diffTime);
     diffTime = getMSTime();
@@ -2560,6 +2586,15 @@ void World::Update(uint32 diff)
         WeatherMgr::Update(uint32(m_timers[WUPDATE_WEATHERS].GetInterval()));
     }
 
+    /// <li> Dump the most expensive opcode handlers
+    if (m_timers[WUPDATE_OPCODE_STATS].Passed())
+    {
+        m_timers[WUPDATE_OPCODE_STATS].Reset();
+
+        if (getBoolConfig(CONFIG_OPCODE_STATS_ENABLE) && getIntConfig(CONFIG_OPCODE_STATS_LOG_INTERVAL))
+            sOpcodeStats->LogTop(getIntConfig(CONFIG_OPCODE_STATS_LOG_COUNT));
+    }
+
     /// <li> Update uptime table
     if (m_timers[WUPDATE_UPTIME].Passed())
     {
@@ -2576,7 +2611,7 @@ void World::Update(uint32 diff)
         stmt->setUInt32(2, g_RealmID);
         stmt->setUInt32(3, uint32(m_startTime));
 
-        LoginDatabase.Execute(stmt);
+        LoginDatabase.Execute(stmt, SQL_PRIORITY_LOW);
 #endif
     }
 
@@ -2593,7 +2628,7 @@ void World::Update(uint32 diff)
             stmt->setUInt32(0, sWorld->getIntConfig(CONFIG_LOGDB_CLEARTIME));
             stmt->setUInt32(1, uint32(time(0)));
 
-            LoginDatabase.Execute(stmt);
+            LoginDatabase.Execute(stmt, SQL_PRIORITY_LOW);
         }
     }
 #endif
@@ -2754,6 +2789,8 @@ void World::Update(uint32 diff)
     sTimeDiffMgr->Update(diff);
 
     sScriptMgr->OnWorldUpdate(diff);
+
+    sTickProfiler->EndTick(diff);
 }
 
 void World::ForceGameEventUpdate()
@@ -3566,8 +3603,7 @@ void World::UpdateRealmCharCount(uint32 accountId)
 #ifndef CROSS
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHARACTER_COUNT);
     stmt->setUInt32(0, accountId);
-    PreparedQueryResultFuture result = CharacterDatabase.AsyncQuery(stmt);
-    m_realmCharCallbacks.insert(result);
+    CharacterDatabase.AsyncQuery(stmt, std::bind(&World::_UpdateRealmCharCount, this, std::placeholders::_1), m_QueryCallbackQueue);
 #endif
 }
 
@@ -4074,98 +4110,8 @@ uint64 World::getWorldState(uint32 index) const
 
 void World::ProcessQueryCallbacks()
 {
-    PreparedQueryResult result;
-
-    while (!m_realmCharCallbacks.is_empty())
-    {
-        ACE_Future<PreparedQueryResult> lResult;
-        ACE_Time_Value timeout = ACE_Time_Value::zero;
-        if (m_realmCharCallbacks.next_readable(lResult, &timeout) != 1)
-            break;
-
-        if (lResult.ready())
-        {
-            lResult.get(result);
-            _UpdateRealmCharCount(result);
-            lResult.cancel();
-        }
-    }
-
-    /// - Update querys holders callbacks
-    if (!m_QueryHolderCallbacks->empty())
-    {
-        m_QueryHolderCallbacks->remove_if([](QueryHolderCallback const& p_Callback) -> bool
-        {
-            if (p_Callback.m_QueryResultHolderFuture.ready())
-            {
-                SQLQueryHolder* l_QueryHolder;
-                p_Callback.m_QueryResultHolderFuture.get(l_QueryHolder);
-
-                p_Callback.m_Callback(l_QueryHolder);
-                return true;
-            }
-
-            return false;
-        });
-    }
-
-    /// - Add querys holders callbacks in buffer queue to real queue
-    while (!m_QueryHolderCallbacksBuffer->empty())
-    {
-        m_QueryHolderCallbacks->push_front(m_QueryHolderCallbacksBuffer->front());
-        m_QueryHolderCallbacksBuffer->pop_front();
-    }
-
-    /// - Update transactions callbacks
-    if (!m_TransactionCallbacks->empty())
-    {
-        m_TransactionCallbacks->remove_if([](MS::Utilities::CallBackPtr const& l_Callback) -> bool
-        {
-            if (l_Callback->m_State == MS::Utilities::CallBackState::Waiting)
-                return false;
-
-            l_Callback->m_CallBack(l_Callback->m_State == MS::Utilities::CallBackState::Success);
-            return true;
-        });
-    }
-
-    /// - Add transactions callbacks in buffer queue to real queue
-    while (!m_TransactionCallbacksBuffer->empty())
-    {
-        m_TransactionCallbacks->push_front(m_TransactionCallbacksBuffer->front());
-        m_TransactionCallbacksBuffer->pop_front();
-    }
-
-    /// - Update prepared statements callbacks
-    if (!m_PreparedStatementCallbacks->empty())
-    {
-        m_PreparedStatementCallbacks->remove_if([](PrepareStatementCallback const& p_Callback) -> bool
-        {
-            /// If the query result is avaiable ...
-            if (p_Callback.second.ready())
-            {
-                /// Then get it
-                PreparedQueryResult l_Result;
-                p_Callback.second.get(l_Result);
-
-                /// Give the result to the callback, and execute it
-                p_Callback.first(l_Result);
-
-                /// Delete the callback from the forward list
-                return true;
-            }
-
-            /// We havn't the query result yet, we keep the callback and wait for the result!
-            return false;
-        });
-    }
-
-    /// - Add prepared statements in buffer queue to real queue
-    while (!m_PreparedStatementCallbacksBuffer->empty())
-    {
-        m_PreparedStatementCallbacks->push_front(m_PreparedStatementCallbacksBuffer->front());
-        m_PreparedStatementCallbacksBuffer->pop_front();
-    }
+    /// - Run the completions of async queries, transactions and query holders posted by the database workers
+    m_QueryCallbackQueue->Process();
 }
 
 void World::UpdatePhaseDefinitions()
@@ -4263,7 +4209,7 @@ void World::UpdateInterRealmStat()
 
     trans->PAppend("REPLACE INTO interrealmstat VALUES (%u, %u, %u)", count, uint32(m_startTime), uptimeDiff);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, SQL_PRIORITY_LOW);
 }
 #endif
 
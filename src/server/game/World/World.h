@@ -83,6 +83,7 @@ enum WorldTimers
     WUPDATE_PINGDB,
     WUPDATE_GUILDSAVE,
     WUPDATE_REALM_STATS,
+    WUPDATE_OPCODE_STATS,
 #ifndef CROSS
     WUPDATE_TRANSFER,
     WUPDATE_TRANSFER_EXP,
@@ -223,6 +224,9 @@ enum WorldBoolConfigs
     CONFIG_ENABLE_RESEARCH_SITE_LOAD,
     CONFIG_ENABLE_ITEM_SPEC_LOAD,
     CONFIG_MUST_HAVE_AUTHENTICATOR_ACCESS,
+    CONFIG_OPCODE_STATS_ENABLE,
+    CONFIG_OPCODE_BUDGET_ENABLE,
+    CONFIG_MOVEMENT_SPLINE_BATCHING,
     BOOL_CONFIG_VALUE_COUNT
 };
 
@@ -245,6 +249,7 @@ enum WorldFloatConfigs
     CONFIG_STATS_LIMITS_BLOCK,
     CONFIG_STATS_LIMITS_CRIT,
     CONFIG_LFR_DROP_CHANCE,
+    CONFIG_CREATURE_LOD_PLAYER_DISTANCE,
     FLOAT_CONFIG_VALUE_COUNT
 };
 
@@ -350,6 +355,8 @@ enum WorldIntConfigs
     CONFIG_BATTLEGROUND_INVITATION_TYPE,
     CONFIG_BATTLEGROUND_PREMATURE_FINISH_TIMER,
     CONFIG_BATTLEGROUND_PREMADE_GROUP_WAIT_FOR_MATCH,
+    CONFIG_BATTLEGROUND_SCHEDULER_INTERVAL,
+    CONFIG_BATTLEGROUND_SCHEDULER_THREADS,
     CONFIG_ARENA_MAX_RATING_DIFFERENCE,
     CONFIG_ARENA_RATING_DISCARD_TIMER,
     CONFIG_ARENA_RATED_UPDATE_TIMER,
@@ -426,6 +433,12 @@ enum WorldIntConfigs
     CONFIG_ACCOUNT_BIND_SHOP_GROUP_MASK,
     CONFIG_ACCOUNT_BIND_ALLOWED_GROUP_MASK,
     CONFIG_ONLY_MAP,
+    CONFIG_OPCODE_STATS_LOG_INTERVAL,
+    CONFIG_OPCODE_STATS_LOG_COUNT,
+    CONFIG_OPCODE_BUDGET_NORMAL,
+    CONFIG_OPCODE_BUDGET_EXPENSIVE,
+    CONFIG_TICK_PROFILER_THRESHOLD,
+    CONFIG_CREATURE_LOD_INTERVAL,
     INT_CONFIG_VALUE_COUNT
 };
 
@@ -667,18 +680,6 @@ enum RecordDiffType
     RECORD_DIFF_MAX
 };
 
-struct QueryHolderCallback
-{
-    QueryHolderCallback(QueryResultHolderFuture p_QueryResultHolderFuture, std::function<void(SQLQueryHolder*)> p_Callback)
-    {
-        m_QueryResultHolderFuture = p_QueryResultHolderFuture;
-        m_Callback = p_Callback;
-    }
-
-    QueryResultHolderFuture m_QueryResultHolderFuture;
-    std::function<void(SQLQueryHolder*)>   m_Callback;
-};
-
 #ifdef CROSS
 typedef std::unordered_map<uint64 /*Guid*/, Player*> PlayerMap;
 #endif /* CROSS */
@@ -1007,26 +1008,9 @@ class World
         //////////////////////////////////////////////////////////////////////////
         /// New callback system
         //////////////////////////////////////////////////////////////////////////
-        void AddTransactionCallback(std::shared_ptr<MS::Utilities::Callback> p_Callback)
-        {
-            m_TransactionCallbackLock.lock();
-            m_TransactionCallbacksBuffer->push_front(p_Callback);
-            m_TransactionCallbackLock.unlock();
-        }
-
-        void AddPrepareStatementCallback(std::pair<std::function<void(PreparedQueryResult)>, PreparedQueryResultFuture> p_Callback)
-        {
-            m_PreparedStatementCallbackLock.lock();
-            m_PreparedStatementCallbacksBuffer->push_front(p_Callback);
-            m_PreparedStatementCallbackLock.unlock();
-        }
-
-        void AddQueryHolderCallback(QueryHolderCallback p_QueryHolderCallback)
-        {
-            m_QueryHolderCallbackLock.lock();
-            m_QueryHolderCallbacksBuffer->push_front(p_QueryHolderCallback);
-            m_QueryHolderCallbackLock.unlock();
-        }
+        /// Database workers post the completions of async queries, transactions and query holders here,
+        /// they are run in ProcessQueryCallbacks on the world thread
+        SQLCallbackQueuePtr GetQueryCallbackQueue() const { return m_QueryCallbackQueue; }
 
         void AddNewSession(uint32 p_AccountID)
         {
@@ -1175,7 +1159,6 @@ class World
 
 
         void ProcessQueryCallbacks();
-        ACE_Future_Set<PreparedQueryResult> m_realmCharCallbacks;
         PreparedQueryResultFuture m_transfersDumpCallbacks;
         PreparedQueryResultFuture m_transfersLoadCallbacks;
         PreparedQueryResultFuture m_transfersExpLoadCallback;
@@ -1183,29 +1166,9 @@ class World
         LexicsCutter *m_lexicsCutter;
 
         //////////////////////////////////////////////////////////////////////////
-        /// New query holder callback system
-        //////////////////////////////////////////////////////////////////////////
-        using QueryHolderCallbacks = std::forward_list<QueryHolderCallback>;
-        std::unique_ptr<QueryHolderCallbacks> m_QueryHolderCallbacks;
-        std::unique_ptr<QueryHolderCallbacks> m_QueryHolderCallbacksBuffer;
-        std::mutex m_QueryHolderCallbackLock;
-
-        //////////////////////////////////////////////////////////////////////////
-        /// New transaction query callback system
-        //////////////////////////////////////////////////////////////////////////
-        using TransactionCallbacks = std::forward_list<std::shared_ptr<MS::Utilities::Callback>>;
-        std::unique_ptr<TransactionCallbacks> m_TransactionCallbacks;
-        std::unique_ptr<TransactionCallbacks> m_TransactionCallbacksBuffer;
-        std::mutex m_TransactionCallbackLock;
-
-        //////////////////////////////////////////////////////////////////////////
-        /// New prepare statement query callback system
+        /// New query callback system (prepared statements, transactions, query holders)
         //////////////////////////////////////////////////////////////////////////
-        using PrepareStatementCallback = std::pair<std::function<void(PreparedQueryResult)>, PreparedQueryResultFuture>;
-        using PreparedStatementCallbacks = std::forward_list<PrepareStatementCallback>;
-        std::unique_ptr<PreparedStatementCallbacks> m_PreparedStatementCallbacks;
-        std::unique_ptr<PreparedStatementCallbacks> m_PreparedStatementCallbacksBuffer;
-        std::mutex m_PreparedStatementCallbackLock;
+        SQLCallbackQueuePtr m_QueryCallbackQueue;
 };
 
 extern uint32 g_RealmID;
@@ -1213,31 +1176,33 @@ extern uint32 g_RealmID;
 #define sWorld ACE_Singleton<World, ACE_Null_Mutex>::instance()
 
 template <typename T>
-PreparedQueryResultFuture AsyncQuery(T& on, PreparedStatement* stmt, std::function<void(PreparedQueryResult)> p_Callback)
+void AsyncQuery(T& on, PreparedStatement* stmt, std::function<void(PreparedQueryResult)> p_Callback, SQLOperationPriority p_Priority = SQL_PRIORITY_NORMAL)
 {
-    uint32 index = stmt->getIndex();
-
-    PreparedQueryResultFuture res = on.AsyncQuery(stmt);
-
-    if (index != 0)
-    {
-        # ifdef GAME_SERVER_PROJECTS
-            sWorld->AddPrepareStatementCallback(std::make_pair(p_Callback, res));
-        # endif
-    }
+    #ifdef GAME_SERVER_PROJECTS
+        on.AsyncQuery(stmt, p_Callback, sWorld->GetQueryCallbackQueue(), p_Priority);
+    #else
+        on.Execute(stmt, p_Priority);
+    #endif
+}
 
-    return res;
+template <typename T>
+void DelayQueryHolder(T& on, SQLQueryHolder* p_Holder, std::function<void(SQLQueryHolder*)> p_Callback, SQLOperationPriority p_Priority = SQL_PRIORITY_NORMAL)
+{
+    #ifdef GAME_SERVER_PROJECTS
+        on.DelayQueryHolder(p_Holder, p_Callback, sWorld->GetQueryCallbackQueue(), p_Priority);
+    #else
+        on.DelayQueryHolder(p_Holder, p_Priority);
+    #endif
 }
 
 template <typename T>
 void CommitTransaction(T& on, SQLTransaction transaction, MS::Utilities::CallBackPtr p_Callback)
 {
     #ifdef GAME_SERVER_PROJECTS
-    if (p_Callback != nullptr)
-        sWorld->AddTransactionCallback(p_Callback);
+        on.CommitTransactionWithCallback(transaction, p_Callback, p_Callback != nullptr ? sWorld->GetQueryCallbackQueue() : nullptr);
+    #else
+        on.CommitTransactionWithCallback(transaction, p_Callback);
     #endif
-
-    on.CommitTransactionWithCallback(transaction, p_Callback);
 }
 
 #endif
@@ -28,6 +28,7 @@ EndScriptData */
 #include "Group.h"
 #include "LFGMgr.h"
 #include "World.h"
+#include "Config.h"
 
 #ifndef CROSS
 #include "InterRealmOpcodes.h"
@@ -36,6 +37,12 @@ EndScriptData */
 #endif /* not CROSS */
 #include <fstream>
 #include "BattlegroundPacketFactory.hpp"
+#include "OpcodeStats.h"
+#include "TickProfiler.h"
+#include "EventProcessor.h"
+#include "CreatureAIImpl.h"
+#include "LootMgr.h"
+#include "WardenWin.h"
 
 struct UnitStates
 {
@@ -120,6 +127,22 @@ class debug_commandscript: public CommandScript
                 { "spellfail",      SEC_ADMINISTRATOR,  false, &HandleDebugSendSpellFailCommand,      "", NULL },
                 { NULL,             SEC_PLAYER,         false, NULL,                                  "", NULL }
             };
+            static ChatCommand debugBenchmarkCommandTable[] =
+            {
+                { "database",       SEC_CONSOLE,        true,  &HandleDebugBenchmarkDatabaseCommand,  "", NULL },
+                { "battleground",   SEC_CONSOLE,        true,  &HandleDebugBenchmarkBattlegroundCommand, "", NULL },
+                { "events",         SEC_CONSOLE,        true,  &HandleDebugBenchmarkEventsCommand,    "", NULL },
+                { "loot",           SEC_CONSOLE,        true,  &HandleDebugBenchmarkLootCommand,      "", NULL },
+                { "warden",         SEC_CONSOLE,        true,  &HandleDebugBenchmarkWardenCommand,    "", NULL },
+                { NULL,             SEC_PLAYER,         false, NULL,                                  "", NULL }
+            };
+            static ChatCommand debugProfilerCommandTable[] =
+            {
+                { "arm",            SEC_ADMINISTRATOR,  true,  &HandleDebugProfilerArmCommand,        "", NULL },
+                { "disarm",         SEC_ADMINISTRATOR,  true,  &HandleDebugProfilerDisarmCommand,     "", NULL },
+                { "status",         SEC_ADMINISTRATOR,  true,  &HandleDebugProfilerStatusCommand,     "", NULL },
+                { NULL,             SEC_PLAYER,         false, NULL,                                  "", NULL }
+            };
             static ChatCommand debugCommandTable[] =
             {
                 { "setbit",                      SEC_ADMINISTRATOR,  false, &HandleDebugSet32BitCommand,             "", NULL },
@@ -197,6 +220,13 @@ class debug_commandscript: public CommandScript
                 { "cleardr",                     SEC_ADMINISTRATOR,  false, &HandleDebugCancelDiminishingReturn,     "", NULL },
                 { "scenario",                    SEC_ADMINISTRATOR,  false, &HandleDebugScenarioCommand,             "", NULL },
                 { "dailypoint",                  SEC_ADMINISTRATOR,  false, &HandleDebugDailyPointCommand,           "", NULL },
+                { "dbqueue",                     SEC_ADMINISTRATOR,  true,  &HandleDebugDatabaseQueueCommand,        "", NULL },
+                { "opcodestats",                 SEC_ADMINISTRATOR,  true,  &HandleDebugOpcodeStatsCommand,          "", NULL },
+                { "benchmark",                   SEC_CONSOLE,        true,  NULL,                                    "", debugBenchmarkCommandTable },
+                { "profiler",                    SEC_ADMINISTRATOR,  true,  NULL,                                    "", debugProfilerCommandTable },
+#ifndef CROSS
+                { "irtunnel",                    SEC_ADMINISTRATOR,  true,  &HandleDebugInterRealmTunnelCommand,     "", NULL },
+#endif /* not CROSS */
                 { NULL,                          SEC_PLAYER,         false, NULL,                                    "", NULL }
             };
             static ChatCommand commandTable[] =
@@ -3978,6 +4008,459 @@ class debug_commandscript: public CommandScript
 
             return true;
         }
+
+        template<class T> static void SendDatabaseQueueStats(ChatHandler* p_Handler, DatabaseWorkerPool<T>& p_Database)
+        {
+            static char const* s_LaneNames[MAX_SQL_PRIORITY] = { "high", "normal", "low" };
+
+            for (uint8 l_Priority = 0; l_Priority < MAX_SQL_PRIORITY; ++l_Priority)
+            {
+                SQLQueueLaneStats& l_Stats = p_Database.GetQueueStats(SQLOperationPriority(l_Priority));
+                if (!l_Stats.Wait.GetCount())
+                    continue;
+
+                p_Handler->PSendSysMessage("%s [%s] %llu ops, wait avg %llu p50 %llu p99 %llu max %llu us, exec avg %llu p50 %llu p99 %llu max %llu us",
+                    p_Database.GetDatabaseName(), s_LaneNames[l_Priority], (unsigned long long)l_Stats.Wait.GetCount(),
+                    (unsigned long long)l_Stats.Wait.GetAverage(), (unsigned long long)l_Stats.Wait.GetPercentile(50),
+                    (unsigned long long)l_Stats.Wait.GetPercentile(99), (unsigned long long)l_Stats.Wait.GetMax(),
+                    (unsigned long long)l_Stats.Execution.GetAverage(), (unsigned long long)l_Stats.Execution.GetPercentile(50),
+                    (unsigned long long)l_Stats.Execution.GetPercentile(99), (unsigned long long)l_Stats.Execution.GetMax());
+            }
+        }
+
+        /// Latency histograms of the asynchronous database queues, per priority lane
+        static bool HandleDebugDatabaseQueueCommand(ChatHandler* p_Handler, char const* /*p_Args*/)
+        {
+            SendDatabaseQueueStats(p_Handler, LoginDatabase);
+            SendDatabaseQueueStats(p_Handler, WorldDatabase);
+            SendDatabaseQueueStats(p_Handler, CharacterDatabase);
+            SendDatabaseQueueStats(p_Handler, HotfixDatabase);
+            return true;
+        }
+
+        /// Client opcodes sorted by total time spent in their handler, "reset" clears the statistics
+        static bool HandleDebugOpcodeStatsCommand(ChatHandler* p_Handler, char const* p_Args)
+        {
+            if (*p_Args && !strcmp(p_Args, "reset"))
+            {
+                sOpcodeStats->Reset();
+                p_Handler->SendSysMessage("Opcode statistics reset.");
+                return true;
+            }
+
+            std::vector<OpcodeStatsEntry> l_Entries;
+            sOpcodeStats->GetTop(*p_Args ? std::max(1, atoi(p_Args)) : 10, l_Entries);
+
+            if (!sWorld->getBoolConfig(CONFIG_OPCODE_STATS_ENABLE))
+                p_Handler->SendSysMessage("OpcodeStats.Enable is off, statistics are not updated.");
+
+            for (OpcodeStatsEntry const& l_Entry : l_Entries)
+            {
+                p_Handler->PSendSysMessage("%s: %llu packets, total %llu ms, avg %llu p50 %llu p99 %llu max %llu us",
+                    GetOpcodeNameForLogging(l_Entry.Opcode, WOW_CLIENT_TO_SERVER).c_str(), (unsigned long long)l_Entry.Count,
+                    (unsigned long long)(l_Entry.TotalTime / 1000), (unsigned long long)l_Entry.GetAverage(),
+                    (unsigned long long)l_Entry.GetPercentile(50), (unsigned long long)l_Entry.GetPercentile(99),
+                    (unsigned long long)l_Entry.MaxTime);
+            }
+
+            return true;
+        }
+
+        /// Arms the tick profiler: .debug profiler arm [threshold ms] [dump count]
+        static bool HandleDebugProfilerArmCommand(ChatHandler* p_Handler, char const* p_Args)
+        {
+            char* l_ThresholdStr = strtok((char*)p_Args, " ");
+            char* l_DumpsStr     = strtok(NULL, " ");
+
+            uint32 l_Threshold = l_ThresholdStr ? std::max(1, atoi(l_ThresholdStr)) : sWorld->getIntConfig(CONFIG_TICK_PROFILER_THRESHOLD);
+            uint32 l_Dumps     = l_DumpsStr ? std::max(1, atoi(l_DumpsStr)) : 1;
+
+            sTickProfiler->Arm(l_Threshold, l_Dumps);
+            p_Handler->PSendSysMessage("Tick profiler armed, the next %u ticks over %u ms will be dumped in the logs directory.", l_Dumps, l_Threshold);
+            return true;
+        }
+
+        static bool HandleDebugProfilerDisarmCommand(ChatHandler* p_Handler, char const* /*p_Args*/)
+        {
+            sTickProfiler->Disarm();
+            p_Handler->SendSysMessage("Tick profiler disarmed.");
+            return true;
+        }
+
+        static bool HandleDebugProfilerStatusCommand(ChatHandler* p_Handler, char const* /*p_Args*/)
+        {
+            if (sTickProfiler->IsArmed())
+                p_Handler->PSendSysMessage("Tick profiler armed: threshold %u ms, %u dumps left, slowest tick %u ms.",
+                    sTickProfiler->GetThreshold(), sTickProfiler->GetRemainingDumps(), sTickProfiler->GetSlowestTick());
+            else
+                p_Handler->SendSysMessage("Tick profiler disarmed.");
+
+            std::string l_LastDump = sTickProfiler->GetLastDump();
+            if (!l_LastDump.empty())
+                p_Handler->PSendSysMessage("Last dump: %s", l_LastDump.c_str());
+
+            return true;
+        }
+
+#ifndef CROSS
+        /// Flow control counters of the tunnel to the cross server
+        static bool HandleDebugInterRealmTunnelCommand(ChatHandler* p_Handler, char const* /*p_Args*/)
+        {
+            InterRealmSession* l_Session = sWorld->GetInterRealmSession();
+            if (!l_Session || !l_Session->IsConnected())
+            {
+                p_Handler->SendSysMessage("Not connected to the cross server.");
+                return true;
+            }
+
+            IRTunnelStats l_Stats = l_Session->GetTunnelStats();
+
+            p_Handler->PSendSysMessage("Sent: %llu packets in %llu batches (%llu compressed, largest %u packets), %llu bytes raw, %llu bytes on the wire",
+                (unsigned long long)l_Stats.SentPackets, (unsigned long long)l_Stats.SentBatches, (unsigned long long)l_Stats.SentCompressedBatches,
+                l_Stats.LargestBatch, (unsigned long long)l_Stats.SentRawBytes, (unsigned long long)l_Stats.SentWireBytes);
+            p_Handler->PSendSysMessage("Received: %llu packets in %llu batches, %llu out of sequence",
+                (unsigned long long)l_Stats.ReceivedPackets, (unsigned long long)l_Stats.ReceivedBatches, (unsigned long long)l_Stats.SequenceGaps);
+            p_Handler->PSendSysMessage("Flow: max pending %u bytes, max flush delay %u ms, queued %u bytes (max %u)",
+                l_Stats.MaxPendingBytes, l_Stats.MaxFlushDelay, l_Stats.QueuedBytes, l_Stats.MaxQueuedBytes);
+            return true;
+        }
+#endif /* not CROSS */
+
+        /// Commits the same transaction of consecutive prepared INSERTs with statement merging disabled then enabled,
+        /// see MySQLConnection::ExecuteTransaction. Everything runs on one synchronous connection, the table and the
+        /// statement only exist for the duration of the command
+        static bool HandleDebugBenchmarkDatabaseCommand(ChatHandler* p_Handler, char const* p_Args)
+        {
+            uint32 l_Rows = *p_Args ? std::max(1, atoi(p_Args)) : 1000;
+            uint32 l_Times[2] = { 0, 0 };
+            bool l_Success = true;
+
+            CharacterDatabase.DirectOnConnection([&](MySQLConnection* p_Connection)
+            {
+                /// Not a temporary table, the statement is prepared again if the connection is lost meanwhile
+                p_Connection->Execute("CREATE TABLE IF NOT EXISTS `benchmark_batch` (`id` INT UNSIGNED NOT NULL, `value` INT UNSIGNED NOT NULL, `text` VARCHAR(32) NOT NULL) ENGINE=InnoDB");
+
+                uint32 l_Index = p_Connection->PrepareTransientStatement("INSERT INTO `benchmark_batch` (`id`, `value`, `text`) VALUES (?, ?, ?)");
+                if (!l_Index)
+                {
+                    p_Connection->Execute("DROP TABLE IF EXISTS `benchmark_batch`");
+                    l_Success = false;
+                    return;
+                }
+
+                for (uint32 l_Pass = 0; l_Pass < 2 && l_Success; ++l_Pass)
+                {
+                    SQLTransaction l_Transaction = CharacterDatabase.BeginTransaction();
+                    l_Transaction->SetMerging(l_Pass != 0);
+
+                    for (uint32 l_I = 0; l_I < l_Rows; ++l_I)
+                    {
+                        PreparedStatement* l_Statement = new PreparedStatement(l_Index);
+                        l_Statement->setUInt32(0, l_I);
+                        l_Statement->setUInt32(1, urand(0, 100000));
+                        l_Statement->setString(2, "benchmark row " + std::to_string(l_I));
+                        l_Transaction->Append(l_Statement);
+                    }
+
+                    l_Transaction->Append("DELETE FROM `benchmark_batch`");
+
+                    uint32 l_StartTime = getMSTime();
+                    l_Success = p_Connection->ExecuteTransaction(l_Transaction);
+                    l_Times[l_Pass] = getMSTimeDiff(l_StartTime, getMSTime());
+                }
+
+                p_Connection->ReleaseTransientStatement(l_Index);
+                p_Connection->Execute("DROP TABLE IF EXISTS `benchmark_batch`");
+            });
+
+            if (!l_Success)
+            {
+                p_Handler->SendSysMessage("Database benchmark failed, see the SQL log.");
+                p_Handler->SetSentErrorMessage(true);
+                return false;
+            }
+
+            p_Handler->PSendSysMessage("Database benchmark, %u rows: %u ms without merging, %u ms with merging (Database.BatchTransactions.MaxRows = %u).",
+                l_Rows, l_Times[0], l_Times[1], uint32(ConfigMgr::GetIntDefault("Database.BatchTransactions.MaxRows", 500)));
+            return true;
+        }
+
+        /// Plans every bracket of a scheduler filled with synthetic queues, on the calling thread then split
+        /// between Battleground.Scheduler.Threads tasks, nothing is created nor invited
+        static bool HandleDebugBenchmarkBattlegroundCommand(ChatHandler* p_Handler, char const* p_Args)
+        {
+            uint32 l_Players = *p_Args ? std::max(1, atoi(p_Args)) : 5000;
+            uint32 l_Threads = std::max(1u, sWorld->getIntConfig(CONFIG_BATTLEGROUND_SCHEDULER_THREADS));
+            uint32 const l_Passes = 20;
+
+            MS::Battlegrounds::BattlegroundScheduler l_Scheduler;
+            l_Scheduler.QueueSyntheticGroups(l_Players);
+
+            std::vector<MS::Battlegrounds::BracketPlan> l_Plans;
+            uint32 l_Times[2];
+            uint32 l_Decided = 0;
+
+            for (uint32 l_Pass = 0; l_Pass < 2; ++l_Pass)
+            {
+                uint32 l_StartTime = getMSTime();
+                for (uint32 l_I = 0; l_I < l_Passes; ++l_I)
+                    l_Scheduler.PlanBrackets(l_Plans, l_Pass ? l_Threads : 0);
+
+                l_Times[l_Pass] = getMSTimeDiff(l_StartTime, getMSTime());
+            }
+
+            for (MS::Battlegrounds::BracketPlan const& l_Plan : l_Plans)
+            {
+                if (l_Plan.m_DecidedBg != MS::Battlegrounds::BattlegroundType::None)
+                    ++l_Decided;
+            }
+
+            p_Handler->PSendSysMessage("Battleground scheduler benchmark, %u queued players, %u passes: %u ms on one thread, %u ms with %u tasks, %u brackets would start a battleground.",
+                l_Players, l_Passes, l_Times[0], l_Times[1], l_Threads, l_Decided);
+            return true;
+        }
+
+        /// Runs unit events and script timers scheduled over the next minute by 50 ms updates
+        /// p_Args : Event count, 100000 by default, the script timers are spread over maps of 100 events
+        static bool HandleDebugBenchmarkEventsCommand(ChatHandler* p_Handler, char const* p_Args)
+        {
+            class BenchmarkEvent : public BasicEvent
+            {
+                public:
+                    explicit BenchmarkEvent(uint32* p_Executed) : m_Executed(p_Executed) { }
+
+                    bool Execute(uint64 /*p_Time*/, uint32 /*p_Diff*/) override
+                    {
+                        ++(*m_Executed);
+                        return true;
+                    }
+
+                private:
+                    uint32* m_Executed;
+            };
+
+            uint32 l_Count = *p_Args ? std::max(1, atoi(p_Args)) : 100000;
+            uint32 const l_Span = 60 * IN_MILLISECONDS;
+            uint32 const l_Diff = 50;
+
+            std::vector<uint32> l_Delays(l_Count);
+            for (uint32& l_Delay : l_Delays)
+                l_Delay = urand(0, l_Span);
+
+            uint32 l_Times[3];
+            uint32 l_Executed[3] = { 0, 0, 0 };
+
+            /// Reference: the tree of the former event processor, one node allocation per event
+            {
+                uint32 l_StartTime = getMSTime();
+
+                std::multimap<uint64, BasicEvent*> l_Events;
+                for (uint32 l_Delay : l_Delays)
+                    l_Events.insert(std::make_pair(uint64(l_Delay), new BenchmarkEvent(&l_Executed[0])));
+
+                for (uint64 l_Now = l_Diff; !l_Events.empty(); l_Now += l_Diff)
+                {
+                    std::multimap<uint64, BasicEvent*>::iterator l_Itr;
+                    while ((l_Itr = l_Events.begin()) != l_Events.end() && l_Itr->first <= l_Now)
+                    {
+                        BasicEvent* l_Event = l_Itr->second;
+                        l_Events.erase(l_Itr);
+
+                        if (l_Event->Execute(l_Now, l_Diff))
+                            delete l_Event;
+                    }
+                }
+
+                l_Times[0] = getMSTimeDiff(l_StartTime, getMSTime());
+            }
+
+            {
+                uint32 l_StartTime = getMSTime();
+
+                EventProcessor l_Processor;
+                for (uint32 l_Delay : l_Delays)
+                    l_Processor.AddEvent(new BenchmarkEvent(&l_Executed[1]), l_Processor.CalculateTime(l_Delay));
+
+                while (l_Executed[1] < l_Count)
+                    l_Processor.Update(l_Diff);
+
+                l_Times[1] = getMSTimeDiff(l_StartTime, getMSTime());
+            }
+
+            /// Boss script like usage: every executed timer is scheduled again, one out of four reschedules another one
+            {
+                uint32 l_MapCount = std::max(1u, l_Count / 100);
+                std::vector<EventMap> l_Maps(l_MapCount);
+
+                uint32 l_StartTime = getMSTime();
+
+                for (uint32 l_I = 0; l_I < l_Count; ++l_I)
+                    l_Maps[l_I % l_MapCount].ScheduleEvent(l_I / l_MapCount + 1, l_Delays[l_I], l_I % 3);
+
+                for (uint32 l_Elapsed = 0; l_Elapsed < l_Span; l_Elapsed += l_Diff)
+                {
+                    for (EventMap& l_Map : l_Maps)
+                    {
+                        l_Map.Update(l_Diff);
+
+                        while (uint32 l_EventId = l_Map.ExecuteEvent())
+                        {
+                            ++l_Executed[2];
+                            l_Map.ScheduleEvent(l_EventId, l_Delays[(l_EventId + l_Executed[2]) % l_Count] / 4 + l_Diff);
+
+                            if (!(l_Executed[2] & 3))
+                                l_Map.RescheduleEvent(l_EventId % 100 + 1, l_Delays[l_Executed[2] % l_Count] / 4 + l_Diff);
+                        }
+                    }
+                }
+
+                l_Maps.clear();
+                l_Times[2] = getMSTimeDiff(l_StartTime, getMSTime());
+            }
+
+            p_Handler->PSendSysMessage("Event benchmark, %u events over %u ms: %u ms with a tree, %u ms with the event processor (%u executed), %u ms for %u script timers executed in %u event maps.",
+                l_Count, l_Span, l_Times[0], l_Times[1], l_Executed[1], l_Times[2], l_Executed[2], uint32(std::max(1u, l_Count / 100)));
+            return true;
+        }
+
+        /// Generates the loot of a creature loot template for as many corpses, with the rates and the auras of the player if any
+        /// p_Args : Loot id, then the corpse count, 1000000 by default
+        static bool HandleDebugBenchmarkLootCommand(ChatHandler* p_Handler, char const* p_Args)
+        {
+            char* l_LootIdStr = strtok((char*)p_Args, " ");
+            if (!l_LootIdStr)
+                return false;
+
+            char* l_CountStr = strtok(NULL, " ");
+
+            uint32 l_LootId = atoi(l_LootIdStr);
+            uint32 l_Count  = l_CountStr ? std::max(1, atoi(l_CountStr)) : 1000000;
+
+            LootTemplate const* l_Template = LootTemplates_Creature.GetLootFor(l_LootId);
+            if (!l_Template)
+            {
+                p_Handler->PSendSysMessage("No creature loot template %u.", l_LootId);
+                p_Handler->SetSentErrorMessage(true);
+                return false;
+            }
+
+            Player* l_Player = p_Handler->GetSession() ? p_Handler->GetSession()->GetPlayer() : nullptr;
+            Loot l_Loot;
+            uint64 l_Items = 0;
+
+            uint32 l_StartTime = getMSTime();
+
+            for (uint32 l_I = 0; l_I < l_Count; ++l_I)
+            {
+                l_Template->Process(l_Loot, LootTemplates_Creature.IsRatesAllowed(), LOOT_MODE_DEFAULT, l_Player);
+                l_Items += l_Loot.Items.size() + l_Loot.QuestItems.size();
+
+                l_Loot.Items.clear();
+                l_Loot.QuestItems.clear();
+                l_Loot.UnlootedCount = 0;
+            }
+
+            uint32 l_Time = getMSTimeDiff(l_StartTime, getMSTime());
+
+            p_Handler->PSendSysMessage("Loot benchmark, %u corpses of creature loot %u: %u ms, %.2f items per corpse.", l_Count, l_LootId, l_Time, float(double(l_Items) / l_Count));
+            return true;
+        }
+
+        /// Builds the check request of synthetic sessions and validates the answer of a clean client, RC4 excluded
+        /// p_Args : Session count, 5000 by default, each one goes through 10 requests
+        static bool HandleDebugBenchmarkWardenCommand(ChatHandler* p_Handler, char const* p_Args)
+        {
+            if (sWardenCheckMgr->MemChecksIdPool.empty() && sWardenCheckMgr->OtherChecksIdPool.empty())
+            {
+                p_Handler->PSendSysMessage("No Warden check loaded.");
+                p_Handler->SetSentErrorMessage(true);
+                return false;
+            }
+
+            uint32 l_Sessions = *p_Args ? std::max(1, atoi(p_Args)) : 5000;
+            uint32 l_MemChecks = sWorld->getIntConfig(CONFIG_WARDEN_NUM_MEM_CHECKS);
+            uint32 l_OtherChecks = sWorld->getIntConfig(CONFIG_WARDEN_NUM_OTHER_CHECKS);
+            uint32 const l_Requests = 10;
+
+            std::vector<WardenCheckCycle> l_Cycles(l_Sessions);
+            std::vector<std::vector<uint16>> l_Checks(l_Sessions);
+            std::vector<ByteBuffer> l_Answers(l_Sessions);
+            ByteBuffer l_Request(256);
+            uint64 l_Bytes = 0;
+            uint32 l_Failed = 0;
+            uint32 l_Times[2] = { 0, 0 };
+
+            for (uint32 l_I = 0; l_I < l_Requests; ++l_I)
+            {
+                uint32 l_StartTime = getMSTime();
+
+                for (uint32 l_Session = 0; l_Session < l_Sessions; ++l_Session)
+                {
+                    sWardenCheckMgr->DrawChecks(l_Cycles[l_Session], l_MemChecks, l_OtherChecks, l_Checks[l_Session]);
+
+                    l_Request.clear();
+                    WardenWin::BuildCheckRequest(l_Request, l_Checks[l_Session], 0x5A);
+                    l_Bytes += l_Request.size();
+                }
+
+                l_Times[0] += getMSTimeDiff(l_StartTime, getMSTime());
+
+                /// What a clean client answers: length, checksum, timing check then the checks
+                for (uint32 l_Session = 0; l_Session < l_Sessions; ++l_Session)
+                {
+                    ByteBuffer& l_Answer = l_Answers[l_Session];
+                    l_Answer.clear();
+                    l_Answer << uint16(0) << uint32(0);
+                    l_Answer << uint8(1) << uint32(getMSTime());
+
+                    for (uint16 l_Id : l_Checks[l_Session])
+                    {
+                        WardenCheck const* l_Check = sWardenCheckMgr->GetWardenDataById(l_Id);
+                        switch (l_Check->Type)
+                        {
+                            case MEM_CHECK:
+                            case MPQ_CHECK:
+                                l_Answer << uint8(0);
+                                l_Answer.append(l_Check->Expected.data(), l_Check->Expected.size());
+                                break;
+                            case LUA_STR_CHECK:
+                                l_Answer << uint8(0) << uint8(0);
+                                break;
+                            default:
+                                l_Answer << uint8(0xE9);
+                                break;
+                        }
+                    }
+
+                    l_Answer.put<uint16>(0, uint16(l_Answer.size() - 6));
+                    l_Answer.put<uint32>(2, Warden::BuildChecksum(l_Answer.contents() + 6, l_Answer.size() - 6));
+                }
+
+                l_StartTime = getMSTime();
+
+                for (uint32 l_Session = 0; l_Session < l_Sessions; ++l_Session)
+                {
+                    ByteBuffer& l_Answer = l_Answers[l_Session];
+                    uint16 l_FailedCheck = 0;
+
+                    if (!Warden::IsValidCheckSum(l_Answer.read<uint32>(2), l_Answer.contents() + 6, l_Answer.read<uint16>(0)))
+                    {
+                        ++l_Failed;
+                        continue;
+                    }
+
+                    l_Answer.rpos(6 + 5);
+                    if (!WardenWin::ValidateCheckResults(l_Answer, l_Checks[l_Session], 0, l_FailedCheck) || l_FailedCheck)
+                        ++l_Failed;
+                }
+
+                l_Times[1] += getMSTimeDiff(l_StartTime, getMSTime());
+            }
+
+            p_Handler->PSendSysMessage("Warden benchmark, %u sessions, %u requests each: %u ms to draw and build the requests (%u bytes on average), %u ms to validate the answers, %u failed.",
+                l_Sessions, l_Requests, l_Times[0], uint32(l_Bytes / (uint64(l_Sessions) * l_Requests)), l_Times[1], l_Failed);
+            return true;
+        }
 };
 
 void AddSC_debug_commandscript()
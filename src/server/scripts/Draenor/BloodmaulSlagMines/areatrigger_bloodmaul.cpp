@@ -24,12 +24,9 @@ namespace MS
                     SuppresionFieldEffect = 151638,
                 };
 
-                std::forward_list<uint64> m_Targets;
-
             public:
                 AreaTrigger_SuppresionField()
-                    : AreaTriggerEntityScript("AreaTrigger_SuppresionField"),
-                    m_Targets()
+                    : AreaTriggerEntityScript("AreaTrigger_SuppresionField")
                 {
                 }
 
@@ -43,11 +40,12 @@ namespace MS
                     // If We are on the last tick.
                     if (p_AreaTrigger->GetDuration() < 100)
                     {
+                        AreaTargetTracker& l_Tracker = p_AreaTrigger->GetTargetTracker();
+                        l_Tracker.Clear();
 
-                        for (auto l_Guid : m_Targets)
+                        for (uint64 l_Guid : l_Tracker.GetLeft())
                         {
-                            Unit* l_Target = Unit::GetUnit(*p_AreaTrigger, l_Guid);
-                            if (l_Target)
+                            if (Unit* l_Target = Unit::GetUnit(*p_AreaTrigger, l_Guid))
                                 l_Target->RemoveAura(uint32(Spells::SuppresionFieldEffect));
                         }
                     }
@@ -55,39 +53,31 @@ namespace MS
 
                 void OnUpdate(AreaTrigger* p_AreaTrigger, uint32 /*p_Time*/)
                 {
-                    std::list<Unit*> l_TargetList;
                     float l_Radius = 5.0f;
 
-                    JadeCore::NearestAttackableUnitInObjectRangeCheck l_Check(p_AreaTrigger, p_AreaTrigger->GetCaster(), l_Radius);
-                    JadeCore::UnitListSearcher<JadeCore::NearestAttackableUnitInObjectRangeCheck> l_Searcher(p_AreaTrigger, l_TargetList, l_Check);
-                    p_AreaTrigger->VisitNearbyObject(l_Radius, l_Searcher);
+                    Unit* l_Caster = p_AreaTrigger->GetCaster();
+                    if (!l_Caster)
+                        return;
 
-                    std::forward_list<uint64> l_ToRemove; // We need to do it in two phase, otherwise it will break iterators.
-                    for (auto l_Guid : m_Targets)
+                    /// Not NearestAttackableUnitInObjectRangeCheck, it shrinks its range with every match
+                    auto l_InField = [l_Caster, p_AreaTrigger, l_Radius](Unit* p_Unit) -> bool
                     {
-                        Unit* l_Target = Unit::GetUnit(*p_AreaTrigger, l_Guid);
-                        if (l_Target && l_Target->GetExactDist2d(p_AreaTrigger) > l_Radius)
-                        {
-                            if (l_Target->HasAura(uint32(Spells::SuppresionFieldEffect)))
-                            {
-                                l_ToRemove.emplace_front(l_Guid);
-                                l_Target->RemoveAura(uint32(Spells::SuppresionFieldEffect));
-                            }
-                        }
-                    }
+                        return p_Unit->isTargetableForAttack() && !l_Caster->IsFriendlyTo(p_Unit) && p_Unit->GetExactDist2d(p_AreaTrigger) <= l_Radius;
+                    };
+
+                    AreaTargetTracker& l_Tracker = p_AreaTrigger->GetTargetTracker();
+                    l_Tracker.Update(p_AreaTrigger, l_Radius, l_InField);
 
-                    for (auto l_Guid : l_ToRemove)
+                    for (uint64 l_Guid : l_Tracker.GetLeft())
                     {
-                        m_Targets.remove(l_Guid);
+                        if (Unit* l_Target = Unit::GetUnit(*p_AreaTrigger, l_Guid))
+                            l_Target->RemoveAura(uint32(Spells::SuppresionFieldEffect));
                     }
 
-                    for (Unit* l_Unit : l_TargetList)
+                    for (Unit* l_Unit : l_Tracker.GetEntered())
                     {
-                        if (!l_Unit || l_Unit->GetExactDist2d(p_AreaTrigger) > l_Radius || l_Unit->HasAura(uint32(Spells::SuppresionFieldEffect)))
-                            continue;
-
-                        p_AreaTrigger->GetCaster()->CastSpell(l_Unit, uint32(Spells::SuppresionFieldEffect), true);
-                        m_Targets.emplace_front(l_Unit->GetGUID());
+                        if (!l_Unit->HasAura(uint32(Spells::SuppresionFieldEffect)))
+                            l_Caster->CastSpell(l_Unit, uint32(Spells::SuppresionFieldEffect), true);
                     }
                 }
             };
@@ -971,9 +971,7 @@ class spell_warl_flames_of_xoroth: public SpellScriptLoader
                             PetQueryHolder* l_PetHolder = new PetQueryHolder(p_Result->Fetch()[0].GetUInt32(), l_RealmID, p_Result);
                             l_PetHolder->Initialize();
 
-                            auto l_QueryHolderResultFuture = CharacterDatabase.DelayQueryHolder(l_PetHolder);
-
-                            sWorld->AddQueryHolderCallback(QueryHolderCallback(l_QueryHolderResultFuture, [l_NewPet, l_PlayerGUID, l_PetNumber](SQLQueryHolder* p_QueryHolder) -> void
+                            DelayQueryHolder(CharacterDatabase, l_PetHolder, [l_NewPet, l_PlayerGUID, l_PetNumber](SQLQueryHolder* p_QueryHolder) -> void
                             {
                                 Player* l_Player = sObjectAccessor->FindPlayer(l_PlayerGUID);
                                 if (!l_Player || !p_QueryHolder)
@@ -1008,7 +1006,7 @@ class spell_warl_flames_of_xoroth: public SpellScriptLoader
                                             break;
                                     }
                                 });
-                            }));
+                            });
                         });
                     }
                 }
@@ -12,7 +12,7 @@
 #include "MySQLConnection.h"
 #include "MySQLThreading.h"
 
-DatabaseWorker::DatabaseWorker(ACE_Activation_Queue* new_queue, MySQLConnection* con) :
+DatabaseWorker::DatabaseWorker(SQLOperationQueue* new_queue, MySQLConnection* con) :
 m_queue(new_queue),
 m_conn(con)
 {
@@ -28,13 +28,19 @@ int DatabaseWorker::svc()
     SQLOperation *request = NULL;
     while (1)
     {
-        request = (SQLOperation*)(m_queue->dequeue());
+        request = m_queue->Dequeue();
         if (!request)
             break;
 
+        std::chrono::steady_clock::time_point l_StartTime = std::chrono::steady_clock::now();
+
         request->SetConnection(m_conn);
         request->call();
 
+        SQLQueueLaneStats& l_Stats = m_queue->GetStats(request->m_priority);
+        l_Stats.Wait.Add(std::chrono::duration_cast<std::chrono::microseconds>(l_StartTime - request->m_enqueueTime).count());
+        l_Stats.Execution.Add(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - l_StartTime).count());
+
         delete request;
     }
 
@@ -10,14 +10,14 @@
 #define _WORKERTHREAD_H
 
 #include <ace/Task.h>
-#include <ace/Activation_Queue.h>
+#include "SQLOperationQueue.h"
 
 class MySQLConnection;
 
 class DatabaseWorker : protected ACE_Task_Base
 {
     public:
-        DatabaseWorker(ACE_Activation_Queue* new_queue, MySQLConnection* con);
+        DatabaseWorker(SQLOperationQueue* new_queue, MySQLConnection* con);
 
         ///- Inherited from ACE_Task_Base
         int svc();
@@ -25,7 +25,7 @@ class DatabaseWorker : protected ACE_Task_Base
 
     private:
         DatabaseWorker() : ACE_Task_Base() {}
-        ACE_Activation_Queue* m_queue;
+        SQLOperationQueue* m_queue;
         MySQLConnection* m_conn;
 };
 
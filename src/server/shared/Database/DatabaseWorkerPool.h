@@ -37,13 +37,9 @@ class DatabaseWorkerPool
     public:
         /* Activity state */
         DatabaseWorkerPool() :
-        _queue(new ACE_Activation_Queue())
+        _queue(new SQLOperationQueue())
         {
             memset(_connectionCount, 0, sizeof(_connectionCount));
-            
-            /// Update queue size limit, 16 kb is not enough
-            _queue->queue()->high_water_mark(8 * 1024 * 1024);
-            _queue->queue()->low_water_mark(8 * 1024 * 1024);
 
             WPFatal (mysql_thread_safe(), "Used MySQL library isn't thread-safe.");
         }
@@ -93,10 +89,10 @@ class DatabaseWorkerPool
         {
             sLog->outInfo(LOG_FILTER_SQL_DRIVER, "Closing down DatabasePool '%s'.", GetDatabaseName());
 
-            //! Shuts down delaythreads for this connection pool by underlying deactivate().
-            //! The next dequeue attempt in the worker thread tasks will result in an error,
-            //! ultimately ending the worker thread task.
-            _queue->queue()->close();
+            //! Shuts down delaythreads for this connection pool.
+            //! Workers drain the operations still queued, then the next dequeue attempt
+            //! returns NULL, ultimately ending the worker thread task.
+            _queue->Close();
 
             for (uint8 i = 0; i < _connectionCount[IDX_ASYNC]; ++i)
             {
@@ -117,7 +113,7 @@ class DatabaseWorkerPool
             for (uint8 i = 0; i < _connectionCount[IDX_SYNCH]; ++i)
                 _connections[IDX_SYNCH][i]->Close();
 
-            //! Deletes the ACE_Activation_Queue object and its underlying ACE_Message_Queue
+            //! Deletes the SQLOperationQueue object
             delete _queue;
 
             sLog->outInfo(LOG_FILTER_SQL_DRIVER, "All connections on DatabasePool '%s' closed.", GetDatabaseName());
@@ -129,13 +125,13 @@ class DatabaseWorkerPool
 
         //! Enqueues a one-way SQL operation in string format that will be executed asynchronously.
         //! This method should only be used for queries that are only executed once, e.g during startup.
-        void Execute(const char* sql)
+        void Execute(const char* sql, SQLOperationPriority priority = SQL_PRIORITY_NORMAL)
         {
             if (!sql)
                 return;
 
             BasicStatementTask* task = new BasicStatementTask(sql);
-            Enqueue(task);
+            Enqueue(task, priority);
         }
 
         //! Enqueues a one-way SQL operation in string format -with variable args- that will be executed asynchronously.
@@ -156,7 +152,7 @@ class DatabaseWorkerPool
 
         //! Enqueues a one-way SQL operation in prepared statement format that will be executed asynchronously.
         //! Statement must be prepared with CONNECTION_ASYNC flag.
-        void Execute(PreparedStatement* stmt)
+        void Execute(PreparedStatement* stmt, SQLOperationPriority priority = SQL_PRIORITY_NORMAL)
         {
             if (stmt->getIndex() == 0)
             {
@@ -167,7 +163,7 @@ class DatabaseWorkerPool
             }
 
             PreparedStatementTask* task = new PreparedStatementTask(stmt);
-            Enqueue(task);
+            Enqueue(task, priority);
         }
 
         /**
@@ -263,6 +259,31 @@ class DatabaseWorkerPool
             return QueryResult(result);
         }
 
+        //! Directly executes an SQL query in string format, rows are streamed from the server while they are read
+        //! instead of being buffered all at once. Meant for big startup loaders: GetRowCount() only counts the rows
+        //! read so far, and the synchronous connection stays busy until the last row is read or the result destroyed.
+        QueryResult StreamQuery(const char* sql)
+        {
+            T* conn = GetFreeConnection();
+
+            ResultSet* result = conn->QueryStream(sql);
+            if (!result)
+            {
+                conn->Unlock();
+                return QueryResult(NULL);
+            }
+
+            //! The result set gives the connection back, even when empty
+            result->SetStreamConnection(conn);
+            if (!result->NextRow())
+            {
+                delete result;
+                return QueryResult(NULL);
+            }
+
+            return QueryResult(result);
+        }
+
         //! Directly executes an SQL query in string format -with variable args- that will block the calling thread until finished.
         //! Returns reference counted auto pointer, no need for manual memory management in upper level code.
         QueryResult PQuery(const char* sql, MySQLConnection* conn, ...)
@@ -354,7 +375,7 @@ class DatabaseWorkerPool
         //! Enqueues a query in prepared format that will set the value of the PreparedQueryResultFuture return object as soon as the query is executed.
         //! The return value is then processed in ProcessQueryCallback methods.
         //! Statement must be prepared with CONNECTION_ASYNC flag.
-        PreparedQueryResultFuture AsyncQuery(PreparedStatement* stmt)
+        PreparedQueryResultFuture AsyncQuery(PreparedStatement* stmt, SQLOperationPriority priority = SQL_PRIORITY_NORMAL)
         {
             if (stmt->getIndex() == 0)
             {
@@ -366,22 +387,46 @@ class DatabaseWorkerPool
 
             PreparedQueryResultFuture res;
             PreparedStatementTask* task = new PreparedStatementTask(stmt, res);
-            Enqueue(task);
+            Enqueue(task, priority);
             return res;
         }
 
+        //! Enqueues a query in prepared format, the callback is posted with the result to callbackQueue as soon as the query is executed,
+        //! and runs when the owner of the queue processes it. No future to poll.
+        //! Statement must be prepared with CONNECTION_ASYNC flag.
+        void AsyncQuery(PreparedStatement* stmt, PreparedQueryCallback callback, SQLCallbackQueuePtr callbackQueue, SQLOperationPriority priority = SQL_PRIORITY_NORMAL)
+        {
+            if (stmt->getIndex() == 0)
+            {
+                ACE_Stack_Trace l_Stack;
+                sLog->outAshran("DatabaseWorkerPool::AsyncQuery: Statement index 0");
+                sLog->outAshran(l_Stack.c_str());
+                return;
+            }
+
+            Enqueue(new PreparedStatementTask(stmt, callback, callbackQueue), priority);
+        }
+
         //! Enqueues a vector of SQL operations (can be both adhoc and prepared) that will set the value of the QueryResultHolderFuture
         //! return object as soon as the query is executed.
         //! The return value is then processed in ProcessQueryCallback methods.
         //! Any prepared statements added to this holder need to be prepared with the CONNECTION_ASYNC flag.
-        QueryResultHolderFuture DelayQueryHolder(SQLQueryHolder* holder)
+        QueryResultHolderFuture DelayQueryHolder(SQLQueryHolder* holder, SQLOperationPriority priority = SQL_PRIORITY_NORMAL)
         {
             QueryResultHolderFuture res;
             SQLQueryHolderTask* task = new SQLQueryHolderTask(holder, res);
-            Enqueue(task);
+            Enqueue(task, priority);
             return res;     //! Fool compiler, has no use yet
         }
 
+        //! Enqueues a vector of SQL operations (can be both adhoc and prepared), the callback is posted with the holder to callbackQueue
+        //! as soon as all queries are executed.
+        //! Any prepared statements added to this holder need to be prepared with the CONNECTION_ASYNC flag.
+        void DelayQueryHolder(SQLQueryHolder* holder, QueryHolderCallbackFunction callback, SQLCallbackQueuePtr callbackQueue, SQLOperationPriority priority = SQL_PRIORITY_NORMAL)
+        {
+            Enqueue(new SQLQueryHolderTask(holder, callback, callbackQueue), priority);
+        }
+
         /**
             Transaction context methods.
         */
@@ -392,7 +437,8 @@ class DatabaseWorkerPool
             return SQLTransaction(new Transaction);
         }
 
-        void CommitTransactionWithCallback(SQLTransaction transaction, MS::Utilities::CallBackPtr p_Callback = nullptr)
+        void CommitTransactionWithCallback(SQLTransaction transaction, MS::Utilities::CallBackPtr p_Callback = nullptr, SQLCallbackQueuePtr p_CallbackQueue = nullptr,
+            SQLOperationPriority priority = SQL_PRIORITY_NORMAL)
         {
             #ifdef TRINITY_DEBUG
             //! Only analyze transaction weaknesses in Debug mode.
@@ -411,14 +457,14 @@ class DatabaseWorkerPool
             }
             #endif // TRINITY_DEBUG
 
-            Enqueue(new TransactionTask(transaction, p_Callback));
+            Enqueue(new TransactionTask(transaction, p_Callback, p_CallbackQueue), priority);
         }
 
         //! Enqueues a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
         //! were appended to the transaction will be respected during execution.
-        void CommitTransaction(SQLTransaction transaction)
+        void CommitTransaction(SQLTransaction transaction, SQLOperationPriority priority = SQL_PRIORITY_NORMAL)
         {
-            CommitTransactionWithCallback(transaction);
+            CommitTransactionWithCallback(transaction, nullptr, nullptr, priority);
         }
 
         //! Directly executes a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
@@ -456,6 +502,16 @@ class DatabaseWorkerPool
             return error;
         }
 
+        //! Runs a function on a free synchronous connection, locked for the whole call so it can rely on the session
+        //! state (temporary tables, transient statements). Meant for tools, queries of the game go through the methods above.
+        template <class F>
+        void DirectOnConnection(F const& function)
+        {
+            T* t = GetFreeConnection();
+            function(static_cast<MySQLConnection*>(t));
+            t->Unlock();
+        }
+
         //! Method used to execute prepared statements in a diverse context.
         //! Will be wrapped in a transaction if valid object is present, otherwise executed standalone.
         void ExecuteOrAppend(SQLTransaction& trans, PreparedStatement* stmt)
@@ -531,6 +587,17 @@ class DatabaseWorkerPool
                 Enqueue(new PingOperation);
         }
 
+        //! Queue wait and execution latencies of the asynchronous operations, per priority lane.
+        SQLQueueLaneStats& GetQueueStats(SQLOperationPriority priority)
+        {
+            return _queue->GetStats(priority);
+        }
+
+        char const* GetDatabaseName() const
+        {
+            return _connectionInfo.database.c_str();
+        }
+
     private:
         unsigned long EscapeString(char *to, const char *from, unsigned long length)
         {
@@ -540,9 +607,9 @@ class DatabaseWorkerPool
             return mysql_real_escape_string(_connections[IDX_SYNCH][0]->GetHandle(), to, from, length);
         }
 
-        void Enqueue(SQLOperation* op)
+        void Enqueue(SQLOperation* op, SQLOperationPriority priority = SQL_PRIORITY_NORMAL)
         {
-            _queue->enqueue(op);
+            _queue->Enqueue(op, priority);
         }
 
         //! Gets a free connection in the synchronous connection pool.
@@ -564,11 +631,6 @@ class DatabaseWorkerPool
             return NULL;
         }
 
-        char const* GetDatabaseName() const
-        {
-            return _connectionInfo.database.c_str();
-        }
-
     private:
         enum _internalIndex
         {
@@ -577,7 +639,7 @@ class DatabaseWorkerPool
             IDX_SIZE
         };
 
-        ACE_Activation_Queue*           _queue;             //! Queue shared by async worker threads.
+        SQLOperationQueue*              _queue;             //! Queue shared by async worker threads.
         std::vector<T*>                 _connections[IDX_SIZE];
         uint32                          _connectionCount[IDX_SIZE];       //! Counter of MySQL connections;
         MySQLConnectionInfo             _connectionInfo;
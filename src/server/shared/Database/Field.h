@@ -28,6 +28,26 @@
 /// | TINYBLOB, MEDIUMBLOB,  | GetBinary, GetString                   |
 /// | BLOB, LONGBLOB         | GetBinary, GetString                   |
 /// | BINARY, VARBINARY      | GetBinary                              |
+///
+/// GetStringRef returns a non-owning view on string fields, it stays valid as long as the result set
+/// for prepared statements and until the next NextRow() call for text queries.
+
+struct SQLStringRef
+{
+    SQLStringRef() : Data(""), Length(0) { }
+    SQLStringRef(char const* data, uint32 length) : Data(data), Length(length) { }
+
+    bool Empty() const { return Length == 0; }
+    std::string ToString() const { return std::string(Data, Length); }
+
+    bool operator==(char const* other) const { return strlen(other) == Length && !memcmp(Data, other, Length); }
+    bool operator==(std::string const& other) const { return other.size() == Length && !memcmp(Data, other.data(), Length); }
+    bool operator!=(char const* other) const { return !(*this == other); }
+    bool operator!=(std::string const& other) const { return !(*this == other); }
+
+    char const* Data;       ///< Not null-terminated for binary data
+    uint32 Length;
+};
 
 class Field
 {
@@ -264,6 +284,15 @@ class Field
             return std::string(string, data.length);
         }
 
+        SQLStringRef GetStringRef() const
+        {
+            char const* string = GetCString();
+            if (!string)
+                return SQLStringRef();
+
+            return SQLStringRef(string, data.length);
+        }
+
         uint32 GetStringLength() const
         {
             return data.length;
@@ -287,7 +316,7 @@ class Field
         #endif
         struct
         {
-            uint32 length;          // Length (prepared strings only)
+            uint32 length;          // Length
             void* value;            // Actual data in memory
             enum_field_types type;  // Field type
             bool raw;               // Raw bytes? (Prepared statement or ad hoc)
@@ -299,13 +328,11 @@ class Field
         #endif
 
         void SetByteValue(void* newValue, enum_field_types newType, uint32 length);
-        void SetStructuredValue(char* newValue, enum_field_types newType);
+        void SetStructuredValue(char* newValue, enum_field_types newType, uint32 length);
 
         void CleanUp()
         {
-            // Field does not own the data if fetched with prepared statement
-            if (!data.raw)
-                delete[] ((char*)data.value);
+            // Field never owns the data, it points into the result set buffers
             data.value = NULL;
         }
 
@@ -32,7 +32,7 @@ public:
 
     /// Constructors for sync and async connections
     LoginMopDatabaseConnection(MySQLConnectionInfo& p_ConnectionInfo) : MySQLConnection(p_ConnectionInfo) { }
-    LoginMopDatabaseConnection(ACE_Activation_Queue* p_Queue, MySQLConnectionInfo& p_ConnectionInfo) : MySQLConnection(p_Queue, p_ConnectionInfo) { }
+    LoginMopDatabaseConnection(SQLOperationQueue* p_Queue, MySQLConnectionInfo& p_ConnectionInfo) : MySQLConnection(p_Queue, p_ConnectionInfo) { }
 
     /// Loads database type specific prepared statements
     void DoPrepareStatements() override;
@@ -24,6 +24,10 @@
 #include "DatabaseWorker.h"
 #include "Timer.h"
 #include "Log.h"
+#include "Config.h"
+
+/// Upper bound of a merged multi-row statement, kept well under the default max_allowed_packet
+#define MAX_BATCH_QUERY_SIZE (1024 * 1024)
 
 MySQLConnection::MySQLConnection(MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
@@ -32,17 +36,19 @@ m_queue(NULL),
 m_worker(NULL),
 m_Mysql(NULL),
 m_connectionInfo(connInfo),
-m_connectionFlags(CONNECTION_SYNCH)
+m_connectionFlags(CONNECTION_SYNCH),
+m_batchMaxRows(ConfigMgr::GetIntDefault("Database.BatchTransactions.MaxRows", 500))
 {
 }
 
-MySQLConnection::MySQLConnection(ACE_Activation_Queue* queue, MySQLConnectionInfo& connInfo) :
+MySQLConnection::MySQLConnection(SQLOperationQueue* queue, MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
 m_prepareError(false),
 m_queue(queue),
 m_Mysql(NULL),
 m_connectionInfo(connInfo),
-m_connectionFlags(CONNECTION_ASYNC)
+m_connectionFlags(CONNECTION_ASYNC),
+m_batchMaxRows(ConfigMgr::GetIntDefault("Database.BatchTransactions.MaxRows", 500))
 {
     m_worker = new DatabaseWorker(m_queue, this);
 }
@@ -307,6 +313,37 @@ ResultSet* MySQLConnection::Query(const char* sql)
     return new ResultSet(result, fields, rowCount, fieldCount);
 }
 
+/// Same as Query, but rows are read from the server one at a time (mysql_use_result) instead of being
+/// buffered client side. The connection can't be used until the returned result set is exhausted or destroyed.
+ResultSet* MySQLConnection::QueryStream(const char* sql)
+{
+    if (!sql || !m_Mysql)
+        return NULL;
+
+    uint32 _s = getMSTime();
+
+    if (mysql_query(m_Mysql, sql))
+    {
+        uint32 lErrno = mysql_errno(m_Mysql);
+        sLog->outInfo(LOG_FILTER_SQL, "SQL: %s", sql);
+        sLog->outError(LOG_FILTER_SQL, "[%u] %s", lErrno, mysql_error(m_Mysql));
+        sLog->outAshran("[%u] %s", lErrno, mysql_error(m_Mysql));
+
+        if (_HandleMySQLErrno(lErrno))      // If it returns true, an error was handled successfully (i.e. reconnection)
+            return QueryStream(sql);        // We try again
+
+        return NULL;
+    }
+
+    sLog->outDebug(LOG_FILTER_SQL, "[%u ms] SQL(stream): %s", getMSTimeDiff(_s, getMSTime()), sql);
+
+    MYSQL_RES* result = mysql_use_result(m_Mysql);
+    if (!result)
+        return NULL;
+
+    return new ResultSet(result, mysql_fetch_fields(result), 0, mysql_field_count(m_Mysql));
+}
+
 bool MySQLConnection::_Query(const char *sql, MYSQL_RES **pResult, MYSQL_FIELD **pFields, uint64* pRowCount, uint32* pFieldCount)
 {
     if (!m_Mysql)
@@ -372,22 +409,24 @@ bool MySQLConnection::ExecuteTransaction(SQLTransaction& transaction)
 
     BeginTransaction();
 
-    std::list<SQLElementData>::const_iterator itr;
-    for (itr = queries.begin(); itr != queries.end(); ++itr)
+    std::list<SQLElementData>::const_iterator itr = queries.begin();
+    while (itr != queries.end())
     {
         SQLElementData const& data = *itr;
         switch (itr->type)
         {
             case SQL_ELEMENT_PREPARED:
             {
-                PreparedStatement* stmt = data.element.stmt;
-                ASSERT(stmt);
-                if (!Execute(stmt))
+                /// Consecutive executions of the same INSERT/REPLACE statement are merged in one round trip
+                std::list<SQLElementData>::const_iterator l_BatchEnd = transaction->_merging ? _GetBatchEnd(itr, queries.end()) : std::next(itr);
+                if (!ExecuteBatch(itr, l_BatchEnd))
                 {
                     sLog->outWarn(LOG_FILTER_SQL, "Transaction aborted. %u queries not executed.", (uint32)queries.size());
                     RollbackTransaction();
                     return false;
                 }
+
+                itr = l_BatchEnd;
             }
             break;
             case SQL_ELEMENT_RAW:
@@ -400,6 +439,8 @@ bool MySQLConnection::ExecuteTransaction(SQLTransaction& transaction)
                     RollbackTransaction();
                     return false;
                 }
+
+                ++itr;
             }
             break;
         }
@@ -414,6 +455,178 @@ bool MySQLConnection::ExecuteTransaction(SQLTransaction& transaction)
     return true;
 }
 
+//- Executes a run of prepared statements sharing the same index.
+//- A single statement goes through the regular prepared path, longer runs are
+//- rewritten to multi-row INSERT/REPLACE queries of at most m_batchMaxRows rows.
+bool MySQLConnection::ExecuteBatch(std::list<SQLElementData>::const_iterator first, std::list<SQLElementData>::const_iterator last)
+{
+    ASSERT(first != last && first->type == SQL_ELEMENT_PREPARED);
+
+    PreparedStatement* l_First = first->element.stmt;
+    ASSERT(l_First);
+
+    std::list<SQLElementData>::const_iterator l_Next = first;
+    if (++l_Next == last)
+        return Execute(l_First);
+
+    MySQLPreparedStatement* l_MStmt = GetPreparedStatement(l_First->m_index);
+    ASSERT(l_MStmt && l_MStmt->IsBatchable());
+
+    std::string l_Query;
+    l_Query.reserve(std::min<size_t>(MAX_BATCH_QUERY_SIZE, l_MStmt->m_batchPrefix.size() + l_MStmt->m_batchTuple.size() * 2 * m_batchMaxRows));
+
+    uint32 l_Rows = 0;
+    for (std::list<SQLElementData>::const_iterator l_Itr = first; l_Itr != last; ++l_Itr)
+    {
+        if (!l_Rows)
+            l_Query = l_MStmt->m_batchPrefix;
+        else
+            l_Query += ", ";
+
+        _AppendBatchTuple(l_Query, l_MStmt, l_Itr->element.stmt);
+        ++l_Rows;
+
+        l_Next = l_Itr;
+        ++l_Next;
+
+        if (l_Next == last || l_Rows >= m_batchMaxRows || l_Query.size() >= MAX_BATCH_QUERY_SIZE)
+        {
+            l_Query += l_MStmt->m_batchSuffix;
+            if (!Execute(l_Query.c_str()))
+                return false;
+
+            l_Rows = 0;
+        }
+    }
+
+    return true;
+}
+
+//- Returns the end of the run of batchable prepared statements starting at first
+std::list<SQLElementData>::const_iterator MySQLConnection::_GetBatchEnd(std::list<SQLElementData>::const_iterator first, std::list<SQLElementData>::const_iterator last)
+{
+    std::list<SQLElementData>::const_iterator l_End = first;
+    ++l_End;
+
+    if (m_batchMaxRows < 2)
+        return l_End;
+
+    uint32 l_Index = first->element.stmt->m_index;
+    MySQLPreparedStatement* l_MStmt = GetPreparedStatement(l_Index);
+    if (!l_MStmt || !l_MStmt->IsBatchable() || !_IsMergeable(first->element.stmt))
+        return l_End;
+
+    while (l_End != last && l_End->type == SQL_ELEMENT_PREPARED && l_End->element.stmt->m_index == l_Index && _IsMergeable(l_End->element.stmt))
+        ++l_End;
+
+    return l_End;
+}
+
+//- NaN and infinities have no SQL literal, statements binding one keep the regular prepared path
+bool MySQLConnection::_IsMergeable(PreparedStatement* stmt) const
+{
+    for (PreparedStatementData const& l_Param : stmt->statement_data)
+    {
+        if ((l_Param.type == TYPE_FLOAT && !std::isfinite(l_Param.data.f)) || (l_Param.type == TYPE_DOUBLE && !std::isfinite(l_Param.data.d)))
+            return false;
+    }
+
+    return true;
+}
+
+//- Appends the value tuple of the statement with its parameters inlined as escaped SQL literals
+void MySQLConnection::_AppendBatchTuple(std::string& query, MySQLPreparedStatement* mStmt, PreparedStatement* stmt)
+{
+    std::string const& l_Tuple = mStmt->m_batchTuple;
+    std::vector<PreparedStatementData> const& l_Params = stmt->statement_data;
+
+    uint32 l_ParamIndex = 0;
+    char l_Quote = 0;
+    char l_Buffer[64];
+
+    for (size_t i = 0; i < l_Tuple.size(); ++i)
+    {
+        char l_Char = l_Tuple[i];
+        if (l_Quote)
+        {
+            if (l_Char == l_Quote)
+                l_Quote = 0;
+            query += l_Char;
+            continue;
+        }
+
+        if (l_Char == '\'' || l_Char == '"' || l_Char == '`')
+        {
+            l_Quote = l_Char;
+            query += l_Char;
+            continue;
+        }
+
+        if (l_Char != '?')
+        {
+            query += l_Char;
+            continue;
+        }
+
+        ASSERT(l_ParamIndex < l_Params.size());
+        PreparedStatementData const& l_Param = l_Params[l_ParamIndex++];
+
+        switch (l_Param.type)
+        {
+            case TYPE_BOOL:
+                query += l_Param.data.boolean ? '1' : '0';
+                continue;
+            case TYPE_UI8:
+                snprintf(l_Buffer, sizeof(l_Buffer), "%u", uint32(l_Param.data.ui8));
+                break;
+            case TYPE_UI16:
+                snprintf(l_Buffer, sizeof(l_Buffer), "%u", uint32(l_Param.data.ui16));
+                break;
+            case TYPE_UI32:
+                snprintf(l_Buffer, sizeof(l_Buffer), "%u", l_Param.data.ui32);
+                break;
+            case TYPE_UI64:
+                snprintf(l_Buffer, sizeof(l_Buffer), UI64FMTD, l_Param.data.ui64);
+                break;
+            case TYPE_I8:
+                snprintf(l_Buffer, sizeof(l_Buffer), "%d", int32(l_Param.data.i8));
+                break;
+            case TYPE_I16:
+                snprintf(l_Buffer, sizeof(l_Buffer), "%d", int32(l_Param.data.i16));
+                break;
+            case TYPE_I32:
+                snprintf(l_Buffer, sizeof(l_Buffer), "%d", l_Param.data.i32);
+                break;
+            case TYPE_I64:
+                snprintf(l_Buffer, sizeof(l_Buffer), SI64FMTD, l_Param.data.i64);
+                break;
+            case TYPE_FLOAT:
+                snprintf(l_Buffer, sizeof(l_Buffer), "%.9g", l_Param.data.f);
+                break;
+            case TYPE_DOUBLE:
+                snprintf(l_Buffer, sizeof(l_Buffer), "%.17g", l_Param.data.d);
+                break;
+            case TYPE_STRING:
+            {
+                ASSERT(l_Param.data.str.ptr);
+
+                std::vector<char> l_Escaped(l_Param.data.str.len * 2 + 1);
+                unsigned long l_Length = mysql_real_escape_string(m_Mysql, &l_Escaped[0], l_Param.data.str.ptr, l_Param.data.str.len);
+
+                query += '\'';
+                query.append(&l_Escaped[0], l_Length);
+                query += '\'';
+                continue;
+            }
+            case TYPE_NULL:
+                query += "NULL";
+                continue;
+        }
+
+        query += l_Buffer;
+    }
+}
+
 MySQLPreparedStatement* MySQLConnection::GetPreparedStatement(uint32 index)
 {
     ASSERT(index < m_stmts.size());
@@ -459,11 +672,45 @@ void MySQLConnection::PrepareStatement(uint32 index, const char* sql, Connection
         else
         {
             MySQLPreparedStatement* mStmt = new MySQLPreparedStatement(stmt);
+            mStmt->ParseBatchTemplate(sql);
             m_stmts[index] = mStmt;
         }
     }
 }
 
+//- Prepares a statement on this connection only, past the statements of the database, until it is released.
+//- It is prepared again on reconnection like the others. Returns 0 if the preparation failed.
+uint32 MySQLConnection::PrepareTransientStatement(const char* sql)
+{
+    uint32 l_Index = uint32(m_stmts.size());
+    bool l_PrepareError = m_prepareError;
+
+    m_stmts.push_back(NULL);
+    PrepareStatement(l_Index, sql, CONNECTION_BOTH);
+
+    if (!m_stmts[l_Index])
+    {
+        m_stmts.pop_back();
+        m_prepareError = l_PrepareError;
+        return 0;
+    }
+
+    m_queries[l_Index] = std::make_pair(strdup(sql), CONNECTION_BOTH);
+    return l_Index;
+}
+
+//- Transient statements are released in the reverse order of their preparation
+void MySQLConnection::ReleaseTransientStatement(uint32 index)
+{
+    ASSERT(index + 1 == m_stmts.size() && m_queries.find(index) != m_queries.end());
+
+    delete m_stmts[index];
+    m_stmts.pop_back();
+
+    free((void*)m_queries[index].first);
+    m_queries.erase(index);
+}
+
 PreparedResultSet* MySQLConnection::Query(PreparedStatement* stmt)
 {
     MYSQL_RES *result = NULL;
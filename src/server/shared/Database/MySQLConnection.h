@@ -6,7 +6,7 @@
 //
 ////////////////////////////////////////////////////////////////////////////////
 
-#include <ace/Activation_Queue.h>
+#include "SQLOperationQueue.h"
 
 #include "DatabaseWorkerPool.h"
 #include "Transaction.h"
@@ -61,10 +61,11 @@ class MySQLConnection
 {
     template <class T> friend class DatabaseWorkerPool;
     friend class PingOperation;
+    friend class ResultSet;
 
     public:
         MySQLConnection(MySQLConnectionInfo& connInfo);                               //! Constructor for synchronous connections.
-        MySQLConnection(ACE_Activation_Queue* queue, MySQLConnectionInfo& connInfo);  //! Constructor for asynchronous connections.
+        MySQLConnection(SQLOperationQueue* queue, MySQLConnectionInfo& connInfo);     //! Constructor for asynchronous connections.
         virtual ~MySQLConnection();
 
         virtual bool Open();
@@ -74,6 +75,7 @@ class MySQLConnection
         bool Execute(const char* sql);
         bool Execute(PreparedStatement* stmt);
         ResultSet* Query(const char* sql);
+        ResultSet* QueryStream(const char* sql);
         PreparedResultSet* Query(PreparedStatement* stmt);
         bool _Query(const char *sql, MYSQL_RES **pResult, MYSQL_FIELD **pFields, uint64* pRowCount, uint32* pFieldCount);
         bool _Query(PreparedStatement* stmt, MYSQL_RES **pResult, uint64* pRowCount, uint32* pFieldCount);
@@ -82,6 +84,10 @@ class MySQLConnection
         void RollbackTransaction();
         void CommitTransaction();
         bool ExecuteTransaction(SQLTransaction& transaction);
+        bool ExecuteBatch(std::list<SQLElementData>::const_iterator first, std::list<SQLElementData>::const_iterator last);
+
+        uint32 PrepareTransientStatement(const char* sql);
+        void ReleaseTransientStatement(uint32 index);
 
         operator bool () const { return m_Mysql != NULL; }
         void Ping() { mysql_ping(m_Mysql); }
@@ -117,13 +123,17 @@ class MySQLConnection
 
     private:
         bool _HandleMySQLErrno(uint32 errNo);
+        bool _IsMergeable(PreparedStatement* stmt) const;
+        std::list<SQLElementData>::const_iterator _GetBatchEnd(std::list<SQLElementData>::const_iterator first, std::list<SQLElementData>::const_iterator last);
+        void _AppendBatchTuple(std::string& query, MySQLPreparedStatement* mStmt, PreparedStatement* stmt);
 
     private:
-        ACE_Activation_Queue* m_queue;                      //! Queue shared with other asynchronous connections.
+        SQLOperationQueue*    m_queue;                      //! Queue shared with other asynchronous connections.
         DatabaseWorker*       m_worker;                     //! Core worker task.
         MYSQL *               m_Mysql;                      //! MySQL Handle.
         MySQLConnectionInfo&  m_connectionInfo;             //! Connection info (used for logging)
         ConnectionFlags       m_connectionFlags;            //! Connection flags (for preparing relevant statements)
+        uint32                m_batchMaxRows;               //! Max rows merged in one multi-row statement inside transactions (0 = disabled)
         ACE_Thread_Mutex      m_Mutex;
 };
 
@@ -518,6 +518,103 @@ std::string MySQLPreparedStatement::getQueryString(const char *query)
     return ss.str();
 }
 
+//- Split a single-row INSERT/REPLACE statement into prefix, value tuple and suffix
+//- so consecutive executions can be sent as one multi-row query (see MySQLConnection::ExecuteTransaction)
+void MySQLPreparedStatement::ParseBatchTemplate(const char* query)
+{
+    m_batchPrefix.clear();
+    m_batchTuple.clear();
+    m_batchSuffix.clear();
+
+    std::string l_Query = query;
+    std::string l_Upper = l_Query;
+    std::transform(l_Upper.begin(), l_Upper.end(), l_Upper.begin(), ::toupper);
+
+    size_t l_Start = l_Upper.find_first_not_of(" \t\r\n");
+    if (l_Start == std::string::npos)
+        return;
+
+    if (l_Upper.compare(l_Start, 6, "INSERT") != 0 && l_Upper.compare(l_Start, 7, "REPLACE") != 0)
+        return;
+
+    /// Locate the VALUES keyword followed by the value tuple, ignoring quoted identifiers and literals
+    size_t l_TupleStart = std::string::npos;
+    char l_Quote = 0;
+    for (size_t i = l_Start; i < l_Upper.size(); ++i)
+    {
+        char l_Char = l_Upper[i];
+        if (l_Quote)
+        {
+            if (l_Char == l_Quote)
+                l_Quote = 0;
+            continue;
+        }
+
+        if (l_Char == '\'' || l_Char == '"' || l_Char == '`')
+        {
+            l_Quote = l_Char;
+            continue;
+        }
+
+        if (l_Upper.compare(i, 6, "VALUES") != 0 || (i > 0 && (isalnum(l_Upper[i - 1]) || l_Upper[i - 1] == '_')))
+            continue;
+
+        size_t l_Paren = l_Upper.find_first_not_of(" \t\r\n", i + 6);
+        if (l_Paren != std::string::npos && l_Upper[l_Paren] == '(')
+            l_TupleStart = l_Paren;
+        break;
+    }
+
+    if (l_TupleStart == std::string::npos)
+        return;
+
+    /// Find the matching closing parenthesis of the value tuple
+    size_t l_TupleEnd = std::string::npos;
+    uint32 l_Depth = 0;
+    l_Quote = 0;
+    for (size_t i = l_TupleStart; i < l_Query.size(); ++i)
+    {
+        char l_Char = l_Query[i];
+        if (l_Quote)
+        {
+            if (l_Char == l_Quote)
+                l_Quote = 0;
+            continue;
+        }
+
+        if (l_Char == '\'' || l_Char == '"' || l_Char == '`')
+            l_Quote = l_Char;
+        else if (l_Char == '(')
+            ++l_Depth;
+        else if (l_Char == ')' && --l_Depth == 0)
+        {
+            l_TupleEnd = i;
+            break;
+        }
+    }
+
+    if (l_TupleEnd == std::string::npos)
+        return;
+
+    std::string l_Prefix = l_Query.substr(0, l_TupleStart);
+    std::string l_Suffix = l_Query.substr(l_TupleEnd + 1);
+
+    size_t l_SuffixEnd = l_Suffix.find_last_not_of(" \t\r\n;");
+    l_Suffix = l_SuffixEnd == std::string::npos ? std::string() : l_Suffix.substr(0, l_SuffixEnd + 1);
+
+    /// Placeholders outside of the tuple would be duplicated/misplaced, and an already multi-row statement is left alone
+    if (l_Prefix.find('?') != std::string::npos || l_Suffix.find('?') != std::string::npos)
+        return;
+
+    size_t l_SuffixStart = l_Suffix.find_first_not_of(" \t\r\n");
+    if (l_SuffixStart != std::string::npos && l_Suffix[l_SuffixStart] == ',')
+        return;
+
+    m_batchPrefix = l_Prefix;
+    m_batchTuple  = l_Query.substr(l_TupleStart, l_TupleEnd - l_TupleStart + 1);
+    m_batchSuffix = l_Suffix;
+}
+
 //- Execution
 PreparedStatementTask::PreparedStatementTask(PreparedStatement* stmt) :
 m_stmt(stmt),
@@ -533,6 +630,14 @@ m_result(result)
 }
 
 
+PreparedStatementTask::PreparedStatementTask(PreparedStatement* stmt, PreparedQueryCallback callback, SQLCallbackQueuePtr callbackQueue) :
+m_stmt(stmt),
+m_has_result(true),
+m_callback(callback),
+m_callbackQueue(callbackQueue)
+{
+}
+
 PreparedStatementTask::~PreparedStatementTask()
 {
     delete m_stmt;
@@ -542,15 +647,20 @@ bool PreparedStatementTask::Execute()
 {
     if (m_has_result)
     {
+        PreparedQueryResult l_Result;
+
         PreparedResultSet* result = m_conn->Query(m_stmt);
         if (!result || !result->GetRowCount())
-        {
             delete result;
-            m_result.set(PreparedQueryResult(NULL));
-            return false;
-        }
-        m_result.set(PreparedQueryResult(result));
-        return true;
+        else
+            l_Result = PreparedQueryResult(result);
+
+        if (m_callbackQueue)
+            m_callbackQueue->Post(std::bind(m_callback, l_Result));
+        else
+            m_result.set(l_Result);
+
+        return l_Result != nullptr;
     }
 
     return m_conn->Execute(m_stmt);
@@ -10,6 +10,7 @@
 #define _PREPAREDSTATEMENT_H
 
 #include "SQLOperation.h"
+#include "SQLCallbackQueue.h"
 #include <ace/Future.h>
 
 //- Union for data buffer (upper-level bind -> queue -> lower-level bind)
@@ -135,6 +136,10 @@ class MySQLPreparedStatement
         bool CheckValidIndex(uint8 index);
         std::string getQueryString(const char *query);
 
+        //- Multi-row rewriting of single-row INSERT/REPLACE ... VALUES (?, ...) statements
+        void ParseBatchTemplate(const char* query);
+        bool IsBatchable() const { return !m_batchTuple.empty(); }
+
     private:
         void setValue(MYSQL_BIND* param, enum_field_types type, const void* value, uint32 len, bool isUnsigned);
 
@@ -143,9 +148,14 @@ class MySQLPreparedStatement
         uint32 m_paramCount;
         std::vector<bool> m_paramsSet;
         MYSQL_BIND* m_bind;
+
+        std::string m_batchPrefix;      //- "INSERT INTO t (a, b) VALUES "
+        std::string m_batchTuple;       //- "(?, ?)", empty if the statement can't be batched
+        std::string m_batchSuffix;      //- Trailing clause without placeholders, e.g. " ON DUPLICATE KEY UPDATE ..."
 };
 
 typedef ACE_Future<PreparedQueryResult> PreparedQueryResultFuture;
+typedef std::function<void(PreparedQueryResult)> PreparedQueryCallback;
 
 //- Lower-level class, enqueuable operation
 class PreparedStatementTask : public SQLOperation
@@ -153,6 +163,7 @@ class PreparedStatementTask : public SQLOperation
     public:
         PreparedStatementTask(PreparedStatement* stmt);
         PreparedStatementTask(PreparedStatement* stmt, PreparedQueryResultFuture result);
+        PreparedStatementTask(PreparedStatement* stmt, PreparedQueryCallback callback, SQLCallbackQueuePtr callbackQueue);
         ~PreparedStatementTask();
 
         bool Execute();
@@ -161,5 +172,7 @@ class PreparedStatementTask : public SQLOperation
         PreparedStatement* m_stmt;
         bool m_has_result;
         PreparedQueryResultFuture m_result;
+        PreparedQueryCallback m_callback;       //- Posted to m_callbackQueue with the result instead of setting m_result
+        SQLCallbackQueuePtr m_callbackQueue;
 };
 #endif
@@ -189,6 +189,10 @@ bool SQLQueryHolderTask::Execute()
         }
     }
 
-    m_result.set(m_holder);
+    if (m_callbackQueue)
+        m_callbackQueue->Post(std::bind(m_callback, m_holder));
+    else
+        m_result.set(m_holder);
+
     return true;
 }
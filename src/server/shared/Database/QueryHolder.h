@@ -10,6 +10,7 @@
 #define _QUERYHOLDER_H
 
 #include <ace/Future.h>
+#include "SQLCallbackQueue.h"
 
 class SQLQueryHolder
 {
@@ -31,16 +32,21 @@ class SQLQueryHolder
 };
 
 typedef ACE_Future<SQLQueryHolder*> QueryResultHolderFuture;
+typedef std::function<void(SQLQueryHolder*)> QueryHolderCallbackFunction;
 
 class SQLQueryHolderTask : public SQLOperation
 {
     private:
         SQLQueryHolder * m_holder;
         QueryResultHolderFuture m_result;
+        QueryHolderCallbackFunction m_callback;
+        SQLCallbackQueuePtr m_callbackQueue;
 
     public:
         SQLQueryHolderTask(SQLQueryHolder *holder, QueryResultHolderFuture res)
             : m_holder(holder), m_result(res){};
+        SQLQueryHolderTask(SQLQueryHolder *holder, QueryHolderCallbackFunction callback, SQLCallbackQueuePtr callbackQueue)
+            : m_holder(holder), m_callback(callback), m_callbackQueue(callbackQueue) {};
         bool Execute();
 
 };
@@ -13,7 +13,9 @@ ResultSet::ResultSet(MYSQL_RES *result, MYSQL_FIELD *fields, uint64 rowCount, ui
 _rowCount(rowCount),
 _fieldCount(fieldCount),
 _result(result),
-_fields(fields)
+_fields(fields),
+_streamConnection(NULL),
+_incomplete(false)
 {
     _currentRow = new Field[_fieldCount];
 #ifdef TRINITY_DEBUG
@@ -23,6 +25,7 @@ _fields(fields)
 }
 
 PreparedResultSet::PreparedResultSet(MYSQL_STMT* stmt, MYSQL_RES *result, uint64 rowCount, uint32 fieldCount) :
+m_currentRow(NULL),
 m_rowCount(rowCount),
 m_rowPosition(0),
 m_fieldCount(fieldCount),
@@ -53,19 +56,40 @@ m_length(NULL)
     if (mysql_stmt_store_result(m_stmt))
     {
         sLog->outWarn(LOG_FILTER_SQL, "%s:mysql_stmt_store_result, cannot bind result from MySQL server. Error: %s", __FUNCTION__, mysql_stmt_error(m_stmt));
+        m_rowCount = 0;
         return;
     }
 
     m_rowCount = mysql_stmt_num_rows(m_stmt);
 
-    //- This is where we prepare the buffer based on metadata
+    //- This is where we prepare the buffers based on metadata: fixed-size columns get their whole
+    //- column array, variable-length ones a single row buffer copied to the packed storage after each fetch
     MYSQL_FIELD* field = mysql_fetch_fields(m_metadataResult);
+    m_columns.resize(m_fieldCount);
     for (uint32 i = 0; i < m_fieldCount; ++i)
     {
         size_t size = Field::SizeForType(&field[i]);
 
+        Column& column = m_columns[i];
+        column.Type = field[i].type;
+        column.Nulls.resize(m_rowCount, false);
+
+        if (IsVariableLength(column.Type) || !size)
+        {
+            column.Width = 0;
+            column.Data = NULL;
+            column.Offsets.reserve(m_rowCount + 1);
+            column.Offsets.push_back(0);
+            m_rBind[i].buffer = new char[size];
+        }
+        else
+        {
+            column.Width = size;
+            column.Data = new char[size * m_rowCount]();
+            m_rBind[i].buffer = column.Data;
+        }
+
         m_rBind[i].buffer_type = field[i].type;
-        m_rBind[i].buffer = new char[size * m_rowCount];
         m_rBind[i].buffer_length = size;
         m_rBind[i].length = &m_length[i];
         m_rBind[i].is_null = &m_isNull[i];
@@ -81,65 +105,52 @@ m_length(NULL)
         CleanUp();
         delete[] m_isNull;
         delete[] m_length;
+        m_rowCount = 0;
         return;
     }
 
-    m_rowCount = mysql_stmt_num_rows(m_stmt);
-
-    m_rows.resize(uint32(m_rowCount) * m_fieldCount);
     while (_NextRow())
     {
         for (uint32 fIndex = 0; fIndex < m_fieldCount; ++fIndex)
         {
-            unsigned long buffer_length = m_rBind[fIndex].buffer_length;
-            unsigned long fetched_length = *m_rBind[fIndex].length;
-            if (!*m_rBind[fIndex].is_null)
+            Column& column = m_columns[fIndex];
+            bool isNull = *m_rBind[fIndex].is_null;
+            column.Nulls[m_rowPosition] = isNull;
+
+            if (column.Width)
             {
-                void* buffer = m_stmt->bind[fIndex].buffer;
-                switch (m_rBind[fIndex].buffer_type)
-                {
-                    case MYSQL_TYPE_TINY_BLOB:
-                    case MYSQL_TYPE_MEDIUM_BLOB:
-                    case MYSQL_TYPE_LONG_BLOB:
-                    case MYSQL_TYPE_BLOB:
-                    case MYSQL_TYPE_STRING:
-                    case MYSQL_TYPE_VAR_STRING:
-                        // warning - the string will not be null-terminated if there is no space for it in the buffer
-                        // when mysql_stmt_fetch returned MYSQL_DATA_TRUNCATED
-                        // we cannot blindly null-terminate the data either as it may be retrieved as binary blob and not specifically a string
-                        // in this case using Field::GetCString will result in garbage
-                        // TODO: remove Field::GetCString and use boost::string_ref (currently proposed for TS as string_view, maybe in C++17)
-                        if (fetched_length < buffer_length)
-                            *((char*)buffer + fetched_length) = '\0';
-                        break;
-                    default:
-                        break;
-                }
-
-                m_rows[uint32(m_rowPosition) * m_fieldCount + fIndex].SetByteValue(
-                                                                                   buffer,
-                                                                                   m_rBind[fIndex].buffer_type,
-                                                                                   fetched_length);
-
-                // move buffer pointer to next part
-                m_stmt->bind[fIndex].buffer = (char*)buffer + buffer_length;
+                //- Move the bound buffer to the next row of the column array, NULL cells included so rows stay aligned
+                m_stmt->bind[fIndex].buffer = (char*)m_stmt->bind[fIndex].buffer + column.Width;
+                continue;
             }
-            else
+
+            if (!isNull)
             {
-                m_rows[uint32(m_rowPosition) * m_fieldCount + fIndex].SetByteValue(
-                                                                                   nullptr,
-                                                                                   m_rBind[fIndex].buffer_type,
-                                                                                   *m_rBind[fIndex].length);
+                //- The buffer is max_length + 1 bytes long so values are never truncated, but they are not null-terminated
+                unsigned long length = std::min(*m_rBind[fIndex].length, m_rBind[fIndex].buffer_length);
+                char const* buffer = (char const*)m_rBind[fIndex].buffer;
+                column.Strings.insert(column.Strings.end(), buffer, buffer + length);
             }
-            
-#ifdef TRINITY_DEBUG
-            m_rows[uint32(m_rowPosition) * m_fieldCount + fIndex].SetMetadata(&field[fIndex], fIndex);
-#endif
+
+            column.Strings.push_back('\0');
+            column.Offsets.push_back(column.Strings.size());
         }
         m_rowPosition++;
     }
+
+    //- A failed fetch stops the buffering early, only expose complete rows
+    m_rowCount = m_rowPosition;
     m_rowPosition = 0;
 
+    m_currentRow = new Field[m_fieldCount];
+#ifdef TRINITY_DEBUG
+    for (uint32 i = 0; i < m_fieldCount; ++i)
+        m_currentRow[i].SetMetadata(&field[i], i);
+#endif
+
+    if (m_rowCount)
+        _SetCurrentRow();
+
     /// All data is buffered, let go of mysql c api structures
     mysql_stmt_free_result(m_stmt);
 }
@@ -152,6 +163,11 @@ ResultSet::~ResultSet()
 PreparedResultSet::~PreparedResultSet()
 {
     CleanUp();
+
+    for (Column& column : m_columns)
+        delete[] column.Data;
+
+    delete[] m_currentRow;
 }
 
 bool ResultSet::NextRow()
@@ -164,12 +180,24 @@ bool ResultSet::NextRow()
     row = mysql_fetch_row(_result);
     if (!row)
     {
+        /// mysql_use_result gives no row both after the last one and when the connection fails midway
+        if (_streamConnection && mysql_errno(_streamConnection->GetHandle()))
+        {
+            sLog->outError(LOG_FILTER_SQL, "Streamed result stopped after " UI64FMTD " rows, error %u: %s", _rowCount,
+                mysql_errno(_streamConnection->GetHandle()), mysql_error(_streamConnection->GetHandle()));
+            _incomplete = true;
+        }
+
         CleanUp();
         return false;
     }
 
+    unsigned long* lengths = mysql_fetch_lengths(_result);
     for (uint32 i = 0; i < _fieldCount; i++)
-        _currentRow[i].SetStructuredValue(row[i], _fields[i].type);
+        _currentRow[i].SetStructuredValue(row[i], _fields[i].type, lengths[i]);
+
+    if (_streamConnection)
+        ++_rowCount;
 
     return true;
 }
@@ -177,10 +205,11 @@ bool ResultSet::NextRow()
 bool PreparedResultSet::NextRow()
 {
     /// Only updates the m_rowPosition so upper level code knows in which element
-    /// of the rows vector to look
+    /// of the columns to look
     if (++m_rowPosition >= m_rowCount)
         return false;
 
+    _SetCurrentRow();
     return true;
 }
 
@@ -202,6 +231,52 @@ bool PreparedResultSet::_NextRow()
     return retval;
 }
 
+void PreparedResultSet::_SetCurrentRow()
+{
+    uint64 row = m_rowPosition;
+    for (uint32 i = 0; i < m_fieldCount; ++i)
+    {
+        Column& column = m_columns[i];
+        if (column.Nulls[row])
+            m_currentRow[i].SetByteValue(nullptr, column.Type, 0);
+        else if (column.Width)
+            m_currentRow[i].SetByteValue(column.Data + row * column.Width, column.Type, column.Width);
+        else
+            m_currentRow[i].SetByteValue(&column.Strings[column.Offsets[row]], column.Type, column.Offsets[row + 1] - column.Offsets[row] - 1);
+    }
+}
+
+SQLStringRef PreparedResultSet::GetStringRef(uint32 index, uint64 row) const
+{
+    ASSERT(index < m_fieldCount && row < m_rowCount);
+
+    Column const& column = m_columns[index];
+    ASSERT(!column.Width);
+
+    if (column.Nulls[row])
+        return SQLStringRef();
+
+    return SQLStringRef(&column.Strings[column.Offsets[row]], column.Offsets[row + 1] - column.Offsets[row] - 1);
+}
+
+bool PreparedResultSet::IsVariableLength(enum_field_types type)
+{
+    switch (type)
+    {
+        case MYSQL_TYPE_TINY_BLOB:
+        case MYSQL_TYPE_MEDIUM_BLOB:
+        case MYSQL_TYPE_LONG_BLOB:
+        case MYSQL_TYPE_BLOB:
+        case MYSQL_TYPE_STRING:
+        case MYSQL_TYPE_VAR_STRING:
+        case MYSQL_TYPE_DECIMAL:                            //- Fetched as text in a 64 bytes buffer, SUM() results included
+        case MYSQL_TYPE_NEWDECIMAL:
+            return true;
+        default:
+            return false;
+    }
+}
+
 void ResultSet::CleanUp()
 {
     if (_currentRow)
@@ -215,18 +290,30 @@ void ResultSet::CleanUp()
         mysql_free_result(_result);
         _result = NULL;
     }
+
+    /// Freeing a mysql_use_result result reads the remaining rows, only then the connection can be reused
+    if (_streamConnection)
+    {
+        _streamConnection->Unlock();
+        _streamConnection = NULL;
+    }
 }
 
 void PreparedResultSet::CleanUp()
 {
     if (m_metadataResult)
+    {
         mysql_free_result(m_metadataResult);
+        m_metadataResult = NULL;
+    }
 
     if (m_rBind)
     {
+        //- Fixed-size column arrays are owned by m_columns
         for (uint32 i = 0; i < m_fieldCount; ++i)
         {
-            delete[]((char*)m_rBind[i].buffer);
+            if (i >= m_columns.size() || !m_columns[i].Width)
+                delete[]((char*)m_rBind[i].buffer);
             m_rBind[i].buffer = nullptr;
         }
 
@@ -18,6 +18,8 @@
 #endif
 #include <mysql.h>
 
+class MySQLConnection;
+
 class ResultSet
 {
     public:
@@ -35,6 +37,13 @@ class ResultSet
             return _currentRow[index];
         }
 
+        /// Streamed results (mysql_use_result) keep the connection locked until the last row is read
+        /// or the result set is destroyed. The row count is only known once every row was read.
+        void SetStreamConnection(MySQLConnection* connection) { _streamConnection = connection; }
+        bool IsStreamed() const { return _streamConnection != NULL; }
+        /// A streamed read that stopped on a connection error instead of the last row, the rows read so far are partial
+        bool IsIncomplete() const { return _incomplete; }
+
     protected:
         uint64 _rowCount;
         Field* _currentRow;
@@ -44,6 +53,8 @@ class ResultSet
         void CleanUp();
         MYSQL_RES* _result;
         MYSQL_FIELD* _fields;
+        MySQLConnection* _streamConnection;
+        bool _incomplete;
 
         ResultSet(ResultSet const& right) = delete;
         ResultSet& operator=(ResultSet const& right) = delete;
@@ -51,6 +62,34 @@ class ResultSet
 
 typedef std::shared_ptr<ResultSet> QueryResult;
 
+/// Typed view on a fixed-size column of a PreparedResultSet, T must match the storage of the column
+/// (uint32/int32 for INT, uint8 for TINYINT, float for FLOAT, ...). NULL cells read as 0.
+template<class T> class PreparedColumnView
+{
+    public:
+        PreparedColumnView(char const* data, std::vector<bool> const& nulls, uint64 rowCount) :
+            m_data(data), m_nulls(nulls), m_rowCount(rowCount) { }
+
+        uint64 GetRowCount() const { return m_rowCount; }
+        bool IsNull(uint64 row) const { return m_nulls[row]; }
+
+        T operator[](uint64 row) const
+        {
+            ASSERT(row < m_rowCount);
+            T l_Value;
+            memcpy(&l_Value, m_data + row * sizeof(T), sizeof(T));
+            return l_Value;
+        }
+
+    private:
+        char const* m_data;
+        std::vector<bool> const& m_nulls;
+        uint64 m_rowCount;
+};
+
+/// Result of a prepared statement, buffered column by column: fixed-size columns are written by libmysql
+/// straight into one array per column, variable-length columns are packed back to back in one buffer per column.
+/// Fetch() exposes the current row through Field objects pointing into these buffers, nothing is copied per row.
 class PreparedResultSet
 {
     public:
@@ -64,18 +103,46 @@ class PreparedResultSet
         Field* Fetch() const
         {
             ASSERT(m_rowPosition < m_rowCount);
-            return const_cast<Field*>(&m_rows[uint32(m_rowPosition) * m_fieldCount]);
+            return m_currentRow;
         }
 
         Field const& operator[](uint32 index) const
         {
             ASSERT(m_rowPosition < m_rowCount);
             ASSERT(index < m_fieldCount);
-            return m_rows[uint32(m_rowPosition) * m_fieldCount + index];
+            return m_currentRow[index];
+        }
+
+        /// Random access to any row, independently of the current one
+        bool IsNull(uint32 index, uint64 row) const
+        {
+            ASSERT(index < m_fieldCount && row < m_rowCount);
+            return m_columns[index].Nulls[row];
+        }
+
+        SQLStringRef GetStringRef(uint32 index, uint64 row) const;
+
+        template<class T> PreparedColumnView<T> GetColumn(uint32 index) const
+        {
+            ASSERT(index < m_fieldCount);
+            Column const& l_Column = m_columns[index];
+            ASSERT(l_Column.Width == sizeof(T));
+            return PreparedColumnView<T>(l_Column.Data, l_Column.Nulls, m_rowCount);
         }
 
     protected:
-        std::vector<Field> m_rows;
+        struct Column
+        {
+            enum_field_types Type;
+            uint32 Width;                   ///< Bytes per row, 0 for variable-length columns
+            char* Data;                     ///< Width * rows bytes (fixed-size columns only)
+            std::vector<char> Strings;      ///< Null-terminated values packed back to back (variable-length columns only)
+            std::vector<uint32> Offsets;    ///< Start of each row in Strings, plus the end of the last one
+            std::vector<bool> Nulls;
+        };
+
+        std::vector<Column> m_columns;
+        Field* m_currentRow;
         uint64 m_rowCount;
         uint64 m_rowPosition;
         uint32 m_fieldCount;
@@ -90,6 +157,9 @@ class PreparedResultSet
 
         void CleanUp();
         bool _NextRow();
+        void _SetCurrentRow();
+
+        static bool IsVariableLength(enum_field_types type);
 
         PreparedResultSet(PreparedResultSet const& right) = delete;
         PreparedResultSet& operator=(PreparedResultSet const& right) = delete;
@@ -0,0 +1,53 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SQLCALLBACKQUEUE_H
+#define _SQLCALLBACKQUEUE_H
+
+#include "Common.h"
+#include <mutex>
+
+//- Completions of asynchronous operations, posted by the database workers and run by the
+//- thread owning the queue (world, session, map) from its own update. Replaces polling futures.
+class SQLCallbackQueue
+{
+    public:
+        typedef std::function<void()> Completion;
+
+        void Post(Completion const& p_Completion)
+        {
+            std::lock_guard<std::mutex> l_Guard(m_Lock);
+            m_Pending.push_back(p_Completion);
+        }
+
+        //- Runs every completion posted so far, completions posted meanwhile wait for the next call
+        void Process()
+        {
+            {
+                std::lock_guard<std::mutex> l_Guard(m_Lock);
+                if (m_Pending.empty())
+                    return;
+
+                m_Processing.swap(m_Pending);
+            }
+
+            for (Completion const& l_Completion : m_Processing)
+                l_Completion();
+
+            m_Processing.clear();
+        }
+
+    private:
+        std::mutex              m_Lock;
+        std::vector<Completion> m_Pending;
+        std::vector<Completion> m_Processing;   //- Only touched by the owner thread
+};
+
+typedef std::shared_ptr<SQLCallbackQueue> SQLCallbackQueuePtr;
+
+#endif
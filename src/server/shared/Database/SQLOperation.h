@@ -9,10 +9,10 @@
 #ifndef _SQLOPERATION_H
 #define _SQLOPERATION_H
 
-#include <ace/Method_Request.h>
-#include <ace/Activation_Queue.h>
+#include <chrono>
 
 #include "QueryResult.h"
+#include "SQLOperationQueue.h"
 
 //- Forward declare (don't include header to prevent circular includes)
 class PreparedStatement;
@@ -47,10 +47,12 @@ union SQLResultSetUnion
 
 class MySQLConnection;
 
-class SQLOperation : public ACE_Method_Request
+class SQLOperation
 {
     public:
-        SQLOperation(): m_conn(NULL) {};
+        SQLOperation(): m_conn(NULL), m_priority(SQL_PRIORITY_NORMAL) {};
+        virtual ~SQLOperation() {}
+
         virtual int call()
         {
             Execute();
@@ -60,6 +62,9 @@ class SQLOperation : public ACE_Method_Request
         virtual void SetConnection(MySQLConnection* con) { m_conn = con; }
 
         MySQLConnection* m_conn;
+
+        SQLOperationPriority                  m_priority;       //- Lane the operation was queued in
+        std::chrono::steady_clock::time_point m_enqueueTime;    //- For queue latency statistics
 };
 
 #endif
@@ -0,0 +1,232 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "SQLOperationQueue.h"
+#include "SQLOperation.h"
+
+SQLLatencyHistogram::SQLLatencyHistogram() : m_count(0), m_total(0), m_max(0)
+{
+    for (uint32 i = 0; i < SQL_LATENCY_BUCKETS; ++i)
+        m_buckets[i].store(0, std::memory_order_relaxed);
+}
+
+void SQLLatencyHistogram::Add(uint64 microseconds)
+{
+    uint32 l_Bucket = 0;
+    for (uint64 l_Value = microseconds >> 6; l_Value && l_Bucket < SQL_LATENCY_BUCKETS - 1; l_Value >>= 1)
+        ++l_Bucket;
+
+    m_buckets[l_Bucket].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_total.fetch_add(microseconds, std::memory_order_relaxed);
+
+    uint64 l_Max = m_max.load(std::memory_order_relaxed);
+    while (microseconds > l_Max && !m_max.compare_exchange_weak(l_Max, microseconds, std::memory_order_relaxed))
+        ;
+}
+
+uint64 SQLLatencyHistogram::GetAverage() const
+{
+    uint64 l_Count = GetCount();
+    return l_Count ? m_total.load(std::memory_order_relaxed) / l_Count : 0;
+}
+
+uint64 SQLLatencyHistogram::GetPercentile(uint32 percentile) const
+{
+    uint64 l_Count = GetCount();
+    if (!l_Count)
+        return 0;
+
+    uint64 l_Threshold = (l_Count * percentile + 99) / 100;
+    uint64 l_Seen = 0;
+    for (uint32 i = 0; i < SQL_LATENCY_BUCKETS - 1; ++i)
+    {
+        l_Seen += m_buckets[i].load(std::memory_order_relaxed);
+        if (l_Seen >= l_Threshold)
+            return uint64(64) << i;
+    }
+
+    return GetMax();
+}
+
+SQLOperationQueue::SQLOperationQueue(uint32 laneCapacity) :
+m_dequeueCount(0),
+m_sleepers(0),
+m_closed(false)
+{
+    /// Ring buffers need a power of two capacity
+    size_t l_Capacity = 2;
+    while (l_Capacity < laneCapacity)
+        l_Capacity <<= 1;
+
+    for (uint32 l_Priority = 0; l_Priority < MAX_SQL_PRIORITY; ++l_Priority)
+    {
+        Lane& l_Lane = m_lanes[l_Priority];
+        l_Lane.Buffer = new Cell[l_Capacity];
+        l_Lane.Mask   = l_Capacity - 1;
+        l_Lane.EnqueuePos.store(0, std::memory_order_relaxed);
+        l_Lane.DequeuePos.store(0, std::memory_order_relaxed);
+        l_Lane.OverflowSize.store(0, std::memory_order_relaxed);
+
+        for (size_t i = 0; i < l_Capacity; ++i)
+        {
+            l_Lane.Buffer[i].Sequence.store(i, std::memory_order_relaxed);
+            l_Lane.Buffer[i].Operation = NULL;
+        }
+    }
+}
+
+SQLOperationQueue::~SQLOperationQueue()
+{
+    /// Operations still queued at this point were never executed
+    while (SQLOperation* l_Operation = TryDequeue())
+        delete l_Operation;
+
+    for (uint32 l_Priority = 0; l_Priority < MAX_SQL_PRIORITY; ++l_Priority)
+        delete[] m_lanes[l_Priority].Buffer;
+}
+
+bool SQLOperationQueue::TryPush(Lane& lane, SQLOperation* op)
+{
+    size_t l_Pos = lane.EnqueuePos.load(std::memory_order_relaxed);
+    Cell* l_Cell;
+
+    for (;;)
+    {
+        l_Cell = &lane.Buffer[l_Pos & lane.Mask];
+        size_t l_Sequence = l_Cell->Sequence.load(std::memory_order_acquire);
+        intptr_t l_Diff = (intptr_t)l_Sequence - (intptr_t)l_Pos;
+
+        if (l_Diff == 0)
+        {
+            if (lane.EnqueuePos.compare_exchange_weak(l_Pos, l_Pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (l_Diff < 0)
+            return false;   ///< Full
+        else
+            l_Pos = lane.EnqueuePos.load(std::memory_order_relaxed);
+    }
+
+    l_Cell->Operation = op;
+    l_Cell->Sequence.store(l_Pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool SQLOperationQueue::TryPop(Lane& lane, SQLOperation*& op)
+{
+    size_t l_Pos = lane.DequeuePos.load(std::memory_order_relaxed);
+    Cell* l_Cell;
+
+    for (;;)
+    {
+        l_Cell = &lane.Buffer[l_Pos & lane.Mask];
+        size_t l_Sequence = l_Cell->Sequence.load(std::memory_order_acquire);
+        intptr_t l_Diff = (intptr_t)l_Sequence - (intptr_t)(l_Pos + 1);
+
+        if (l_Diff == 0)
+        {
+            if (lane.DequeuePos.compare_exchange_weak(l_Pos, l_Pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (l_Diff < 0)
+        {
+            /// Ring is empty, fall back on operations that didn't fit in it, nothing newer was pushed in the ring meanwhile
+            if (!lane.OverflowSize.load(std::memory_order_acquire))
+                return false;
+
+            std::lock_guard<std::mutex> l_Guard(lane.OverflowLock);
+            if (lane.Overflow.empty())
+                return false;
+
+            op = lane.Overflow.front();
+            lane.Overflow.pop_front();
+            lane.OverflowSize.fetch_sub(1, std::memory_order_release);
+            return true;
+        }
+        else
+            l_Pos = lane.DequeuePos.load(std::memory_order_relaxed);
+    }
+
+    op = l_Cell->Operation;
+    l_Cell->Sequence.store(l_Pos + lane.Mask + 1, std::memory_order_release);
+    return true;
+}
+
+void SQLOperationQueue::Enqueue(SQLOperation* op, SQLOperationPriority priority)
+{
+    ASSERT(priority < MAX_SQL_PRIORITY);
+
+    op->m_priority    = priority;
+    op->m_enqueueTime = std::chrono::steady_clock::now();
+
+    /// Once a lane overflowed, new operations queue behind the overflow until it is drained, so the lane stays
+    /// FIFO: the overflow is only popped once the ring is empty
+    Lane& l_Lane = m_lanes[priority];
+    if (l_Lane.OverflowSize.load(std::memory_order_acquire) || !TryPush(l_Lane, op))
+    {
+        std::lock_guard<std::mutex> l_Guard(l_Lane.OverflowLock);
+        l_Lane.Overflow.push_back(op);
+        l_Lane.OverflowSize.fetch_add(1, std::memory_order_release);
+    }
+
+    /// Pairs with the sleeper registration in Dequeue, either the worker sees the operation or we see the worker
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_sleepers.load(std::memory_order_relaxed))
+    {
+        std::lock_guard<std::mutex> l_Guard(m_sleepLock);
+        m_sleepCondition.notify_one();
+    }
+}
+
+SQLOperation* SQLOperationQueue::TryDequeue()
+{
+    SQLOperation* l_Operation = NULL;
+
+    /// Lanes are strictly ordered, except every 8th dequeue which starts from the lowest one so logs can't starve
+    bool l_Reverse = (m_dequeueCount.fetch_add(1, std::memory_order_relaxed) & 7) == 7;
+    for (uint32 i = 0; i < MAX_SQL_PRIORITY; ++i)
+    {
+        uint32 l_Priority = l_Reverse ? MAX_SQL_PRIORITY - 1 - i : i;
+        if (TryPop(m_lanes[l_Priority], l_Operation))
+            return l_Operation;
+    }
+
+    return NULL;
+}
+
+SQLOperation* SQLOperationQueue::Dequeue()
+{
+    for (;;)
+    {
+        if (SQLOperation* l_Operation = TryDequeue())
+            return l_Operation;
+
+        std::unique_lock<std::mutex> l_Lock(m_sleepLock);
+        m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+
+        SQLOperation* l_Operation = TryDequeue();
+        if (!l_Operation && !m_closed.load(std::memory_order_acquire))
+            m_sleepCondition.wait(l_Lock);
+
+        m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+
+        if (l_Operation)
+            return l_Operation;
+
+        if (m_closed.load(std::memory_order_acquire))
+            return TryDequeue();
+    }
+}
+
+void SQLOperationQueue::Close()
+{
+    std::lock_guard<std::mutex> l_Guard(m_sleepLock);
+    m_closed.store(true, std::memory_order_release);
+    m_sleepCondition.notify_all();
+}
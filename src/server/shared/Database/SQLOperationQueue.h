@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SQLOPERATIONQUEUE_H
+#define _SQLOPERATIONQUEUE_H
+
+#include "Common.h"
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+class SQLOperation;
+
+//- Lanes of the asynchronous operation queue, dequeued in this order
+enum SQLOperationPriority : uint8
+{
+    SQL_PRIORITY_HIGH,      //- Reads a client is waiting on that no queued save can change, e.g. the name lookups of the social list
+    SQL_PRIORITY_NORMAL,    //- Saves and regular asynchronous queries, character loads stay here to run after their saves
+    SQL_PRIORITY_LOW,       //- Writes nothing reads back in game: log tables, AppenderDB, uptime and statistics
+    MAX_SQL_PRIORITY
+};
+
+#define SQL_LATENCY_BUCKETS 16
+
+//- Lock-free log2 histogram of operation latencies, bucket 0 is < 64 us, bucket N is [2^(N+5), 2^(N+6)) us
+class SQLLatencyHistogram
+{
+    public:
+        SQLLatencyHistogram();
+
+        void Add(uint64 microseconds);
+
+        uint64 GetCount() const { return m_count.load(std::memory_order_relaxed); }
+        uint64 GetMax() const { return m_max.load(std::memory_order_relaxed); }
+        uint64 GetAverage() const;
+
+        //- Upper bound (in us) of the bucket holding the given percentile (0-100)
+        uint64 GetPercentile(uint32 percentile) const;
+
+    private:
+        std::atomic<uint64> m_buckets[SQL_LATENCY_BUCKETS];
+        std::atomic<uint64> m_count;
+        std::atomic<uint64> m_total;
+        std::atomic<uint64> m_max;
+};
+
+struct SQLQueueLaneStats
+{
+    SQLLatencyHistogram Wait;       //- Time spent in the queue
+    SQLLatencyHistogram Execution;  //- Time spent executing on the connection
+};
+
+//- Multi-producer multi-consumer queue of SQLOperation shared by the asynchronous connections of a pool.
+//- Each priority lane is a bounded lock-free ring buffer (D. Vyukov's algorithm), only an idle worker or an
+//- overflowing lane ever touches a mutex.
+class SQLOperationQueue
+{
+    public:
+        explicit SQLOperationQueue(uint32 laneCapacity = 64 * 1024);
+        ~SQLOperationQueue();
+
+        void Enqueue(SQLOperation* op, SQLOperationPriority priority);
+
+        //- Blocks until an operation is available, returns NULL once the queue is closed and drained
+        SQLOperation* Dequeue();
+
+        //- Wakes all workers, pending operations are still handed out before Dequeue returns NULL
+        void Close();
+
+        SQLQueueLaneStats& GetStats(SQLOperationPriority priority) { return m_stats[priority]; }
+
+    private:
+        struct Cell
+        {
+            std::atomic<size_t> Sequence;
+            SQLOperation*       Operation;
+        };
+
+        struct Lane
+        {
+            Cell*                     Buffer;
+            size_t                    Mask;
+            std::atomic<size_t>       EnqueuePos;
+            std::atomic<size_t>       DequeuePos;
+
+            std::mutex                OverflowLock;
+            std::deque<SQLOperation*> Overflow;
+            std::atomic<uint32>       OverflowSize;
+        };
+
+        bool TryPush(Lane& lane, SQLOperation* op);
+        bool TryPop(Lane& lane, SQLOperation*& op);
+        SQLOperation* TryDequeue();
+
+        Lane                    m_lanes[MAX_SQL_PRIORITY];
+        SQLQueueLaneStats       m_stats[MAX_SQL_PRIORITY];
+
+        std::atomic<uint32>     m_dequeueCount;
+        std::atomic<uint32>     m_sleepers;
+        std::atomic<bool>       m_closed;
+        std::mutex              m_sleepLock;
+        std::condition_variable m_sleepCondition;
+};
+
+#endif
@@ -79,8 +79,19 @@ bool TransactionTask::Execute()
     }
 
     if (m_Callback != nullptr)
+    {
         m_Callback->m_State = l_ExecuteResult ? MS::Utilities::CallBackState::Success : MS::Utilities::CallBackState::Fail;
 
+        if (m_CallbackQueue != nullptr)
+        {
+            MS::Utilities::CallBackPtr l_Callback = m_Callback;
+            m_CallbackQueue->Post([l_Callback, l_ExecuteResult]() -> void
+            {
+                l_Callback->m_CallBack(l_ExecuteResult);
+            });
+        }
+    }
+
     // Clean up now.
     m_trans->Cleanup();
 
@@ -10,6 +10,7 @@
 #define _TRANSACTION_H
 
 #include "SQLOperation.h"
+#include "SQLCallbackQueue.h"
 #include "MSCallback.hpp"
 
 //- Forward declare (don't include header to prevent circular includes)
@@ -23,7 +24,7 @@ class Transaction
     friend class DatabaseWokerPool;
 
     public:
-        Transaction() : _cleanedUp(false) {}
+        Transaction() : _cleanedUp(false), _merging(true) {}
         ~Transaction() { Cleanup(); }
 
         void Append(PreparedStatement* statement);
@@ -32,12 +33,16 @@ class Transaction
 
         size_t GetSize() const { return m_queries.size(); }
 
+        //- Consecutive INSERT/REPLACE statements are merged in multi-row queries unless disabled here
+        void SetMerging(bool merging) { _merging = merging; }
+
     //protected:
         void Cleanup();
         std::list<SQLElementData> m_queries;
 
     private:
         bool _cleanedUp;
+        bool _merging;
 
 };
 typedef std::shared_ptr<Transaction> SQLTransaction;
@@ -49,7 +54,8 @@ class TransactionTask : public SQLOperation
     friend class DatabaseWorker;
 
     public:
-        TransactionTask(SQLTransaction trans, MS::Utilities::CallBackPtr p_Callback) : m_trans(trans), m_Callback(p_Callback) {};
+        TransactionTask(SQLTransaction trans, MS::Utilities::CallBackPtr p_Callback, SQLCallbackQueuePtr p_CallbackQueue = nullptr)
+            : m_trans(trans), m_Callback(p_Callback), m_CallbackQueue(p_CallbackQueue) {};
         ~TransactionTask(){};
 
     protected:
@@ -57,6 +63,7 @@ class TransactionTask : public SQLOperation
 
         SQLTransaction                m_trans;
         MS::Utilities::CallBackPtr    m_Callback;
+        SQLCallbackQueuePtr           m_CallbackQueue;    ///< If set, m_Callback is posted there instead of having its state polled
 };
 
 #endif
@@ -208,6 +208,10 @@ char const* Appender::getLogFilterTypeString(LogFilterType type)
             return "SERVER LOADING";
         case LOG_FILTER_OPCODES:
             return "OPCODE";
+        case LOG_FILTER_INTERREALM:
+            return "INTERREALM";
+        case LOG_FILTER_PROFILING:
+            return "PROFILING";
         default:
             break;
     }
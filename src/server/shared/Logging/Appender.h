@@ -60,8 +60,8 @@ enum LogFilterType
     LOG_FILTER_PROFILING
 };
 
-const uint8 MaxLogFilter = uint8(LOG_FILTER_OPCODES) + 1;
-#define MAX_LOG_FILTER (LOG_FILTER_OPCODES + 1)
+const uint8 MaxLogFilter = uint8(LOG_FILTER_PROFILING) + 1;
+#define MAX_LOG_FILTER (LOG_FILTER_PROFILING + 1)
 
 // Values assigned have their equivalent in enum ACE_Log_Priority
 enum LogLevel
@@ -92,7 +92,8 @@ enum AppenderFlags
     APPENDER_FLAGS_PREFIX_LOGLEVEL      = 0x02,
     APPENDER_FLAGS_PREFIX_LOGFILTERTYPE = 0x04,
     APPENDER_FLAGS_USE_TIMESTAMP        = 0x08, // only used by FileAppender
-    APPENDER_FLAGS_MAKE_FILE_BACKUP     = 0x10  // only used by FileAppender
+    APPENDER_FLAGS_MAKE_FILE_BACKUP     = 0x10, // only used by FileAppender
+    APPENDER_FLAGS_STRUCTURED           = 0x20  // only used by FileAppender, one JSON object per line
 };
 
 struct LogMessage
@@ -132,6 +133,10 @@ class Appender
 
         void setLogLevel(LogLevel);
         void write(LogMessage& message);
+
+        /// Called by the log worker after each batch of messages
+        virtual void flush() { }
+
         static const char* getLogLevelString(LogLevel level);
         static const char* getLogFilterTypeString(LogFilterType type);
 
@@ -10,7 +10,7 @@
 #include "Database/DatabaseEnv.h"
 
 AppenderDB::AppenderDB(uint8 id, std::string const& name, LogLevel level, uint8 realmId):
-Appender(id, name, APPENDER_DB, level), realm(realmId), enable(false)
+Appender(id, name, APPENDER_DB, level), realm(realmId), enable(false), rowCount(0)
 {
 }
 
@@ -29,17 +29,36 @@ void AppenderDB::_write(LogMessage& message)
         case LOG_FILTER_SQL_DEV:
             break; // Avoid infinite loop, PExecute triggers Logging with LOG_FILTER_SQL type
         default:
-            PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_INS_LOG);
-            stmt->setUInt64(0, message.mtime);
-            stmt->setUInt32(1, realm);
-            stmt->setUInt8(2, message.type);
-            stmt->setUInt8(3, message.level);
-            stmt->setString(4, message.text);
-            LoginDatabase.Execute(stmt);
+        {
+            std::string text = message.text;
+            LoginDatabase.EscapeString(text);
+
+            char row[64];
+            snprintf(row, sizeof(row), "%s(" UI64FMTD ", %u, %u, %u, '", rowCount ? ", " : "", uint64(message.mtime), uint32(realm), uint32(message.type), uint32(message.level));
+            rows.append(row);
+            rows.append(text);
+            rows.append("')");
+
+            if (++rowCount >= APPENDER_DB_MAX_ROWS)
+                flush();
             break;
+        }
     }
 }
 
+void AppenderDB::flush()
+{
+    if (!rowCount)
+        return;
+
+    std::string query = "INSERT INTO logs (time, realm, type, level, string) VALUES ";
+    query.append(rows);
+    LoginDatabase.Execute(query.c_str(), SQL_PRIORITY_LOW);
+
+    rows.clear();
+    rowCount = 0;
+}
+
 void AppenderDB::setEnable(bool _enable)
 {
     enable = _enable;
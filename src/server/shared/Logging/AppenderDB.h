@@ -11,6 +11,8 @@
 
 #include "Appender.h"
 
+#define APPENDER_DB_MAX_ROWS 100                ///< Rows sent in a single statement
+
 class AppenderDB: public Appender
 {
     public:
@@ -18,9 +20,14 @@ class AppenderDB: public Appender
         ~AppenderDB();
         void setEnable(bool enable);
 
+        /// Sends the buffered rows as a single multi-row insert
+        void flush();
+
     private:
         uint8 realm;
         bool enable;
+        std::string rows;                       ///< VALUES part of the pending insert
+        uint32 rowCount;
         void _write(LogMessage& message);
 };
 
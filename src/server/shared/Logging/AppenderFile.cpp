@@ -9,11 +9,14 @@
 #include "AppenderFile.h"
 #include "Common.h"
 
-AppenderFile::AppenderFile(uint8 id, std::string const& name, LogLevel level, const char* _filename, const char* _logDir, const char* _mode, AppenderFlags _flags)
+AppenderFile::AppenderFile(uint8 id, std::string const& name, LogLevel level, const char* _filename, const char* _logDir, const char* _mode, AppenderFlags _flags, uint64 _maxFileSize)
     : Appender(id, name, APPENDER_FILE, level, _flags)
     , filename(_filename)
     , logDir(_logDir)
     , mode(_mode)
+    , maxFileSize(_maxFileSize)
+    , fileSize(0)
+    , buffer(NULL)
 {
     dynamicName = std::string::npos != filename.find("%s");
     backup = _flags & APPENDER_FLAGS_MAKE_FILE_BACKUP;
@@ -28,6 +31,8 @@ AppenderFile::~AppenderFile()
         fclose(logfile);
         logfile = NULL;
     }
+
+    delete[] buffer;
 }
 
 void AppenderFile::_write(LogMessage& message)
@@ -36,20 +41,95 @@ void AppenderFile::_write(LogMessage& message)
     {
         char namebuf[TRINITY_PATH_MAX];
         snprintf(namebuf, TRINITY_PATH_MAX, filename.c_str(), message.param1.c_str());
-        logfile = OpenFile(namebuf, mode, backup);
+
+        /// Rarely used files (char dumps, gm logs...), opened and closed on each message
+        if (FILE* file = fopen((logDir + namebuf).c_str(), mode.c_str()))
+        {
+            if (getFlags() & APPENDER_FLAGS_STRUCTURED)
+                WriteStructured(file, message);
+            else
+                fprintf(file, "%s%s", message.prefix.c_str(), message.text.c_str());
+
+            fclose(file);
+        }
+
+        return;
     }
 
-    if (logfile)
-    {
-        fprintf(logfile, "%s%s", message.prefix.c_str(), message.text.c_str());
-        fflush(logfile);
+    if (!logfile)
+        return;
 
-        if (dynamicName)
+    if (getFlags() & APPENDER_FLAGS_STRUCTURED)
+        WriteStructured(logfile, message);
+    else
+        fileSize += fprintf(logfile, "%s%s", message.prefix.c_str(), message.text.c_str());
+
+    if (maxFileSize && fileSize >= maxFileSize)
+        Rotate();
+}
+
+void AppenderFile::WriteStructured(FILE* file, LogMessage const& message)
+{
+    std::string line;
+    line.reserve(message.text.size() + 96);
+
+    char header[96];
+    snprintf(header, sizeof(header), "{\"time\":" UI64FMTD ",\"level\":\"%s\",\"filter\":\"%s\",\"text\":\"", uint64(message.mtime),
+        Appender::getLogLevelString(message.level), Appender::getLogFilterTypeString(message.type));
+    line.append(header);
+
+    std::string::const_iterator end = message.text.end();
+    if (!message.text.empty() && message.text[message.text.size() - 1] == '\n')
+        --end;
+
+    for (std::string::const_iterator itr = message.text.begin(); itr != end; ++itr)
+    {
+        unsigned char c = *itr;
+        switch (c)
         {
-            fclose(logfile);
-            logfile = NULL;
+            case '"':  line.append("\\\""); break;
+            case '\\': line.append("\\\\"); break;
+            case '\n': line.append("\\n");  break;
+            case '\r': line.append("\\r");  break;
+            case '\t': line.append("\\t");  break;
+            default:
+                if (c < 0x20)
+                {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    line.append(escaped);
+                }
+                else
+                    line.push_back(c);
+                break;
         }
     }
+
+    line.append("\"}\n");
+    fileSize += fwrite(line.c_str(), 1, line.size(), file);
+}
+
+void AppenderFile::flush()
+{
+    if (logfile)
+        fflush(logfile);
+}
+
+void AppenderFile::Rotate()
+{
+    fclose(logfile);
+
+    std::string path = logDir + filename;
+    std::string newPath(path);
+    newPath.push_back('.');
+    newPath.append(LogMessage::getTimeStr(time(NULL)));
+    rename(path.c_str(), newPath.c_str()); // no error handling... the file is reopened in any case
+
+    logfile = fopen(path.c_str(), "w");
+    fileSize = 0;
+
+    if (logfile)
+        setvbuf(logfile, buffer, _IOFBF, APPENDER_FILE_BUFFER_SIZE);
 }
 
 FILE* AppenderFile::OpenFile(std::string const &filename, std::string const &mode, bool backup)
@@ -61,5 +141,19 @@ FILE* AppenderFile::OpenFile(std::string const &filename, std::string const &mod
         newName.append(LogMessage::getTimeStr(time(NULL)));
         rename(filename.c_str(), newName.c_str()); // no error handling... if we couldn't make a backup, just ignore
     }
-    return fopen((logDir + filename).c_str(), mode.c_str());
+
+    FILE* file = fopen((logDir + filename).c_str(), mode.c_str());
+    if (!file)
+        return NULL;
+
+    /// Only flushed once per log worker batch
+    if (!buffer)
+        buffer = new char[APPENDER_FILE_BUFFER_SIZE];
+    setvbuf(file, buffer, _IOFBF, APPENDER_FILE_BUFFER_SIZE);
+
+    fseek(file, 0, SEEK_END);
+    long position = ftell(file);
+    fileSize = position > 0 ? uint64(position) : 0;
+
+    return file;
 }
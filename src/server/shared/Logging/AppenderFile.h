@@ -11,21 +11,32 @@
 
 #include "Appender.h"
 
+#define APPENDER_FILE_BUFFER_SIZE (64 * 1024)
+
 class AppenderFile: public Appender
 {
     public:
-        AppenderFile(uint8 _id, std::string const& _name, LogLevel level, const char* filename, const char* logDir, const char* mode, AppenderFlags flags);
+        AppenderFile(uint8 _id, std::string const& _name, LogLevel level, const char* filename, const char* logDir, const char* mode, AppenderFlags flags, uint64 maxFileSize = 0);
         ~AppenderFile();
         FILE* OpenFile(std::string const& _name, std::string const& _mode, bool _backup);
 
+        /// Lines are buffered, written once per log worker batch
+        void flush();
+
     private:
         void _write(LogMessage& message);
+        void WriteStructured(FILE* file, LogMessage const& message);
+        void Rotate();
+
         FILE* logfile;
         std::string filename;
         std::string logDir;
         std::string mode;
         bool dynamicName;
         bool backup;
+        uint64 maxFileSize;                     ///< 0 disables the rotation
+        uint64 fileSize;
+        char* buffer;                           ///< stdio buffer of logfile
 };
 
 #endif
@@ -15,14 +15,34 @@
 #include "AppenderDB.h"
 #include "LogOperation.h"
 
+#include <ace/TSS_T.h>
+
 #include <cstdarg>
 #include <cstdio>
 #include <future>
+#include <thread>
+
+/// Logging state of a thread, deleted when the thread exits
+struct LogThreadBuffer
+{
+    LogThreadBuffer() : Ring(nullptr) { }
+
+    ~LogThreadBuffer()
+    {
+        if (Ring)
+            Ring->Close();
+    }
+
+    LogRingBuffer* Ring;
+    char           Scratch[LOG_RECORD_MAX_SIZE];   ///< Record being captured
+};
+
+static ACE_TSS<LogThreadBuffer> s_ThreadBuffers;
 
 Log::Log() : worker(NULL)
 {
-    memset(m_LogLevelTypeByFilterCache, LOG_LEVEL_DISABLED, MAX_LOG_FILTER);
-    memset(m_LogTypePresentCache, 0, MAX_LOG_FILTER);
+    memset(m_LoggerByFilter, 0, sizeof(m_LoggerByFilter));
+    memset(m_MinLevelByFilter, LOG_LEVEL_FATAL + 1, sizeof(m_MinLevelByFilter));
 
     SetRealmID(0);
     m_logsTimestamp = "_" + GetTimestampStr();
@@ -71,8 +91,8 @@ void Log::CreateAppenderFromConfig(const char* name)
     if (!name || *name == '\0')
         return;
 
-    // Format=type,level,flags,optional1,optional2
-    // if type = File. optional1 = file and option2 = mode
+    // Format=type,level,flags,optional1,optional2,optional3
+    // if type = File. optional1 = file, option2 = mode and optional3 = max file size
     // if type = Console. optional1 = Color
     std::string options = "Appender.";
     options.append(name);
@@ -114,6 +134,7 @@ void Log::CreateAppenderFromConfig(const char* name)
         {
             std::string filename;
             std::string mode = "a";
+            uint64 maxFileSize = 0;
 
             if (++iter == tokens.end())
             {
@@ -124,8 +145,13 @@ void Log::CreateAppenderFromConfig(const char* name)
             filename = *iter;
 
             if (++iter != tokens.end())
+            {
                 mode = *iter;
 
+                if (++iter != tokens.end())
+                    maxFileSize = strtoull(*iter, NULL, 10);
+            }
+
             if (flags & APPENDER_FLAGS_USE_TIMESTAMP)
             {
                 size_t dot_pos = filename.find_last_of(".");
@@ -136,7 +162,7 @@ void Log::CreateAppenderFromConfig(const char* name)
             }
 
             uint8 id = NextAppenderId();
-            appenders[id] = new AppenderFile(id, name, level, filename.c_str(), m_logsDir.c_str(), mode.c_str(), flags);
+            appenders[id] = new AppenderFile(id, name, level, filename.c_str(), m_logsDir.c_str(), mode.c_str(), flags, maxFileSize);
             //fprintf(stdout, "Log::CreateAppenderFromConfig: Created Appender %s (%u), Type FILE, Mask %u, File %s, Mode %s\n", name, id, level, filename.c_str(), mode.c_str()); // DEBUG - RemoveMe
             break;
         }
@@ -180,7 +206,7 @@ void Log::CreateLoggerFromConfig(const char* name)
     }
 
     type = atoi(*iter);
-    if (type > MaxLogFilter)
+    if (type >= MaxLogFilter)
     {
         fprintf(stderr, "Log::CreateLoggerFromConfig: Wrong type %u for logger %s\n", type, name);
         return;
@@ -201,12 +227,6 @@ void Log::CreateLoggerFromConfig(const char* name)
         return;
     }
 
-    m_LogLevelTypeByFilterCache[type] = level;
-    m_LogTypePresentCache[type] = 1;
-
-    if (level < lowestLogLevel)
-        lowestLogLevel = level;
-
     logger.Create(name, LogFilterType(type), level);
     //fprintf(stdout, "Log::CreateLoggerFromConfig: Created Logger %s, Type %u, mask %u\n", name, LogFilterType(type), level); // DEBUG - RemoveMe
 
@@ -263,6 +283,29 @@ void Log::ReadLoggersFromConfig()
     // root logger must exist. Marking as disabled as its not configured
     if (it == loggers.end())
         loggers[0].Create("root", LOG_FILTER_GENERAL, LOG_LEVEL_DISABLED);
+
+    UpdateFilterCache();
+}
+
+void Log::UpdateFilterCache()
+{
+    for (uint8 l_Filter = 0; l_Filter < MAX_LOG_FILTER; ++l_Filter)
+    {
+        LoggerMap::iterator l_Itr = loggers.find(l_Filter);
+        if (l_Itr == loggers.end() || l_Itr->second.getName().empty())
+            l_Itr = loggers.find(LOG_FILTER_GENERAL);
+
+        if (l_Itr == loggers.end())
+        {
+            m_LoggerByFilter[l_Filter]   = NULL;
+            m_MinLevelByFilter[l_Filter] = LOG_LEVEL_FATAL + 1;
+            continue;
+        }
+
+        LogLevel l_Level = l_Itr->second.getLogLevel();
+        m_LoggerByFilter[l_Filter]   = &l_Itr->second;
+        m_MinLevelByFilter[l_Filter] = l_Level == LOG_LEVEL_DISABLED ? LOG_LEVEL_FATAL + 1 : l_Level;
+    }
 }
 
 void Log::EnableDBAppenders()
@@ -274,9 +317,104 @@ void Log::EnableDBAppenders()
 
 void Log::vlog(LogFilterType filter, LogLevel level, char const* str, va_list argptr)
 {
-    char text[MAX_QUERY_LEN];
-    vsnprintf(text, MAX_QUERY_LEN, str, argptr);
-    write(new LogMessage(level, filter, text));
+    LogWorker* l_Worker = worker;
+    if (!l_Worker)
+        return;
+
+    LogThreadBuffer* l_Buffer = s_ThreadBuffers;
+    if (!l_Buffer->Ring)
+    {
+        l_Buffer->Ring = new LogRingBuffer();
+
+        std::lock_guard<std::mutex> l_Guard(m_ThreadBuffersLock);
+        m_ThreadBuffers.push_back(l_Buffer->Ring);
+    }
+
+    /// Arguments are only copied, the worker formats them
+    va_list l_Args;
+    va_copy(l_Args, argptr);
+
+    uint32 l_Size = LogFormat::Capture(l_Buffer->Scratch, level, filter, str, argptr);
+    if (!l_Size)
+    {
+        char l_Text[MAX_QUERY_LEN];
+        vsnprintf(l_Text, MAX_QUERY_LEN, str, l_Args);
+        l_Size = LogFormat::CaptureText(l_Buffer->Scratch, level, filter, l_Text);
+    }
+
+    va_end(l_Args);
+
+    char* l_Record;
+    while (!(l_Record = l_Buffer->Ring->Reserve(l_Size)))
+    {
+        /// The worker can't wait for itself (appenders logging while writing)
+        if (l_Worker->IsWorkerThread())
+            return;
+
+        l_Worker->Wake();
+        std::this_thread::yield();
+    }
+
+    memcpy(l_Record, l_Buffer->Scratch, l_Size);
+    l_Buffer->Ring->Commit(l_Size);
+    l_Worker->Wake();
+}
+
+uint32 Log::ProcessThreadBuffers()
+{
+    {
+        std::lock_guard<std::mutex> l_Guard(m_ThreadBuffersLock);
+        m_DrainedBuffers = m_ThreadBuffers;
+    }
+
+    uint32 l_Count = 0;
+    for (LogRingBuffer* l_Ring : m_DrainedBuffers)
+    {
+        /// Read before draining, nothing is written once closed
+        bool l_Closed = l_Ring->IsClosed();
+
+        l_Count += l_Ring->Drain([this](LogRecordHeader const& p_Record) -> void
+        {
+            WriteRecord(p_Record);
+        });
+
+        if (l_Closed)
+        {
+            {
+                std::lock_guard<std::mutex> l_Guard(m_ThreadBuffersLock);
+                m_ThreadBuffers.erase(std::find(m_ThreadBuffers.begin(), m_ThreadBuffers.end(), l_Ring));
+            }
+
+            delete l_Ring;
+        }
+    }
+
+    return l_Count;
+}
+
+void Log::WriteRecord(LogRecordHeader const& p_Record)
+{
+    Logger* l_Logger = GetLoggerByType(LogFilterType(p_Record.Filter));
+    if (!l_Logger)
+        return;
+
+    char l_Text[MAX_QUERY_LEN];
+    LogFormat::Format(p_Record, l_Text, MAX_QUERY_LEN);
+
+    LogMessage l_Message(LogLevel(p_Record.Level), LogFilterType(p_Record.Filter), l_Text);
+    l_Message.mtime = time_t(p_Record.Time);
+    l_Message.text.append("\n");
+
+    l_Logger->write(l_Message);
+}
+
+void Log::FlushAppenders()
+{
+    for (AppenderMap::iterator l_Itr = appenders.begin(); l_Itr != appenders.end(); ++l_Itr)
+    {
+        if (l_Itr->second)
+            l_Itr->second->flush();
+    }
 }
 
 void Log::write(LogMessage* msg)
@@ -322,7 +460,7 @@ bool Log::SetLogLevel(std::string const& name, const char* newLevelc, bool isLog
             return false;
 
         it->second.setLogLevel(newLevel);
-        m_LogLevelTypeByFilterCache[it->second.getType()] = newLevel;
+        UpdateFilterCache();
     }
     else
     {
@@ -371,8 +509,12 @@ void Log::SetRealmID(uint32 id)
 
 void Log::Close()
 {
+    /// The worker writes everything still queued before stopping
     delete worker;
     worker = NULL;
+
+    memset(m_LoggerByFilter, 0, sizeof(m_LoggerByFilter));
+    memset(m_MinLevelByFilter, LOG_LEVEL_FATAL + 1, sizeof(m_MinLevelByFilter));
     loggers.clear();
     for (AppenderMap::iterator it = appenders.begin(); it != appenders.end(); ++it)
     {
@@ -386,9 +528,7 @@ void Log::LoadFromConfig()
 {
     Close();
 
-    lowestLogLevel = LOG_LEVEL_FATAL;
     AppenderId = 0;
-    worker = new LogWorker();
     m_logsDir = ConfigMgr::GetStringDefault("LogsDir", "");
     if (!m_logsDir.empty())
         if ((m_logsDir.at(m_logsDir.length() - 1) != '/') && (m_logsDir.at(m_logsDir.length() - 1) != '\\'))
@@ -396,6 +536,9 @@ void Log::LoadFromConfig()
     ReadAppendersFromConfig();
     ReadLoggersFromConfig();
 
+    /// Reads the loggers and appenders, started once they are configured
+    worker = new LogWorker(this);
+
     /// Init slack
     m_SlackEnable  = ConfigMgr::GetBoolDefault("Slack.Enable", false);
     m_SlackApiUrl  = ConfigMgr::GetStringDefault("Slack.ApiUrl", "");
@@ -15,9 +15,11 @@
 #include "LogWorker.h"
 #include "Logger.h"
 #include "LogOperation.h"
+#include "LogRingBuffer.h"
 
 #include <cstdarg>
 #include <cstdio>
+#include <mutex>
 
 class Log
 {
@@ -29,6 +31,8 @@ class Log
         Log();
         ~Log();
 
+    friend class LogWorker;
+
     public:
         void LoadFromConfig();
         void Close();
@@ -150,6 +154,14 @@ class Log
         void vlog(LogFilterType f, LogLevel level, char const* str, va_list argptr);
         void write(LogMessage* msg);
 
+        /// Log worker side, returns the number of messages written
+        uint32 ProcessThreadBuffers();
+        void WriteRecord(LogRecordHeader const& p_Record);
+        void FlushAppenders();
+
+        /// Resolves the logger and the lowest level of every filter, called when loggers change
+        void UpdateFilterCache();
+
         inline Logger* GetLoggerByType(LogFilterType filter);
         Appender* GetAppenderByName(std::string const& name);
         uint8 NextAppenderId();
@@ -161,7 +173,6 @@ class Log
         AppenderMap appenders;
         LoggerMap loggers;
         uint8 AppenderId;
-        LogLevel lowestLogLevel;
 
         std::string m_logsDir;
         std::string m_logsTimestamp;
@@ -176,8 +187,14 @@ class Log
         std::string m_SlackApiUrl;
         std::string m_SlackAppName;
 
-        uint8 m_LogLevelTypeByFilterCache[MAX_LOG_FILTER];
-        uint8 m_LogTypePresentCache[MAX_LOG_FILTER];
+        /// Flat filter lookups, the filter own logger or the root logger
+        Logger* m_LoggerByFilter[MAX_LOG_FILTER];
+        uint8   m_MinLevelByFilter[MAX_LOG_FILTER];         ///< LOG_LEVEL_FATAL + 1 if nothing is logged
+
+        /// Ring buffers of every thread having logged something, drained by the worker
+        std::mutex                  m_ThreadBuffersLock;
+        std::vector<LogRingBuffer*> m_ThreadBuffers;
+        std::vector<LogRingBuffer*> m_DrainedBuffers;       ///< Worker copy of m_ThreadBuffers
 };
 
 #define sLog ACE_Singleton<Log, ACE_Thread_Mutex>::instance()
@@ -185,25 +202,12 @@ class Log
 // Returns default logger if the requested logger is not found
 inline Logger* Log::GetLoggerByType(LogFilterType filter)
 {
-    return m_LogTypePresentCache[filter] ? &loggers[filter] : &(loggers[0]);
+    return filter < MAX_LOG_FILTER ? m_LoggerByFilter[filter] : m_LoggerByFilter[LOG_FILTER_GENERAL];
 }
 
 inline bool Log::ShouldLog(LogFilterType type, LogLevel level)
 {
-    // Don't even look for a logger if the LogLevel is lower than lowest log levels across all loggers
-    if (level < lowestLogLevel)
-        return false;
-
-    if (m_LogTypePresentCache[type])
-    {
-        LogLevel loggerLevel = (LogLevel)m_LogLevelTypeByFilterCache[type];
-        return  loggerLevel != LOG_LEVEL_DISABLED && loggerLevel <= level;
-    }
-
-    if (type != LOG_FILTER_GENERAL)
-        return ShouldLog(LOG_FILTER_GENERAL, level);
-
-    return false;
+    return type < MAX_LOG_FILTER && uint8(level) >= m_MinLevelByFilter[type];
 }
 
 #endif
@@ -0,0 +1,398 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "LogRingBuffer.h"
+#include "Common.h"
+
+#include <cstdio>
+#include <cstring>
+
+#define LOG_SPEC_MAX 32
+
+LogRingBuffer::LogRingBuffer() : m_Buffer(new char[LOG_RING_BUFFER_SIZE]), m_Head(0), m_Tail(0), m_Closed(false)
+{
+}
+
+LogRingBuffer::~LogRingBuffer()
+{
+    delete[] m_Buffer;
+}
+
+char* LogRingBuffer::Reserve(uint32 p_Size)
+{
+    uint64 l_Head   = m_Head.load(std::memory_order_relaxed);
+    uint32 l_Offset = uint32(l_Head & (LOG_RING_BUFFER_SIZE - 1));
+
+    /// Records never wrap, the end of the buffer is skipped if the record doesn't fit in it
+    uint32 l_Skip = l_Offset + p_Size > LOG_RING_BUFFER_SIZE ? LOG_RING_BUFFER_SIZE - l_Offset : 0;
+
+    if (l_Head + l_Skip + p_Size - m_Tail.load(std::memory_order_acquire) > LOG_RING_BUFFER_SIZE)
+        return nullptr;
+
+    if (l_Skip)
+    {
+        reinterpret_cast<LogRecordHeader*>(m_Buffer + l_Offset)->Size = 0;
+        l_Head += l_Skip;
+        m_Head.store(l_Head, std::memory_order_release);
+    }
+
+    return m_Buffer + (l_Head & (LOG_RING_BUFFER_SIZE - 1));
+}
+
+void LogRingBuffer::Commit(uint32 p_Size)
+{
+    m_Head.store(m_Head.load(std::memory_order_relaxed) + p_Size, std::memory_order_release);
+}
+
+namespace LogFormat
+{
+    /// Type of the value read from the va_list for a conversion
+    enum LogArgKind
+    {
+        LOG_ARG_NONE,                                   ///< %%
+        LOG_ARG_INT,
+        LOG_ARG_LONG,
+        LOG_ARG_LONG_LONG,
+        LOG_ARG_INTMAX,
+        LOG_ARG_SIZE,
+        LOG_ARG_PTRDIFF,
+        LOG_ARG_DOUBLE,
+        LOG_ARG_STRING,
+        LOG_ARG_POINTER,
+        LOG_ARG_INVALID
+    };
+
+    enum LogArgLength
+    {
+        LOG_LENGTH_NONE,
+        LOG_LENGTH_LONG,
+        LOG_LENGTH_LONG_LONG,
+        LOG_LENGTH_INTMAX,
+        LOG_LENGTH_SIZE,
+        LOG_LENGTH_PTRDIFF,
+        LOG_LENGTH_LONG_DOUBLE
+    };
+
+    /// Parses the conversion starting at p_Format, right after its '%'
+    /// @p_Format : Moved after the conversion
+    /// @p_Spec   : Output, the whole conversion ("%-8.3lu") for snprintf
+    static LogArgKind ParseSpec(char const*& p_Format, char* p_Spec)
+    {
+        char const* l_Start = p_Format - 1;
+        char const* l_Itr   = p_Format;
+
+        if (*l_Itr == '%')
+        {
+            p_Format = l_Itr + 1;
+            return LOG_ARG_NONE;
+        }
+
+        while (*l_Itr && strchr("-+ #0'", *l_Itr))
+            ++l_Itr;
+
+        while (*l_Itr >= '0' && *l_Itr <= '9')
+            ++l_Itr;
+
+        if (*l_Itr == '$' || *l_Itr == '*')
+            return LOG_ARG_INVALID;
+
+        if (*l_Itr == '.')
+        {
+            ++l_Itr;
+            if (*l_Itr == '*')
+                return LOG_ARG_INVALID;
+
+            while (*l_Itr >= '0' && *l_Itr <= '9')
+                ++l_Itr;
+        }
+
+        LogArgLength l_Length = LOG_LENGTH_NONE;
+        switch (*l_Itr)
+        {
+            case 'h':
+                l_Itr += l_Itr[1] == 'h' ? 2 : 1;
+                break;
+            case 'l':
+                l_Length = l_Itr[1] == 'l' ? LOG_LENGTH_LONG_LONG : LOG_LENGTH_LONG;
+                l_Itr += l_Itr[1] == 'l' ? 2 : 1;
+                break;
+            case 'q':
+                l_Length = LOG_LENGTH_LONG_LONG;
+                ++l_Itr;
+                break;
+            case 'j':
+                l_Length = LOG_LENGTH_INTMAX;
+                ++l_Itr;
+                break;
+            case 'z':
+                l_Length = LOG_LENGTH_SIZE;
+                ++l_Itr;
+                break;
+            case 't':
+                l_Length = LOG_LENGTH_PTRDIFF;
+                ++l_Itr;
+                break;
+            case 'L':
+                l_Length = LOG_LENGTH_LONG_DOUBLE;
+                ++l_Itr;
+                break;
+            default:
+                break;
+        }
+
+        LogArgKind l_Kind = LOG_ARG_INVALID;
+        switch (*l_Itr)
+        {
+            case 'd':
+            case 'i':
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+                switch (l_Length)
+                {
+                    case LOG_LENGTH_NONE:      l_Kind = LOG_ARG_INT;       break;
+                    case LOG_LENGTH_LONG:      l_Kind = LOG_ARG_LONG;      break;
+                    case LOG_LENGTH_LONG_LONG: l_Kind = LOG_ARG_LONG_LONG; break;
+                    case LOG_LENGTH_INTMAX:    l_Kind = LOG_ARG_INTMAX;    break;
+                    case LOG_LENGTH_SIZE:      l_Kind = LOG_ARG_SIZE;      break;
+                    case LOG_LENGTH_PTRDIFF:   l_Kind = LOG_ARG_PTRDIFF;   break;
+                    default:                                               break;
+                }
+                break;
+            case 'c':
+                if (l_Length == LOG_LENGTH_NONE)
+                    l_Kind = LOG_ARG_INT;
+                break;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+                if (l_Length == LOG_LENGTH_NONE || l_Length == LOG_LENGTH_LONG)
+                    l_Kind = LOG_ARG_DOUBLE;
+                break;
+            case 's':
+                if (l_Length == LOG_LENGTH_NONE)
+                    l_Kind = LOG_ARG_STRING;
+                break;
+            case 'p':
+                l_Kind = LOG_ARG_POINTER;
+                break;
+            default:
+                break;
+        }
+
+        if (l_Kind == LOG_ARG_INVALID)
+            return LOG_ARG_INVALID;
+
+        ++l_Itr;
+
+        size_t l_SpecLength = l_Itr - l_Start;
+        if (l_SpecLength >= LOG_SPEC_MAX)
+            return LOG_ARG_INVALID;
+
+        memcpy(p_Spec, l_Start, l_SpecLength);
+        p_Spec[l_SpecLength] = '\0';
+        p_Format = l_Itr;
+        return l_Kind;
+    }
+
+    static void FillHeader(char* p_Buffer, uint32 p_Size, uint32 p_FormatSize, LogLevel p_Level, LogFilterType p_Filter, uint8 p_Flags)
+    {
+        LogRecordHeader* l_Header = reinterpret_cast<LogRecordHeader*>(p_Buffer);
+        l_Header->Size       = p_Size;
+        l_Header->FormatSize = p_FormatSize;
+        l_Header->Level      = uint8(p_Level);
+        l_Header->Filter     = uint8(p_Filter);
+        l_Header->Flags      = p_Flags;
+        l_Header->Padding    = 0;
+        l_Header->Time       = uint64(time(NULL));
+    }
+
+    uint32 Capture(char* p_Buffer, LogLevel p_Level, LogFilterType p_Filter, char const* p_Format, va_list p_Args)
+    {
+        uint32 l_Position   = sizeof(LogRecordHeader);
+        uint32 l_FormatSize = uint32(strlen(p_Format)) + 1;
+
+        if (l_Position + l_FormatSize > LOG_RECORD_MAX_SIZE)
+            return 0;
+
+        memcpy(p_Buffer + l_Position, p_Format, l_FormatSize);
+        l_Position += l_FormatSize;
+
+        char l_Spec[LOG_SPEC_MAX];
+        for (char const* l_Itr = p_Format; *l_Itr;)
+        {
+            if (*l_Itr++ != '%')
+                continue;
+
+            LogArgKind l_Kind = ParseSpec(l_Itr, l_Spec);
+            if (l_Kind == LOG_ARG_NONE)
+                continue;
+
+            if (l_Kind == LOG_ARG_INVALID)
+                return 0;
+
+            if (l_Kind == LOG_ARG_STRING)
+            {
+                char const* l_String = va_arg(p_Args, char const*);
+                if (!l_String)
+                    l_String = "(null)";
+
+                uint32 l_Length = uint32(strlen(l_String));
+                if (l_Position + 1 + sizeof(uint32) + l_Length + 1 > LOG_RECORD_MAX_SIZE)
+                    return 0;
+
+                p_Buffer[l_Position++] = char(l_Kind);
+                memcpy(p_Buffer + l_Position, &l_Length, sizeof(uint32));
+                l_Position += sizeof(uint32);
+                memcpy(p_Buffer + l_Position, l_String, l_Length + 1);
+                l_Position += l_Length + 1;
+                continue;
+            }
+
+            uint64 l_Value = 0;
+            switch (l_Kind)
+            {
+                case LOG_ARG_INT:       l_Value = uint64(int64(va_arg(p_Args, int)));        break;
+                case LOG_ARG_LONG:      l_Value = uint64(int64(va_arg(p_Args, long)));       break;
+                case LOG_ARG_LONG_LONG: l_Value = uint64(va_arg(p_Args, long long));         break;
+                case LOG_ARG_INTMAX:    l_Value = uint64(va_arg(p_Args, intmax_t));          break;
+                case LOG_ARG_SIZE:      l_Value = uint64(va_arg(p_Args, size_t));            break;
+                case LOG_ARG_PTRDIFF:   l_Value = uint64(int64(va_arg(p_Args, ptrdiff_t)));  break;
+                case LOG_ARG_POINTER:   l_Value = uint64(uintptr_t(va_arg(p_Args, void*)));  break;
+                case LOG_ARG_DOUBLE:
+                {
+                    double l_Double = va_arg(p_Args, double);
+                    memcpy(&l_Value, &l_Double, sizeof(double));
+                    break;
+                }
+                default:
+                    return 0;
+            }
+
+            if (l_Position + 1 + sizeof(uint64) > LOG_RECORD_MAX_SIZE)
+                return 0;
+
+            p_Buffer[l_Position++] = char(l_Kind);
+            memcpy(p_Buffer + l_Position, &l_Value, sizeof(uint64));
+            l_Position += sizeof(uint64);
+        }
+
+        l_Position = (l_Position + 7) & ~7;
+        FillHeader(p_Buffer, l_Position, l_FormatSize, p_Level, p_Filter, 0);
+        return l_Position;
+    }
+
+    uint32 CaptureText(char* p_Buffer, LogLevel p_Level, LogFilterType p_Filter, char const* p_Text)
+    {
+        uint32 l_Position = sizeof(LogRecordHeader);
+        uint32 l_Length   = std::min(uint32(strlen(p_Text)), uint32(LOG_RECORD_MAX_SIZE - l_Position - 8));
+
+        memcpy(p_Buffer + l_Position, p_Text, l_Length);
+        p_Buffer[l_Position + l_Length] = '\0';
+        l_Position += l_Length + 1;
+
+        l_Position = (l_Position + 7) & ~7;
+        FillHeader(p_Buffer, l_Position, l_Length + 1, p_Level, p_Filter, LOG_RECORD_PREFORMATTED);
+        return l_Position;
+    }
+
+    void Format(LogRecordHeader const& p_Record, char* p_Output, uint32 p_Size)
+    {
+        char const* l_Format = reinterpret_cast<char const*>(&p_Record + 1);
+        char const* l_Args   = l_Format + p_Record.FormatSize;
+
+        if (p_Record.Flags & LOG_RECORD_PREFORMATTED)
+        {
+            snprintf(p_Output, p_Size, "%s", l_Format);
+            return;
+        }
+
+        uint32 l_Used = 0;
+        auto l_Append = [&](char const* p_Text, uint32 p_Length) -> void
+        {
+            p_Length = std::min(p_Length, p_Size - 1 - l_Used);
+            memcpy(p_Output + l_Used, p_Text, p_Length);
+            l_Used += p_Length;
+        };
+
+        char l_Spec[LOG_SPEC_MAX];
+        for (char const* l_Itr = l_Format; *l_Itr && l_Used < p_Size - 1;)
+        {
+            char const* l_Literal = l_Itr;
+            while (*l_Itr && *l_Itr != '%')
+                ++l_Itr;
+
+            l_Append(l_Literal, uint32(l_Itr - l_Literal));
+            if (!*l_Itr)
+                break;
+
+            ++l_Itr;
+
+            /// Same format as the one accepted by Capture, every conversion is valid
+            LogArgKind l_Kind = ParseSpec(l_Itr, l_Spec);
+            if (l_Kind == LOG_ARG_NONE)
+            {
+                l_Append("%", 1);
+                continue;
+            }
+
+            ++l_Args;
+
+            uint64 l_Value = 0;
+            char const* l_String = nullptr;
+            if (l_Kind == LOG_ARG_STRING)
+            {
+                uint32 l_Length;
+                memcpy(&l_Length, l_Args, sizeof(uint32));
+                l_String = l_Args + sizeof(uint32);
+                l_Args  += sizeof(uint32) + l_Length + 1;
+            }
+            else
+            {
+                memcpy(&l_Value, l_Args, sizeof(uint64));
+                l_Args += sizeof(uint64);
+            }
+
+            char* l_Target = p_Output + l_Used;
+            size_t l_Left  = p_Size - l_Used;
+            int l_Written  = 0;
+
+            switch (l_Kind)
+            {
+                case LOG_ARG_INT:       l_Written = snprintf(l_Target, l_Left, l_Spec, int(l_Value));               break;
+                case LOG_ARG_LONG:      l_Written = snprintf(l_Target, l_Left, l_Spec, long(l_Value));              break;
+                case LOG_ARG_LONG_LONG: l_Written = snprintf(l_Target, l_Left, l_Spec, (long long)l_Value);         break;
+                case LOG_ARG_INTMAX:    l_Written = snprintf(l_Target, l_Left, l_Spec, intmax_t(l_Value));          break;
+                case LOG_ARG_SIZE:      l_Written = snprintf(l_Target, l_Left, l_Spec, size_t(l_Value));            break;
+                case LOG_ARG_PTRDIFF:   l_Written = snprintf(l_Target, l_Left, l_Spec, ptrdiff_t(l_Value));         break;
+                case LOG_ARG_POINTER:   l_Written = snprintf(l_Target, l_Left, l_Spec, (void*)uintptr_t(l_Value));  break;
+                case LOG_ARG_STRING:    l_Written = snprintf(l_Target, l_Left, l_Spec, l_String);                   break;
+                case LOG_ARG_DOUBLE:
+                {
+                    double l_Double;
+                    memcpy(&l_Double, &l_Value, sizeof(double));
+                    l_Written = snprintf(l_Target, l_Left, l_Spec, l_Double);
+                    break;
+                }
+                default:
+                    break;
+            }
+
+            if (l_Written > 0)
+                l_Used += std::min(uint32(l_Written), uint32(l_Left - 1));
+        }
+
+        p_Output[l_Used] = '\0';
+    }
+}
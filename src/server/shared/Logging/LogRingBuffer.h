@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LOGRINGBUFFER_H
+#define LOGRINGBUFFER_H
+
+#include "Define.h"
+#include "Appender.h"
+
+#include <atomic>
+#include <cstdarg>
+
+#define LOG_RING_BUFFER_SIZE    (512 * 1024)            ///< Per logging thread, must be a power of two
+#define LOG_RECORD_MAX_SIZE     (64 * 1024)             ///< Bigger messages are formatted and truncated right away
+
+enum LogRecordFlags
+{
+    LOG_RECORD_PREFORMATTED = 0x01                      ///< Text already formatted, there is no argument
+};
+
+/// A message waiting in a thread ring buffer, followed by its format string and its arguments.
+/// The format is copied, callers don't always pass a literal.
+struct LogRecordHeader
+{
+    uint32 Size;                                        ///< Whole record, header included, multiple of 8, 0 marks the end of the buffer
+    uint32 FormatSize;                                  ///< Terminating null included
+    uint8  Level;
+    uint8  Filter;
+    uint8  Flags;
+    uint8  Padding;
+    uint64 Time;
+};
+
+/// Single producer / single consumer buffer of log records.
+/// The producer is the thread owning it, the consumer is the log worker, neither side takes a lock.
+class LogRingBuffer
+{
+    public:
+        LogRingBuffer();
+        ~LogRingBuffer();
+
+        /// Producer side, returns nullptr until the worker frees enough space
+        /// @p_Size : Record size, multiple of 8, at most LOG_RECORD_MAX_SIZE
+        char* Reserve(uint32 p_Size);
+        void Commit(uint32 p_Size);
+
+        /// Consumer side, calls p_Callback(LogRecordHeader const&) on every record written so far
+        template<class Callback> uint32 Drain(Callback p_Callback)
+        {
+            uint64 l_Tail  = m_Tail.load(std::memory_order_relaxed);
+            uint64 l_Head  = m_Head.load(std::memory_order_acquire);
+            uint32 l_Count = 0;
+
+            while (l_Tail < l_Head)
+            {
+                uint32 l_Offset = uint32(l_Tail & (LOG_RING_BUFFER_SIZE - 1));
+                LogRecordHeader const* l_Record = reinterpret_cast<LogRecordHeader const*>(m_Buffer + l_Offset);
+
+                /// Next record didn't fit before the end
+                if (!l_Record->Size)
+                {
+                    l_Tail += LOG_RING_BUFFER_SIZE - l_Offset;
+                    continue;
+                }
+
+                p_Callback(*l_Record);
+                l_Tail += l_Record->Size;
+                ++l_Count;
+
+                /// Released record by record, a producer may be waiting for space
+                m_Tail.store(l_Tail, std::memory_order_release);
+            }
+
+            m_Tail.store(l_Tail, std::memory_order_release);
+            return l_Count;
+        }
+
+        bool IsEmpty() const { return m_Tail.load(std::memory_order_acquire) == m_Head.load(std::memory_order_acquire); }
+
+        /// Set by the owning thread when it exits, the worker deletes the buffer once drained
+        void Close() { m_Closed.store(true, std::memory_order_release); }
+        bool IsClosed() const { return m_Closed.load(std::memory_order_acquire); }
+
+    private:
+        char*               m_Buffer;
+        std::atomic<uint64> m_Head;                     ///< Written by the producer
+        std::atomic<uint64> m_Tail;                     ///< Written by the consumer
+        std::atomic<bool>   m_Closed;
+
+        LogRingBuffer(LogRingBuffer const&);
+        LogRingBuffer& operator=(LogRingBuffer const&);
+};
+
+/// Deferred printf formatting: the calling thread only copies the format and the arguments,
+/// the log worker runs the conversions later
+namespace LogFormat
+{
+    /// Writes a record for p_Format / p_Args in p_Buffer
+    /// @p_Buffer  : Output, LOG_RECORD_MAX_SIZE bytes
+    /// @return Record size, 0 if the format uses something that can't be deferred (%n, *, positional arguments...)
+    ///         or doesn't fit, p_Args may have been consumed
+    uint32 Capture(char* p_Buffer, LogLevel p_Level, LogFilterType p_Filter, char const* p_Format, va_list p_Args);
+
+    /// Writes an already formatted text, truncated if needed
+    uint32 CaptureText(char* p_Buffer, LogLevel p_Level, LogFilterType p_Filter, char const* p_Text);
+
+    /// Formats a record, result truncated to p_Size - 1 characters
+    void Format(LogRecordHeader const& p_Record, char* p_Output, uint32 p_Size);
+}
+
+#endif
@@ -7,35 +7,79 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "LogWorker.h"
+#include "Log.h"
 
-LogWorker::LogWorker()
-    : m_queue(HIGH_WATERMARK, LOW_WATERMARK)
+#include <chrono>
+
+/// Upper bound of the delay between a message and its write when nobody wakes the worker
+#define LOG_WORKER_IDLE_WAIT 10
+
+LogWorker::LogWorker(Log* p_Log)
+    : m_Log(p_Log), m_Stop(false), m_Sleeping(false)
 {
-    ACE_Task_Base::activate(THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED, 1);
+    m_Thread = std::thread(&LogWorker::Run, this);
 }
 
 LogWorker::~LogWorker()
 {
-    m_queue.deactivate();
-    wait();
+    {
+        std::lock_guard<std::mutex> l_Guard(m_Lock);
+        m_Stop.store(true, std::memory_order_release);
+    }
+
+    m_Condition.notify_one();
+    m_Thread.join();
 }
 
 int LogWorker::enqueue(LogOperation* op)
 {
-    return m_queue.enqueue(op);
+    {
+        std::lock_guard<std::mutex> l_Guard(m_Lock);
+        m_Operations.push_back(op);
+    }
+
+    m_Condition.notify_one();
+    return 0;
 }
 
-int LogWorker::svc()
+void LogWorker::Run()
 {
-    while (1)
+    std::vector<LogOperation*> l_Operations;
+
+    while (true)
     {
-        LogOperation* request;
-        if (m_queue.dequeue(request) == -1)
+        bool l_Stop = m_Stop.load(std::memory_order_acquire);
+
+        {
+            std::lock_guard<std::mutex> l_Guard(m_Lock);
+            l_Operations.swap(m_Operations);
+        }
+
+        for (LogOperation* l_Operation : l_Operations)
+        {
+            l_Operation->call();
+            delete l_Operation;
+        }
+
+        uint32 l_Written = l_Operations.size() + m_Log->ProcessThreadBuffers();
+        l_Operations.clear();
+
+        if (l_Written)
+        {
+            m_Log->FlushAppenders();
+            continue;
+        }
+
+        /// Everything written before the stop request has been drained
+        if (l_Stop)
             break;
 
-        request->call();
-        delete request;
-    }
+        std::unique_lock<std::mutex> l_Guard(m_Lock);
+        m_Sleeping.store(true, std::memory_order_release);
 
-    return 0;
+        if (m_Operations.empty() && !m_Stop.load(std::memory_order_acquire))
+            m_Condition.wait_for(l_Guard, std::chrono::milliseconds(LOG_WORKER_IDLE_WAIT));
+
+        m_Sleeping.store(false, std::memory_order_release);
+    }
 }
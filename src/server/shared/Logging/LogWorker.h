@@ -11,28 +11,44 @@
 
 #include "LogOperation.h"
 
-#include <ace/Task.h>
-#include <ace/Activation_Queue.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 
-class LogWorker: protected ACE_Task_Base
+class Log;
+
+/// Single thread writing every log message: it drains the ring buffers of the logging threads,
+/// formats their records and flushes the appenders once per batch
+class LogWorker
 {
     public:
-        LogWorker();
+        explicit LogWorker(Log* p_Log);
         ~LogWorker();
 
-        typedef ACE_Message_Queue_Ex<LogOperation, ACE_MT_SYNCH> LogMessageQueueType;
+        /// Messages built by the caller (char dumps...), executed before the next ring buffer batch
+        int enqueue(LogOperation* op);
 
-        enum
+        /// Called by a logging thread after writing in its ring buffer, cheap unless the worker sleeps
+        void Wake()
         {
-            HIGH_WATERMARK = 8 * 1024 * 1024,
-            LOW_WATERMARK  = 8 * 1024 * 1024
-        };
+            if (m_Sleeping.load(std::memory_order_acquire))
+                m_Condition.notify_one();
+        }
 
-        int enqueue(LogOperation *op);
+        bool IsWorkerThread() const { return std::this_thread::get_id() == m_Thread.get_id(); }
 
     private:
-        virtual int svc();
-        LogMessageQueueType m_queue;
+        void Run();
+
+        Log*                        m_Log;
+        std::thread                 m_Thread;
+        std::atomic<bool>           m_Stop;
+        std::atomic<bool>           m_Sleeping;
+        std::mutex                  m_Lock;             ///< Protects m_Operations, used by m_Condition
+        std::condition_variable     m_Condition;
+        std::vector<LogOperation*>  m_Operations;
 };
 
 #endif
@@ -0,0 +1,237 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#ifndef CONCURRENTGUIDMAP_HPP_INCLUDED
+# define CONCURRENTGUIDMAP_HPP_INCLUDED
+
+#include "Common.h"
+#include "EpochReclaimer.hpp"
+#include <atomic>
+#include <mutex>
+
+namespace MS { namespace Utilities
+{
+    /// GUID -> object pointer index with wait-free lookups.
+    /// Open addressing with linear probing, readers never lock: writers are serialized, fill new slots
+    /// value first and key last, and removed entries are kept as tombstones (null value) so probe chains
+    /// stay valid. Growing or purging tombstones publishes a new table, the old one is freed through
+    /// EpochReclaimer once no reader can still be probing it.
+    template <typename T> class ConcurrentGuidMap
+    {
+        public:
+            /// Constructor
+            /// @p_Capacity : Initial slot count, rounded to a power of two
+            explicit ConcurrentGuidMap(uint32 p_Capacity = 64)
+                : m_Used(0), m_Live(0)
+            {
+                m_Table.store(CreateTable(p_Capacity), std::memory_order_relaxed);
+            }
+
+            /// Destructor, no reader may be left at this point
+            ~ConcurrentGuidMap()
+            {
+                DeleteTable(m_Table.load(std::memory_order_relaxed));
+            }
+
+            /// Insert or replace an element
+            /// @p_Key   : Element key, can't be 0
+            /// @p_Value : Element to insert
+            void Insert(uint64 p_Key, T* p_Value)
+            {
+                if (!p_Key || !p_Value)
+                    return;
+
+                std::lock_guard<std::mutex> l_Guard(m_WriteLock);
+
+                Table* l_Table = m_Table.load(std::memory_order_relaxed);
+                if ((m_Used + 1) * 2 > l_Table->Capacity)
+                    l_Table = Rehash(l_Table);
+
+                for (uint32 l_Index = Hash(l_Table, p_Key);; l_Index = (l_Index + 1) & (l_Table->Capacity - 1))
+                {
+                    Slot& l_Slot = l_Table->Slots[l_Index];
+                    uint64 l_Key = l_Slot.Key.load(std::memory_order_relaxed);
+
+                    if (l_Key == p_Key)
+                    {
+                        if (!l_Slot.Value.load(std::memory_order_relaxed))
+                            ++m_Live;
+
+                        l_Slot.Value.store(p_Value, std::memory_order_release);
+                        return;
+                    }
+
+                    if (!l_Key)
+                    {
+                        /// Value before key, a reader matching the key always sees the value
+                        l_Slot.Value.store(p_Value, std::memory_order_relaxed);
+                        l_Slot.Key.store(p_Key, std::memory_order_release);
+                        ++m_Used;
+                        ++m_Live;
+                        return;
+                    }
+                }
+            }
+
+            /// Remove an element
+            /// @p_Key      : Element key
+            /// @p_Expected : Only remove the entry if it still points to this element (NULL for any)
+            void Remove(uint64 p_Key, T* p_Expected = nullptr)
+            {
+                if (!p_Key)
+                    return;
+
+                std::lock_guard<std::mutex> l_Guard(m_WriteLock);
+
+                Table* l_Table = m_Table.load(std::memory_order_relaxed);
+                for (uint32 l_Index = Hash(l_Table, p_Key);; l_Index = (l_Index + 1) & (l_Table->Capacity - 1))
+                {
+                    Slot& l_Slot = l_Table->Slots[l_Index];
+                    uint64 l_Key = l_Slot.Key.load(std::memory_order_relaxed);
+
+                    if (!l_Key)
+                        return;
+
+                    if (l_Key != p_Key)
+                        continue;
+
+                    T* l_Value = l_Slot.Value.load(std::memory_order_relaxed);
+                    if (l_Value && (!p_Expected || l_Value == p_Expected))
+                    {
+                        l_Slot.Value.store(nullptr, std::memory_order_release);
+                        --m_Live;
+                    }
+                    return;
+                }
+            }
+
+            /// Find an element, never blocks
+            /// @p_Key : Element key
+            T* Find(uint64 p_Key) const
+            {
+                if (!p_Key)
+                    return nullptr;
+
+                EpochReclaimer::Guard l_Epoch;
+
+                Table const* l_Table = m_Table.load();
+                for (uint32 l_Index = Hash(l_Table, p_Key);; l_Index = (l_Index + 1) & (l_Table->Capacity - 1))
+                {
+                    Slot const& l_Slot = l_Table->Slots[l_Index];
+                    uint64 l_Key = l_Slot.Key.load(std::memory_order_acquire);
+
+                    if (l_Key == p_Key)
+                        return l_Slot.Value.load(std::memory_order_acquire);
+
+                    if (!l_Key)
+                        return nullptr;
+                }
+            }
+
+            /// Number of elements
+            uint32 Size() const
+            {
+                std::lock_guard<std::mutex> l_Guard(m_WriteLock);
+                return m_Live;
+            }
+
+        private:
+            struct Slot
+            {
+                std::atomic<uint64> Key;
+                std::atomic<T*>     Value;
+            };
+
+            struct Table
+            {
+                uint32 Capacity;
+                uint32 Shift;
+                Slot*  Slots;
+            };
+
+            static Table* CreateTable(uint32 p_Capacity)
+            {
+                Table* l_Table    = new Table();
+                l_Table->Capacity = 16;
+                l_Table->Shift    = 64 - 4;
+
+                while (l_Table->Capacity < p_Capacity)
+                {
+                    l_Table->Capacity <<= 1;
+                    --l_Table->Shift;
+                }
+
+                l_Table->Slots = new Slot[l_Table->Capacity];
+                for (uint32 l_I = 0; l_I < l_Table->Capacity; ++l_I)
+                {
+                    l_Table->Slots[l_I].Key.store(0, std::memory_order_relaxed);
+                    l_Table->Slots[l_I].Value.store(nullptr, std::memory_order_relaxed);
+                }
+
+                return l_Table;
+            }
+
+            static void DeleteTable(void* p_Table)
+            {
+                Table* l_Table = static_cast<Table*>(p_Table);
+                delete[] l_Table->Slots;
+                delete l_Table;
+            }
+
+            /// Fibonacci hashing, GUIDs only differ by their low part
+            static uint32 Hash(Table const* p_Table, uint64 p_Key)
+            {
+                return uint32((p_Key * UI64LIT(0x9E3779B97F4A7C15)) >> p_Table->Shift);
+            }
+
+            /// Copies live entries to a new table sized for them, publishes it and retires the old one
+            Table* Rehash(Table* p_Old)
+            {
+                uint32 l_Capacity = p_Old->Capacity;
+                while ((m_Live + 1) * 4 > l_Capacity)
+                    l_Capacity <<= 1;
+
+                Table* l_New = CreateTable(l_Capacity);
+                for (uint32 l_I = 0; l_I < p_Old->Capacity; ++l_I)
+                {
+                    Slot& l_Slot = p_Old->Slots[l_I];
+                    uint64 l_Key = l_Slot.Key.load(std::memory_order_relaxed);
+                    T* l_Value   = l_Slot.Value.load(std::memory_order_relaxed);
+
+                    if (!l_Key || !l_Value)
+                        continue;
+
+                    uint32 l_Index = Hash(l_New, l_Key);
+                    while (l_New->Slots[l_Index].Key.load(std::memory_order_relaxed))
+                        l_Index = (l_Index + 1) & (l_New->Capacity - 1);
+
+                    l_New->Slots[l_Index].Value.store(l_Value, std::memory_order_relaxed);
+                    l_New->Slots[l_Index].Key.store(l_Key, std::memory_order_relaxed);
+                }
+
+                m_Table.store(l_New);
+                m_Used = m_Live;
+
+                EpochReclaimer::Retire(p_Old, &DeleteTable);
+                return l_New;
+            }
+
+            std::atomic<Table*> m_Table;
+            mutable std::mutex  m_WriteLock;    ///< Serializes writers only
+            uint32              m_Used;         ///< Slots holding a key, tombstones included
+            uint32              m_Live;         ///< Slots holding an element
+
+            ConcurrentGuidMap(ConcurrentGuidMap const&);
+            ConcurrentGuidMap& operator=(ConcurrentGuidMap const&);
+    };
+
+}   ///< namespace Utilities
+}   ///< namespace MS
+
+#endif  ///< CONCURRENTGUIDMAP_HPP_INCLUDED
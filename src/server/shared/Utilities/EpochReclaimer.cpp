@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "EpochReclaimer.hpp"
+#include "Errors.h"
+
+#include <ace/TSS_T.h>
+
+namespace MS { namespace Utilities
+{
+    std::atomic<uint64>                  EpochReclaimer::s_GlobalEpoch(1);
+    std::atomic<uint64>                  EpochReclaimer::s_PinnedEpochs[EpochReclaimer::MaxThreads];
+    std::atomic<uint32>                  EpochReclaimer::s_ThreadCount(0);
+    std::mutex                           EpochReclaimer::s_RetiredLock;
+    std::vector<EpochReclaimer::Retired> EpochReclaimer::s_Retired;
+
+    static std::mutex          s_SlotLock;
+    static std::vector<uint32> s_FreeSlots;         ///< Slots of exited threads
+
+    static thread_local uint32 t_EpochSlot  = 0;    ///< Slot + 1, 0 until the thread first reads
+    static thread_local uint32 t_GuardDepth = 0;
+
+    /// Destroyed by ACE when its thread exits, gives the slot back. No guard is alive at that point,
+    /// the slot is unpinned and can be handed to the next reader thread as is
+    struct EpochThreadSlot
+    {
+        explicit EpochThreadSlot(uint32 p_Slot = 0) : Slot(p_Slot) { }
+
+        ~EpochThreadSlot()
+        {
+            std::lock_guard<std::mutex> l_Guard(s_SlotLock);
+            s_FreeSlots.push_back(Slot);
+        }
+
+        uint32 Slot;
+    };
+
+    static ACE_TSS<EpochThreadSlot> s_ThreadSlots;
+
+    uint32 EpochReclaimer::GetThreadSlot()
+    {
+        if (!t_EpochSlot)
+        {
+            uint32 l_Slot;
+
+            {
+                std::lock_guard<std::mutex> l_Guard(s_SlotLock);
+                if (!s_FreeSlots.empty())
+                {
+                    l_Slot = s_FreeSlots.back();
+                    s_FreeSlots.pop_back();
+                }
+                else
+                {
+                    ASSERT(s_ThreadCount.load() < MaxThreads && "EpochReclaimer: too many reader threads");
+                    l_Slot = s_ThreadCount.fetch_add(1);
+                }
+            }
+
+            s_ThreadSlots.ts_object(new EpochThreadSlot(l_Slot));
+            t_EpochSlot = l_Slot + 1;
+        }
+
+        return t_EpochSlot - 1;
+    }
+
+    EpochReclaimer::Guard::Guard()
+    {
+        if (t_GuardDepth++)
+            return;
+
+        /// Sequentially consistent, the pinned epoch must be visible before any shared pointer is read
+        s_PinnedEpochs[GetThreadSlot()].store(s_GlobalEpoch.load());
+    }
+
+    EpochReclaimer::Guard::~Guard()
+    {
+        if (--t_GuardDepth)
+            return;
+
+        s_PinnedEpochs[t_EpochSlot - 1].store(0, std::memory_order_release);
+    }
+
+    uint64 EpochReclaimer::GetOldestPinnedEpoch()
+    {
+        uint64 l_Oldest   = s_GlobalEpoch.load();
+        uint32 l_Threads  = std::min<uint32>(s_ThreadCount.load(), MaxThreads);
+
+        for (uint32 l_I = 0; l_I < l_Threads; ++l_I)
+        {
+            uint64 l_Epoch = s_PinnedEpochs[l_I].load();
+            if (l_Epoch && l_Epoch < l_Oldest)
+                l_Oldest = l_Epoch;
+        }
+
+        return l_Oldest;
+    }
+
+    void EpochReclaimer::Retire(void* p_Pointer, Deleter p_Deleter)
+    {
+        Retired l_Retired;
+        l_Retired.Pointer = p_Pointer;
+        l_Retired.Release = p_Deleter;
+
+        /// Readers pinned on this epoch or before may still hold p_Pointer, later ones can't reach it anymore
+        l_Retired.Epoch   = s_GlobalEpoch.fetch_add(1);
+
+        {
+            std::lock_guard<std::mutex> l_Guard(s_RetiredLock);
+            s_Retired.push_back(l_Retired);
+        }
+
+        Collect();
+    }
+
+    void EpochReclaimer::Collect()
+    {
+        std::vector<Retired> l_Freeable;
+
+        {
+            std::lock_guard<std::mutex> l_Guard(s_RetiredLock);
+            if (s_Retired.empty())
+                return;
+
+            uint64 l_Oldest = GetOldestPinnedEpoch();
+            for (size_t l_I = 0; l_I < s_Retired.size();)
+            {
+                if (s_Retired[l_I].Epoch < l_Oldest)
+                {
+                    l_Freeable.push_back(s_Retired[l_I]);
+                    s_Retired[l_I] = s_Retired.back();
+                    s_Retired.pop_back();
+                }
+                else
+                    ++l_I;
+            }
+        }
+
+        for (Retired const& l_Retired : l_Freeable)
+            l_Retired.Release(l_Retired.Pointer);
+    }
+
+}   ///< namespace Utilities
+}   ///< namespace MS
@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#ifndef EPOCHRECLAIMER_HPP_INCLUDED
+# define EPOCHRECLAIMER_HPP_INCLUDED
+
+#include "Common.h"
+#include <atomic>
+#include <mutex>
+
+namespace MS { namespace Utilities
+{
+    /// Epoch based memory reclamation for lock-free readers.
+    /// A reader pins the current epoch for the duration of its lookup (EpochReclaimer::Guard),
+    /// memory unlinked by a writer is retired with the epoch it was unlinked in, and is only
+    /// freed once every pinned reader entered a later epoch.
+    class EpochReclaimer
+    {
+        public:
+            enum
+            {
+                MaxThreads = 1024       ///< Reader threads running at the same time, slots of exited threads are reused
+            };
+
+            typedef void (*Deleter)(void*);
+
+            /// Pins the current epoch until destruction, can be nested
+            class Guard
+            {
+                public:
+                    Guard();
+                    ~Guard();
+
+                private:
+                    Guard(Guard const&);
+                    Guard& operator=(Guard const&);
+            };
+
+            /// Frees p_Pointer with p_Deleter once no reader can still see it.
+            /// Must be called after p_Pointer was unlinked from every shared structure.
+            /// @p_Pointer : Unlinked memory
+            /// @p_Deleter : Function releasing it
+            static void Retire(void* p_Pointer, Deleter p_Deleter);
+
+            /// Frees everything retired before the oldest pinned epoch
+            static void Collect();
+
+        private:
+            struct Retired
+            {
+                void*   Pointer;
+                Deleter Release;
+                uint64  Epoch;
+            };
+
+            static uint32 GetThreadSlot();
+            static uint64 GetOldestPinnedEpoch();
+
+            static std::atomic<uint64>   s_GlobalEpoch;
+            static std::atomic<uint64>   s_PinnedEpochs[MaxThreads];    ///< 0 when the thread is not reading
+            static std::atomic<uint32>   s_ThreadCount;                 ///< Slots ever handed out, the scanned range
+            static std::mutex            s_RetiredLock;
+            static std::vector<Retired>  s_Retired;
+    };
+
+}   ///< namespace Utilities
+}   ///< namespace MS
+
+#endif  ///< EPOCHRECLAIMER_HPP_INCLUDED
@@ -11,10 +11,12 @@
 
 #include "Define.h"
 #include "Common.h"
+#include "TimerWheel.h"
 
 // Note. All times are in milliseconds here.
 
-class BasicEvent
+// events are intrusive nodes of the timing wheel of their processor
+class BasicEvent : public TimerWheelNode
 {
     public:
         BasicEvent() { to_Abort = false; }
@@ -38,8 +40,6 @@ class BasicEvent
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
 };
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
-
 class EventProcessor
 {
     public:
@@ -52,7 +52,7 @@ class EventProcessor
         uint64 CalculateTime(uint64 t_offset) const;
     protected:
         uint64 m_time;
-        EventList m_events;
+        TimerWheel m_events;
         bool m_aborting;
 };
 #endif
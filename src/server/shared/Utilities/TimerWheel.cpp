@@ -0,0 +1,301 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "TimerWheel.h"
+#include "Common.h"
+#include "Errors.h"
+
+#define TIMER_WHEEL_POOL_GRANULARITY    16
+#define TIMER_WHEEL_POOL_CLASSES        40              ///< Blocks up to 640 bytes, bigger ones go to the allocator
+#define TIMER_WHEEL_POOL_MAX_FREE       512             ///< Per size class and thread, the rest goes back to the allocator
+
+struct TimerWheelFreeBlock
+{
+    TimerWheelFreeBlock* Next;
+};
+
+static thread_local TimerWheelFreeBlock* t_TimerWheelFreeBlocks[TIMER_WHEEL_POOL_CLASSES];
+static thread_local uint32 t_TimerWheelFreeCounts[TIMER_WHEEL_POOL_CLASSES];
+
+void* TimerWheelPool::Allocate(size_t p_Size)
+{
+    size_t l_Class = (p_Size + TIMER_WHEEL_POOL_GRANULARITY - 1) / TIMER_WHEEL_POOL_GRANULARITY - 1;
+    if (l_Class >= TIMER_WHEEL_POOL_CLASSES)
+        return ::operator new(p_Size);
+
+    if (TimerWheelFreeBlock* l_Block = t_TimerWheelFreeBlocks[l_Class])
+    {
+        t_TimerWheelFreeBlocks[l_Class] = l_Block->Next;
+        --t_TimerWheelFreeCounts[l_Class];
+        return l_Block;
+    }
+
+    return ::operator new((l_Class + 1) * TIMER_WHEEL_POOL_GRANULARITY);
+}
+
+void TimerWheelPool::Free(void* p_Block, size_t p_Size)
+{
+    size_t l_Class = (p_Size + TIMER_WHEEL_POOL_GRANULARITY - 1) / TIMER_WHEEL_POOL_GRANULARITY - 1;
+    if (l_Class >= TIMER_WHEEL_POOL_CLASSES || t_TimerWheelFreeCounts[l_Class] >= TIMER_WHEEL_POOL_MAX_FREE)
+    {
+        ::operator delete(p_Block);
+        return;
+    }
+
+    TimerWheelFreeBlock* l_Block = static_cast<TimerWheelFreeBlock*>(p_Block);
+    l_Block->Next = t_TimerWheelFreeBlocks[l_Class];
+    t_TimerWheelFreeBlocks[l_Class] = l_Block;
+    ++t_TimerWheelFreeCounts[l_Class];
+}
+
+TimerWheel::TimerWheel(uint64 p_Time)
+    : m_Overflow(nullptr), m_Now(p_Time), m_Size(0)
+{
+    memset(m_Levels, 0, sizeof(m_Levels));
+}
+
+TimerWheel::~TimerWheel()
+{
+    for (uint8 l_Level = 0; l_Level < TIMER_WHEEL_LEVELS; ++l_Level)
+    {
+        if (m_Levels[l_Level])
+            FreeLevel(l_Level);
+    }
+}
+
+void TimerWheel::Insert(TimerWheelNode* p_Node, uint64 p_Due)
+{
+    p_Node->WheelDue = p_Due;
+    Link(p_Node);
+    ++m_Size;
+}
+
+void TimerWheel::Remove(TimerWheelNode* p_Node)
+{
+    Unlink(p_Node);
+    --m_Size;
+}
+
+TimerWheelNode* TimerWheel::PeekDue(uint64 p_Time)
+{
+    for (;;)
+    {
+        if (TimerWheelLevel* l_Wheel = m_Levels[0])
+        {
+            if (TimerWheelNode* l_Node = l_Wheel->Slots[m_Now & (TIMER_WHEEL_SLOTS - 1)])
+                return l_Node;
+        }
+
+        uint64 l_Boundary = m_Size ? GetNextBoundary() : p_Time + 1;
+        if (l_Boundary > p_Time)
+        {
+            /// No slot starts before p_Time, every timer stays where it is
+            if (p_Time > m_Now)
+                m_Now = p_Time;
+
+            return nullptr;
+        }
+
+        m_Now = l_Boundary;
+        Cascade(l_Boundary);
+    }
+}
+
+TimerWheelNode* TimerWheel::PopDue(uint64 p_Time)
+{
+    TimerWheelNode* l_Node = PeekDue(p_Time);
+    if (l_Node)
+        Remove(l_Node);
+
+    return l_Node;
+}
+
+TimerWheelNode* TimerWheel::DetachAll()
+{
+    TimerWheelNode* l_First = nullptr;
+    TimerWheelNode** l_Tail = &l_First;
+
+    Visit([&l_Tail](TimerWheelNode* p_Node) -> bool
+    {
+        *l_Tail = p_Node;
+        l_Tail = &p_Node->WheelNext;
+        return true;
+    });
+
+    *l_Tail = nullptr;
+
+    for (uint8 l_Level = 0; l_Level < TIMER_WHEEL_LEVELS; ++l_Level)
+    {
+        if (m_Levels[l_Level])
+            FreeLevel(l_Level);
+    }
+
+    m_Overflow = nullptr;
+    m_Size     = 0;
+
+    for (TimerWheelNode* l_Node = l_First; l_Node; l_Node = l_Node->WheelNext)
+        l_Node->WheelPrev = nullptr;
+
+    return l_First;
+}
+
+void TimerWheel::Reset(uint64 p_Time)
+{
+    ASSERT(!m_Size);
+    m_Now = p_Time;
+}
+
+void TimerWheel::Link(TimerWheelNode* p_Node)
+{
+    uint64 l_Place = std::max(p_Node->WheelDue, m_Now);
+    uint64 l_Diff  = l_Place ^ m_Now;
+    uint8 l_Level  = l_Diff ? TimerWheelHighestBit(l_Diff) / TIMER_WHEEL_SLOT_BITS : 0;
+
+    TimerWheelNode** l_Head;
+    if (l_Level >= TIMER_WHEEL_LEVELS)
+    {
+        p_Node->WheelLevel = TIMER_WHEEL_LEVELS;
+        p_Node->WheelSlot  = 0;
+        l_Head = &m_Overflow;
+    }
+    else
+    {
+        TimerWheelLevel*& l_Wheel = m_Levels[l_Level];
+        if (!l_Wheel)
+        {
+            l_Wheel = static_cast<TimerWheelLevel*>(TimerWheelPool::Allocate(sizeof(TimerWheelLevel)));
+            memset(l_Wheel, 0, sizeof(TimerWheelLevel));
+        }
+
+        uint8 l_Slot = uint8((l_Place >> (l_Level * TIMER_WHEEL_SLOT_BITS)) & (TIMER_WHEEL_SLOTS - 1));
+        l_Wheel->Occupied |= UI64LIT(1) << l_Slot;
+
+        p_Node->WheelLevel = l_Level;
+        p_Node->WheelSlot  = l_Slot;
+        l_Head = &l_Wheel->Slots[l_Slot];
+    }
+
+    if (TimerWheelNode* l_First = *l_Head)
+    {
+        p_Node->WheelNext = l_First;
+        p_Node->WheelPrev = l_First->WheelPrev;
+        l_First->WheelPrev->WheelNext = p_Node;
+        l_First->WheelPrev = p_Node;
+    }
+    else
+    {
+        p_Node->WheelNext = p_Node;
+        p_Node->WheelPrev = p_Node;
+        *l_Head = p_Node;
+    }
+}
+
+void TimerWheel::Unlink(TimerWheelNode* p_Node)
+{
+    TimerWheelLevel* l_Wheel = p_Node->WheelLevel < TIMER_WHEEL_LEVELS ? m_Levels[p_Node->WheelLevel] : nullptr;
+    TimerWheelNode** l_Head  = l_Wheel ? &l_Wheel->Slots[p_Node->WheelSlot] : &m_Overflow;
+
+    if (p_Node->WheelNext == p_Node)
+    {
+        *l_Head = nullptr;
+
+        if (l_Wheel)
+        {
+            l_Wheel->Occupied &= ~(UI64LIT(1) << p_Node->WheelSlot);
+            if (!l_Wheel->Occupied)
+                FreeLevel(p_Node->WheelLevel);
+        }
+    }
+    else
+    {
+        p_Node->WheelPrev->WheelNext = p_Node->WheelNext;
+        p_Node->WheelNext->WheelPrev = p_Node->WheelPrev;
+
+        if (*l_Head == p_Node)
+            *l_Head = p_Node->WheelNext;
+    }
+
+    p_Node->WheelPrev = nullptr;
+    p_Node->WheelNext = nullptr;
+}
+
+void TimerWheel::RelinkList(TimerWheelNode* p_Head)
+{
+    /// Breaks the circle, the nodes are linked again one by one in their former order
+    p_Head->WheelPrev->WheelNext = nullptr;
+
+    for (TimerWheelNode* l_Node = p_Head; l_Node;)
+    {
+        TimerWheelNode* l_Next = l_Node->WheelNext;
+        Link(l_Node);
+        l_Node = l_Next;
+    }
+}
+
+void TimerWheel::FreeLevel(uint8 p_Level)
+{
+    TimerWheelPool::Free(m_Levels[p_Level], sizeof(TimerWheelLevel));
+    m_Levels[p_Level] = nullptr;
+}
+
+uint64 TimerWheel::GetNextBoundary() const
+{
+    for (uint8 l_Level = 0; l_Level < TIMER_WHEEL_LEVELS; ++l_Level)
+    {
+        TimerWheelLevel const* l_Wheel = m_Levels[l_Level];
+        if (!l_Wheel)
+            continue;
+
+        uint8 l_Shift  = l_Level * TIMER_WHEEL_SLOT_BITS;
+        uint8 l_Cursor = uint8((m_Now >> l_Shift) & (TIMER_WHEEL_SLOTS - 1));
+
+        /// Slots up to the cursor are empty above level 0, the level 0 one is checked by the caller
+        uint64 l_After = l_Wheel->Occupied & ~((UI64LIT(2) << l_Cursor) - 1);
+        if (!l_After)
+            continue;
+
+        uint64 l_LevelSpan = UI64LIT(1) << (l_Shift + TIMER_WHEEL_SLOT_BITS);
+        return (m_Now & ~(l_LevelSpan - 1)) | (uint64(TimerWheelLowestBit(l_After)) << l_Shift);
+    }
+
+    /// Only the overflow list left, it's sorted out when the top level wraps
+    uint8 l_TopShift = TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOT_BITS;
+    return ((m_Now >> l_TopShift) + 1) << l_TopShift;
+}
+
+void TimerWheel::Cascade(uint64 p_Boundary)
+{
+    if (m_Overflow && !(p_Boundary & ((UI64LIT(1) << (TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOT_BITS)) - 1)))
+    {
+        TimerWheelNode* l_List = m_Overflow;
+        m_Overflow = nullptr;
+        RelinkList(l_List);
+    }
+
+    for (uint8 l_Level = TIMER_WHEEL_LEVELS - 1; l_Level > 0; --l_Level)
+    {
+        uint8 l_Shift = l_Level * TIMER_WHEEL_SLOT_BITS;
+        if (p_Boundary & ((UI64LIT(1) << l_Shift) - 1))
+            continue;
+
+        TimerWheelLevel* l_Wheel = m_Levels[l_Level];
+        uint8 l_Slot = uint8((p_Boundary >> l_Shift) & (TIMER_WHEEL_SLOTS - 1));
+        if (!l_Wheel || !(l_Wheel->Occupied & (UI64LIT(1) << l_Slot)))
+            continue;
+
+        TimerWheelNode* l_List = l_Wheel->Slots[l_Slot];
+        l_Wheel->Slots[l_Slot] = nullptr;
+        l_Wheel->Occupied &= ~(UI64LIT(1) << l_Slot);
+
+        if (!l_Wheel->Occupied)
+            FreeLevel(l_Level);
+
+        /// Relinked relatively to the boundary, they all land in lower levels
+        RelinkList(l_List);
+    }
+}
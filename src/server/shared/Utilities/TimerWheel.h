@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include "Define.h"
+
+#if defined(_MSC_VER)
+# include <intrin.h>
+#endif
+
+#define TIMER_WHEEL_SLOT_BITS   6
+#define TIMER_WHEEL_SLOTS       (1 << TIMER_WHEEL_SLOT_BITS)
+#define TIMER_WHEEL_LEVELS      6                       ///< 2^36 ms ahead, anything later waits in the overflow list
+
+inline uint8 TimerWheelLowestBit(uint64 p_Value)
+{
+#if defined(_MSC_VER)
+    unsigned long l_Index;
+    _BitScanForward64(&l_Index, p_Value);
+    return uint8(l_Index);
+#else
+    return uint8(__builtin_ctzll(p_Value));
+#endif
+}
+
+inline uint8 TimerWheelHighestBit(uint64 p_Value)
+{
+#if defined(_MSC_VER)
+    unsigned long l_Index;
+    _BitScanReverse64(&l_Index, p_Value);
+    return uint8(l_Index);
+#else
+    return uint8(63 - __builtin_clzll(p_Value));
+#endif
+}
+
+/// Intrusive hook of a timer, a node can only be scheduled in one wheel at a time
+struct TimerWheelNode
+{
+    TimerWheelNode() : WheelPrev(nullptr), WheelNext(nullptr), WheelDue(0), WheelLevel(0), WheelSlot(0) { }
+
+    TimerWheelNode* WheelPrev;                          ///< Circular list of the slot
+    TimerWheelNode* WheelNext;
+    uint64          WheelDue;
+    uint8           WheelLevel;                         ///< TIMER_WHEEL_LEVELS for the overflow list
+    uint8           WheelSlot;
+};
+
+struct TimerWheelLevel
+{
+    uint64          Occupied;                           ///< One bit per non empty slot
+    TimerWheelNode* Slots[TIMER_WHEEL_SLOTS];
+};
+
+/// Small blocks (wheel levels, timer nodes) kept in free lists of the thread releasing them
+namespace TimerWheelPool
+{
+    void* Allocate(size_t p_Size);
+    void Free(void* p_Block, size_t p_Size);
+}
+
+/// Hierarchical timing wheel, 1 ms resolution.
+/// Level N has 64 slots of 64^N ms, a timer sits in the lowest level where its due time shares the upper bits
+/// of the current time and moves down a level each time the cursor reaches the beginning of its slot.
+/// Insertion and removal are O(1), timers due at the same time expire in insertion order.
+/// Levels are only allocated while they hold timers, an idle wheel is a few pointers.
+/// The wheel doesn't own the nodes, time given to PeekDue / PopDue must never go backward.
+class TimerWheel
+{
+    public:
+        explicit TimerWheel(uint64 p_Time = 0);
+        ~TimerWheel();
+
+        /// A due time before the current time expires on the next PeekDue / PopDue call
+        void Insert(TimerWheelNode* p_Node, uint64 p_Due);
+        void Remove(TimerWheelNode* p_Node);
+
+        /// Advances the wheel up to p_Time, stopping at the first timer due
+        /// @return Earliest due timer, still in the wheel, nullptr if none is due at p_Time
+        TimerWheelNode* PeekDue(uint64 p_Time);
+        /// Same as PeekDue, the timer is removed from the wheel
+        TimerWheelNode* PopDue(uint64 p_Time);
+
+        /// Empties the wheel
+        /// @return Timers linked through WheelNext, nullptr terminated, in due order except inside slots above level 0
+        TimerWheelNode* DetachAll();
+
+        /// Calls p_Visitor(TimerWheelNode*) on every timer until it returns false.
+        /// The visitor may remove the node it's given, but nothing else
+        template<class Visitor> bool Visit(Visitor p_Visitor) const
+        {
+            for (uint8 l_Level = 0; l_Level < TIMER_WHEEL_LEVELS; ++l_Level)
+            {
+                uint64 l_Pending = m_Levels[l_Level] ? m_Levels[l_Level]->Occupied : 0;
+
+                /// The level is released as soon as the visitor empties it
+                while (l_Pending && m_Levels[l_Level])
+                {
+                    uint8 l_Slot = TimerWheelLowestBit(l_Pending);
+                    l_Pending &= l_Pending - 1;
+
+                    if (!VisitList(m_Levels[l_Level]->Slots[l_Slot], p_Visitor))
+                        return false;
+                }
+            }
+
+            return VisitList(m_Overflow, p_Visitor);
+        }
+
+        /// Moves the wheel to p_Time, must be empty
+        void Reset(uint64 p_Time);
+
+        bool IsEmpty() const { return !m_Size; }
+        uint32 GetSize() const { return m_Size; }
+        uint64 GetTime() const { return m_Now; }
+
+    private:
+        template<class Visitor> static bool VisitList(TimerWheelNode* p_Head, Visitor& p_Visitor)
+        {
+            if (!p_Head)
+                return true;
+
+            TimerWheelNode* l_Last = p_Head->WheelPrev;
+            TimerWheelNode* l_Node = p_Head;
+
+            for (;;)
+            {
+                TimerWheelNode* l_Next = l_Node->WheelNext;
+                bool l_IsLast = l_Node == l_Last;
+
+                if (!p_Visitor(l_Node))
+                    return false;
+
+                if (l_IsLast)
+                    return true;
+
+                l_Node = l_Next;
+            }
+        }
+
+        void Link(TimerWheelNode* p_Node);
+        void Unlink(TimerWheelNode* p_Node);
+        void RelinkList(TimerWheelNode* p_Head);
+        void FreeLevel(uint8 p_Level);
+
+        /// Time at which the cursor reaches the first non empty slot after it
+        uint64 GetNextBoundary() const;
+        /// Moves the timers of the slots starting at p_Boundary down
+        void Cascade(uint64 p_Boundary);
+
+        TimerWheelLevel*    m_Levels[TIMER_WHEEL_LEVELS];
+        TimerWheelNode*     m_Overflow;
+        uint64              m_Now;
+        uint32              m_Size;
+
+        TimerWheel(TimerWheel const&);
+        TimerWheel& operator=(TimerWheel const&);
+};
+
+#endif